@@ -0,0 +1,144 @@
+#include "AllocationCounter.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace bench {
+
+namespace {
+
+std::atomic<uint64_t> g_allocations{0};
+std::atomic<uint64_t> g_deallocations{0};
+std::atomic<uint64_t> g_bytesAllocated{0};
+std::atomic<uint64_t> g_liveBytes{0};
+std::atomic<uint64_t> g_peakLiveBytes{0};
+
+// Перед каждым блоком храним его размер, чтобы delete знал, сколько освобождается.
+// Заголовок выровнен как max_align_t, поэтому выравнивание блока не меняется.
+constexpr size_t HEADER_SIZE = alignof(std::max_align_t) > sizeof(size_t)
+    ? alignof(std::max_align_t) : sizeof(size_t);
+
+void recordAllocation(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_bytesAllocated.fetch_add(size, std::memory_order_relaxed);
+    uint64_t live = g_liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+
+    uint64_t peak = g_peakLiveBytes.load(std::memory_order_relaxed);
+    while (live > peak &&
+           !g_peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+}
+
+void* countedAlloc(size_t size) noexcept {
+    void* raw = std::malloc(size + HEADER_SIZE);
+    if (!raw) {
+        return nullptr;
+    }
+    *static_cast<size_t*>(raw) = size;
+    recordAllocation(size);
+    return static_cast<char*>(raw) + HEADER_SIZE;
+}
+
+void* countedNew(size_t size) {
+    while (true) {
+        if (void* p = countedAlloc(size)) {
+            return p;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void countedFree(void* ptr) noexcept {
+    if (!ptr) {
+        return;
+    }
+    void* raw = static_cast<char*>(ptr) - HEADER_SIZE;
+    size_t size = *static_cast<size_t*>(raw);
+    g_deallocations.fetch_add(1, std::memory_order_relaxed);
+    g_liveBytes.fetch_sub(size, std::memory_order_relaxed);
+    std::free(raw);
+}
+
+} // namespace
+
+AllocationStats AllocationCounter::snapshot() {
+    AllocationStats stats;
+    stats.allocations = g_allocations.load(std::memory_order_relaxed);
+    stats.deallocations = g_deallocations.load(std::memory_order_relaxed);
+    stats.bytesAllocated = g_bytesAllocated.load(std::memory_order_relaxed);
+    stats.liveBytes = g_liveBytes.load(std::memory_order_relaxed);
+    stats.peakLiveBytes = g_peakLiveBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void AllocationCounter::resetPeak() {
+    g_peakLiveBytes.store(g_liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+AllocationScope::AllocationScope() {
+    AllocationCounter::resetPeak();
+    m_start = AllocationCounter::snapshot();
+}
+
+StageAllocations AllocationScope::stop() const {
+    AllocationStats now = AllocationCounter::snapshot();
+
+    StageAllocations stage;
+    stage.allocations = now.allocations - m_start.allocations;
+    stage.deallocations = now.deallocations - m_start.deallocations;
+    stage.bytesAllocated = now.bytesAllocated - m_start.bytesAllocated;
+    stage.peakBytes = now.peakLiveBytes > m_start.liveBytes
+        ? now.peakLiveBytes - m_start.liveBytes : 0;
+    stage.netBytes = static_cast<int64_t>(now.liveBytes) - static_cast<int64_t>(m_start.liveBytes);
+    return stage;
+}
+
+} // namespace bench
+
+// ==================== Глобальные operator new/delete ====================
+// Выровненные варианты (align_val_t) не заменяются: они парные между собой
+// и в счётчики не попадают.
+
+void* operator new(size_t size) {
+    return bench::countedNew(size);
+}
+
+void* operator new[](size_t size) {
+    return bench::countedNew(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return bench::countedAlloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return bench::countedAlloc(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    bench::countedFree(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    bench::countedFree(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    bench::countedFree(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    bench::countedFree(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    bench::countedFree(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    bench::countedFree(ptr);
+}
@@ -0,0 +1,50 @@
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace bench {
+
+// Снимок счётчиков глобальных operator new/delete.
+// Счётчики ведутся только в jsonparser_memory_benchmarks (AllocationCounter.cpp
+// заменяет глобальные operator new/delete); в замеры времени он не линкуется.
+struct AllocationStats {
+    uint64_t allocations = 0;       // Вызовов operator new
+    uint64_t deallocations = 0;     // Вызовов operator delete
+    uint64_t bytesAllocated = 0;    // Всего запрошено байт
+    uint64_t liveBytes = 0;         // Байт выделено и не освобождено
+    uint64_t peakLiveBytes = 0;     // Максимум liveBytes
+};
+
+class AllocationCounter {
+public:
+    static AllocationStats snapshot();
+
+    // Сбросить пик до текущего объёма живой памяти
+    static void resetPeak();
+};
+
+// Статистика аллокаций за время жизни объекта (один этап обработки)
+struct StageAllocations {
+    uint64_t allocations = 0;
+    uint64_t deallocations = 0;
+    uint64_t bytesAllocated = 0;
+    uint64_t peakBytes = 0;         // Пик живой памяти сверх уровня на входе в этап
+    int64_t netBytes = 0;           // Изменение живой памяти (может быть < 0)
+};
+
+class AllocationScope {
+private:
+    AllocationStats m_start;
+
+public:
+    AllocationScope();
+
+    // Статистика с момента создания
+    StageAllocations stop() const;
+};
+
+} // namespace bench
+
+#endif // ALLOCATION_COUNTER_HPP
@@ -0,0 +1,441 @@
+#include "BenchmarkHarness.hpp"
+#include "JsonWriter.hpp"
+#include "Parser.hpp"
+#include "SystemInfo.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#ifndef JSONPARSER_BUILD_TYPE
+#define JSONPARSER_BUILD_TYPE ""
+#endif
+
+namespace bench {
+
+// ==================== Привязка к ядру ====================
+
+#if defined(__linux__)
+static cpu_set_t g_originalMask;
+static bool g_haveOriginalMask = false;
+
+bool pinCurrentThread(int cpu) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    if (!g_haveOriginalMask) {
+        g_haveOriginalMask = sched_getaffinity(0, sizeof(g_originalMask), &g_originalMask) == 0;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+void unpinCurrentThread() {
+    if (g_haveOriginalMask) {
+        sched_setaffinity(0, sizeof(g_originalMask), &g_originalMask);
+    }
+}
+#elif defined(_WIN32)
+static DWORD_PTR g_originalMask = 0;
+
+bool pinCurrentThread(int cpu) {
+    if (cpu < 0 || cpu >= static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+        return false;
+    }
+    DWORD_PTR previous = SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu);
+    if (previous == 0) {
+        return false;
+    }
+    if (g_originalMask == 0) {
+        g_originalMask = previous;
+    }
+    return true;
+}
+
+void unpinCurrentThread() {
+    if (g_originalMask != 0) {
+        SetThreadAffinityMask(GetCurrentThread(), g_originalMask);
+    }
+}
+#else
+// macOS не даёт жёстко привязать поток к ядру
+bool pinCurrentThread(int) {
+    return false;
+}
+
+void unpinCurrentThread() {}
+#endif
+
+// ==================== Вспомогательные функции ====================
+
+std::string formatDuration(double ns) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    if (ns < 1e3) {
+        oss << ns << " ns";
+    } else if (ns < 1e6) {
+        oss << ns / 1e3 << " us";
+    } else if (ns < 1e9) {
+        oss << ns / 1e6 << " ms";
+    } else {
+        oss << ns / 1e9 << " s";
+    }
+    return oss.str();
+}
+
+// Перцентиль отсортированной выборки с линейной интерполяцией
+static double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    double pos = p * static_cast<double>(sorted.size() - 1);
+    size_t lower = static_cast<size_t>(pos);
+    size_t upper = std::min(lower + 1, sorted.size() - 1);
+    double frac = pos - static_cast<double>(lower);
+    return sorted[lower] + (sorted[upper] - sorted[lower]) * frac;
+}
+
+// ==================== BenchmarkHarness ====================
+
+BenchmarkHarness::BenchmarkHarness(const BenchmarkConfig& config)
+    : m_config(config), m_pinned(false) {
+    if (m_config.pinCpu >= 0) {
+        m_pinned = pinCurrentThread(m_config.pinCpu);
+        if (!m_pinned) {
+            std::cerr << "[!] Не удалось привязать поток к ядру " << m_config.pinCpu << "\n";
+        }
+    }
+}
+
+BenchmarkHarness::~BenchmarkHarness() {
+    if (m_pinned) {
+        unpinCurrentThread();
+    }
+}
+
+bool BenchmarkHarness::matches(const std::string& name) const {
+    return m_config.filter.empty() || name.find(m_config.filter) != std::string::npos;
+}
+
+void BenchmarkHarness::run(const std::string& name,
+                           const std::function<void()>& func,
+                           size_t bytesPerIteration,
+                           size_t itemsPerIteration,
+                           bool multiThreaded) {
+    if (!matches(name)) {
+        return;
+    }
+
+    std::cout << "Running: " << name << "..." << std::flush;
+
+    if (multiThreaded && m_pinned) {
+        unpinCurrentThread();
+    }
+
+    BenchmarkResult result = measure(name, func);
+
+    if (multiThreaded && m_pinned) {
+        pinCurrentThread(m_config.pinCpu);
+    }
+
+    result.bytesPerIteration = bytesPerIteration;
+    result.itemsPerIteration = itemsPerIteration;
+    if (result.medianNs > 0) {
+        result.bytesPerSecond = static_cast<double>(bytesPerIteration) * 1e9 / result.medianNs;
+        result.itemsPerSecond = static_cast<double>(itemsPerIteration) * 1e9 / result.medianNs;
+    }
+
+    std::cout << " " << formatDuration(result.medianNs)
+              << " (" << result.samples << " x " << result.batchSize << ")\n";
+
+    m_results.push_back(std::move(result));
+}
+
+BenchmarkResult BenchmarkHarness::measure(const std::string& name, const std::function<void()>& func) {
+    using Clock = std::chrono::steady_clock;
+
+    auto timeBatch = [&func](size_t count) {
+        auto start = Clock::now();
+        for (size_t i = 0; i < count; ++i) {
+            func();
+        }
+        auto end = Clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count();
+    };
+
+    // Прогрев: кэши, предсказатель переходов, аллокатор
+    const double warmupNs = m_config.warmupMs * 1e6;
+    auto warmupStart = Clock::now();
+    do {
+        func();
+    } while (std::chrono::duration<double, std::nano>(Clock::now() - warmupStart).count() < warmupNs);
+
+    // Калибровка: один замер должен длиться заметно дольше разрешения таймера
+    const double targetSampleNs = std::max(
+        m_config.minTimeMs * 1e6 / static_cast<double>(std::max<size_t>(m_config.targetSamples, 1)),
+        10000.0);
+    const size_t maxBatch = size_t(1) << 24;
+
+    auto batchFor = [&](double batchNs, size_t batch) {
+        double estimate = static_cast<double>(batch) * targetSampleNs / std::max(batchNs, 1.0);
+        return static_cast<size_t>(std::clamp(estimate, 1.0, static_cast<double>(maxBatch)));
+    };
+
+    size_t batchSize = 1;
+    double single = timeBatch(1);
+    if (single < targetSampleNs) {
+        batchSize = batchFor(single, 1);
+        batchSize = batchFor(timeBatch(batchSize), batchSize);
+    }
+
+    // Замеры
+    std::vector<double> samples;
+    samples.reserve(std::min<size_t>(m_config.maxSamples, 1024));
+    const double minTimeNs = m_config.minTimeMs * 1e6;
+    double totalNs = 0.0;
+
+    while (samples.size() < m_config.maxSamples &&
+           (totalNs < minTimeNs || samples.size() < m_config.minSamples)) {
+        double batchNs = timeBatch(batchSize);
+        totalNs += batchNs;
+        samples.push_back(batchNs / static_cast<double>(batchSize));
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    BenchmarkResult result;
+    result.name = name;
+    result.samples = samples.size();
+    result.batchSize = batchSize;
+    result.iterations = samples.size() * batchSize;
+    result.medianNs = percentile(samples, 0.5);
+    result.p95Ns = percentile(samples, 0.95);
+    result.p99Ns = percentile(samples, 0.99);
+    result.minNs = samples.front();
+    result.maxNs = samples.back();
+
+    double sum = 0.0;
+    for (double s : samples) sum += s;
+    result.meanNs = sum / static_cast<double>(samples.size());
+
+    double variance = 0.0;
+    for (double s : samples) {
+        variance += (s - result.meanNs) * (s - result.meanNs);
+    }
+    result.stddevNs = samples.size() > 1
+        ? std::sqrt(variance / static_cast<double>(samples.size() - 1))
+        : 0.0;
+
+    return result;
+}
+
+void BenchmarkHarness::printResults() const {
+    std::cout << "\n" << std::string(118, '=') << "\n";
+    std::cout << "BENCHMARK RESULTS\n";
+    std::cout << std::string(118, '=') << "\n\n";
+
+    std::cout << std::left << std::setw(46) << "Benchmark"
+              << std::right << std::setw(12) << "Median"
+              << std::right << std::setw(12) << "p95"
+              << std::right << std::setw(12) << "p99"
+              << std::right << std::setw(12) << "StdDev"
+              << std::right << std::setw(10) << "MB/s"
+              << std::right << std::setw(14) << "Mitems/s"
+              << "\n";
+    std::cout << std::string(118, '-') << "\n";
+
+    for (const auto& r : m_results) {
+        std::cout << std::left << std::setw(46) << r.name
+                  << std::right << std::setw(12) << formatDuration(r.medianNs)
+                  << std::right << std::setw(12) << formatDuration(r.p95Ns)
+                  << std::right << std::setw(12) << formatDuration(r.p99Ns)
+                  << std::right << std::setw(12) << formatDuration(r.stddevNs);
+
+        std::cout << std::fixed << std::setprecision(2);
+        if (r.bytesPerSecond > 0) {
+            std::cout << std::right << std::setw(10) << r.bytesPerSecond / (1024.0 * 1024.0);
+        } else {
+            std::cout << std::right << std::setw(10) << "-";
+        }
+        if (r.itemsPerSecond > 0) {
+            std::cout << std::right << std::setw(14) << r.itemsPerSecond / 1e6;
+        } else {
+            std::cout << std::right << std::setw(14) << "-";
+        }
+        std::cout << "\n";
+    }
+
+    std::cout << std::string(118, '=') << "\n\n";
+}
+
+bool BenchmarkHarness::writeJson(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    json::CPUInfo cpu = json::SystemInfo::getCPUInfo();
+
+    char date[32] = {0};
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    {
+        json::JsonWriter writer(file);
+        writer.beginObject();
+
+        writer.key("context").beginObject()
+              .key("date").value(date)
+              .key("cpu").value(cpu.name)
+              .key("logicalCores").value(cpu.logicalCores)
+              .key("pinnedCpu").value(m_pinned ? m_config.pinCpu : -1)
+              .key("buildType").value(JSONPARSER_BUILD_TYPE)
+#ifdef NDEBUG
+              .key("assertions").value(false)
+#else
+              .key("assertions").value(true)
+#endif
+              .key("minTimeMs").value(m_config.minTimeMs)
+              .endObject();
+
+        writer.key("benchmarks").beginArray();
+        for (const auto& r : m_results) {
+            writer.beginObject()
+                  .key("name").value(r.name)
+                  .key("samples").value(r.samples)
+                  .key("batchSize").value(r.batchSize)
+                  .key("iterations").value(r.iterations)
+                  .key("medianNs").value(r.medianNs)
+                  .key("p95Ns").value(r.p95Ns)
+                  .key("p99Ns").value(r.p99Ns)
+                  .key("minNs").value(r.minNs)
+                  .key("maxNs").value(r.maxNs)
+                  .key("meanNs").value(r.meanNs)
+                  .key("stddevNs").value(r.stddevNs)
+                  .key("bytesPerIteration").value(r.bytesPerIteration)
+                  .key("itemsPerIteration").value(r.itemsPerIteration)
+                  .key("bytesPerSecond").value(r.bytesPerSecond)
+                  .key("itemsPerSecond").value(r.itemsPerSecond)
+                  .endObject();
+        }
+        writer.endArray();
+
+        writer.endObject();
+    }
+
+    file << "\n";
+    return file.good();
+}
+
+std::vector<BenchmarkResult> BenchmarkHarness::loadResults(const std::string& filename) {
+    json::JsonValue doc = json::Parser::parseFile(filename);
+    if (!doc.isObject() || !doc.contains("benchmarks") || !doc.at("benchmarks").isArray()) {
+        throw json::JsonException("Файл " + filename + " не содержит результатов бенчмарков");
+    }
+
+    auto number = [](const json::JsonValue& obj, const std::string& key) {
+        return obj.contains(key) && obj.at(key).isNumber() ? obj.at(key).asNumber() : 0.0;
+    };
+
+    std::vector<BenchmarkResult> results;
+    for (const auto& item : doc.at("benchmarks").asArray()) {
+        if (!item.isObject() || !item.contains("name")) {
+            continue;
+        }
+        BenchmarkResult r;
+        r.name = item.at("name").asString();
+        r.samples = static_cast<size_t>(number(item, "samples"));
+        r.batchSize = static_cast<size_t>(number(item, "batchSize"));
+        r.iterations = static_cast<size_t>(number(item, "iterations"));
+        r.medianNs = number(item, "medianNs");
+        r.p95Ns = number(item, "p95Ns");
+        r.p99Ns = number(item, "p99Ns");
+        r.minNs = number(item, "minNs");
+        r.maxNs = number(item, "maxNs");
+        r.meanNs = number(item, "meanNs");
+        r.stddevNs = number(item, "stddevNs");
+        r.bytesPerIteration = static_cast<size_t>(number(item, "bytesPerIteration"));
+        r.itemsPerIteration = static_cast<size_t>(number(item, "itemsPerIteration"));
+        r.bytesPerSecond = number(item, "bytesPerSecond");
+        r.itemsPerSecond = number(item, "itemsPerSecond");
+        results.push_back(std::move(r));
+    }
+    return results;
+}
+
+std::vector<ComparisonEntry> BenchmarkHarness::compare(const std::vector<BenchmarkResult>& baseline,
+                                                       const std::vector<BenchmarkResult>& current,
+                                                       double thresholdPercent) {
+    std::map<std::string, const BenchmarkResult*> byName;
+    for (const auto& r : baseline) {
+        byName[r.name] = &r;
+    }
+
+    std::vector<ComparisonEntry> entries;
+    for (const auto& r : current) {
+        auto it = byName.find(r.name);
+        if (it == byName.end() || it->second->medianNs <= 0) {
+            continue;
+        }
+
+        ComparisonEntry entry;
+        entry.name = r.name;
+        entry.baselineNs = it->second->medianNs;
+        entry.currentNs = r.medianNs;
+        entry.changePercent = (entry.currentNs - entry.baselineNs) / entry.baselineNs * 100.0;
+        entry.regression = entry.changePercent > thresholdPercent;
+        entry.improvement = entry.changePercent < -thresholdPercent;
+        entries.push_back(entry);
+    }
+    return entries;
+}
+
+void BenchmarkHarness::printComparison(const std::vector<ComparisonEntry>& entries, double thresholdPercent) {
+    std::cout << "\n" << std::string(100, '=') << "\n";
+    std::cout << "COMPARISON (threshold " << std::fixed << std::setprecision(1)
+              << thresholdPercent << "%)\n";
+    std::cout << std::string(100, '=') << "\n\n";
+
+    std::cout << std::left << std::setw(46) << "Benchmark"
+              << std::right << std::setw(14) << "Baseline"
+              << std::right << std::setw(14) << "Current"
+              << std::right << std::setw(12) << "Change"
+              << "  Status\n";
+    std::cout << std::string(100, '-') << "\n";
+
+    size_t regressions = 0;
+    for (const auto& e : entries) {
+        std::ostringstream change;
+        change << std::showpos << std::fixed << std::setprecision(1) << e.changePercent << "%";
+
+        std::cout << std::left << std::setw(46) << e.name
+                  << std::right << std::setw(14) << formatDuration(e.baselineNs)
+                  << std::right << std::setw(14) << formatDuration(e.currentNs)
+                  << std::right << std::setw(12) << change.str() << "  ";
+        if (e.regression) {
+            std::cout << "REGRESSION";
+            regressions++;
+        } else if (e.improvement) {
+            std::cout << "faster";
+        } else {
+            std::cout << "ok";
+        }
+        std::cout << "\n";
+    }
+
+    std::cout << std::string(100, '=') << "\n";
+    std::cout << "Regressions: " << regressions << " of " << entries.size() << "\n\n";
+}
+
+} // namespace bench
@@ -0,0 +1,125 @@
+#ifndef BENCHMARK_HARNESS_HPP
+#define BENCHMARK_HARNESS_HPP
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+namespace bench {
+
+// Не даёт компилятору выбросить вычисление результата
+template<typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    const volatile char* sink = reinterpret_cast<const volatile char*>(&value);
+    (void)*sink;
+#endif
+}
+
+// Параметры запуска
+struct BenchmarkConfig {
+    double minTimeMs;           // Минимальное время измерений одного бенчмарка
+    double warmupMs;            // Время прогрева перед измерениями
+    size_t minSamples;          // Минимальное количество замеров
+    size_t maxSamples;          // Максимальное количество замеров
+    size_t targetSamples;       // Желаемое количество замеров (для калибровки пачки)
+    int pinCpu;                 // Номер ядра для привязки (-1 - без привязки)
+    std::string filter;         // Подстрока в имени бенчмарка (пусто - все)
+
+    BenchmarkConfig()
+        : minTimeMs(500.0), warmupMs(100.0), minSamples(5), maxSamples(10000),
+          targetSamples(100), pinCpu(-1) {}
+};
+
+// Результат одного бенчмарка. Времена - на одну итерацию, в наносекундах.
+struct BenchmarkResult {
+    std::string name;
+    size_t samples = 0;             // Количество замеров
+    size_t batchSize = 0;           // Итераций в одном замере (после калибровки)
+    size_t iterations = 0;          // Всего итераций
+
+    double medianNs = 0.0;
+    double p95Ns = 0.0;
+    double p99Ns = 0.0;
+    double minNs = 0.0;
+    double maxNs = 0.0;
+    double meanNs = 0.0;
+    double stddevNs = 0.0;
+
+    size_t bytesPerIteration = 0;   // Объём данных за итерацию (0 - не задан)
+    size_t itemsPerIteration = 0;   // Количество элементов за итерацию (0 - не задано)
+    double bytesPerSecond = 0.0;    // По медиане
+    double itemsPerSecond = 0.0;    // По медиане
+};
+
+// Строка сравнения двух прогонов
+struct ComparisonEntry {
+    std::string name;
+    double baselineNs = 0.0;
+    double currentNs = 0.0;
+    double changePercent = 0.0;     // > 0 - медленнее
+    bool regression = false;
+    bool improvement = false;
+};
+
+class BenchmarkHarness {
+private:
+    BenchmarkConfig m_config;
+    std::vector<BenchmarkResult> m_results;
+    bool m_pinned;
+
+    BenchmarkResult measure(const std::string& name, const std::function<void()>& func);
+
+public:
+    explicit BenchmarkHarness(const BenchmarkConfig& config = BenchmarkConfig());
+    ~BenchmarkHarness();
+
+    BenchmarkHarness(const BenchmarkHarness&) = delete;
+    BenchmarkHarness& operator=(const BenchmarkHarness&) = delete;
+
+    // Проходит ли имя через фильтр
+    bool matches(const std::string& name) const;
+
+    // Запуск бенчмарка: прогрев, калибровка размера пачки, сбор замеров.
+    // multiThreaded снимает привязку к ядру на время запуска, иначе
+    // рабочие потоки унаследуют маску и окажутся на одном ядре.
+    void run(const std::string& name,
+             const std::function<void()>& func,
+             size_t bytesPerIteration = 0,
+             size_t itemsPerIteration = 0,
+             bool multiThreaded = false);
+
+    const std::vector<BenchmarkResult>& results() const { return m_results; }
+    const BenchmarkConfig& config() const { return m_config; }
+    bool isPinned() const { return m_pinned; }
+
+    // Таблица результатов
+    void printResults() const;
+
+    // Результаты в JSON (формат читает loadResults)
+    bool writeJson(const std::string& filename) const;
+
+    static std::vector<BenchmarkResult> loadResults(const std::string& filename);
+
+    // Сравнение по медиане; изменение больше thresholdPercent считается регрессией
+    static std::vector<ComparisonEntry> compare(const std::vector<BenchmarkResult>& baseline,
+                                                const std::vector<BenchmarkResult>& current,
+                                                double thresholdPercent);
+
+    static void printComparison(const std::vector<ComparisonEntry>& entries, double thresholdPercent);
+};
+
+// Привязка текущего потока к ядру и её снятие (поддерживается на Linux и Windows)
+bool pinCurrentThread(int cpu);
+void unpinCurrentThread();
+
+// Форматирование времени (нс -> "12.3 us")
+std::string formatDuration(double ns);
+
+} // namespace bench
+
+#endif // BENCHMARK_HARNESS_HPP
@@ -0,0 +1,137 @@
+#include "BenchmarkHarness.hpp"
+#include "Trace.hpp"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <exception>
+
+// Объявления функций бенчмарков. Профилирование памяти - отдельный
+// бинарник jsonparser_memory_benchmarks: замена operator new/delete со
+// счётчиками не должна попадать в замеры времени.
+void runParserBenchmarks(bench::BenchmarkHarness& runner);
+
+static void printUsage(const char* program) {
+    std::cout << "Usage:\n"
+              << "  " << program << " [options]\n"
+              << "  " << program << " --compare <baseline.json> <current.json> [--threshold <percent>]\n\n"
+              << "Options:\n"
+              << "  --filter <text>      Run only benchmarks whose name contains <text>\n"
+              << "  --json <file>        Write results as JSON\n"
+              << "  --min-time <ms>      Minimum measuring time per benchmark (default 500)\n"
+              << "  --warmup <ms>        Warmup time per benchmark (default 100)\n"
+              << "  --cpu <n>            Pin the benchmark thread to CPU n\n"
+              << "  --trace <file>       Write a Chrome trace (needs -DENABLE_PROFILING=ON)\n"
+              << "  --threshold <pct>    Regression threshold for --compare (default 5)\n"
+              << "  --help               Show this help\n";
+}
+
+int main(int argc, char* argv[]) {
+    bench::BenchmarkConfig config;
+    std::string jsonOutput;
+    std::string traceOutput;
+    std::string baselineFile;
+    std::string currentFile;
+    double threshold = 5.0;
+    bool compareMode = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--filter" && hasValue) {
+            config.filter = argv[++i];
+        } else if (arg == "--json" && hasValue) {
+            jsonOutput = argv[++i];
+        } else if (arg == "--trace" && hasValue) {
+            traceOutput = argv[++i];
+        } else if (arg == "--min-time" && hasValue) {
+            config.minTimeMs = std::atof(argv[++i]);
+        } else if (arg == "--warmup" && hasValue) {
+            config.warmupMs = std::atof(argv[++i]);
+        } else if (arg == "--cpu" && hasValue) {
+            config.pinCpu = std::atoi(argv[++i]);
+        } else if (arg == "--threshold" && hasValue) {
+            threshold = std::atof(argv[++i]);
+        } else if (arg == "--compare" && i + 2 < argc) {
+            compareMode = true;
+            baselineFile = argv[++i];
+            currentFile = argv[++i];
+        } else {
+            std::cerr << "Unknown option: " << arg << "\n\n";
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    // Режим сравнения двух сохранённых прогонов
+    if (compareMode) {
+        try {
+            auto baseline = bench::BenchmarkHarness::loadResults(baselineFile);
+            auto current = bench::BenchmarkHarness::loadResults(currentFile);
+            auto entries = bench::BenchmarkHarness::compare(baseline, current, threshold);
+            bench::BenchmarkHarness::printComparison(entries, threshold);
+
+            for (const auto& e : entries) {
+                if (e.regression) return 1;
+            }
+            return 0;
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 2;
+        }
+    }
+
+    std::cout << "\n";
+    std::cout << "╔════════════════════════════════════════════════════════════════════╗\n";
+    std::cout << "║          JSON Parser - Complete Benchmark Suite                   ║\n";
+    std::cout << "╚════════════════════════════════════════════════════════════════════╝\n\n";
+
+#ifndef NDEBUG
+    std::cout << "[!] Built without NDEBUG: use -DCMAKE_BUILD_TYPE=Release for meaningful numbers\n";
+#endif
+
+    bench::BenchmarkHarness runner(config);
+    if (runner.isPinned()) {
+        std::cout << "Pinned to CPU " << config.pinCpu << "\n";
+    }
+
+    if (!traceOutput.empty()) {
+#ifdef ENABLE_PROFILING
+        json::trace::start();
+        JSON_TRACE_THREAD_NAME("benchmark");
+#else
+        std::cerr << "[!] --trace ignored: build with -DENABLE_PROFILING=ON\n";
+        traceOutput.clear();
+#endif
+    }
+
+    // Запуск бенчмарков производительности
+    runParserBenchmarks(runner);
+    runner.printResults();
+
+    if (!traceOutput.empty()) {
+        json::trace::stop();
+        if (json::trace::writeChromeTrace(traceOutput)) {
+            std::cout << "Trace written to " << traceOutput << " ("
+                      << json::trace::eventCount() << " events)\n";
+        } else {
+            std::cerr << "Error: cannot write " << traceOutput << "\n";
+        }
+    }
+
+    if (!jsonOutput.empty()) {
+        if (runner.writeJson(jsonOutput)) {
+            std::cout << "Results written to " << jsonOutput << "\n";
+        } else {
+            std::cerr << "Error: cannot write " << jsonOutput << "\n";
+            return 2;
+        }
+    }
+
+    std::cout << "\n✓ All benchmarks completed successfully!\n\n";
+
+    return 0;
+}
@@ -0,0 +1,382 @@
+#include "AllocationCounter.hpp"
+#include "Parser.hpp"
+#include "Lexer.hpp"
+#include "Serializer.hpp"
+#include "JsonValue.hpp"
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <iomanip>
+#include <cstdlib>
+#include <cstdio>
+#include <functional>
+#include <sstream>
+#include <vector>
+
+using namespace json;
+using bench::AllocationScope;
+using bench::StageAllocations;
+
+// Утилита для получения текущего использования памяти процесса (в KB).
+// RSS меняется страницами и не видит переиспользования памяти аллокатором,
+// поэтому основные цифры ниже берутся из счётчиков operator new/delete.
+#ifdef __APPLE__
+#include <mach/mach.h>
+
+size_t getCurrentMemoryUsage() {
+    struct mach_task_basic_info info;
+    mach_msg_type_number_t infoCount = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                  (task_info_t)&info, &infoCount) != KERN_SUCCESS) {
+        return 0;
+    }
+    return info.resident_size / 1024;  // Convert to KB
+}
+#elif __linux__
+#include <unistd.h>
+
+size_t getCurrentMemoryUsage() {
+    std::ifstream statm("/proc/self/statm");
+    long size, resident, share, text, lib, data, dt;
+    statm >> size >> resident >> share >> text >> lib >> data >> dt;
+    return (resident * sysconf(_SC_PAGESIZE)) / 1024;  // Convert to KB
+}
+#else
+size_t getCurrentMemoryUsage() {
+    return 0;  // Not implemented for this platform
+}
+#endif
+
+// Разность со знаком: память может и уменьшиться
+static std::string formatSignedKB(long long kb) {
+    return (kb > 0 ? "+" : "") + std::to_string(kb) + " KB";
+}
+
+static std::string formatBytes(double bytes) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    if (bytes < 1024.0) {
+        oss << bytes << " B";
+    } else if (bytes < 1024.0 * 1024.0) {
+        oss << bytes / 1024.0 << " KB";
+    } else {
+        oss << bytes / (1024.0 * 1024.0) << " MB";
+    }
+    return oss.str();
+}
+
+static std::string formatSignedBytes(long long bytes) {
+    std::string sign = bytes > 0 ? "+" : (bytes < 0 ? "-" : "");
+    return sign + formatBytes(static_cast<double>(bytes < 0 ? -bytes : bytes));
+}
+
+// Класс для профилирования памяти участка кода: точные аллокации и RSS
+class MemoryProfiler {
+private:
+    AllocationScope scope;
+    size_t startMemory;
+    std::string description;
+
+public:
+    MemoryProfiler(const std::string& desc) : description(desc) {
+        startMemory = getCurrentMemoryUsage();
+    }
+
+    ~MemoryProfiler() {
+        StageAllocations stats = scope.stop();
+        long long rssDiff = static_cast<long long>(getCurrentMemoryUsage()) -
+                            static_cast<long long>(startMemory);
+
+        std::cout << std::left << std::setw(50) << description
+                  << std::right << std::setw(10) << stats.allocations
+                  << std::right << std::setw(14) << formatBytes(static_cast<double>(stats.peakBytes))
+                  << std::right << std::setw(14) << formatSignedBytes(stats.netBytes)
+                  << std::right << std::setw(14) << formatSignedKB(rssDiff)
+                  << "\n";
+    }
+
+    void checkpoint(const std::string& checkpointName) {
+        StageAllocations stats = scope.stop();
+
+        std::cout << "  └─ " << std::left << std::setw(45) << checkpointName
+                  << std::right << std::setw(10) << stats.allocations
+                  << std::right << std::setw(14) << formatBytes(static_cast<double>(stats.peakBytes))
+                  << std::right << std::setw(14) << formatSignedBytes(stats.netBytes)
+                  << "\n";
+    }
+
+    static void printHeader() {
+        std::cout << std::left << std::setw(50) << "Operation"
+                  << std::right << std::setw(10) << "Allocs"
+                  << std::right << std::setw(14) << "Peak live"
+                  << std::right << std::setw(14) << "Net live"
+                  << std::right << std::setw(14) << "RSS"
+                  << "\n" << std::string(102, '-') << "\n";
+    }
+};
+
+// Генерация больших тестовых данных
+std::string generateLargeJSON(int numObjects) {
+    std::string json = "[";
+    for (int i = 0; i < numObjects; ++i) {
+        if (i > 0) json += ",";
+        json += R"({"id":)" + std::to_string(i) +
+                R"(,"name":"User )" + std::to_string(i) +
+                R"(","email":"user)" + std::to_string(i) + R"(@example.com",)" +
+                R"("age":)" + std::to_string(20 + (i % 50)) +
+                R"(,"active":)" + (i % 2 == 0 ? "true" : "false") +
+                R"(,"score":)" + std::to_string(i * 3.14) + "}";
+    }
+    json += "]";
+    return json;
+}
+
+// Аллокации одного этапа: всё, что создано внутри stage и не пережило его,
+// попадает в deallocations
+static StageAllocations measureStage(const std::function<void()>& stage) {
+    AllocationScope scope;
+    stage();
+    return scope.stop();
+}
+
+// Тест копирования vs перемещения
+void testCopyVsMove() {
+    std::cout << "\n[1] Copy vs Move Performance\n" << std::string(70, '-') << "\n";
+
+    const int numElements = 10000;
+    JsonArray arr;
+    for (int i = 0; i < numElements; ++i) {
+        arr.push_back(JsonValue(i));
+    }
+
+    // Тест копирования
+    {
+        AllocationScope scope;
+        auto start = std::chrono::steady_clock::now();
+
+        JsonValue copy = JsonValue(arr);  // Copy constructor
+
+        auto end = std::chrono::steady_clock::now();
+        StageAllocations stats = scope.stop();
+
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+        std::cout << "Copy: " << duration.count() << " μs, "
+                  << stats.allocations << " allocations, "
+                  << formatBytes(static_cast<double>(stats.bytesAllocated)) << "\n";
+    }
+
+    // Тест перемещения
+    {
+        JsonArray tempArr;
+        for (int i = 0; i < numElements; ++i) {
+            tempArr.push_back(JsonValue(i));
+        }
+
+        AllocationScope scope;
+        auto start = std::chrono::steady_clock::now();
+
+        JsonValue moved = JsonValue(std::move(tempArr));  // Move constructor
+
+        auto end = std::chrono::steady_clock::now();
+        StageAllocations stats = scope.stop();
+
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+        std::cout << "Move: " << duration.count() << " μs, "
+                  << stats.allocations << " allocations, "
+                  << formatBytes(static_cast<double>(stats.bytesAllocated)) << "\n";
+    }
+}
+
+// Аллокации по этапам обработки документа
+void analyzeParsingStages() {
+    std::cout << "\n[2] Allocations per Processing Stage\n" << std::string(70, '-') << "\n";
+
+    const std::string tempFile = "benchmark_memory_temp.json";
+
+    for (int size : {100, 1000, 10000, 50000}) {
+        std::string json = generateLargeJSON(size);
+        double inputMB = static_cast<double>(json.size()) / (1024.0 * 1024.0);
+
+        {
+            std::ofstream file(tempFile, std::ios::binary);
+            file << json;
+        }
+
+        std::vector<Token> tokens;
+        JsonValue doc;
+        JsonValue parallelDoc;
+
+        std::vector<std::pair<std::string, StageAllocations>> stages;
+        stages.emplace_back("tokenize", measureStage([&]() {
+            Lexer lexer(json);
+            tokens = lexer.tokenize();
+        }));
+        stages.emplace_back("parse (from tokens)", measureStage([&]() {
+            Parser parser(std::move(tokens));
+            doc = parser.parse();
+        }));
+        stages.emplace_back("parallel parse (read+merge, 4 thr)", measureStage([&]() {
+            parallelDoc = Parser::parseFileParallel(tempFile, 4);
+        }));
+        stages.emplace_back("serialize (compact)", measureStage([&]() {
+            std::string out = Serializer::toString(doc, false);
+        }));
+        stages.emplace_back("destroy", measureStage([&]() {
+            doc = JsonValue();
+            parallelDoc = JsonValue();
+        }));
+
+        std::cout << "\nInput: " << size << " objects, " << formatBytes(static_cast<double>(json.size())) << "\n";
+        std::cout << std::left << std::setw(38) << "Stage"
+                  << std::right << std::setw(10) << "Allocs"
+                  << std::right << std::setw(10) << "Frees"
+                  << std::right << std::setw(13) << "Allocated"
+                  << std::right << std::setw(13) << "Peak live"
+                  << std::right << std::setw(13) << "Net live"
+                  << std::right << std::setw(14) << "Alloc/MB in"
+                  << "\n" << std::string(111, '-') << "\n";
+
+        for (const auto& [name, s] : stages) {
+            std::cout << std::left << std::setw(38) << name
+                      << std::right << std::setw(10) << s.allocations
+                      << std::right << std::setw(10) << s.deallocations
+                      << std::right << std::setw(13) << formatBytes(static_cast<double>(s.bytesAllocated))
+                      << std::right << std::setw(13) << formatBytes(static_cast<double>(s.peakBytes))
+                      << std::right << std::setw(13) << formatSignedBytes(s.netBytes)
+                      << std::right << std::setw(14)
+                      << formatBytes(static_cast<double>(s.bytesAllocated) / inputMB)
+                      << "\n";
+        }
+    }
+
+    std::remove(tempFile.c_str());
+}
+
+// Профилирование постепенного построения объектов
+void profileIncrementalBuilding() {
+    std::cout << "\n[3] Incremental Object Building\n" << std::string(70, '-') << "\n";
+    MemoryProfiler::printHeader();
+
+    const int numElements = 10000;
+
+    {
+        MemoryProfiler profiler("Building array incrementally (" + std::to_string(numElements) + " elements)");
+
+        JsonArray arr;
+        for (int i = 0; i < numElements; ++i) {
+            arr.push_back(JsonValue(i));
+
+            if (i == 1000 || i == 5000 || i == 9999) {
+                profiler.checkpoint("After " + std::to_string(i + 1) + " elements");
+            }
+        }
+    }
+}
+
+// Анализ утечек памяти при множественных операциях
+void detectMemoryLeaks() {
+    std::cout << "\n[5] Memory Leak Detection\n" << std::string(70, '-') << "\n";
+
+    bench::AllocationStats initial = bench::AllocationCounter::snapshot();
+    size_t initialRss = getCurrentMemoryUsage();
+    std::cout << "Initial live heap: " << formatBytes(static_cast<double>(initial.liveBytes))
+              << " (RSS " << initialRss << " KB)\n\n";
+
+    // Многократное создание и уничтожение объектов
+    const int iterations = 100;
+    for (int i = 0; i < iterations; ++i) {
+        std::string json = generateLargeJSON(100);
+        JsonValue value = Parser::parseString(json);
+        // value уничтожается в конце каждой итерации
+    }
+
+    bench::AllocationStats after = bench::AllocationCounter::snapshot();
+    long long liveDiff = static_cast<long long>(after.liveBytes) - static_cast<long long>(initial.liveBytes);
+    long long rssDiff = static_cast<long long>(getCurrentMemoryUsage()) - static_cast<long long>(initialRss);
+
+    std::cout << "After " << iterations << " iterations: "
+              << (after.allocations - initial.allocations) << " allocations, "
+              << (after.deallocations - initial.deallocations) << " frees\n";
+    std::cout << "Live heap difference: " << formatSignedBytes(liveDiff)
+              << " (RSS " << formatSignedKB(rssDiff) << ") ";
+
+    if (liveDiff > 0) {
+        std::cout << "(⚠ Possible memory leak detected!)\n";
+    } else {
+        std::cout << "(✓ No leak)\n";
+    }
+}
+
+// Сравнение размеров различных структур JSON
+void compareStructureSizes() {
+    std::cout << "\n[4] Memory Footprint of Different Structures\n" << std::string(70, '-') << "\n";
+
+    const int count = 1000;
+
+    auto report = [count](const std::string& name, const StageAllocations& s) {
+        std::cout << std::left << std::setw(40) << name
+                  << std::right << std::setw(10) << s.allocations << " allocs"
+                  << std::right << std::setw(14) << formatSignedBytes(s.netBytes) << " live"
+                  << std::right << std::setw(12)
+                  << formatBytes(static_cast<double>(s.netBytes) / count) << " / elem\n";
+    };
+
+    // Array of numbers
+    {
+        JsonValue value;
+        report("Array of " + std::to_string(count) + " numbers", measureStage([&]() {
+            JsonArray arr;
+            for (int i = 0; i < count; ++i) {
+                arr.push_back(JsonValue(i));
+            }
+            value = JsonValue(std::move(arr));
+        }));
+    }
+
+    // Array of strings
+    {
+        JsonValue value;
+        report("Array of " + std::to_string(count) + " strings", measureStage([&]() {
+            JsonArray arr;
+            for (int i = 0; i < count; ++i) {
+                arr.push_back(JsonValue("String number " + std::to_string(i)));
+            }
+            value = JsonValue(std::move(arr));
+        }));
+    }
+
+    // Array of objects
+    {
+        JsonValue value;
+        report("Array of " + std::to_string(count) + " objects", measureStage([&]() {
+            JsonArray arr;
+            for (int i = 0; i < count; ++i) {
+                JsonObject obj;
+                obj["id"] = JsonValue(i);
+                obj["name"] = JsonValue("Item " + std::to_string(i));
+                arr.push_back(JsonValue(std::move(obj)));
+            }
+            value = JsonValue(std::move(arr));
+        }));
+    }
+
+    std::cout << "sizeof(JsonValue) = " << sizeof(JsonValue) << " bytes\n";
+}
+
+int main() {
+    std::cout << "\n";
+    std::cout << "╔════════════════════════════════════════════════════════════════════╗\n";
+    std::cout << "║          JSON Parser Memory Profiling                             ║\n";
+    std::cout << "╚════════════════════════════════════════════════════════════════════╝\n";
+
+    testCopyVsMove();
+    analyzeParsingStages();
+    profileIncrementalBuilding();
+    compareStructureSizes();
+    detectMemoryLeaks();
+
+    std::cout << "\n✓ Memory profiling completed!\n\n";
+    return 0;
+}
@@ -0,0 +1,631 @@
+#include "BenchmarkHarness.hpp"
+#include "Parser.hpp"
+#include "Lexer.hpp"
+#include "Validator.hpp"
+#include "Serializer.hpp"
+#include "JsonWriter.hpp"
+#include "JsonPatch.hpp"
+#include "TreeVisitor.hpp"
+#include "TolerantParser.hpp"
+#include "BatchProcessor.hpp"
+#include "Cbor.hpp"
+#include "DocumentCache.hpp"
+#include "TypedJson.hpp"
+#include "Utf8.hpp"
+#include "Generator.hpp"
+#include "ParallelProcessor.hpp"
+#include "InputStream.hpp"
+#include "JsonSchema.hpp"
+#include "SchemaValidator.hpp"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+
+#ifdef JSON_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef JSON_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+using namespace json;
+using bench::BenchmarkHarness;
+using bench::doNotOptimize;
+namespace fs = std::filesystem;
+
+// Генерация тестовых данных
+std::string generateArray(int size) {
+    std::string json = "[";
+    for (int i = 0; i < size; ++i) {
+        if (i > 0) json += ",";
+        json += std::to_string(i);
+    }
+    json += "]";
+    return json;
+}
+
+std::string generateObject(int size) {
+    std::string json = "{";
+    for (int i = 0; i < size; ++i) {
+        if (i > 0) json += ",";
+        json += "\"key" + std::to_string(i) + "\":" + std::to_string(i);
+    }
+    json += "}";
+    return json;
+}
+
+std::string generateComplexObject(int size) {
+    std::string json = "{\"users\":[";
+    for (int i = 0; i < size; ++i) {
+        if (i > 0) json += ",";
+        json += R"({"id":)" + std::to_string(i) +
+                R"(,"name":"User)" + std::to_string(i) +
+                R"(","email":"user)" + std::to_string(i) + R"(@example.com"})";
+    }
+    json += "]}";
+    return json;
+}
+
+// Записи журнала с длинными сообщениями: основная доля входа - строки,
+// изредка с escape-последовательностями и кириллицей
+std::string generateLogRecords(int size) {
+    std::string json = "[";
+    for (int i = 0; i < size; ++i) {
+        if (i > 0) json += ",";
+        json += R"({"ts":"2024-03-15T12:34:56.)" + std::to_string(100 + i % 900) +
+                R"(Z","level":"INFO","logger":"com.example.service.RequestHandler",)"
+                R"("message":"Request processed successfully for user )" + std::to_string(i) +
+                R"( after validating the session token and loading the profile from cache",)"
+                R"("details":"path=\/api\/v2\/orders\tstatus=200\nПользователь: \u0418\u0432\u0430\u043d"})";
+    }
+    json += "]";
+    return json;
+}
+
+// Массив случайных документов от Generator с фиксированным seed:
+// разнородные данные, одинаковые между запусками
+std::string generateMixedCorpus(int elements, unsigned int seed = 42) {
+    Generator generator(seed);
+    GeneratorOptions opts;
+    opts.maxDepth = 4;
+    opts.compactOutput = true;
+    generator.setOptions(opts);
+
+    std::string json = "[";
+    for (int i = 0; i < elements; ++i) {
+        if (i > 0) json += ",";
+        generator.generateInto(json);
+    }
+    json += "]";
+    return json;
+}
+
+// То же по элементу на строку; errorProbability - процент испорченных
+// элементов (ошибки генератора)
+std::string generateLineCorpus(int elements, int errorProbability, unsigned int seed = 42) {
+    Generator generator(seed);
+    GeneratorOptions opts;
+    opts.maxDepth = 4;
+    opts.compactOutput = true;
+    opts.errorProbability = errorProbability;
+    generator.setOptions(opts);
+
+    std::string json = "[\n";
+    for (int i = 0; i < elements; ++i) {
+        if (i > 0) json += ",\n";
+        generator.generateInto(json);
+    }
+    json += "\n]";
+    return json;
+}
+
+// Запись пользователя для типизированного разбора
+struct UserRecord {
+    int id = 0;
+    std::string name;
+    std::string email;
+};
+JSON_FIELDS(UserRecord, id, name, email)
+
+struct UserList {
+    std::vector<UserRecord> users;
+};
+JSON_FIELDS(UserList, users)
+
+static size_t countTokens(const std::string& json) {
+    Lexer lexer(json);
+    return lexer.tokenize().size();
+}
+
+void runParserBenchmarks(BenchmarkHarness& runner) {
+    std::cout << "\n";
+    std::cout << "╔════════════════════════════════════════════════════════════════════╗\n";
+    std::cout << "║          JSON Parser Performance Benchmarks                        ║\n";
+    std::cout << "╚════════════════════════════════════════════════════════════════════╝\n\n";
+
+    std::string smallArray = generateArray(100);
+    std::string mediumArray = generateArray(1000);
+    std::string largeArray = generateArray(10000);
+    std::string wideObject = generateObject(1000);
+    std::string complexObj = generateComplexObject(1000);
+    std::string mixed = generateMixedCorpus(500);
+    std::string logs = generateLogRecords(2000);
+
+    // === Бенчмарки Lexer ===
+    std::cout << "\n[1] Lexer Benchmarks\n" << std::string(50, '-') << "\n";
+
+    struct NamedInput {
+        const char* name;
+        const std::string* json;
+    };
+    const NamedInput lexerInputs[] = {
+        {"Lexer: Small Array (100 elements)", &smallArray},
+        {"Lexer: Medium Array (1000 elements)", &mediumArray},
+        {"Lexer: Large Array (10000 elements)", &largeArray},
+        {"Lexer: Complex Objects (1000)", &complexObj},
+        {"Lexer: Mixed Corpus (500 documents)", &mixed},
+        {"Lexer: Log Records (2000, string-heavy)", &logs},
+    };
+    for (const auto& input : lexerInputs) {
+        const std::string& json = *input.json;
+        runner.run(input.name, [&json]() {
+            Lexer lexer(json);
+            auto tokens = lexer.tokenize();
+            doNotOptimize(tokens);
+        }, json.size(), countTokens(json));
+    }
+
+    // Проверка UTF-8, выполняемая лексером перед разбором
+    std::cout << "  UTF-8 SIMD: " << (utf8::hasSimd() ? "AVX2" : "unavailable") << "\n";
+    runner.run("UTF-8: Mixed Corpus (vector)", [&mixed]() {
+        size_t offset = utf8::findInvalid(mixed);
+        doNotOptimize(offset);
+    }, mixed.size(), 0);
+
+    runner.run("UTF-8: Mixed Corpus (scalar)", [&mixed]() {
+        size_t offset = utf8::findInvalidScalar(mixed.data(), mixed.size());
+        doNotOptimize(offset);
+    }, mixed.size(), 0);
+
+    // === Бенчмарки Parser ===
+    std::cout << "\n[2] Parser Benchmarks\n" << std::string(50, '-') << "\n";
+
+    const NamedInput parserInputs[] = {
+        {"Parser: Small Array (100)", &smallArray},
+        {"Parser: Medium Array (1000)", &mediumArray},
+        {"Parser: Large Array (10000)", &largeArray},
+        {"Parser: Wide Object (1000 keys)", &wideObject},
+        {"Parser: Complex Objects (1000)", &complexObj},
+        {"Parser: Mixed Corpus (500 documents)", &mixed},
+        {"Parser: Log Records (2000, string-heavy)", &logs},
+    };
+    for (const auto& input : parserInputs) {
+        const std::string& json = *input.json;
+        runner.run(input.name, [&json]() {
+            JsonValue value = Parser::parseString(json);
+            doNotOptimize(value);
+        }, json.size(), countTokens(json));
+    }
+
+    // Отложенное преобразование чисел
+    for (const auto* input : {&largeArray, &mixed}) {
+        const std::string& json = *input;
+        std::string name = input == &largeArray ? "Parser (lazy numbers): Large Array (10000)"
+                                                : "Parser (lazy numbers): Mixed Corpus (500 documents)";
+        runner.run(name, [&json]() {
+            JsonValue value = Parser::parseString(json, NumberMode::Lazy);
+            doNotOptimize(value);
+        }, json.size(), countTokens(json));
+    }
+
+    // Типизированный разбор против дерева с ручным извлечением полей
+    runner.run("Parse + extract: Complex Objects (1000)", [&complexObj]() {
+        JsonValue value = Parser::parseString(complexObj);
+        std::vector<UserRecord> users;
+        for (const auto& item : value.at("users").asArray()) {
+            UserRecord user;
+            user.id = static_cast<int>(item.at("id").asNumber());
+            user.name = item.at("name").asString();
+            user.email = item.at("email").asString();
+            users.push_back(std::move(user));
+        }
+        doNotOptimize(users);
+    }, complexObj.size(), 1000);
+
+    runner.run("Typed read: Complex Objects (1000)", [&complexObj]() {
+        UserList list = json::read<UserList>(complexObj);
+        doNotOptimize(list);
+    }, complexObj.size(), 1000);
+
+    // === Бенчмарки Validator ===
+    std::cout << "\n[3] Validator Benchmarks\n" << std::string(50, '-') << "\n";
+
+    Validator validator;
+    const NamedInput validatorInputs[] = {
+        {"Validator: Small Array (100)", &smallArray},
+        {"Validator: Medium Array (1000)", &mediumArray},
+        {"Validator: Large Array (10000)", &largeArray},
+        {"Validator: Mixed Corpus (500 documents)", &mixed},
+    };
+    for (const auto& input : validatorInputs) {
+        const std::string& json = *input.json;
+        runner.run(input.name, [&json, &validator]() {
+            auto result = validator.validate(json);
+            doNotOptimize(result);
+        }, json.size(), countTokens(json));
+    }
+
+    // === Бенчмарки Serializer ===
+    std::cout << "\n[4] Serializer Benchmarks\n" << std::string(50, '-') << "\n";
+
+    JsonValue complexDoc = Parser::parseString(complexObj);
+    JsonValue mixedDoc = Parser::parseString(mixed);
+    size_t complexOut = Serializer::toString(complexDoc, false).size();
+    size_t mixedOut = Serializer::toString(mixedDoc, false).size();
+    size_t mixedPrettyOut = Serializer::toString(mixedDoc, true).size();
+
+    runner.run("Serializer: Complex Objects (compact)", [&complexDoc]() {
+        std::string out = Serializer::toString(complexDoc, false);
+        doNotOptimize(out);
+    }, complexOut, 1000);
+
+    runner.run("Serializer: Mixed Corpus (compact)", [&mixedDoc]() {
+        std::string out = Serializer::toString(mixedDoc, false);
+        doNotOptimize(out);
+    }, mixedOut, 500);
+
+    runner.run("Serializer: Mixed Corpus (pretty)", [&mixedDoc]() {
+        std::string out = Serializer::toString(mixedDoc, true);
+        doNotOptimize(out);
+    }, mixedPrettyOut, 500);
+
+    runner.run("JsonWriter: Mixed Corpus (compact)", [&mixedDoc]() {
+        std::string out;
+        JsonWriter writer(out, JsonWriter::Options::compact());
+        writer.value(mixedDoc);
+        doNotOptimize(out);
+    }, mixedOut, 500);
+
+    // Двоичный формат: запись и повторная загрузка против текста
+    std::string mixedCbor = CborWriter::toBytes(mixedDoc);
+    std::cout << "  CBOR size: " << mixedCbor.size() << " bytes vs "
+              << mixedOut << " bytes of compact JSON\n";
+
+    runner.run("CborWriter: Mixed Corpus", [&mixedDoc]() {
+        std::string out = CborWriter::toBytes(mixedDoc);
+        doNotOptimize(out);
+    }, mixedCbor.size(), 500);
+
+    runner.run("CborReader: Mixed Corpus", [&mixedCbor]() {
+        JsonValue value = CborReader::parseBytes(mixedCbor);
+        doNotOptimize(value);
+    }, mixedCbor.size(), 500);
+
+    // Снимок документа и правка одного элемента: копируется только путь
+    runner.run("JsonValue: Snapshot + Edit (Mixed Corpus)", [&mixedDoc]() {
+        JsonValue snapshot = mixedDoc;
+        snapshot[250] = JsonValue(nullptr);
+        doNotOptimize(snapshot);
+    }, 0, 1);
+
+    // === Параллельный парсинг и валидация ===
+    std::cout << "\n[5] Single-threaded vs Multi-threaded\n" << std::string(50, '-') << "\n";
+
+    // Создаем временный файл для тестирования
+    std::string testDir = "benchmark_temp";
+    fs::create_directory(testDir);
+
+    std::string bigArray = generateComplexObject(50000);
+    std::string filepath = testDir + "/big_test.json";
+    {
+        std::ofstream file(filepath, std::ios::binary);
+        file << bigArray;
+    }
+    size_t fileSize = bigArray.size();
+    bigArray.clear();
+    bigArray.shrink_to_fit();
+
+    runner.run("Single-threaded Parse (50k objects)", [&filepath]() {
+        JsonValue value = Parser::parseFile(filepath);
+        doNotOptimize(value);
+    }, fileSize, 50000);
+
+    // Чтение блоками в отдельном потоке вместе с токенизацией
+    runner.run("Pipelined Read + Parse (50k objects)", [&filepath]() {
+        JsonValue value = Parser::parseFileWithProgress(filepath);
+        doNotOptimize(value);
+    }, fileSize, 50000, true);
+
+#ifdef JSON_HAVE_ZLIB
+    // Тот же файл в gzip: распаковка в потоке чтения
+    std::string gzipPath = filepath + ".gz";
+    {
+        std::string content = readFileContent(filepath);
+        gzFile gz = gzopen(gzipPath.c_str(), "wb");
+        gzwrite(gz, content.data(), static_cast<unsigned int>(content.size()));
+        gzclose(gz);
+    }
+    runner.run("Pipelined Gzip Read + Parse (50k objects)", [&gzipPath]() {
+        JsonValue value = Parser::parseFileWithProgress(gzipPath);
+        doNotOptimize(value);
+    }, fileSize, 50000, true);
+#endif
+
+#ifdef JSON_HAVE_ZSTD
+    // zstd кадрами по 1 МБ (как zstd -T): кадры распаковываются параллельно
+    std::string zstdPath = filepath + ".zst";
+    {
+        std::string content = readFileContent(filepath);
+        std::ofstream file(zstdPath, std::ios::binary);
+        const size_t frameSize = 1024 * 1024;
+        std::string frame(ZSTD_compressBound(frameSize), '\0');
+        for (size_t pos = 0; pos < content.size(); pos += frameSize) {
+            size_t size = std::min(frameSize, content.size() - pos);
+            size_t written = ZSTD_compress(&frame[0], frame.size(), content.data() + pos, size, 3);
+            file.write(frame.data(), static_cast<std::streamsize>(written));
+        }
+    }
+    for (unsigned int threads : {1u, 4u}) {
+        runner.run("Zstd Read (1 MB frames, " + std::to_string(threads) + " threads)", [&zstdPath, threads]() {
+            std::string content = InputStream::open(zstdPath, threads)->readAll();
+            doNotOptimize(content);
+        }, fileSize, 0, true);
+    }
+    runner.run("Pipelined Zstd Read + Parse (50k objects)", [&zstdPath]() {
+        JsonValue value = Parser::parseFileWithProgress(zstdPath);
+        doNotOptimize(value);
+    }, fileSize, 50000, true);
+#endif
+
+    for (unsigned int threads : {1u, 2u, 4u}) {
+        runner.run("Multi-threaded Parse (50k, " + std::to_string(threads) + " threads)",
+            [&filepath, threads]() {
+                JsonValue value = Parser::parseFileParallel(filepath, threads);
+                doNotOptimize(value);
+            }, fileSize, 50000, true);
+    }
+
+    runner.run("Multi-threaded Parse (50k, auto)", [&filepath]() {
+        JsonValue value = Parser::parseFileParallel(filepath, 0);
+        doNotOptimize(value);
+    }, fileSize, 50000, true);
+
+    // Повторная загрузка из кэша разобранного документа
+    DocumentCache cache(testDir + "/cache");
+    cache.store(filepath, Parser::parseFile(filepath));
+
+    runner.run("DocumentCache: Open (50k objects)", [&cache, &filepath]() {
+        auto doc = cache.open(filepath);
+        doNotOptimize(doc);
+    }, fileSize, 50000);
+
+    // Так загружает CLI: отображение и обход для глубины без построения
+    // JsonValue (дерево строится только перед первой правкой)
+    runner.run("DocumentCache: Open + Stats (50k objects)", [&cache, &filepath]() {
+        auto doc = cache.open(filepath);
+        TreeStats stats = TreeStats::collect(doc->root());
+        doNotOptimize(stats);
+    }, fileSize, 50000);
+
+    runner.run("DocumentCache: Open + findByPath (50k objects)", [&cache, &filepath]() {
+        auto doc = cache.open(filepath);
+        auto found = doc->root().findByPath("users[25000].name");
+        doNotOptimize(found);
+    }, fileSize, 50000);
+
+    // Сохранение после одной правки: целиком и с копированием неизменённых
+    // элементов из исходного файла
+    {
+        std::string savePath = testDir + "/saved.json";
+        fs::copy_file(filepath, savePath, fs::copy_options::overwrite_existing);
+        SourceFile source = SourceFile::capture(savePath);
+        Lexer lexer(readFileContent(savePath));
+        Parser parser(lexer.tokenize());
+        parser.setSourceSpans(source.id);
+        JsonValue doc = parser.parse();
+        Serializer compact(Serializer::Options::compact());
+
+        int edit = 0;
+        runner.run("Serializer: Full Save (50k objects, 1 edit)", [&]() {
+            doc["users"][edit++ % 50000]["id"] = -1;
+            bool ok = compact.saveToFile(doc, savePath);
+            doNotOptimize(ok);
+        }, fileSize, 50000);
+
+        source = SourceFile::capture(savePath);
+        runner.run("Serializer: Incremental Save (50k objects, 1 edit)", [&]() {
+            doc["users"][edit++ % 50000]["id"] = -1;
+            bool ok = compact.saveIncremental(doc, source, savePath);
+            doNotOptimize(ok);
+        }, fileSize, 50000);
+    }
+
+    // Разница двух независимо разобранных документов после одной правки:
+    // хэши посчитаны заранее, после правки пересчитывается только путь
+    {
+        JsonValue base = Parser::parseFile(filepath);
+        JsonValue edited = Parser::parseFile(filepath);
+        base.computeHashes();
+        edited.computeHashes();
+
+        // Правка откатывается в конце итерации (id совпадает с индексом)
+        int edit = 0;
+        runner.run("JsonPatch: Diff (50k objects, 1 edit)", [&]() {
+            int index = edit++ % 50000;
+            edited["users"][index]["id"] = -1;
+            JsonValue patch = JsonPatch::diff(base, edited);
+            doNotOptimize(patch);
+            edited["users"][index]["id"] = index;
+        }, fileSize, 50000);
+
+        // Снимок с правкой: общие поддеревья отсекаются без хэшей
+        runner.run("JsonPatch: Diff (50k objects, snapshot + 1 edit)", [&]() {
+            JsonValue snapshot = base;
+            snapshot["users"][edit++ % 50000]["id"] = -1;
+            JsonValue patch = JsonPatch::diff(base, snapshot);
+            doNotOptimize(patch);
+        }, fileSize, 50000);
+
+        for (unsigned int threads : {1u, 4u}) {
+            TreeVisitor visitor(threads);
+            runner.run("TreeVisitor: Stats (50k objects, " + std::to_string(threads) + " threads)",
+                [&base, &visitor]() {
+                    TreeStats stats = TreeStats::collect(base, visitor);
+                    doNotOptimize(stats);
+                }, fileSize, 50000, threads > 1);
+        }
+    }
+
+    runner.run("Single-threaded Validation", [&filepath, &validator]() {
+        auto result = validator.validateFile(filepath);
+        doNotOptimize(result);
+    }, fileSize, 50000);
+
+    for (unsigned int threads : {2u, 4u, 8u}) {
+        ParallelProcessor processor(threads);
+        runner.run("Parallel Validation (" + std::to_string(threads) + " threads)",
+            [&filepath, &processor]() {
+                auto result = processor.validateLargeFile(filepath);
+                doNotOptimize(result);
+            }, fileSize, 50000, true);
+    }
+
+    // Толерантная загрузка: чистый файл и файл с 10% испорченных элементов
+    {
+        std::string clean = generateLineCorpus(5000, 0);
+        std::string dirty = generateLineCorpus(5000, 10);
+
+        runner.run("Parser: Clean corpus (5k elements)", [&clean]() {
+            JsonValue value = Parser::parseString(clean);
+            doNotOptimize(value);
+        }, clean.size(), 5000);
+
+        for (unsigned int threads : {1u, 4u}) {
+            TolerantParser tolerant(threads);
+            std::string suffix = std::to_string(threads) + " threads)";
+            runner.run("TolerantParser: Clean (5k, " + suffix, [&clean, &tolerant]() {
+                TolerantResult result = tolerant.parse(clean);
+                doNotOptimize(result);
+            }, clean.size(), 5000, threads > 1);
+            runner.run("TolerantParser: 10% broken (5k, " + suffix, [&dirty, &tolerant]() {
+                TolerantResult result = tolerant.parse(dirty);
+                doNotOptimize(result);
+            }, dirty.size(), 5000, threads > 1);
+        }
+    }
+
+    // Проверка по JSON Schema: массив записей, последовательно и порциями
+    {
+        std::string users = generateComplexObject(50000);
+        users = users.substr(9, users.size() - 10);     // Массив без обёртки {"users": ...}
+        JsonSchema schema = JsonSchema::compile(Parser::parseString(R"({
+            "type": "array",
+            "items": {
+                "type": "object",
+                "required": ["id", "name", "email"],
+                "additionalProperties": false,
+                "properties": {
+                    "id": {"type": "integer", "minimum": 0},
+                    "name": {"type": "string", "minLength": 1, "maxLength": 64},
+                    "email": {"type": "string", "pattern": "^[^@]+@[^@]+$"}
+                }
+            }
+        })"));
+
+        runner.run("Validator: Syntax only (50k users)", [&users, &validator]() {
+            auto result = validator.validate(users);
+            doNotOptimize(result);
+        }, users.size(), 50000);
+
+        for (unsigned int threads : {1u, 4u}) {
+            SchemaValidator schemaValidator(schema, threads);
+            runner.run("SchemaValidator: 50k users (" + std::to_string(threads) + " threads)",
+                [&users, &schemaValidator]() {
+                    SchemaResult result = schemaValidator.validate(users);
+                    doNotOptimize(result);
+                }, users.size(), 50000, threads > 1);
+        }
+    }
+
+    // Пакет файлов: последовательная проверка против BatchProcessor
+    // (мелкие файлы - по задаче на файл, большой - порциями)
+    {
+        std::string batchDir = testDir + "/batch";
+        fs::create_directory(batchDir);
+        std::vector<std::string> files = {filepath};
+        size_t batchBytes = fileSize;
+        for (int i = 0; i < 32; ++i) {
+            std::string content = generateLineCorpus(500, 0, static_cast<unsigned int>(i + 1));
+            files.push_back(batchDir + "/part" + std::to_string(i) + ".json");
+            std::ofstream file(files.back(), std::ios::binary);
+            file << content;
+            batchBytes += content.size();
+        }
+
+        runner.run("Batch: Sequential Validation (33 files)", [&files, &validator]() {
+            for (const std::string& file : files) {
+                auto result = validator.validateFile(file);
+                doNotOptimize(result);
+            }
+        }, batchBytes, files.size());
+
+        for (unsigned int threads : {1u, 4u}) {
+            BatchOptions options;
+            options.threads = threads;
+            options.chunkThreshold = 1024 * 1024;
+            BatchProcessor processor(options);
+            runner.run("BatchProcessor: Validate (33 files, " + std::to_string(threads) + " threads)",
+                [&files, &processor]() {
+                    BatchResult result = processor.run(files);
+                    doNotOptimize(result);
+                }, batchBytes, files.size(), threads > 1);
+        }
+    }
+
+    // === Генератор ===
+    std::cout << "\n[6] Generator Benchmarks\n" << std::string(50, '-') << "\n";
+
+    {
+        Generator generator(7);
+        GeneratorOptions opts;
+        opts.maxDepth = 4;
+        opts.compactOutput = true;
+        generator.setOptions(opts);
+
+        std::string out;
+        runner.run("Generator: Document (depth 4, compact)", [&generator, &out]() {
+            out.clear();
+            generator.generateInto(out);
+            doNotOptimize(out);
+        }, 0, 1);
+    }
+
+    const size_t genSize = 8 * 1024 * 1024;
+    std::string genPath = testDir + "/generated.json";
+    for (unsigned int threads : {1u, 0u}) {
+        ParallelGenerator generator(threads);
+        generator.setSeed(12345);
+        std::string label = threads == 0 ? "auto" : std::to_string(threads) + " thread";
+        runner.run("ParallelGenerator: 8 MB file (" + label + ")", [&generator, &genPath, genSize]() {
+            bool ok = generator.generateLargeFile(genPath, genSize, 3, 0);
+            doNotOptimize(ok);
+        }, genSize, 0, true);
+    }
+
+    // === Разные размеры данных ===
+    std::cout << "\n[7] Scaling with Data Size\n" << std::string(50, '-') << "\n";
+
+    for (int size : {100, 500, 1000, 5000, 10000}) {
+        std::string data = generateArray(size);
+        runner.run("Parse Array (" + std::to_string(size) + " elements)",
+            [&data]() {
+                JsonValue value = Parser::parseString(data);
+                doNotOptimize(value);
+            }, data.size(), static_cast<size_t>(size));
+    }
+
+    // Очистка
+    fs::remove_all(testDir);
+}
@@ -0,0 +1,108 @@
+#ifndef BATCH_PROCESSOR_HPP
+#define BATCH_PROCESSOR_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <functional>
+
+namespace json {
+
+class ForkJoinPool;
+
+// Что делать с каждым файлом пакета
+enum class BatchOperation {
+    Validate,       // Только проверить
+    Convert         // Разобрать и записать в outputDir в формате format
+};
+
+// Формат результата Convert
+enum class BatchFormat {
+    Compact,
+    Pretty,
+    Cbor
+};
+
+struct BatchOptions {
+    BatchOperation operation = BatchOperation::Validate;
+    BatchFormat format = BatchFormat::Compact;
+    std::string outputDir;                      // Для Convert; пусто - рядом с исходником
+    unsigned int threads = 0;                   // 0 - по числу ядер
+    size_t readAheadBytes = 256 * 1024 * 1024;  // Прочитано, но ещё не обработано
+    size_t chunkThreshold = 8 * 1024 * 1024;    // С этого размера файл режется на порции
+};
+
+// Результат одного файла
+struct BatchFileResult {
+    std::string path;
+    std::string outputPath;     // Файл результата (Convert)
+    size_t bytes = 0;
+    bool success = false;
+    bool chunked = false;       // Разобран порциями TolerantParser
+    size_t errorCount = 0;
+    std::string firstError;     // "строка:столбец: сообщение" или текст исключения
+    double readMs = 0.0;
+    double processMs = 0.0;
+};
+
+// Итог пакета
+struct BatchResult {
+    std::vector<BatchFileResult> files;     // В порядке входного списка
+    size_t succeeded = 0;
+    size_t failed = 0;
+    size_t totalBytes = 0;
+    double wallMs = 0.0;
+    double readMs = 0.0;                    // Сумма по файлам
+    double processMs = 0.0;                 // Сумма по файлам
+    size_t peakBufferedBytes = 0;           // Максимум прочитанного, но не обработанного
+
+    double throughputMBps() const;
+    std::string toString() const;
+};
+
+// Пакетная обработка множества файлов.
+// Вызывающий поток читает файлы (от больших к меньшим) и отдаёт каждый
+// задачей в общий ForkJoinPool, поэтому чтение идёт одновременно с
+// разбором. Прочитанные, но не обработанные данные ограничены
+// readAheadBytes: чтение ждёт, пока задачи не освободят место (файл
+// больше всего бюджета читается, когда в работе ничего нет). Файлы от
+// chunkThreshold разбираются TolerantParser порциями на том же пуле,
+// остальные - целиком в одной задаче. Ошибка одного файла не
+// останавливает пакет.
+class BatchProcessor {
+public:
+    // Вызывается после каждого файла (из рабочих потоков, но не одновременно)
+    using FileCallback = std::function<void(const BatchFileResult& file, size_t done, size_t total)>;
+
+private:
+    BatchOptions m_options;
+    FileCallback m_fileCallback;
+
+    // Обработать прочитанный файл; pool - для разбора порциями
+    void processFile(const std::string& content, ForkJoinPool& pool, BatchFileResult& result) const;
+
+    std::string outputPathFor(const std::string& input) const;
+
+public:
+    explicit BatchProcessor(BatchOptions options = BatchOptions());
+
+    const BatchOptions& options() const { return m_options; }
+
+    void setFileCallback(FileCallback callback) { m_fileCallback = std::move(callback); }
+
+    // Файлы *.json (и *.json.gz, *.json.zst) в каталоге (по алфавиту)
+    // или сам путь, если это файл.
+    // JsonException, если пути нет.
+    static std::vector<std::string> collectFiles(const std::string& path, bool recursive = false);
+
+    // Convert пишет <outputDir>/<имя>.json или .cbor ("a.json.gz" -> "a.json").
+    // Файл, результат которого совпал бы с исходником или с результатом
+    // другого файла пакета, отмечается ошибкой и не читается. Сжатые файлы
+    // распаковываются при чтении; бюджет резервируется по размеру на диске
+    // и уточняется после распаковки. JsonException, если не создать outputDir.
+    BatchResult run(const std::vector<std::string>& files) const;
+};
+
+} // namespace json
+
+#endif // BATCH_PROCESSOR_HPP
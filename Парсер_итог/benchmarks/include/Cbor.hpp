@@ -0,0 +1,119 @@
+#ifndef CBOR_HPP
+#define CBOR_HPP
+
+#include "JsonValue.hpp"
+#include <string>
+#include <string_view>
+#include <ostream>
+#include <cstdint>
+
+namespace json {
+
+// Двоичный формат CBOR (RFC 8949) для быстрого сохранения и повторной загрузки.
+// Целые числа хранятся как целые, дробные - как float32 (если без потерь) или
+// float64, строки и контейнеры - с длиной в заголовке, поэтому при чтении не
+// нужны ни лексер, ни разбор чисел, ни экранирование.
+
+// Потоковый писатель CBOR (аналог JsonWriter).
+// Длины контейнеров указываются заранее, ключи объектов - обычные строки.
+class CborWriter {
+public:
+    // Метка самоописания CBOR (0xd9d9f7): по ней файл распознаётся при загрузке
+    static constexpr uint8_t SELF_DESCRIBE_TAG[3] = {0xd9, 0xd9, 0xf7};
+
+private:
+    std::string m_buffer;           // Внутренний буфер (режим потока)
+    std::string* m_out;             // Куда пишем: внешняя строка или m_buffer
+    std::ostream* m_stream;         // Поток для сброса буфера (или nullptr)
+    size_t m_bufferSize;
+    size_t m_startSize;
+    size_t m_flushedBytes;
+
+    // Заголовок элемента: старший тип (0-7) и аргумент минимальной длины
+    void writeHead(uint8_t major, uint64_t argument);
+    void maybeFlush();
+
+public:
+    // Запись в строку (данные дописываются в конец output)
+    explicit CborWriter(std::string& output);
+
+    // Запись в поток через внутренний буфер
+    explicit CborWriter(std::ostream& os, size_t bufferSize = 64 * 1024);
+
+    ~CborWriter();
+
+    CborWriter(const CborWriter&) = delete;
+    CborWriter& operator=(const CborWriter&) = delete;
+
+    // Контейнеры (далее следует size элементов / пар ключ-значение)
+    CborWriter& beginArray(size_t size);
+    CborWriter& beginObject(size_t size);
+    CborWriter& key(std::string_view name) { return value(name); }
+
+    // Скалярные значения
+    CborWriter& null();
+    CborWriter& value(bool b);
+    CborWriter& value(double number);
+    CborWriter& value(int64_t number);
+    CborWriter& value(std::string_view str);
+    CborWriter& value(const char* str) { return value(std::string_view(str)); }
+    CborWriter& value(const std::string& str) { return value(std::string_view(str)); }
+
+    // Запись поддерева DOM
+    CborWriter& value(const JsonValue& node);
+
+    // Метка самоописания в начале файла
+    CborWriter& selfDescribe();
+
+    // Сбросить буфер в поток
+    void flush();
+
+    // Общее количество записанных байт
+    size_t bytesWritten() const;
+
+    // Статические методы для быстрой сериализации
+    static std::string toBytes(const JsonValue& value);
+    static bool toFile(const JsonValue& value, const std::string& filename);
+};
+
+// Чтение CBOR в JsonValue (аналог Parser).
+// Ошибки формата сообщаются через JsonException со смещением в байтах.
+class CborReader {
+private:
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_pos;
+    size_t m_depth;
+
+    // Ограничение вложенности: защищает стек от повреждённых файлов
+    static constexpr size_t MAX_DEPTH = 1000;
+
+    [[noreturn]] void fail(const std::string& message) const;
+
+    uint8_t readByte();
+    uint64_t readArgument(uint8_t info);
+    void readText(uint8_t info, std::string& out);
+    double readFloat(uint8_t info);
+
+    JsonValue readValue();
+
+public:
+    explicit CborReader(std::string_view data);
+
+    // Прочитать одно значение (метка самоописания пропускается)
+    JsonValue read();
+
+    // Позиция после прочитанного значения
+    size_t position() const { return m_pos; }
+
+    // Статические методы для быстрого чтения
+    static JsonValue parseBytes(std::string_view data);
+    static JsonValue parseFile(const std::string& filename);
+
+    // Начинается ли файл с метки самоописания CBOR
+    static bool isCborFile(const std::string& filename);
+};
+
+} // namespace json
+
+#endif // CBOR_HPP
@@ -0,0 +1,59 @@
+#ifndef CONTENT_HASHER_HPP
+#define CONTENT_HASHER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace json {
+
+// Пошаговое хэширование по 8 байт (не криптографическое).
+// Результат никогда не равен 0, поэтому 0 можно использовать как
+// признак "хэш не вычислен".
+class ContentHasher {
+private:
+    uint64_t m_state = 0x9E3779B97F4A7C15ULL;
+    uint64_t m_length = 0;
+
+    static uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+    void mix(uint64_t word) {
+        m_state ^= word * 0x9E3779B97F4A7C15ULL;
+        m_state = rotl(m_state, 31) * 0xBF58476D1CE4E5B9ULL;
+    }
+
+public:
+    // Все блоки, кроме последнего, должны быть кратны 8 байтам
+    void update(const char* data, size_t size) {
+        m_length += size;
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+            mix(word);
+        }
+        if (i < size) {
+            uint64_t word = 0;
+            std::memcpy(&word, data + i, size - i);
+            mix(word);
+        }
+    }
+
+    // Одно 8-байтное слово (например, хэш дочернего значения)
+    void update(uint64_t word) {
+        m_length += sizeof(word);
+        mix(word);
+    }
+
+    uint64_t finish() const {
+        uint64_t h = m_state ^ m_length;
+        h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+        h ^= h >> 31;
+        return h == 0 ? 1 : h;
+    }
+};
+
+} // namespace json
+
+#endif // CONTENT_HASHER_HPP
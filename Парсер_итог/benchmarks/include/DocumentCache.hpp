@@ -0,0 +1,138 @@
+#ifndef DOCUMENT_CACHE_HPP
+#define DOCUMENT_CACHE_HPP
+
+#include "JsonValue.hpp"
+#include <string>
+#include <string_view>
+#include <memory>
+#include <optional>
+#include <cstdint>
+
+namespace json {
+
+class MappedFile;
+
+// Кэш разобранных документов на диске.
+// Файл кэша - плоский образ дерева: узлы фиксированного размера ссылаются на
+// детей и строки смещениями от начала файла, поэтому он не зависит от адреса
+// загрузки и читается через отображение в память без десериализации.
+// Ключ кэша - путь к исходнику, проверка актуальности - размер, время
+// изменения и (по запросу) хэш содержимого.
+
+// Значение внутри отображённого кэша (только чтение, без копирования).
+// Действительно, пока жив CachedDocument, которому оно принадлежит.
+class CachedValue {
+private:
+    const char* m_base;     // Начало отображения
+    size_t m_size;          // Размер отображения
+    size_t m_offset;        // Смещение узла
+
+    const void* node() const;
+    CachedValue child(uint64_t offset) const;
+
+public:
+    CachedValue(const char* base, size_t size, size_t offset);
+
+    // Проверки типа
+    bool isNull() const;
+    bool isBool() const;
+    bool isNumber() const;
+    bool isString() const;
+    bool isArray() const;
+    bool isObject() const;
+    std::string typeName() const;
+
+    // Значения (JsonException при несовпадении типа)
+    bool asBool() const;
+    double asNumber() const;
+    std::string_view asString() const;
+
+    // Размер массива или объекта
+    size_t size() const;
+
+    // Элемент массива
+    CachedValue operator[](size_t index) const;
+
+    // Поле объекта: двоичный поиск по отсортированным ключам
+    std::optional<CachedValue> find(std::string_view key) const;
+    CachedValue at(std::string_view key) const;
+
+    // Перебор полей объекта по индексу
+    std::string_view keyAt(size_t index) const;
+    CachedValue valueAt(size_t index) const;
+
+    // Поиск по пути, как JsonValue::findByPath ("items[0].name")
+    std::optional<CachedValue> findByPath(const std::string& path) const;
+
+    // Построить обычное дерево JsonValue
+    JsonValue toJsonValue() const;
+};
+
+// Сведения об исходном файле, по которым проверяется актуальность кэша
+struct CacheSourceInfo {
+    uint64_t size = 0;
+    int64_t mtime = 0;
+    uint64_t hash = 0;          // 0 - не вычислялся
+};
+
+// Отображённый в память файл кэша
+class CachedDocument {
+private:
+    std::unique_ptr<MappedFile> m_mapping;
+    CacheSourceInfo m_source;
+    size_t m_rootOffset;
+
+    CachedDocument();
+
+public:
+    ~CachedDocument();
+
+    CachedDocument(const CachedDocument&) = delete;
+    CachedDocument& operator=(const CachedDocument&) = delete;
+
+    // Открыть файл кэша; JsonException, если файл повреждён или чужой версии
+    static std::unique_ptr<CachedDocument> open(const std::string& cacheFile);
+
+    CachedValue root() const;
+    const CacheSourceInfo& source() const { return m_source; }
+    size_t sizeBytes() const;
+};
+
+// Каталог кэша
+class DocumentCache {
+private:
+    std::string m_directory;
+
+public:
+    explicit DocumentCache(const std::string& directory = ".jsoncache");
+
+    const std::string& directory() const { return m_directory; }
+
+    // Путь к файлу кэша для исходника (имя - хэш абсолютного пути)
+    std::string cachePathFor(const std::string& sourceFile) const;
+
+    // Открыть актуальный кэш; nullptr, если его нет или исходник изменился
+    // (устаревший файл кэша при этом удаляется). verifyHash дополнительно
+    // сверяет хэш содержимого - это чтение всего исходника.
+    std::unique_ptr<CachedDocument> open(const std::string& sourceFile, bool verifyHash = false) const;
+
+    // Сохранить разобранный документ для исходника
+    bool store(const std::string& sourceFile, const JsonValue& value) const;
+
+    // Удалить кэш исходника
+    bool invalidate(const std::string& sourceFile) const;
+
+    // Сведения об исходнике (hash вычисляется только при withHash)
+    static CacheSourceInfo describe(const std::string& sourceFile, bool withHash);
+
+    // Хэш содержимого файла (64 бита, не криптографический)
+    static uint64_t hashFile(const std::string& filename);
+
+    // Записать образ дерева в файл
+    static bool writeCacheFile(const JsonValue& value, const CacheSourceInfo& source,
+                               const std::string& cacheFile);
+};
+
+} // namespace json
+
+#endif // DOCUMENT_CACHE_HPP
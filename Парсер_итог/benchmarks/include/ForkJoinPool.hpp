@@ -0,0 +1,63 @@
+#ifndef FORK_JOIN_POOL_HPP
+#define FORK_JOIN_POOL_HPP
+
+#include <cstddef>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+namespace json {
+
+// Пул потоков для fork-join: задачи группы запускаются spawn(), а поток,
+// ожидающий группу в wait(), сам выполняет задачи из очереди. Поэтому
+// вложенные группы не блокируют пул, сколько бы уровней ни было.
+class ForkJoinPool {
+public:
+    // Набор задач, завершения которых ждут вместе
+    class Group {
+    private:
+        friend class ForkJoinPool;
+        size_t m_pending = 0;           // Защищено мьютексом пула
+        std::exception_ptr m_error;     // Первое исключение из задач группы
+    };
+
+private:
+    struct Task {
+        Group* group;
+        std::function<void()> run;
+    };
+
+    std::vector<std::thread> m_workers;
+    std::deque<Task> m_queue;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_stop = false;
+
+    // Выполнить задачу и отметить её завершение (мьютекс не удерживается)
+    void execute(Task& task);
+
+    void workerLoop();
+
+public:
+    // workers - число фоновых потоков (ожидающий поток работает тоже)
+    explicit ForkJoinPool(unsigned int workers);
+    ~ForkJoinPool();
+
+    ForkJoinPool(const ForkJoinPool&) = delete;
+    ForkJoinPool& operator=(const ForkJoinPool&) = delete;
+
+    size_t workerCount() const { return m_workers.size(); }
+
+    void spawn(Group& group, std::function<void()> task);
+
+    // Дождаться задач группы; исключение из задачи пробрасывается здесь
+    void wait(Group& group);
+};
+
+} // namespace json
+
+#endif // FORK_JOIN_POOL_HPP
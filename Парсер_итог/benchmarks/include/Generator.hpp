@@ -44,39 +44,40 @@ struct GeneratorOptions {
 };
 
 // Класс генератора JSON
+// Все значения дописываются в один выходной буфер, без промежуточных строк
 class Generator {
 private:
     std::mt19937 m_rng;
     GeneratorOptions m_options;
     std::vector<GeneratedError> m_errors;
-    int m_currentLine;
-    int m_currentColumn;
-
-    // Вспомогательные методы генерации
-    std::string generateValue(int depth);
-    std::string generateObject(int depth);
-    std::string generateArray(int depth);
-    std::string generateString();
-    std::string generateNumber();
-    std::string generateBool();
-    std::string generateNull();
+    std::string* m_out;                             // Текущий выходной буфер
+    std::vector<std::vector<std::string>> m_usedKeys; // Использованные ключи по уровням
+    std::string m_keyBuffer;
+
+    // Вспомогательные методы генерации (дописывают в *m_out)
+    void appendValue(int depth);
+    void appendObject(int depth);
+    void appendArray(int depth);
+    void appendString();
+    void appendNumber();
+    void appendBool();
+    void appendNull();
+    void appendIndent(int width);
+    void appendRoot();
 
     // Генерация случайных данных
-    std::string randomString(int minLen = 3, int maxLen = 15);
-    std::string randomKey();
+    void appendRandomString(int minLen = 3, int maxLen = 15);
+    void randomKey(std::string& key);
     int randomInt(int min, int max);
     double randomDouble(double min, double max);
     bool randomBool();
     bool shouldGenerateError();
 
-    // Внесение ошибок
-    std::string injectError(const std::string& json, ErrorType errorType);
+    // Внесение ошибки в часть буфера, начинающуюся с позиции start
+    void injectError(std::string& json, size_t start, ErrorType errorType);
     ErrorType selectRandomError();
     std::string getErrorDescription(ErrorType type);
 
-    // Обновление позиции
-    void updatePosition(const std::string& str);
-
 public:
     explicit Generator(unsigned int seed = 0);
 
@@ -87,6 +88,9 @@ public:
     // Генерация JSON
     std::string generate();
 
+    // Дописать один корневой элемент в конец out (ошибки накапливаются)
+    void generateInto(std::string& out);
+
     // Генерация с заданным количеством ошибок
     std::string generateWithErrors(int errorCount);
 
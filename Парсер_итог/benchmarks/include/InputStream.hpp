@@ -0,0 +1,61 @@
+#ifndef INPUT_STREAM_HPP
+#define INPUT_STREAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace json {
+
+// Сжатие входного файла (определяется по сигнатуре, не по расширению)
+enum class Compression {
+    None,
+    Gzip,       // 1f 8b; несколько склеенных членов тоже читаются
+    Zstd        // 28 b5 2f fd; кадры распаковываются параллельно
+};
+
+// Формат по первым байтам файла
+Compression detectCompression(std::string_view prefix);
+
+const char* compressionName(Compression compression);
+
+// Поддержка формата включена в сборку (zlib, libzstd)
+bool compressionAvailable(Compression compression);
+
+// Расширение сжатого файла: ".gz" или ".zst"
+bool isCompressedExtension(const std::string& extension);
+
+// Последовательное чтение файла с прозрачной распаковкой.
+// read() выдаёт распакованные данные; распаковка идёт в потоке,
+// вызывающем read() (и в рабочих потоках для многокадрового zstd).
+class InputStream {
+protected:
+    uint64_t m_fileSize = 0;
+    uint64_t m_position = 0;    // Прочитано байт файла (сжатых)
+
+public:
+    virtual ~InputStream() = default;
+
+    // До size байт распакованных данных; 0 - конец.
+    // JsonException при ошибке чтения или повреждённом сжатом потоке.
+    virtual size_t read(char* buffer, size_t size) = 0;
+
+    virtual Compression compression() const = 0;
+
+    // Прогресс по файлу: (position, fileSize) в байтах файла
+    uint64_t position() const { return m_position; }
+    uint64_t fileSize() const { return m_fileSize; }
+
+    // Остаток потока целиком
+    std::string readAll();
+
+    // Открыть файл; threads - потоков распаковки zstd (0 - по числу ядер).
+    // JsonException, если файл не открыть или формат не собран.
+    static std::unique_ptr<InputStream> open(const std::string& filename, unsigned int threads = 0);
+};
+
+} // namespace json
+
+#endif // INPUT_STREAM_HPP
@@ -0,0 +1,45 @@
+#ifndef JSON_PATCH_HPP
+#define JSON_PATCH_HPP
+
+#include "JsonValue.hpp"
+#include <string>
+#include <vector>
+
+namespace json {
+
+// Разница документов в формате JSON Patch (RFC 6902).
+// Патч - массив операций {"op", "path", ["from"], ["value"]}, пути - JSON
+// Pointer (RFC 6901).
+class JsonPatch {
+public:
+    // Операции, превращающие from в to. Спуск идёт только в различающиеся
+    // поддеревья: общие узлы копий (copy-on-write) отсекаются сравнением
+    // указателей, остальные - по структурному хэшу (JsonValue::hash), так
+    // что для снимка с правками время пропорционально изменениям.
+    // Хэши считаются лениво при первом сравнении; для двух независимо
+    // разобранных документов их выгодно посчитать заранее параллельно
+    // (JsonValue::computeHashes) - после правки пересчитается только путь.
+    // Массивы сравниваются по общему началу и концу: вставка или удаление
+    // в середине даёт операции для отличающегося участка, а не для всего
+    // хвоста.
+    static JsonValue diff(const JsonValue& from, const JsonValue& to);
+
+    // Применить патч. Патч применяется к копии документа (O(1) благодаря
+    // copy-on-write), поэтому при ошибке (JsonException) документ не меняется.
+    static void apply(JsonValue& document, const JsonValue& patch);
+
+    // Равенство значений: общий узел - сразу да, разный хэш - сразу нет,
+    // при равных хэшах поддеревья сравниваются обходом (хэш не защищён
+    // от подобранных коллизий)
+    static bool equal(const JsonValue& a, const JsonValue& b);
+
+    // Сегменты JSON Pointer ("/a~1b/0" -> "a/b", "0")
+    static std::vector<std::string> parsePointer(const std::string& pointer);
+
+    // Экранирование сегмента ("~" -> "~0", "/" -> "~1")
+    static std::string escapeToken(const std::string& token);
+};
+
+} // namespace json
+
+#endif // JSON_PATCH_HPP
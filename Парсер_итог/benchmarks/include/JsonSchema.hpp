@@ -0,0 +1,158 @@
+#ifndef JSON_SCHEMA_HPP
+#define JSON_SCHEMA_HPP
+
+#include "JsonValue.hpp"
+#include "Regex.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace json {
+
+class SchemaCompiler;
+
+// Схема JSON Schema (draft-07), скомпилированная в таблицу узлов.
+//
+// Каждая (под)схема - узел с разобранными ограничениями; ссылки между
+// узлами - индексы, так что проверка не ищет ключевые слова и не ходит по
+// JsonValue схемы. Свойства отсортированы для двоичного поиска, pattern
+// скомпилированы в Regex (ECMAScript, как требует стандарт), $ref
+// разрешены в индексы узлов (рекурсивные схемы - циклы в таблице).
+//
+// Поддерживаются все ключевые слова проверки draft-07: type, enum, const,
+// числовые, строковые, items/additionalItems/contains/uniqueItems,
+// properties/patternProperties/additionalProperties/required/
+// propertyNames/dependencies, min/max для размеров, allOf/anyOf/oneOf/not,
+// if/then/else, $ref на ту же схему ("#", "#/definitions/..." и любой
+// JSON Pointer). format и аннотации (title, default, ...) не проверяются,
+// неизвестные ключевые слова пропускаются, как велит стандарт. $ref на
+// другие документы или по $id - JsonException при компиляции.
+class JsonSchema {
+public:
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+    static constexpr uint32_t TRUE_NODE = 0;    // Схема true: подходит всё
+    static constexpr uint32_t FALSE_NODE = 1;   // Схема false: не подходит ничего
+    static constexpr size_t UNLIMITED = std::numeric_limits<size_t>::max();
+
+    // Биты типов для type; "number" - оба числовых бита
+    enum TypeBits : uint8_t {
+        NULL_TYPE = 1,
+        BOOLEAN_TYPE = 2,
+        INTEGER_TYPE = 4,           // Число без дробной части
+        FRACTION_TYPE = 8,          // Число с дробной частью
+        STRING_TYPE = 16,
+        ARRAY_TYPE = 32,
+        OBJECT_TYPE = 64,
+        ANY_TYPE = 127
+    };
+
+    struct Property {
+        std::string name;
+        uint32_t node;              // Схема из properties
+        bool declared;              // Есть в properties (иначе только отслеживается)
+        uint32_t seen;              // Номер отметки "ключ встретился" или NONE
+    };
+
+    // Зависимость dependencies: если ключ есть, нужны ключи или схема
+    struct Dependency {
+        uint32_t seen;              // Отметка ключа
+        std::vector<uint32_t> requiredSeen;
+        uint32_t node = NONE;       // Схема для всего объекта
+    };
+
+    struct Node {
+        uint8_t types = ANY_TYPE;
+
+        // Числа
+        bool hasMinimum = false;
+        bool hasMaximum = false;
+        bool exclusiveMinimum = false;
+        bool exclusiveMaximum = false;
+        double minimum = 0.0;
+        double maximum = 0.0;
+        double multipleOf = 0.0;            // 0 - нет
+
+        // Строки (длина - в символах Unicode)
+        size_t minLength = 0;
+        size_t maxLength = UNLIMITED;
+        uint32_t pattern = NONE;
+
+        // enum и const (const - enum из одного значения)
+        bool hasEnum = false;
+        bool isConst = false;
+        JsonArray enumValues;
+
+        // Массивы
+        uint32_t items = TRUE_NODE;
+        bool tupleItems = false;            // items - массив схем
+        std::vector<uint32_t> tuple;
+        uint32_t additionalItems = TRUE_NODE;
+        uint32_t contains = NONE;
+        size_t minItems = 0;
+        size_t maxItems = UNLIMITED;
+        bool uniqueItems = false;
+
+        // Объекты
+        std::vector<Property> properties;   // По имени
+        std::vector<uint32_t> required;     // Отметки обязательных ключей
+        std::vector<std::pair<uint32_t, uint32_t>> patternProperties;  // (pattern, узел)
+        uint32_t additionalProperties = TRUE_NODE;
+        uint32_t propertyNames = NONE;
+        std::vector<Dependency> dependencies;
+        size_t dependencySchemas = 0;       // Зависимостей со схемой
+        std::vector<std::string> seenNames; // Ключи по номеру отметки
+        size_t minProperties = 0;
+        size_t maxProperties = UNLIMITED;
+
+        // Схемы для того же значения ($ref разрешается при компиляции:
+        // ссылки на узел с $ref ведут прямо в цель)
+        std::vector<uint32_t> allOf;
+        std::vector<uint32_t> anyOf;
+        std::vector<uint32_t> oneOf;
+        uint32_t notNode = NONE;
+        uint32_t ifNode = NONE;
+        uint32_t thenNode = NONE;
+        uint32_t elseNode = NONE;
+
+        // Есть ли что проверять у элементов массива / ключей объекта
+        bool arrayChildren = false;
+        bool objectChildren = false;
+        // Нужно значение целиком (enum/const с контейнерами, uniqueItems)
+        bool needsValue = false;
+
+        // Есть ли схемы для того же значения
+        bool hasApplicators() const {
+            return !allOf.empty() || !anyOf.empty() || !oneOf.empty() || notNode != NONE || ifNode != NONE ||
+                   dependencySchemas > 0;
+        }
+    };
+
+private:
+    std::vector<Node> m_nodes;
+    std::vector<Regex> m_patterns;
+    std::vector<std::string> m_patternSources;
+    uint32_t m_root = TRUE_NODE;
+
+    friend class SchemaCompiler;
+
+public:
+    // Компиляция; JsonException для некорректной схемы
+    static JsonSchema compile(const JsonValue& schema);
+    static JsonSchema compileFile(const std::string& filename);
+
+    uint32_t root() const { return m_root; }
+    const Node& node(uint32_t index) const { return m_nodes[index]; }
+    size_t nodeCount() const { return m_nodes.size(); }
+
+    const Regex& pattern(uint32_t index) const { return m_patterns[index]; }
+    const std::string& patternSource(uint32_t index) const { return m_patternSources[index]; }
+
+    // Свойство узла по имени или nullptr
+    static const Property* findProperty(const Node& node, const std::string& name);
+};
+
+} // namespace json
+
+#endif // JSON_SCHEMA_HPP
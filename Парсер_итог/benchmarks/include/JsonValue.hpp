@@ -4,10 +4,12 @@
 #include <string>
 #include <vector>
 #include <map>
-#include <variant>
 #include <memory>
 #include <stdexcept>
 #include <optional>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
 
 namespace json {
 
@@ -29,110 +31,341 @@ public:
         : std::runtime_error(message) {}
 };
 
-// Основной класс для представления JSON-значения
+// Число в исходной записи: преобразуется при первом обращении.
+// Результат кэшируется атомарно, поэтому одновременное чтение из
+// нескольких потоков безопасно.
+class JsonRawNumber {
+private:
+    std::string m_text;
+    mutable std::atomic<uint64_t> m_cached;     // Биты double или NOT_CONVERTED
+
+    // NaN с особой полезной нагрузкой: корректное JSON-число его не даёт
+    static constexpr uint64_t NOT_CONVERTED = 0x7ff8dead0000beefULL;
+
+public:
+    explicit JsonRawNumber(std::string text)
+        : m_text(std::move(text)), m_cached(NOT_CONVERTED) {}
+
+    JsonRawNumber(const JsonRawNumber& other)
+        : m_text(other.m_text), m_cached(other.m_cached.load(std::memory_order_relaxed)) {}
+
+    JsonRawNumber(JsonRawNumber&& other) noexcept
+        : m_text(std::move(other.m_text)), m_cached(other.m_cached.load(std::memory_order_relaxed)) {}
+
+    JsonRawNumber& operator=(const JsonRawNumber& other) {
+        m_text = other.m_text;
+        m_cached.store(other.m_cached.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+    }
+
+    JsonRawNumber& operator=(JsonRawNumber&& other) noexcept {
+        m_text = std::move(other.m_text);
+        m_cached.store(other.m_cached.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+    }
+
+    // Исходная запись числа
+    const std::string& text() const { return m_text; }
+
+    // Значение double (преобразование выполняется один раз)
+    double value() const;
+
+    // Точное целое значение; false, если число не целое или вне диапазона
+    bool toInt64(int64_t& out) const;
+};
+
+namespace detail {
+
+// Отдельно выделенные данные узла со счётчиком ссылок
+struct SharedPayload {
+    std::atomic<uint32_t> refs{1};
+    uint32_t spanSource = 0;    // Источник участка (SourceSpan), 0 - участка нет
+};
+
+template<typename T>
+constexpr bool IS_CONTAINER = std::is_same_v<T, JsonArray> || std::is_same_v<T, JsonObject>;
+
+// Участок исходного текста и структурный хэш хранят только контейнеры:
+// скаляры дешевле записать и сравнить заново
+template<typename T, bool Container = IS_CONTAINER<T>>
+struct SharedBox : SharedPayload {
+    T value;
+
+    template<typename... Args>
+    explicit SharedBox(Args&&... args) : value(std::forward<Args>(args)...) {}
+};
+
+template<typename T>
+struct SharedBox<T, true> : SharedPayload {
+    uint64_t spanOffset = 0;
+    uint64_t spanLength = 0;
+    mutable std::atomic<uint64_t> hash{0};     // Хэш поддерева, 0 - не вычислен
+    T value;
+
+    template<typename... Args>
+    explicit SharedBox(Args&&... args) : value(std::forward<Args>(args)...) {}
+};
+
+} // namespace detail
+
+// Участок исходного файла, из которого разобран контейнер
+// (Parser::setSourceSpans, Serializer::saveIncremental)
+struct SourceSpan {
+    uint32_t source = 0;        // Идентификатор источника, 0 - участка нет
+    uint64_t offset = 0;        // Смещение открывающей скобки
+    uint64_t length = 0;        // Длина вместе с закрывающей скобкой
+
+    // Новый уникальный идентификатор источника (для каждого прочитанного файла)
+    static uint32_t newSource();
+};
+
+// Основной класс для представления JSON-значения.
+// Узел занимает 16 байт: тег типа и 8 байт данных. null, bool и double
+// хранятся прямо в узле, строки, контейнеры и исходная запись числа -
+// в отдельно выделенной памяти со счётчиком ссылок.
+//
+// Копирование узла не копирует данные: копии разделяют поддеревья, пока
+// одна из них не изменится (copy-on-write). Неконстантный доступ
+// (asArray(), operator[], push_back, findByPath...) отделяет копию только
+// на пройденном пути, поэтому снимок документа стоит O(1), а правка -
+// O(глубина). Разделяемые данные неизменяемы, и копии можно свободно
+// передавать между потоками. Ссылка, полученная неконстантным методом,
+// действительна до следующего копирования узла: изменения через неё
+// после копирования увидят обе копии.
 class JsonValue {
 public:
-    // Вариант для хранения всех возможных типов JSON
-    using ValueType = std::variant<
-        JsonNull,
-        JsonBool,
-        JsonNumber,
-        JsonString,
-        JsonArray,
-        JsonObject
-    >;
+    // Тип значения (порядок совпадает с типами узлов DocumentCache)
+    enum class Type : uint8_t {
+        Null,
+        Bool,
+        Number,
+        String,
+        Array,
+        Object,
+        RawNumber       // Число без преобразования (Parser::NumberMode::Lazy)
+    };
 
 private:
-    ValueType m_value;
+    union Payload {
+        bool boolean;
+        double number;
+        detail::SharedPayload* shared;
+    };
+
+    Payload m_payload;
+    Type m_type;
+
+    // Данные, выделенные отдельно (строка, контейнер, исходная запись)
+    bool ownsPayload() const { return m_type >= Type::String; }
+
+    // Отпустить ссылку на отдельные данные (тип узла не меняется)
+    void unref() noexcept;
+
+    template<typename T>
+    static detail::SharedPayload* box(T&& value) {
+        return new detail::SharedBox<std::decay_t<T>>(std::forward<T>(value));
+    }
+
+    template<typename T>
+    const T& shared() const {
+        return static_cast<const detail::SharedBox<T>*>(m_payload.shared)->value;
+    }
+
+    // Данные для изменения: разделяемые сначала копируются (дети копии
+    // по-прежнему разделяются, так что это O(ширина узла)). Узел теряет
+    // исходный участок и хэш: доступ для изменения считается изменением,
+    // и так помечается весь путь от корня.
+    template<typename T>
+    T& unique() {
+        auto* current = static_cast<detail::SharedBox<T>*>(m_payload.shared);
+        if (current->refs.load(std::memory_order_acquire) != 1) {
+            auto* copy = new detail::SharedBox<T>(current->value);
+            unref();
+            m_payload.shared = copy;
+            current = copy;
+        }
+        current->spanSource = 0;
+        if constexpr (detail::IS_CONTAINER<T>) {
+            current->hash.store(0, std::memory_order_relaxed);
+        }
+        return current->value;
+    }
 
 public:
     // Конструкторы
-    JsonValue() : m_value(nullptr) {}
-    JsonValue(std::nullptr_t) : m_value(nullptr) {}
-    JsonValue(bool value) : m_value(value) {}
-    JsonValue(int value) : m_value(static_cast<double>(value)) {}
-    JsonValue(double value) : m_value(value) {}
-    JsonValue(const char* value) : m_value(std::string(value)) {}
-    JsonValue(const std::string& value) : m_value(value) {}
-    JsonValue(std::string&& value) : m_value(std::move(value)) {}
-    JsonValue(const JsonArray& value) : m_value(value) {}
-    JsonValue(JsonArray&& value) : m_value(std::move(value)) {}
-    JsonValue(const JsonObject& value) : m_value(value) {}
-    JsonValue(JsonObject&& value) : m_value(std::move(value)) {}
+    JsonValue() : m_type(Type::Null) { m_payload.shared = nullptr; }
+    JsonValue(std::nullptr_t) : JsonValue() {}
+    JsonValue(bool value) : m_type(Type::Bool) { m_payload.number = 0; m_payload.boolean = value; }
+    JsonValue(int value) : m_type(Type::Number) { m_payload.number = value; }
+    JsonValue(double value) : m_type(Type::Number) { m_payload.number = value; }
+    JsonValue(const char* value) : m_type(Type::String) { m_payload.shared = box(JsonString(value)); }
+    JsonValue(const std::string& value) : m_type(Type::String) { m_payload.shared = box(value); }
+    JsonValue(std::string&& value) : m_type(Type::String) { m_payload.shared = box(std::move(value)); }
+    JsonValue(const JsonArray& value) : m_type(Type::Array) { m_payload.shared = box(value); }
+    JsonValue(JsonArray&& value) : m_type(Type::Array) { m_payload.shared = box(std::move(value)); }
+    JsonValue(const JsonObject& value) : m_type(Type::Object) { m_payload.shared = box(value); }
+    JsonValue(JsonObject&& value) : m_type(Type::Object) { m_payload.shared = box(std::move(value)); }
+    JsonValue(JsonRawNumber&& value) : m_type(Type::RawNumber) { m_payload.shared = box(std::move(value)); }
+
+    // Копия разделяет данные с оригиналом
+    JsonValue(const JsonValue& other) noexcept : m_payload(other.m_payload), m_type(other.m_type) {
+        if (ownsPayload()) {
+            m_payload.shared->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    JsonValue(JsonValue&& other) noexcept : m_payload(other.m_payload), m_type(other.m_type) {
+        other.m_type = Type::Null;
+    }
+
+    JsonValue& operator=(const JsonValue& other) noexcept {
+        if (this != &other) {
+            // Сначала копия: other может быть частью заменяемого дерева
+            JsonValue copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    JsonValue& operator=(JsonValue&& other) noexcept {
+        if (this != &other) {
+            // Данные забираются до освобождения старых по той же причине
+            Payload payload = other.m_payload;
+            Type type = other.m_type;
+            other.m_type = Type::Null;
+            if (ownsPayload()) unref();
+            m_payload = payload;
+            m_type = type;
+        }
+        return *this;
+    }
+
+    ~JsonValue() {
+        if (ownsPayload()) unref();
+    }
+
+    void swap(JsonValue& other) noexcept {
+        std::swap(m_payload, other.m_payload);
+        std::swap(m_type, other.m_type);
+    }
+
+    // Тип значения
+    Type type() const { return m_type; }
+
+    // Разделяет ли узел данные с другими копиями
+    bool isShared() const {
+        return ownsPayload() && m_payload.shared->refs.load(std::memory_order_acquire) > 1;
+    }
+
+    // Исходный участок контейнера; false, если его нет или узел получали
+    // для изменения после разбора (сохранения)
+    bool sourceSpan(SourceSpan& span) const;
+
+    // Запомнить исходный участок (только для массивов и объектов).
+    // Участок - метаданные неизменяемых данных и виден всем копиям узла,
+    // поэтому метод константный; одновременно с чтением участков этого
+    // дерева из других потоков вызывать его нельзя.
+    void setSourceSpan(const SourceSpan& span) const;
+
+    // Тот же узел: копии разделяют данные (для скаляров в узле - false)
+    bool sharesPayloadWith(const JsonValue& other) const {
+        return ownsPayload() && m_type == other.m_type && m_payload.shared == other.m_payload.shared;
+    }
+
+    // Структурный хэш значения. Равные значения (числа - по значению,
+    // объекты - без учёта порядка вставки) имеют равный хэш. У массивов
+    // и объектов хэш кэшируется в данных узла до изменения, поэтому
+    // повторный вызов - O(1), а после правки пересчитывается только путь.
+    uint64_t hash() const;
+
+    // Вычислить хэши всего дерева в threads потоках (0 - по числу ядер):
+    // дерево делится на поддеревья, которые хэшируются параллельно
+    void computeHashes(unsigned int threads = 0) const;
 
     // Проверки типа
-    bool isNull() const { return std::holds_alternative<JsonNull>(m_value); }
-    bool isBool() const { return std::holds_alternative<JsonBool>(m_value); }
-    bool isNumber() const { return std::holds_alternative<JsonNumber>(m_value); }
-    bool isString() const { return std::holds_alternative<JsonString>(m_value); }
-    bool isArray() const { return std::holds_alternative<JsonArray>(m_value); }
-    bool isObject() const { return std::holds_alternative<JsonObject>(m_value); }
+    bool isNull() const { return m_type == Type::Null; }
+    bool isBool() const { return m_type == Type::Bool; }
+    bool isNumber() const { return m_type == Type::Number || m_type == Type::RawNumber; }
+    bool isRawNumber() const { return m_type == Type::RawNumber; }
+    bool isString() const { return m_type == Type::String; }
+    bool isArray() const { return m_type == Type::Array; }
+    bool isObject() const { return m_type == Type::Object; }
 
     // Получение значений с проверкой типа
     bool asBool() const {
         if (!isBool()) throw JsonException("Значение не является булевым");
-        return std::get<JsonBool>(m_value);
+        return m_payload.boolean;
     }
 
     double asNumber() const {
-        if (!isNumber()) throw JsonException("Значение не является числом");
-        return std::get<JsonNumber>(m_value);
+        if (m_type == Type::Number) return m_payload.number;
+        if (m_type == Type::RawNumber) return shared<JsonRawNumber>().value();
+        throw JsonException("Значение не является числом");
+    }
+
+    // Целое значение без потери точности (для исходной записи - вплоть до 2^63)
+    int64_t asInt64() const;
+
+    // Исходная запись числа (только для isRawNumber())
+    const JsonRawNumber& asRawNumber() const {
+        if (!isRawNumber()) throw JsonException("Число не хранит исходную запись");
+        return shared<JsonRawNumber>();
+    }
+
+    const std::string& numberText() const {
+        return asRawNumber().text();
     }
 
     const std::string& asString() const {
         if (!isString()) throw JsonException("Значение не является строкой");
-        return std::get<JsonString>(m_value);
+        return shared<JsonString>();
     }
 
     std::string& asString() {
         if (!isString()) throw JsonException("Значение не является строкой");
-        return std::get<JsonString>(m_value);
+        return unique<JsonString>();
     }
 
     const JsonArray& asArray() const {
         if (!isArray()) throw JsonException("Значение не является массивом");
-        return std::get<JsonArray>(m_value);
+        return shared<JsonArray>();
     }
 
     JsonArray& asArray() {
         if (!isArray()) throw JsonException("Значение не является массивом");
-        return std::get<JsonArray>(m_value);
+        return unique<JsonArray>();
     }
 
     const JsonObject& asObject() const {
         if (!isObject()) throw JsonException("Значение не является объектом");
-        return std::get<JsonObject>(m_value);
+        return shared<JsonObject>();
     }
 
     JsonObject& asObject() {
         if (!isObject()) throw JsonException("Значение не является объектом");
-        return std::get<JsonObject>(m_value);
+        return unique<JsonObject>();
     }
 
     // Доступ к элементам массива
     JsonValue& operator[](size_t index) {
-        if (!isArray()) throw JsonException("Значение не является массивом");
-        auto& arr = std::get<JsonArray>(m_value);
+        auto& arr = asArray();
         if (index >= arr.size()) throw JsonException("Индекс выходит за границы массива");
         return arr[index];
     }
 
     const JsonValue& operator[](size_t index) const {
-        if (!isArray()) throw JsonException("Значение не является массивом");
-        const auto& arr = std::get<JsonArray>(m_value);
+        const auto& arr = asArray();
         if (index >= arr.size()) throw JsonException("Индекс выходит за границы массива");
         return arr[index];
     }
 
     // Доступ к элементам объекта
     JsonValue& operator[](const std::string& key) {
-        if (!isObject()) throw JsonException("Значение не является объектом");
-        return std::get<JsonObject>(m_value)[key];
+        return asObject()[key];
     }
 
     const JsonValue& at(const std::string& key) const {
-        if (!isObject()) throw JsonException("Значение не является объектом");
-        const auto& obj = std::get<JsonObject>(m_value);
+        const auto& obj = asObject();
         auto it = obj.find(key);
         if (it == obj.end()) throw JsonException("Ключ не найден: " + key);
         return it->second;
@@ -141,33 +374,32 @@ public:
     // Проверка наличия ключа
     bool contains(const std::string& key) const {
         if (!isObject()) return false;
-        const auto& obj = std::get<JsonObject>(m_value);
+        const auto& obj = shared<JsonObject>();
         return obj.find(key) != obj.end();
     }
 
     // Размер (для массивов и объектов)
     size_t size() const {
-        if (isArray()) return std::get<JsonArray>(m_value).size();
-        if (isObject()) return std::get<JsonObject>(m_value).size();
+        if (isArray()) return shared<JsonArray>().size();
+        if (isObject()) return shared<JsonObject>().size();
         throw JsonException("Размер доступен только для массивов и объектов");
     }
 
     // Добавление элемента в массив
     void push_back(const JsonValue& value) {
         if (!isArray()) throw JsonException("push_back доступен только для массивов");
-        std::get<JsonArray>(m_value).push_back(value);
+        unique<JsonArray>().push_back(value);
     }
 
     // Удаление элемента из объекта по ключу
     bool erase(const std::string& key) {
         if (!isObject()) throw JsonException("erase по ключу доступен только для объектов");
-        return std::get<JsonObject>(m_value).erase(key) > 0;
+        return unique<JsonObject>().erase(key) > 0;
     }
 
     // Удаление элемента из массива по индексу
     void erase(size_t index) {
-        if (!isArray()) throw JsonException("erase по индексу доступен только для массивов");
-        auto& arr = std::get<JsonArray>(m_value);
+        auto& arr = asArray();
         if (index >= arr.size()) throw JsonException("Индекс выходит за границы массива");
         arr.erase(arr.begin() + index);
     }
@@ -184,14 +416,13 @@ public:
     }
 
     // Поиск по пути (например, "user.address.city" или "items[0].name")
+    static std::vector<std::string> splitPath(const std::string& path);
     std::optional<std::reference_wrapper<const JsonValue>> findByPath(const std::string& path) const;
     std::optional<std::reference_wrapper<JsonValue>> findByPath(const std::string& path);
-
-    // Доступ к внутреннему variant (для сериализации)
-    const ValueType& getValue() const { return m_value; }
-    ValueType& getValue() { return m_value; }
 };
 
+static_assert(sizeof(void*) != 8 || sizeof(JsonValue) == 16, "JsonValue должен занимать 16 байт");
+
 } // namespace json
 
 #endif // JSON_VALUE_HPP
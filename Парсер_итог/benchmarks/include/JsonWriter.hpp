@@ -0,0 +1,136 @@
+#ifndef JSON_WRITER_HPP
+#define JSON_WRITER_HPP
+
+#include "JsonValue.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <ostream>
+#include <cstdint>
+#include <type_traits>
+
+namespace json {
+
+// Потоковый писатель JSON без построения DOM.
+// Значения пишутся сразу в выходной буфер (строку или поток), вложенность
+// проверяется по стеку открытых контейнеров.
+class JsonWriter {
+public:
+    // Опции форматирования (формат совпадает с Serializer)
+    struct Options {
+        bool prettyPrint;
+        int indentSize;
+        size_t bufferSize;      // Порог сброса буфера в поток (байт)
+
+        Options() : prettyPrint(true), indentSize(2), bufferSize(64 * 1024) {}
+
+        static Options compact() {
+            Options opts;
+            opts.prettyPrint = false;
+            return opts;
+        }
+
+        static Options pretty(int indent = 2) {
+            Options opts;
+            opts.prettyPrint = true;
+            opts.indentSize = indent;
+            return opts;
+        }
+    };
+
+private:
+    // Открытый контейнер
+    struct Frame {
+        bool isObject;
+        bool hasKey;        // Для объекта: ключ записан, ожидается значение
+        size_t count;       // Количество записанных элементов
+    };
+
+    Options m_options;
+    std::string m_buffer;           // Внутренний буфер (режим потока)
+    std::string* m_out;             // Куда пишем: внешняя строка или m_buffer
+    std::ostream* m_stream;         // Поток для сброса буфера (или nullptr)
+    std::vector<Frame> m_stack;
+    bool m_rootWritten;
+    size_t m_startSize;             // Исходный размер внешней строки
+    size_t m_flushedBytes;
+
+    // Подготовка к записи значения (запятая, перевод строки, отступ)
+    void beforeValue();
+    void afterValue();
+
+    void writeIndent(size_t depth);
+    void writeEscaped(std::string_view str);
+    void writeNumber(double value);
+    void writeInteger(long long value);
+    void writeUnsigned(unsigned long long value);
+    void maybeFlush();
+
+    void writeValue(const JsonValue& value);
+
+public:
+    // Запись в строку (данные дописываются в конец output)
+    explicit JsonWriter(std::string& output, const Options& options = Options());
+
+    // Запись в поток через внутренний буфер фиксированного размера
+    explicit JsonWriter(std::ostream& os, const Options& options = Options());
+
+    ~JsonWriter();
+
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    // Контейнеры
+    JsonWriter& beginObject();
+    JsonWriter& endObject();
+    JsonWriter& beginArray();
+    JsonWriter& endArray();
+
+    // Ключ внутри объекта
+    JsonWriter& key(std::string_view name);
+
+    // Скалярные значения
+    JsonWriter& null();
+    JsonWriter& value(std::nullptr_t) { return null(); }
+    JsonWriter& value(bool b);
+    JsonWriter& value(double number);
+    JsonWriter& value(std::string_view str);
+    JsonWriter& value(const char* str) { return value(std::string_view(str)); }
+    JsonWriter& value(const std::string& str) { return value(std::string_view(str)); }
+
+    template<typename T,
+             typename std::enable_if<std::is_integral<T>::value &&
+                                     !std::is_same<T, bool>::value, int>::type = 0>
+    JsonWriter& value(T number) {
+        beforeValue();
+        if constexpr (std::is_signed<T>::value) {
+            writeInteger(static_cast<long long>(number));
+        } else {
+            writeUnsigned(static_cast<unsigned long long>(number));
+        }
+        afterValue();
+        return *this;
+    }
+
+    // Запись готового поддерева DOM
+    JsonWriter& value(const JsonValue& node);
+
+    // Запись заранее сформированного JSON-фрагмента как значения (без проверки)
+    JsonWriter& rawValue(std::string_view json);
+
+    // Сбросить буфер в поток
+    void flush();
+
+    // Записано ли ровно одно корневое значение и закрыты все контейнеры
+    bool isComplete() const { return m_rootWritten && m_stack.empty(); }
+
+    // Текущая глубина вложенности
+    size_t depth() const { return m_stack.size(); }
+
+    // Общее количество записанных байт
+    size_t bytesWritten() const;
+};
+
+} // namespace json
+
+#endif // JSON_WRITER_HPP
@@ -29,9 +29,10 @@ struct Token {
     std::string value;
     size_t line;
     size_t column;
+    size_t offset;      // Смещение первого символа токена во входе
 
-    Token(TokenType t, std::string v, size_t l, size_t c)
-        : type(t), value(std::move(v)), line(l), column(c) {}
+    Token(TokenType t, std::string v, size_t l, size_t c, size_t o = 0)
+        : type(t), value(std::move(v)), line(l), column(c), offset(o) {}
 };
 
 // Исключение лексера
@@ -53,6 +54,13 @@ private:
     size_t m_pos;
     size_t m_line;
     size_t m_column;
+    size_t m_checkedBytes;      // Начало входа, проверенное на корректность UTF-8
+    bool m_finished;            // Вход полный (append() больше не будет)
+    size_t m_resumeAt;          // Размер входа, с которого стоит повторить незавершённый токен
+    size_t m_base;              // Смещение m_input[0] во входе (отброшенное начало)
+
+    // Проверка UTF-8 участка [m_checkedBytes, end) (до первого токена из него)
+    void checkEncoding(size_t end);
 
     // Получить текущий символ
     char current() const;
@@ -69,7 +77,8 @@ private:
     // Пропустить пробельные символы
     void skipWhitespace();
 
-    // Разбор строки
+    // Разбор строки: участки без escape-последовательностей находятся
+    // векторным поиском и копируются целиком
     Token parseString();
 
     // Разбор числа
@@ -81,15 +90,35 @@ private:
     // Обработка escape-последовательностей в строке
     std::string processEscapeSequences(const std::string& str);
 
-    // Разбор unicode escape (\uXXXX)
+    // Разбор unicode escape (\uXXXX) по таблице значений цифр
     char32_t parseUnicodeEscape();
 
-    // Конвертация code point в UTF-8
-    std::string codePointToUTF8(char32_t cp);
-
 public:
     explicit Lexer(const std::string& input);
 
+    // Пошаговый вход: данные поступают через append(), конец - finish()
+    Lexer();
+
+    void reserve(size_t bytes) { m_input.reserve(bytes); }
+    void append(const char* data, size_t size) { m_input.append(data, size); }
+    void finish() { m_finished = true; }
+
+    // Освободить уже разобранное начало входа (длинный поток через
+    // append()). Смещения токенов по-прежнему считаются от начала входа.
+    void discardConsumed();
+
+    // Вход - фрагмент документа с этой позиции: строки, столбцы и смещения
+    // токенов и ошибок считаются от неё. Вызывается до разбора.
+    void setStartPosition(size_t line, size_t column, size_t offset);
+
+    // Добавить в tokens все токены, которые целиком лежат в полученных
+    // данных. Токен у конца данных (число, строка, ключевое слово могут
+    // продолжиться) откладывается до следующего append(); ошибка в нём -
+    // тоже, пока вход не полный. После finish() разбирает остаток и
+    // возвращает true, добавив EndOfFile. Токены и ошибки те же, что у
+    // tokenize() для всего входа, при любом разбиении на части.
+    bool tokenizeAvailable(std::vector<Token>& tokens);
+
     // Получить следующий токен
     Token nextToken();
 
@@ -100,6 +129,11 @@ public:
 // Вспомогательная функция для получения названия типа токена
 std::string tokenTypeName(TokenType type);
 
+// Первый байт в [pos, end), на котором обычное копирование строки
+// прерывается: '"', '\' или управляющий символ; end, если таких нет.
+// С SSE2 поиск идёт по 16 байт за шаг.
+const char* findStringSpecial(const char* pos, const char* end);
+
 } // namespace json
 
 #endif // LEXER_HPP
@@ -0,0 +1,35 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace json {
+
+// Файл, отображённый в память только для чтения
+class MappedFile {
+private:
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+#ifdef _WIN32
+    void* m_file = nullptr;         // HANDLE файла
+    void* m_mapping = nullptr;      // HANDLE отображения
+#endif
+
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Отобразить файл; false, если файл не открылся или пуст
+    bool open(const std::string& filename);
+
+    const char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+};
+
+} // namespace json
+
+#endif // MAPPED_FILE_HPP
@@ -4,6 +4,7 @@
 #include "Validator.hpp"
 #include "SystemInfo.hpp"
 #include <vector>
+#include <cstdint>
 #include <thread>
 #include <mutex>
 #include <atomic>
@@ -23,6 +24,7 @@ struct ParallelResult {
     double totalTimeMs;
     double throughputMBps;
     std::vector<ValidationError> errors;
+    ParseStats stats;           // Время по этапам и потокам
 };
 
 // Прогресс обработки
@@ -76,12 +78,15 @@ public:
 class ParallelGenerator {
 private:
     unsigned int m_threadCount;
-    std::mutex m_fileMutex;
+    size_t m_chunkSize;             // Размер одного чанка генерации
+    size_t m_maxChunksInFlight;     // Окно переупорядочивания (чанков в памяти)
+    uint64_t m_seed;                // Базовый seed (0 - выбрать по времени)
+    uint64_t m_lastSeed;            // Seed, использованный в последней генерации
     std::atomic<size_t> m_generatedBytes{0};
     std::atomic<size_t> m_targetBytes{0};
 
     // Генерация одного чанка
-    std::string generateChunk(size_t targetSize, int depth, int seed, int errorProbability);
+    std::string generateChunk(size_t targetSize, int depth, unsigned int seed, int errorProbability);
 
 public:
     explicit ParallelGenerator(unsigned int threadCount = 0);
@@ -89,12 +94,28 @@ public:
     // Установить количество потоков
     void setThreadCount(unsigned int count);
 
-    // Генерация большого файла заданного размера
+    // Размер чанка и глубина конвейера (по умолчанию 4 МБ и 2 чанка на поток)
+    void setChunkSize(size_t bytes) { m_chunkSize = bytes > 0 ? bytes : 1; }
+    void setMaxChunksInFlight(size_t count) { m_maxChunksInFlight = count > 0 ? count : 1; }
+
+    // Seed генерации. При одинаковых seed, размере файла, размере чанка и
+    // параметрах содержимое файла одинаково при любом числе потоков.
+    void setSeed(uint64_t seed) { m_seed = seed; }
+    uint64_t getSeed() const { return m_seed; }
+    uint64_t getLastSeed() const { return m_lastSeed; }
+
+    // Seed чанка с номером index: зависит только от (seed, index)
+    static unsigned int chunkSeed(uint64_t seed, size_t index);
+
+    // Генерация большого файла заданного размера.
+    // Рабочие потоки генерируют чанки непрерывно, а вызывающий поток пишет их
+    // в файл по порядку, поэтому генерация и запись идут одновременно.
     bool generateLargeFile(const std::string& filename,
                           size_t targetSizeBytes,
                           int depth,
                           int errorProbability,
-                          std::function<void(size_t current, size_t total)> progressCallback = nullptr);
+                          std::function<void(size_t current, size_t total)> progressCallback = nullptr,
+                          ParseStats* stats = nullptr);
 
     // Получить прогресс генерации
     size_t getGeneratedBytes() const { return m_generatedBytes; }
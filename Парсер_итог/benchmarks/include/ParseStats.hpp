@@ -0,0 +1,113 @@
+#ifndef PARSE_STATS_HPP
+#define PARSE_STATS_HPP
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstddef>
+
+namespace json {
+
+// Время одного этапа обработки.
+// Для этапов, которые выполняются в нескольких потоках, wallMs и cpuMs
+// суммируются по всем потокам; реальная длительность параллельной фазы
+// хранится в ParseStats::parallelPhaseMs.
+struct StageTiming {
+    double wallMs = 0.0;
+    double cpuMs = 0.0;         // Процессорное время потока(ов)
+    size_t calls = 0;
+
+    void add(const StageTiming& other) {
+        wallMs += other.wallMs;
+        cpuMs += other.cpuMs;
+        calls += other.calls;
+    }
+};
+
+// Статистика одного рабочего потока
+struct WorkerStats {
+    size_t workerId = 0;
+    size_t chunks = 0;          // Обработано чанков
+    size_t bytes = 0;           // Обработано байт
+    double busyMs = 0.0;        // Время работы над чанками
+    double idleMs = 0.0;        // Ожидание (запуск, окно, завершение фазы)
+    double cpuMs = 0.0;
+};
+
+// Счётчики производительности парсинга, валидации и генерации.
+// Передаётся необязательным указателем; nullptr - статистика не собирается.
+struct ParseStats {
+    // Этапы
+    StageTiming read;           // Чтение файла
+    StageTiming boundaryScan;   // Поиск границ чанков
+    StageTiming tokenize;       // Лексический анализ
+    StageTiming parse;          // Построение дерева / проверка грамматики
+    StageTiming merge;          // Сборка результатов чанков
+    StageTiming generate;       // Генерация данных (ParallelGenerator)
+    StageTiming write;          // Запись в файл (ParallelGenerator)
+    StageTiming total;
+
+    double parallelPhaseMs = 0.0;   // Длительность параллельной фазы
+
+    // Рабочие потоки и чанки
+    std::vector<WorkerStats> workers;
+    std::vector<size_t> chunkSizes;
+
+    // Объёмы
+    size_t bytes = 0;
+    size_t tokens = 0;
+    size_t elements = 0;        // Построенных значений (или элементов верхнего уровня)
+
+    void reset() { *this = ParseStats(); }
+
+    // Сводка по размерам чанков
+    size_t minChunkSize() const;
+    size_t maxChunkSize() const;
+    double averageChunkSize() const;
+
+    // Пропускная способность по общему времени, МБ/с
+    double throughputMBps() const;
+
+    // Человекочитаемый отчёт
+    std::string toString() const;
+};
+
+// Процессорное время текущего потока, мс
+double threadCpuTimeMs();
+
+// Замер этапа: время стены и процессорное время текущего потока.
+// При stats == nullptr ничего не делает.
+class StageTimer {
+private:
+    StageTiming* m_target;
+    std::chrono::steady_clock::time_point m_wallStart;
+    double m_cpuStart;
+
+public:
+    explicit StageTimer(StageTiming* target)
+        : m_target(target), m_cpuStart(0.0) {
+        if (m_target) {
+            m_wallStart = std::chrono::steady_clock::now();
+            m_cpuStart = threadCpuTimeMs();
+        }
+    }
+
+    ~StageTimer() { stop(); }
+
+    StageTimer(const StageTimer&) = delete;
+    StageTimer& operator=(const StageTimer&) = delete;
+
+    // Завершить замер досрочно (повторный вызов ничего не делает)
+    void stop() {
+        if (!m_target) return;
+        m_target->wallMs += std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - m_wallStart).count();
+        m_target->cpuMs += threadCpuTimeMs() - m_cpuStart;
+        m_target->calls++;
+        m_target = nullptr;
+    }
+};
+
+} // namespace json
+
+#endif // PARSE_STATS_HPP
@@ -3,6 +3,7 @@
 
 #include "JsonValue.hpp"
 #include "Lexer.hpp"
+#include "ParseStats.hpp"
 #include <string>
 #include <vector>
 #include <functional>
@@ -24,13 +25,42 @@ public:
 // Колбэк для отчета о прогрессе (текущая позиция, общий размер)
 using ProgressCallback = std::function<void(size_t, size_t)>;
 
-// Класс парсера JSON методом рекурсивного спуска
+// Режим обработки чисел
+enum class NumberMode {
+    Eager,      // Преобразование в double при разборе
+    Lazy        // Хранение исходной записи (JsonRawNumber), преобразование при чтении
+};
+
+// Класс парсера JSON. Разбор итеративный: открытые объекты и массивы
+// хранятся на явном стеке, поэтому глубина вложенности ограничена
+// настройкой maxDepth, а не размером стека потока.
 class Parser {
+public:
+    // Глубина вложенности по умолчанию (как у CborReader)
+    static constexpr size_t DEFAULT_MAX_DEPTH = 1000;
+
 private:
+    // Открытый контейнер на стеке разбора
+    struct Frame {
+        bool isObject = false;
+        JsonObject object;
+        JsonArray array;
+        std::string key;        // Ключ, ожидающий значения (для объекта)
+        size_t openOffset = 0;  // Смещение открывающей скобки (для участков)
+    };
+
+    static constexpr size_t INITIAL_STACK_CAPACITY = 32;
+
     std::vector<Token> m_tokens;
     size_t m_current;
     ProgressCallback m_progressCallback;
     size_t m_totalTokens;
+    size_t m_valueCount;    // Количество разобранных значений
+    NumberMode m_numberMode;
+    size_t m_maxDepth;
+    std::vector<Frame> m_stack;     // Переиспользуется между вызовами parse()
+    uint32_t m_spanSource;          // Источник участков контейнеров, 0 - не записывать
+    uint64_t m_spanBase;            // Смещение входа лексера в исходном файле
 
     // Получить текущий токен
     const Token& current() const;
@@ -50,10 +80,16 @@ private:
     // Проверить, достигнут ли конец
     bool isAtEnd() const;
 
-    // Рекурсивные функции разбора
+    // Разбор значения любой вложенности (без рекурсии)
     JsonValue parseValue();
-    JsonValue parseObject();
-    JsonValue parseArray();
+
+    // Записать участок закрытого контейнера (текущий токен - его скобка)
+    void recordSpan(const JsonValue& container, size_t openOffset) const;
+
+    // Ключ объекта и двоеточие после него
+    void parseKey(Frame& frame);
+
+    // Разбор скалярных значений
     JsonValue parseString();
     JsonValue parseNumber();
     JsonValue parseBool();
@@ -69,23 +105,51 @@ public:
     // Установить колбэк для прогресса
     void setProgressCallback(ProgressCallback callback);
 
+    // Режим обработки чисел (по умолчанию Eager)
+    void setNumberMode(NumberMode mode) { m_numberMode = mode; }
+
+    // Максимальная глубина вложенности; при превышении parse() бросает
+    // ParserException. Освобождение и обход дерева остаются рекурсивными,
+    // поэтому без необходимости лимит лучше не поднимать.
+    void setMaxDepth(size_t depth) { m_maxDepth = depth; }
+    size_t maxDepth() const { return m_maxDepth; }
+
+    // Записывать в массивы и объекты участок исходного текста
+    // (SourceSpan с источником sourceId; baseOffset - смещение разбираемого
+    // текста в файле). Нужно для Serializer::saveIncremental.
+    void setSourceSpans(uint32_t sourceId, uint64_t baseOffset = 0) {
+        m_spanSource = sourceId;
+        m_spanBase = baseOffset;
+    }
+
     // Основной метод парсинга
     JsonValue parse();
 
+    // Количество значений, построенных последним parse()
+    size_t valueCount() const { return m_valueCount; }
+
     // Статический метод для парсинга строки
-    static JsonValue parseString(const std::string& jsonStr);
+    // (stats - необязательная статистика по этапам)
+    static JsonValue parseString(const std::string& jsonStr, ParseStats* stats = nullptr);
+    static JsonValue parseString(const std::string& jsonStr, NumberMode mode, ParseStats* stats = nullptr);
 
     // Статический метод для парсинга файла
-    static JsonValue parseFile(const std::string& filename);
+    static JsonValue parseFile(const std::string& filename, ParseStats* stats = nullptr);
+    static JsonValue parseFile(const std::string& filename, NumberMode mode, ParseStats* stats = nullptr);
 
     // Статический метод для парсинга файла с прогресс-баром
     static JsonValue parseFileWithProgress(const std::string& filename, ProgressCallback callback = nullptr);
 
     // Многопоточный парсинг JSON массива из файла
     static JsonValue parseFileParallel(const std::string& filename, unsigned int threadCount = 0,
-                                       ProgressCallback callback = nullptr);
+                                       ProgressCallback callback = nullptr,
+                                       ParseStats* stats = nullptr);
 
 private:
+    // Токенизация и разбор готового текста (без учёта общего времени)
+    static JsonValue parseContent(const std::string& content, ParseStats* stats,
+                                  NumberMode mode = NumberMode::Eager);
+
     // Вспомогательные методы для параллельного парсинга
     static std::vector<std::pair<size_t, size_t>> splitContentIntoChunks(
         const std::string& content, size_t threadCount);
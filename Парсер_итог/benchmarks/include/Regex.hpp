@@ -0,0 +1,66 @@
+#ifndef REGEX_HPP
+#define REGEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace json {
+
+// Регулярное выражение ECMAScript для pattern/patternProperties.
+//
+// Выражение компилируется в НКА Томпсона и ищется одновременным обходом
+// всех состояний: время O(длина строки * размер выражения), стек не
+// зависит от входа (std::regex из libstdc++ рекурсивен по символам и
+// падает на строках в сотни тысяч символов). Символы - кодовые точки
+// UTF-8, как в ECMAScript, а не байты.
+//
+// Поддерживаются литералы и экранирование, ".", классы [...] с
+// диапазонами и отрицанием, \d \D \w \W \s \S, группы (...), (?:...) и
+// (?<имя>...), альтернатива, квантификаторы * + ? {n} {n,} {n,m} (в том
+// числе ленивые), ^ $ \b \B. Обратные ссылки, просмотр вперёд/назад и
+// \p{...} проверяются std::regex, но только для строк не длиннее
+// FALLBACK_MAX_LENGTH байт.
+class Regex {
+public:
+    static constexpr size_t FALLBACK_MAX_LENGTH = 4096;
+
+    // Класс символов: отсортированные непересекающиеся диапазоны
+    using Ranges = std::vector<std::pair<char32_t, char32_t>>;
+
+    enum class Op : uint8_t { Class, Split, Jump, LineStart, LineEnd, WordBoundary, NotWordBoundary, Match };
+
+    struct Instruction {
+        Op op;
+        uint32_t x = 0;     // Class - индекс класса, Split/Jump - переход
+        uint32_t y = 0;     // Split - второй переход
+    };
+
+private:
+    std::vector<Instruction> m_program;
+    std::vector<Ranges> m_classes;
+    bool m_anchored = false;                    // Начинается с ^: совпадение только с начала
+    std::shared_ptr<const std::regex> m_fallback;
+
+public:
+    // JsonException для некорректного выражения
+    explicit Regex(const std::string& pattern);
+
+    // Можно ли проверить строку такой длины (ограничение только у std::regex)
+    bool canSearch(size_t length) const { return !m_fallback || length <= FALLBACK_MAX_LENGTH; }
+
+    // Есть ли совпадение где-либо в строке
+    bool search(std::string_view text) const;
+
+    bool usesFallback() const { return m_fallback != nullptr; }
+    size_t programSize() const { return m_program.size(); }
+};
+
+} // namespace json
+
+#endif // REGEX_HPP
@@ -0,0 +1,81 @@
+#ifndef SCHEMA_VALIDATOR_HPP
+#define SCHEMA_VALIDATOR_HPP
+
+#include "JsonSchema.hpp"
+#include "ParseStats.hpp"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace json {
+
+// Нарушение схемы (или синтаксическая ошибка входа)
+struct SchemaError {
+    size_t line;
+    size_t column;
+    std::string path;       // JSON Pointer значения ("" - корень)
+    std::string message;
+
+    SchemaError(size_t l, size_t c, std::string p, std::string msg)
+        : line(l), column(c), path(std::move(p)), message(std::move(msg)) {}
+};
+
+struct SchemaResult {
+    bool isValid = true;
+    bool syntaxError = false;   // Вход - не JSON: ошибка последняя в errors, проверка прервана
+    std::vector<SchemaError> errors;
+    size_t valueCount = 0;      // Проверено значений
+    size_t chunkCount = 0;      // Порций параллельной проверки (1 - последовательно)
+};
+
+// Проверка JSON по скомпилированной схеме прямо по потоку токенов, без
+// построения дерева. Для каждого открытого контейнера хранятся только
+// активные проверки узлов схемы; значение целиком собирается лишь там,
+// где его требует схема (uniqueItems, enum/const с контейнерами).
+//
+// Большой массив верхнего уровня проверяется параллельно порциями по
+// границам элементов, как у TolerantParser, если корневая схема
+// раскладывается на независимые проверки элементов (нет anyOf/oneOf/not/
+// if и uniqueItems у корня). Ошибки и их порядок те же, что у
+// последовательной проверки.
+class SchemaValidator {
+public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 1024 * 1024;
+
+private:
+    std::shared_ptr<const JsonSchema> m_schema;
+    unsigned int m_threadCount;
+    size_t m_chunkSize;
+    size_t m_maxDepth;
+    bool m_stopOnFirstError;
+    bool m_splittable;          // Корень проверяется по элементам независимо
+
+    SchemaResult validateSequential(std::string_view content, ParseStats* stats) const;
+    SchemaResult validateParallel(std::string_view content, size_t begin, ParseStats* stats) const;
+
+public:
+    // threadCount = 0 - по числу ядер
+    explicit SchemaValidator(JsonSchema schema, unsigned int threadCount = 0);
+
+    void setThreadCount(unsigned int count);
+    void setChunkSize(size_t bytes) { m_chunkSize = bytes > 0 ? bytes : 1; }
+    void setMaxDepth(size_t depth) { m_maxDepth = depth; }
+    void setStopOnFirstError(bool stop) { m_stopOnFirstError = stop; }
+
+    const JsonSchema& schema() const { return *m_schema; }
+
+    // Проверка текста JSON
+    SchemaResult validate(std::string_view content, ParseStats* stats = nullptr) const;
+
+    // Проверка файла (gzip и zstd распаковываются). Последовательная
+    // проверка читает файл блоками и не держит его в памяти целиком.
+    SchemaResult validateFile(const std::string& filename, ParseStats* stats = nullptr) const;
+
+    // Проверка уже построенного значения (строки и столбцы ошибок - 0)
+    SchemaResult validateValue(const JsonValue& value) const;
+};
+
+} // namespace json
+
+#endif // SCHEMA_VALIDATOR_HPP
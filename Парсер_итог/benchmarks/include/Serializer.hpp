@@ -4,9 +4,37 @@
 #include "JsonValue.hpp"
 #include <string>
 #include <ostream>
+#include <cstdint>
 
 namespace json {
 
+// Исходный файл документа для инкрементального сохранения.
+// Контейнеры, разобранные из него с участками (Parser::setSourceSpans),
+// при сохранении копируются из файла байт в байт, пока не изменены.
+struct SourceFile {
+    // Форматирование файла. Участки копируются, только если сохранение
+    // с текущими опциями записало бы их байт в байт так же.
+    enum class Layout : uint8_t {
+        Unchecked,      // Ещё не проверено (проверяется при сохранении)
+        Other,          // Не совпадает ни с одним режимом Serializer
+        Compact,
+        Pretty,
+    };
+
+    std::string path;
+    uint32_t id = 0;            // Источник участков (SourceSpan::source)
+    uint64_t size = 0;
+    int64_t mtime = 0;
+    Layout layout = Layout::Unchecked;
+    int indentSize = 0;         // Для Layout::Pretty
+
+    // Запомнить размер и время изменения файла под новым идентификатором
+    static SourceFile capture(const std::string& path);
+
+    // Файл не менялся с момента capture()
+    bool unchanged() const;
+};
+
 // Класс для сериализации JSON в строку/файл
 class Serializer {
 public:
@@ -34,9 +62,22 @@ public:
         }
     };
 
+    // Статистика инкрементального сохранения
+    struct IncrementalStats {
+        uint64_t copiedBytes = 0;       // Скопировано из исходного файла
+        uint64_t serializedBytes = 0;   // Записано сериализатором
+        size_t copiedSpans = 0;         // Скопированных контейнеров
+    };
+
 private:
     Options m_options;
 
+    struct IncrementalWriter;
+
+    // Узел для инкрементального сохранения: неизменённый контейнер
+    // копируется из исходного файла, остальное сериализуется
+    void writeIncremental(const JsonValue& value, IncrementalWriter& writer, int depth) const;
+
     // Вспомогательные методы
     void serializeValue(const JsonValue& value, std::ostream& os, int depth) const;
     void serializeObject(const JsonObject& obj, std::ostream& os, int depth) const;
@@ -62,6 +103,20 @@ public:
     // Сохранение в файл
     bool saveToFile(const JsonValue& value, const std::string& filename) const;
 
+    // Сохранение с копированием неизменённых контейнеров из source.
+    // Изменённые узлы (и путь к ним от корня) сериализуются с текущими
+    // опциями, неизменённые копируются, если source отформатирован так
+    // же (prettyPrint и indentSize; см. SourceFile::layout). С sortKeys,
+    // escapeUnicode или другим форматированием документ сериализуется
+    // целиком, так что результат совпадает с saveToFile. Файл пишется
+    // во временный и переименовывается, поэтому filename может совпадать
+    // с source.path. После успеха source описывает новый файл, а участки
+    // узлов указывают в него - следующее сохранение тоже инкрементальное.
+    // Если source не задан или изменился на диске, документ
+    // сериализуется целиком.
+    bool saveIncremental(const JsonValue& value, SourceFile& source, const std::string& filename,
+                         IncrementalStats* stats = nullptr) const;
+
     // Статические методы для быстрой сериализации
     static std::string toString(const JsonValue& value, bool pretty = true);
     static bool toFile(const JsonValue& value, const std::string& filename, bool pretty = true);
@@ -3,6 +3,8 @@
 
 #include <string>
 #include <thread>
+#include <cstdio>
+#include <cstring>
 
 #ifdef __APPLE__
 #include <sys/sysctl.h>
@@ -0,0 +1,96 @@
+#ifndef TOLERANT_PARSER_HPP
+#define TOLERANT_PARSER_HPP
+
+#include "JsonValue.hpp"
+#include "Validator.hpp"
+#include "Parser.hpp"
+#include "ParseStats.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace json {
+
+class ForkJoinPool;
+
+// Результат толерантной загрузки
+struct TolerantResult {
+    JsonArray elements;                     // Корректные элементы в порядке файла
+    std::vector<ValidationError> errors;    // Строка, столбец и контекст ошибок
+    size_t elementCount = 0;                // Корректных элементов (и без setKeepElements)
+    size_t skippedElements = 0;             // Элементов отброшено из-за ошибок
+    size_t chunkCount = 0;                  // Порций, разобранных независимо
+    bool isArray = false;                   // Вход - массив, а не последовательность значений
+};
+
+// Загрузка повреждённого JSON: корректные элементы верхнего уровня
+// сохраняются, ошибочные пропускаются со списком ошибок.
+//
+// Вход - массив элементов ("[...]") или последовательность значений
+// (JSON Lines и т.п.). Разбор идёт по байтам без исключений. После ошибки
+// элемент отбрасывается, а разбор восстанавливается, как в
+// Validator::synchronize, но с учётом открытых скобок: пропуск идёт до
+// запятой или ']' верхнего уровня (строки и вложенные скобки учитываются,
+// непарная закрывающая скобка закрывает всё до своей пары). Строки не
+// бывают многострочными, поэтому незакрытая строка заканчивается на
+// переводе строки. Кроме того, строка файла, которая начинается с '{' или
+// '[' на отступе элементов (отступ первого элемента), считается началом
+// нового элемента - так потерянная закрывающая скобка стоит одного
+// элемента, а не всего хвоста файла.
+//
+// Файл режется на порции примерно по chunkSize байт по строкам вида
+// ",\n<отступ элементов>{" и порции разбираются параллельно. Разбиение
+// зависит только от содержимого и chunkSize, поэтому результат не зависит
+// от числа потоков. Файл в одну строку (или с первым элементом на строке
+// '[') разбирается одной порцией.
+class TolerantParser {
+public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 1024 * 1024;
+
+private:
+    unsigned int m_threadCount;
+    size_t m_chunkSize;
+    size_t m_maxDepth;
+    uint32_t m_spanSource;          // 0 - участки не записываются
+    bool m_keepElements;
+    ProgressCallback m_progressCallback;
+
+    // pool = nullptr - свои потоки по m_threadCount
+    TolerantResult parseOn(std::string_view content, ForkJoinPool* pool, ParseStats* stats) const;
+
+public:
+    // threadCount = 0 - по числу ядер
+    explicit TolerantParser(unsigned int threadCount = 0);
+
+    void setThreadCount(unsigned int count);
+    unsigned int getThreadCount() const { return m_threadCount; }
+
+    void setChunkSize(size_t bytes) { m_chunkSize = bytes > 0 ? bytes : 1; }
+    void setMaxDepth(size_t depth) { m_maxDepth = depth; }
+
+    // Записывать участки контейнеров (смещения - от начала входа),
+    // см. Parser::setSourceSpans
+    void setSourceSpans(uint32_t sourceId) { m_spanSource = sourceId; }
+
+    // false - только проверка: элемент разбирается и сразу освобождается,
+    // elements остаётся пустым, память не растёт с размером входа
+    void setKeepElements(bool keep) { m_keepElements = keep; }
+
+    // Прогресс (байт разобрано, всего); вызывается после каждой порции
+    // из рабочих потоков, но не одновременно
+    void setProgressCallback(ProgressCallback callback) { m_progressCallback = std::move(callback); }
+
+    TolerantResult parse(std::string_view content, ParseStats* stats = nullptr) const;
+
+    // Порции разбираются задачами общего пула (threadCount не используется).
+    // Можно вызывать из задачи этого же пула: ожидание выполняет чужие задачи.
+    TolerantResult parse(std::string_view content, ForkJoinPool& pool, ParseStats* stats = nullptr) const;
+
+    // Файл отображается в память; JsonException, если его не открыть
+    TolerantResult parseFile(const std::string& filename, ParseStats* stats = nullptr) const;
+};
+
+} // namespace json
+
+#endif // TOLERANT_PARSER_HPP
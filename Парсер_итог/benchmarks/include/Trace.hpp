@@ -0,0 +1,90 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <string>
+#include <chrono>
+#include <atomic>
+
+namespace json {
+namespace trace {
+
+// Трассировка в формате Chrome Trace Event (chrome://tracing, ui.perfetto.dev).
+// Макросы JSON_TRACE_* компилируются только при ENABLE_PROFILING; без него
+// в коде не остаётся ни одной инструкции. При включённой сборке, но
+// выключенной записи, стоимость области - одна атомарная загрузка.
+
+namespace detail {
+extern std::atomic<bool> g_enabled;
+
+double nowMicros();
+void record(const char* name, double startUs, double endUs);
+} // namespace detail
+
+// Начать запись (очищает ранее записанные события)
+void start();
+
+// Остановить запись (события сохраняются до следующего start)
+void stop();
+
+inline bool isEnabled() {
+    return detail::g_enabled.load(std::memory_order_relaxed);
+}
+
+// Имя текущего потока на временной шкале. Буфер потока при этом не
+// создаётся: имя запоминается до первого события.
+void setThreadName(const std::string& name);
+
+// Буферов потоков в реестре: живые потоки с событиями и завершённые,
+// чьи события ещё не сброшены следующим start()
+size_t threadBufferCount();
+
+// Количество записанных событий
+size_t eventCount();
+
+// Записать события в файл JSON; false при ошибке записи
+bool writeChromeTrace(const std::string& filename);
+
+// Область трассировки: событие длительностью от конструктора до деструктора.
+// name должен жить до записи файла (обычно строковый литерал).
+class Scope {
+private:
+    const char* m_name;
+    double m_start;
+
+public:
+    explicit Scope(const char* name) : m_name(nullptr), m_start(0.0) {
+        if (isEnabled()) {
+            m_name = name;
+            m_start = detail::nowMicros();
+        }
+    }
+
+    ~Scope() {
+        if (m_name) {
+            detail::record(m_name, m_start, detail::nowMicros());
+        }
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+};
+
+} // namespace trace
+} // namespace json
+
+#define JSON_TRACE_CONCAT_INNER(a, b) a##b
+#define JSON_TRACE_CONCAT(a, b) JSON_TRACE_CONCAT_INNER(a, b)
+
+#ifdef ENABLE_PROFILING
+#define JSON_TRACE_SCOPE(name) \
+    ::json::trace::Scope JSON_TRACE_CONCAT(jsonTraceScope_, __LINE__)(name)
+#define JSON_TRACE_THREAD_NAME(name) \
+    do { \
+        if (::json::trace::isEnabled()) ::json::trace::setThreadName(name); \
+    } while (false)
+#else
+#define JSON_TRACE_SCOPE(name) ((void)0)
+#define JSON_TRACE_THREAD_NAME(name) ((void)0)
+#endif
+
+#endif // TRACE_HPP
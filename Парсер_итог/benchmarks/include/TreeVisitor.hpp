@@ -0,0 +1,249 @@
+#ifndef TREE_VISITOR_HPP
+#define TREE_VISITOR_HPP
+
+#include "JsonValue.hpp"
+#include "ForkJoinPool.hpp"
+#include <algorithm>
+#include <vector>
+#include <exception>
+#include <memory>
+#include <iterator>
+#include <utility>
+
+namespace json {
+
+class CachedValue;
+
+// Параллельный обход дерева JsonValue (fork-join).
+// Массивы и объекты размером от grainSize делятся на порции по grainSize
+// детей, порции обходятся параллельно; меньшие контейнеры обходятся в
+// потоке родителя. Дерево только читается, поэтому обход безопасен для
+// общих (copy-on-write) узлов.
+class TreeVisitor {
+public:
+    static constexpr size_t DEFAULT_GRAIN_SIZE = 2048;
+
+private:
+    unsigned int m_threadCount;
+    size_t m_grainSize;
+    std::unique_ptr<ForkJoinPool> m_pool;   // nullptr - один поток
+
+    // Начала порций по grainSize детей и конец диапазона
+    template<typename Iterator>
+    std::vector<Iterator> chunkBounds(Iterator begin, Iterator end) const {
+        std::vector<Iterator> bounds;
+        size_t index = 0;
+        for (auto it = begin; it != end; ++it, ++index) {
+            if (index % m_grainSize == 0) bounds.push_back(it);
+        }
+        bounds.push_back(end);
+        return bounds;
+    }
+
+    bool splits(size_t size) const { return m_pool && size >= m_grainSize; }
+
+    // Выполнить свою порцию и дождаться остальных. Ждать нужно и при
+    // исключении: задачи группы ссылаются на данные этого кадра стека.
+    template<typename Work>
+    void runThenWait(ForkJoinPool::Group& group, Work work) const {
+        std::exception_ptr error;
+        try {
+            work();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        m_pool->wait(group);
+        if (error) std::rethrow_exception(error);
+    }
+
+    template<typename Reducer, typename Visit>
+    void reduceNode(const JsonValue& value, size_t depth, Reducer& acc, Visit& visit) const;
+
+    template<typename Reducer, typename Visit, typename Iterator, typename Child>
+    void reduceChildren(Iterator begin, Iterator end, size_t size, size_t depth,
+                        Reducer& acc, Visit& visit, Child child) const;
+
+    template<typename Fn>
+    JsonValue transformNode(const JsonValue& value, size_t depth, Fn& fn) const;
+
+public:
+    // threads = 0 - по числу ядер
+    explicit TreeVisitor(unsigned int threads = 0, size_t grainSize = DEFAULT_GRAIN_SIZE);
+    ~TreeVisitor();
+
+    unsigned int threadCount() const { return m_threadCount; }
+    size_t grainSize() const { return m_grainSize; }
+
+    // Свёртка по всем узлам (прямой порядок).
+    // visit(Reducer& acc, const JsonValue& value, size_t depth) вызывается
+    // для каждого узла, одновременно из нескольких потоков (со своим acc
+    // у каждой порции). Результаты порций сливаются acc.merge(part) в
+    // порядке детей, так что merge достаточно быть ассоциативным.
+    // Reducer должен конструироваться по умолчанию.
+    template<typename Reducer, typename Visit>
+    Reducer reduce(const JsonValue& root, Visit visit) const {
+        Reducer acc;
+        reduceNode(root, 0, acc, visit);
+        return acc;
+    }
+
+    // Новое дерево снизу вверх: fn(JsonValue value, size_t depth) получает
+    // узел с уже преобразованными детьми и возвращает замену. Дети больших
+    // контейнеров преобразуются параллельно (fn вызывается из нескольких
+    // потоков); исходное дерево не меняется.
+    template<typename Fn>
+    JsonValue transform(const JsonValue& root, Fn fn) const {
+        return transformNode(root, 0, fn);
+    }
+};
+
+// Статистика документа (пункты меню "Статистика" и "Метрики")
+struct TreeStats {
+    size_t objects = 0;
+    size_t arrays = 0;
+    size_t strings = 0;
+    size_t numbers = 0;
+    size_t bools = 0;
+    size_t nulls = 0;
+    size_t keys = 0;
+    size_t stringBytes = 0;     // Байт в строковых значениях и ключах
+    size_t maxDepth = 0;        // Корень - глубина 0
+
+    size_t total() const { return objects + arrays + strings + numbers + bools + nulls; }
+
+    void merge(const TreeStats& other);
+
+    static TreeStats collect(const JsonValue& root, const TreeVisitor& visitor);
+
+    // То же по отображённому кэшу, без построения JsonValue (в одном потоке)
+    static TreeStats collect(const CachedValue& root);
+};
+
+// ============================================================================
+// Реализация шаблонов
+// ============================================================================
+
+template<typename Reducer, typename Visit, typename Iterator, typename Child>
+void TreeVisitor::reduceChildren(Iterator begin, Iterator end, size_t size, size_t depth,
+                                 Reducer& acc, Visit& visit, Child child) const {
+    if (!splits(size)) {
+        for (auto it = begin; it != end; ++it) {
+            reduceNode(child(it), depth, acc, visit);
+        }
+        return;
+    }
+
+    // Первая порция обходится в текущем потоке прямо в acc
+    std::vector<Iterator> bounds = chunkBounds(begin, end);
+
+    std::vector<Reducer> parts(bounds.size() - 2);
+    ForkJoinPool::Group group;
+    for (size_t part = 1; part + 1 < bounds.size(); ++part) {
+        Iterator from = bounds[part];
+        Iterator to = bounds[part + 1];
+        Reducer* target = &parts[part - 1];
+        m_pool->spawn(group, [this, from, to, depth, target, &visit, child]() {
+            for (auto it = from; it != to; ++it) {
+                reduceNode(child(it), depth, *target, visit);
+            }
+        });
+    }
+    runThenWait(group, [&]() {
+        for (auto it = bounds[0]; it != bounds[1]; ++it) {
+            reduceNode(child(it), depth, acc, visit);
+        }
+    });
+
+    for (const Reducer& part : parts) {
+        acc.merge(part);
+    }
+}
+
+template<typename Reducer, typename Visit>
+void TreeVisitor::reduceNode(const JsonValue& value, size_t depth, Reducer& acc, Visit& visit) const {
+    visit(acc, value, depth);
+    if (value.isArray()) {
+        const JsonArray& arr = value.asArray();
+        reduceChildren(arr.begin(), arr.end(), arr.size(), depth + 1, acc, visit,
+                       [](JsonArray::const_iterator it) -> const JsonValue& { return *it; });
+    } else if (value.isObject()) {
+        const JsonObject& obj = value.asObject();
+        reduceChildren(obj.begin(), obj.end(), obj.size(), depth + 1, acc, visit,
+                       [](JsonObject::const_iterator it) -> const JsonValue& { return it->second; });
+    }
+}
+
+template<typename Fn>
+JsonValue TreeVisitor::transformNode(const JsonValue& value, size_t depth, Fn& fn) const {
+    if (value.isArray()) {
+        const JsonArray& arr = value.asArray();
+        JsonArray result(arr.size());
+        if (!splits(arr.size())) {
+            for (size_t i = 0; i < arr.size(); ++i) {
+                result[i] = transformNode(arr[i], depth + 1, fn);
+            }
+        } else {
+            // Каждая порция пишет в свой диапазон result
+            ForkJoinPool::Group group;
+            for (size_t begin = m_grainSize; begin < arr.size(); begin += m_grainSize) {
+                size_t end = std::min(begin + m_grainSize, arr.size());
+                m_pool->spawn(group, [this, &arr, &result, begin, end, depth, &fn]() {
+                    for (size_t i = begin; i < end; ++i) {
+                        result[i] = transformNode(arr[i], depth + 1, fn);
+                    }
+                });
+            }
+            runThenWait(group, [&]() {
+                for (size_t i = 0; i < m_grainSize; ++i) {
+                    result[i] = transformNode(arr[i], depth + 1, fn);
+                }
+            });
+        }
+        return fn(JsonValue(std::move(result)), depth);
+    }
+
+    if (value.isObject()) {
+        const JsonObject& obj = value.asObject();
+        JsonObject result;
+        if (!splits(obj.size())) {
+            for (const auto& [key, item] : obj) {
+                result.emplace_hint(result.end(), key, transformNode(item, depth + 1, fn));
+            }
+        } else {
+            auto bounds = chunkBounds(obj.begin(), obj.end());
+            std::vector<JsonArray> parts(bounds.size() - 1);
+            ForkJoinPool::Group group;
+            for (size_t part = 1; part + 1 < bounds.size(); ++part) {
+                auto from = bounds[part];
+                auto to = bounds[part + 1];
+                JsonArray* target = &parts[part];
+                m_pool->spawn(group, [this, from, to, target, depth, &fn]() {
+                    for (auto it = from; it != to; ++it) {
+                        target->push_back(transformNode(it->second, depth + 1, fn));
+                    }
+                });
+            }
+            runThenWait(group, [&]() {
+                for (auto it = bounds[0]; it != bounds[1]; ++it) {
+                    parts[0].push_back(transformNode(it->second, depth + 1, fn));
+                }
+            });
+
+            // Ключи уже упорядочены: вставка в конец с подсказкой - O(1)
+            auto key = obj.begin();
+            for (auto& part : parts) {
+                for (auto& item : part) {
+                    result.emplace_hint(result.end(), key->first, std::move(item));
+                    ++key;
+                }
+            }
+        }
+        return fn(JsonValue(std::move(result)), depth);
+    }
+
+    return fn(JsonValue(value), depth);
+}
+
+} // namespace json
+
+#endif // TREE_VISITOR_HPP
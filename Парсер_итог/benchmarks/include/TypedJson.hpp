@@ -0,0 +1,396 @@
+#ifndef TYPED_JSON_HPP
+#define TYPED_JSON_HPP
+
+#include "JsonValue.hpp"
+#include "JsonWriter.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <limits>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+namespace json {
+
+// Типизированный разбор JSON прямо в структуры C++, без построения JsonValue.
+//
+// Поля структуры описываются один раз:
+//
+//     struct User { int id; std::string name; std::string email; };
+//     JSON_FIELDS(User, id, name, email)
+//
+// после чего доступны json::read<User>(text), json::read<std::vector<User>>(text)
+// и json::write(user). Макрос ставится в том же пространстве имён, что и
+// структура. Поддерживаются bool, целые и дробные числа, std::string,
+// std::optional, std::vector, std::map<std::string, T>, JsonValue и вложенные
+// описанные структуры. Неизвестные ключи пропускаются, отсутствие
+// обязательного (не optional) поля - ошибка.
+
+// Описание поля: имя ключа и указатель на член
+template<typename Class, typename Member>
+struct Field {
+    std::string_view name;
+    Member Class::* member;
+};
+
+template<typename Class, typename Member>
+constexpr Field<Class, Member> field(std::string_view name, Member Class::* member) {
+    return Field<Class, Member>{name, member};
+}
+
+// Потоковое чтение JSON-текста без токенов и дерева.
+// Ошибки сообщаются через ParserException со строкой и столбцом.
+class TypedReader {
+private:
+    std::string_view m_input;
+    size_t m_pos;
+
+    void skipWhitespace() {
+        while (m_pos < m_input.size()) {
+            char c = m_input[m_pos];
+            if (c != ' ' && c != '\n' && c != '\r' && c != '\t') break;
+            ++m_pos;
+        }
+    }
+
+    void readEscaped(std::string& out);
+    void readLiteral(std::string_view literal);
+
+public:
+    explicit TypedReader(std::string_view input) : m_input(input), m_pos(0) {}
+
+    [[noreturn]] void fail(const std::string& message) const;
+
+    // Следующий значимый символ ('\0' в конце входа)
+    char peek() {
+        skipWhitespace();
+        return m_pos < m_input.size() ? m_input[m_pos] : '\0';
+    }
+
+    // Пропустить символ c, если он следующий
+    bool consume(char c) {
+        if (peek() != c) return false;
+        ++m_pos;
+        return true;
+    }
+
+    void expect(char c);
+
+    // Строка (с обработкой escape-последовательностей)
+    void readString(std::string& out);
+
+    // Ключ объекта: ссылка во вход, если в нём нет escape, иначе scratch
+    std::string_view readKey(std::string& scratch);
+
+    // Лексема числа по грамматике JSON
+    std::string_view readNumberToken();
+    double readDouble();
+
+    template<typename Int>
+    Int readInteger() {
+        std::string_view token = readNumberToken();
+        Int value{};
+        auto result = std::from_chars(token.data(), token.data() + token.size(), value);
+        if (result.ec == std::errc() && result.ptr == token.data() + token.size()) {
+            return value;
+        }
+        if (result.ec == std::errc::result_out_of_range) {
+            fail("Число вне диапазона типа: " + std::string(token));
+        }
+
+        // Дробная запись целого ("5.0", "1e3")
+        double number = 0.0;
+        auto fallback = std::from_chars(token.data(), token.data() + token.size(), number);
+        if (fallback.ec != std::errc() || fallback.ptr != token.data() + token.size()) {
+            fail("Число вне диапазона типа: " + std::string(token));
+        }
+        if (std::trunc(number) != number ||
+            number < static_cast<double>(std::numeric_limits<Int>::lowest()) ||
+            number >= static_cast<double>(std::numeric_limits<Int>::max()) + 1.0) {
+            fail("Ожидалось целое число: " + std::string(token));
+        }
+        return static_cast<Int>(number);
+    }
+
+    bool readBool();
+
+    // Прочитать null, если он следующий
+    bool readNull();
+
+    // Пропустить значение любого типа
+    void skipValue();
+
+    // Разобрать следующее значение в JsonValue
+    JsonValue readValue();
+
+    // Проверить, что после значения остались только пробелы
+    void finish();
+
+    size_t position() const { return m_pos; }
+};
+
+// Привязка типа к JSON: read(TypedReader&, T&) и write(JsonWriter&, const T&).
+// Для собственных типов можно объявить специализацию.
+template<typename T, typename Enable = void>
+struct JsonBinding;
+
+// Есть ли у типа описание полей (JSON_FIELDS)
+template<typename T, typename = void>
+struct HasJsonFields : std::false_type {};
+
+template<typename T>
+struct HasJsonFields<T, std::void_t<decltype(jsonFields(static_cast<const T*>(nullptr)))>>
+    : std::true_type {};
+
+template<typename T>
+struct IsOptional : std::false_type {};
+
+template<typename T>
+struct IsOptional<std::optional<T>> : std::true_type {};
+
+template<>
+struct JsonBinding<bool> {
+    static void read(TypedReader& reader, bool& out) { out = reader.readBool(); }
+    static void write(JsonWriter& writer, bool value) { writer.value(value); }
+};
+
+template<typename T>
+struct JsonBinding<T, std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value>> {
+    static void read(TypedReader& reader, T& out) { out = reader.readInteger<T>(); }
+    static void write(JsonWriter& writer, T value) { writer.value(value); }
+};
+
+template<typename T>
+struct JsonBinding<T, std::enable_if_t<std::is_floating_point<T>::value>> {
+    static void read(TypedReader& reader, T& out) { out = static_cast<T>(reader.readDouble()); }
+    static void write(JsonWriter& writer, T value) { writer.value(static_cast<double>(value)); }
+};
+
+template<>
+struct JsonBinding<std::string> {
+    static void read(TypedReader& reader, std::string& out) { reader.readString(out); }
+    static void write(JsonWriter& writer, const std::string& value) { writer.value(value); }
+};
+
+template<>
+struct JsonBinding<JsonValue> {
+    static void read(TypedReader& reader, JsonValue& out) { out = reader.readValue(); }
+    static void write(JsonWriter& writer, const JsonValue& value) { writer.value(value); }
+};
+
+template<typename T>
+struct JsonBinding<std::optional<T>> {
+    static void read(TypedReader& reader, std::optional<T>& out) {
+        if (reader.readNull()) {
+            out.reset();
+            return;
+        }
+        out.emplace();
+        JsonBinding<T>::read(reader, *out);
+    }
+
+    static void write(JsonWriter& writer, const std::optional<T>& value) {
+        if (value) {
+            JsonBinding<T>::write(writer, *value);
+        } else {
+            writer.null();
+        }
+    }
+};
+
+template<typename T, typename Alloc>
+struct JsonBinding<std::vector<T, Alloc>> {
+    static void read(TypedReader& reader, std::vector<T, Alloc>& out) {
+        out.clear();
+        reader.expect('[');
+        if (reader.consume(']')) return;
+        do {
+            out.emplace_back();
+            JsonBinding<T>::read(reader, out.back());
+        } while (reader.consume(','));
+        reader.expect(']');
+    }
+
+    static void write(JsonWriter& writer, const std::vector<T, Alloc>& value) {
+        writer.beginArray();
+        for (const auto& item : value) {
+            JsonBinding<T>::write(writer, item);
+        }
+        writer.endArray();
+    }
+};
+
+template<typename T, typename Compare, typename Alloc>
+struct JsonBinding<std::map<std::string, T, Compare, Alloc>> {
+    static void read(TypedReader& reader, std::map<std::string, T, Compare, Alloc>& out) {
+        out.clear();
+        reader.expect('{');
+        if (reader.consume('}')) return;
+        std::string key;
+        do {
+            reader.readString(key);
+            reader.expect(':');
+            JsonBinding<T>::read(reader, out[key]);
+            key.clear();
+        } while (reader.consume(','));
+        reader.expect('}');
+    }
+
+    static void write(JsonWriter& writer, const std::map<std::string, T, Compare, Alloc>& value) {
+        writer.beginObject();
+        for (const auto& [key, item] : value) {
+            writer.key(key);
+            JsonBinding<T>::write(writer, item);
+        }
+        writer.endObject();
+    }
+};
+
+// Структуры с описанием полей
+template<typename T>
+struct JsonBinding<T, std::enable_if_t<HasJsonFields<T>::value>> {
+private:
+    static constexpr auto fields() { return jsonFields(static_cast<const T*>(nullptr)); }
+    static constexpr size_t FIELD_COUNT = std::tuple_size<decltype(fields())>::value;
+
+    static_assert(FIELD_COUNT <= 64, "JSON_FIELDS: не более 64 полей");
+
+    template<typename F>
+    using MemberType = std::remove_reference_t<decltype(std::declval<T&>().*(std::declval<F>().member))>;
+
+    // Сравнение ключа с именами полей разворачивается при компиляции
+    template<size_t... I>
+    static bool readField(TypedReader& reader, T& out, std::string_view key,
+                          uint64_t& seen, std::index_sequence<I...>) {
+        constexpr auto list = fields();
+        return (... || (key == std::get<I>(list).name &&
+                        (readMember(reader, out, std::get<I>(list)), seen |= (uint64_t(1) << I), true)));
+    }
+
+    template<typename F>
+    static void readMember(TypedReader& reader, T& out, const F& f) {
+        JsonBinding<MemberType<F>>::read(reader, out.*(f.member));
+    }
+
+    template<size_t... I>
+    static void checkRequired(TypedReader& reader, uint64_t seen, std::index_sequence<I...>) {
+        constexpr auto list = fields();
+        (..., ((!IsOptional<MemberType<std::tuple_element_t<I, decltype(list)>>>::value &&
+                !(seen & (uint64_t(1) << I)))
+               ? reader.fail("Отсутствует обязательное поле: " + std::string(std::get<I>(list).name))
+               : void()));
+    }
+
+    template<size_t... I>
+    static void writeFields(JsonWriter& writer, const T& value, std::index_sequence<I...>) {
+        constexpr auto list = fields();
+        (..., (writer.key(std::get<I>(list).name),
+               JsonBinding<MemberType<std::tuple_element_t<I, decltype(list)>>>::write(
+                   writer, value.*(std::get<I>(list).member))));
+    }
+
+public:
+    static void read(TypedReader& reader, T& out) {
+        using Indices = std::make_index_sequence<FIELD_COUNT>;
+        uint64_t seen = 0;
+        std::string scratch;
+
+        reader.expect('{');
+        if (!reader.consume('}')) {
+            do {
+                std::string_view key = reader.readKey(scratch);
+                reader.expect(':');
+                if (!readField(reader, out, key, seen, Indices{})) {
+                    reader.skipValue();
+                }
+            } while (reader.consume(','));
+            reader.expect('}');
+        }
+
+        checkRequired(reader, seen, Indices{});
+    }
+
+    static void write(JsonWriter& writer, const T& value) {
+        writer.beginObject();
+        writeFields(writer, value, std::make_index_sequence<FIELD_COUNT>{});
+        writer.endObject();
+    }
+};
+
+// Чтение файла целиком (для readFile); .gz и .zst распаковываются
+std::string readFileContent(const std::string& filename);
+
+// Разобрать JSON-текст в значение типа T
+template<typename T>
+void read(std::string_view input, T& out) {
+    TypedReader reader(input);
+    JsonBinding<T>::read(reader, out);
+    reader.finish();
+}
+
+template<typename T>
+T read(std::string_view input) {
+    T out{};
+    read(input, out);
+    return out;
+}
+
+template<typename T>
+T readFile(const std::string& filename) {
+    return read<T>(readFileContent(filename));
+}
+
+// Записать значение типа T
+template<typename T>
+void write(JsonWriter& writer, const T& value) {
+    JsonBinding<T>::write(writer, value);
+}
+
+template<typename T>
+std::string write(const T& value, bool pretty = false) {
+    std::string out;
+    JsonWriter writer(out, pretty ? JsonWriter::Options::pretty() : JsonWriter::Options::compact());
+    JsonBinding<T>::write(writer, value);
+    return out;
+}
+
+} // namespace json
+
+// Описание полей структуры (до 16 полей; для большего числа объявите
+// функцию jsonFields вручную через json::field)
+#define JSON_FIELDS_EXPAND(x) x
+#define JSON_FIELDS_ENTRY(Type, name) ::json::field(#name, &Type::name)
+#define JSON_FIELDS_1(Type, a) JSON_FIELDS_ENTRY(Type, a)
+#define JSON_FIELDS_2(Type, a, ...) JSON_FIELDS_ENTRY(Type, a), JSON_FIELDS_EXPAND(JSON_FIELDS_1(Type, __VA_ARGS__))
+#define JSON_FIELDS_3(Type, a, ...) JSON_FIELDS_ENTRY(Type, a), JSON_FIELDS_EXPAND(JSON_FIELDS_2(Type, __VA_ARGS__))
+#define JSON_FIELDS_4(Type, a, ...) JSON_FIELDS_ENTRY(Type, a), JSON_FIELDS_EXPAND(JSON_FIELDS_3(Type, __VA_ARGS__))
+#define JSON_FIELDS_5(Type, a, ...) JSON_FIELDS_ENTRY(Type, a), JSON_FIELDS_EXPAND(JSON_FIELDS_4(Type, __VA_ARGS__))
+#define JSON_FIELDS_6(Type, a, ...) JSON_FIELDS_ENTRY(Type, a), JSON_FIELDS_EXPAND(JSON_FIELDS_5(Type, __VA_ARGS__))
+#define JSON_FIELDS_7(Type, a, ...) JSON_FIELDS_ENTRY(Type, a), JSON_FIELDS_EXPAND(JSON_FIELDS_6(Type, __VA_ARGS__))
+#define JSON_FIELDS_8(Type, a, ...) JSON_FIELDS_ENTRY(Type, a), JSON_FIELDS_EXPAND(JSON_FIELDS_7(Type, __VA_ARGS__))
+#define JSON_FIELDS_9(Type, a, ...) JSON_FIELDS_ENTRY(Type, a), JSON_FIELDS_EXPAND(JSON_FIELDS_8(Type, __VA_ARGS__))
+#define JSON_FIELDS_10(Type, a, ...) JSON_FIELDS_ENTRY(Type, a), JSON_FIELDS_EXPAND(JSON_FIELDS_9(Type, __VA_ARGS__))
+#define JSON_FIELDS_11(Type, a, ...) JSON_FIELDS_ENTRY(Type, a), JSON_FIELDS_EXPAND(JSON_FIELDS_10(Type, __VA_ARGS__))
+#define JSON_FIELDS_12(Type, a, ...) JSON_FIELDS_ENTRY(Type, a), JSON_FIELDS_EXPAND(JSON_FIELDS_11(Type, __VA_ARGS__))
+#define JSON_FIELDS_13(Type, a, ...) JSON_FIELDS_ENTRY(Type, a), JSON_FIELDS_EXPAND(JSON_FIELDS_12(Type, __VA_ARGS__))
+#define JSON_FIELDS_14(Type, a, ...) JSON_FIELDS_ENTRY(Type, a), JSON_FIELDS_EXPAND(JSON_FIELDS_13(Type, __VA_ARGS__))
+#define JSON_FIELDS_15(Type, a, ...) JSON_FIELDS_ENTRY(Type, a), JSON_FIELDS_EXPAND(JSON_FIELDS_14(Type, __VA_ARGS__))
+#define JSON_FIELDS_16(Type, a, ...) JSON_FIELDS_ENTRY(Type, a), JSON_FIELDS_EXPAND(JSON_FIELDS_15(Type, __VA_ARGS__))
+#define JSON_FIELDS_SELECT(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, NAME, ...) NAME
+
+#define JSON_FIELDS(Type, ...)                                                      \
+    constexpr auto jsonFields(const Type*) {                                        \
+        return std::make_tuple(JSON_FIELDS_EXPAND(JSON_FIELDS_SELECT(__VA_ARGS__,   \
+            JSON_FIELDS_16, JSON_FIELDS_15, JSON_FIELDS_14, JSON_FIELDS_13,         \
+            JSON_FIELDS_12, JSON_FIELDS_11, JSON_FIELDS_10, JSON_FIELDS_9,          \
+            JSON_FIELDS_8, JSON_FIELDS_7, JSON_FIELDS_6, JSON_FIELDS_5,             \
+            JSON_FIELDS_4, JSON_FIELDS_3, JSON_FIELDS_2, JSON_FIELDS_1)(Type, __VA_ARGS__))); \
+    }
+
+#endif // TYPED_JSON_HPP
@@ -0,0 +1,38 @@
+#ifndef UTF8_HPP
+#define UTF8_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace json {
+namespace utf8 {
+
+constexpr size_t npos = static_cast<size_t>(-1);
+
+// Смещение первого байта некорректной последовательности UTF-8 или npos.
+// Проверяются длина последовательностей, избыточные (overlong) формы,
+// суррогаты и выход за U+10FFFF.
+//
+// На x86-64 с AVX2 вход проверяется векторно по 64 байта за шаг (таблицы
+// по полубайтам, алгоритм Кайзера-Лемира); точная позиция ошибки ищется
+// скалярно только если векторная проверка её нашла.
+size_t findInvalid(const char* data, size_t size);
+
+inline size_t findInvalid(const std::string& text) {
+    return findInvalid(text.data(), text.size());
+}
+
+inline bool isValid(const std::string& text) {
+    return findInvalid(text) == npos;
+}
+
+// Скалярная проверка (ASCII по 8 байт, остальное побайтно)
+size_t findInvalidScalar(const char* data, size_t size);
+
+// Доступна ли векторная реализация на этом процессоре
+bool hasSimd();
+
+} // namespace utf8
+} // namespace json
+
+#endif // UTF8_HPP
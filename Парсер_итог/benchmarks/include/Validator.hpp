@@ -2,6 +2,7 @@
 #define VALIDATOR_HPP
 
 #include "Lexer.hpp"
+#include "ParseStats.hpp"
 #include <string>
 #include <vector>
 
@@ -36,6 +37,8 @@ private:
     size_t m_current;
     ValidationResult m_result;
     bool m_stopOnFirstError;
+    size_t m_depth;             // Текущая глубина вложенности
+    size_t m_maxDepth;
 
     // Получить текущий токен
     const Token& current() const;
@@ -59,14 +62,20 @@ private:
     // Попытка восстановления после ошибки
     void synchronize();
 
+    // Пропустить контейнер, начинающийся с текущего токена
+    void skipNested();
+
 public:
     explicit Validator(bool stopOnFirstError = false);
 
-    // Валидация строки JSON
-    ValidationResult validate(const std::string& jsonStr);
+    // Максимальная глубина вложенности (по умолчанию как у Parser)
+    void setMaxDepth(size_t depth) { m_maxDepth = depth; }
+
+    // Валидация строки JSON (stats - необязательная статистика по этапам)
+    ValidationResult validate(const std::string& jsonStr, ParseStats* stats = nullptr);
 
     // Валидация файла
-    ValidationResult validateFile(const std::string& filename);
+    ValidationResult validateFile(const std::string& filename, ParseStats* stats = nullptr);
 
     // Статический метод для быстрой проверки
     static bool isValid(const std::string& jsonStr);
@@ -0,0 +1,315 @@
+#include "BatchProcessor.hpp"
+#include "ForkJoinPool.hpp"
+#include "TolerantParser.hpp"
+#include "Validator.hpp"
+#include "Parser.hpp"
+#include "Serializer.hpp"
+#include "Cbor.hpp"
+#include "TypedJson.hpp"
+#include "InputStream.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+namespace json {
+
+namespace {
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::string describe(const ValidationError& error) {
+    return "строка " + std::to_string(error.line) + ", столбец " + std::to_string(error.column) +
+           ": " + error.message;
+}
+
+// Путь для сравнения: один и тот же файл - одна строка
+std::string normalizedPath(const std::string& path) {
+    std::error_code ec;
+    fs::path canonical = fs::weakly_canonical(path, ec);
+    return ec ? fs::path(path).lexically_normal().string() : canonical.string();
+}
+
+// Имя без расширения сжатия: "a.json.gz" -> "a.json"
+fs::path uncompressedName(const fs::path& path) {
+    return isCompressedExtension(path.extension().string()) ? path.stem() : path.filename();
+}
+
+} // namespace
+
+double BatchResult::throughputMBps() const {
+    if (wallMs <= 0.0) return 0.0;
+    return (static_cast<double>(totalBytes) / (1024.0 * 1024.0)) / (wallMs / 1000.0);
+}
+
+std::string BatchResult::toString() const {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    oss << "Файлов: " << files.size() << " (успешно " << succeeded << ", с ошибками " << failed << ")\n";
+    oss << "Объём: " << static_cast<double>(totalBytes) / (1024.0 * 1024.0) << " МБ\n";
+    oss << "Время: " << wallMs << " мс (чтение " << readMs << " мс, обработка " << processMs << " мс)\n";
+    oss << "Пропускная способность: " << throughputMBps() << " МБ/с\n";
+    oss << "Пик буфера чтения: " << static_cast<double>(peakBufferedBytes) / (1024.0 * 1024.0) << " МБ\n";
+    return oss.str();
+}
+
+BatchProcessor::BatchProcessor(BatchOptions options) : m_options(std::move(options)) {
+    if (m_options.threads == 0) {
+        m_options.threads = std::thread::hardware_concurrency();
+        if (m_options.threads == 0) m_options.threads = 1;
+    }
+    if (m_options.chunkThreshold == 0) m_options.chunkThreshold = 1;
+}
+
+std::vector<std::string> BatchProcessor::collectFiles(const std::string& path, bool recursive) {
+    std::error_code ec;
+    if (fs::is_regular_file(path, ec)) {
+        return {path};
+    }
+    if (!fs::is_directory(path, ec)) {
+        throw JsonException("Путь не найден: " + path);
+    }
+
+    std::vector<std::string> files;
+    auto add = [&files](const fs::directory_entry& entry) {
+        if (entry.is_regular_file() && uncompressedName(entry.path()).extension() == ".json") {
+            files.push_back(entry.path().string());
+        }
+    };
+    if (recursive) {
+        for (const auto& entry : fs::recursive_directory_iterator(path, fs::directory_options::skip_permission_denied)) {
+            add(entry);
+        }
+    } else {
+        for (const auto& entry : fs::directory_iterator(path)) {
+            add(entry);
+        }
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+std::string BatchProcessor::outputPathFor(const std::string& input) const {
+    fs::path source(input);
+    fs::path dir = m_options.outputDir.empty() ? source.parent_path() : fs::path(m_options.outputDir);
+    fs::path name = uncompressedName(source).stem();
+    name += m_options.format == BatchFormat::Cbor ? ".cbor" : ".json";
+    return (dir / name).string();
+}
+
+void BatchProcessor::processFile(const std::string& content, ForkJoinPool& pool, BatchFileResult& result) const {
+    JSON_TRACE_SCOPE("batch file");
+    bool convert = m_options.operation == BatchOperation::Convert;
+    JsonValue value;
+
+    if (content.size() >= m_options.chunkThreshold) {
+        // Большой файл: порции разбираются задачами того же пула. При
+        // проверке дерево не собирается - элементы только считаются
+        result.chunked = true;
+        TolerantParser parser;
+        parser.setKeepElements(convert);
+        TolerantResult parsed = parser.parse(content, pool);
+        if (!parsed.errors.empty()) {
+            result.errorCount = parsed.errors.size();
+            result.firstError = describe(parsed.errors.front());
+            return;
+        }
+        // Последовательность значений корректна, только если значение одно
+        if (!parsed.isArray && parsed.elementCount != 1) {
+            result.errorCount = 1;
+            result.firstError = "Ожидалось одно значение верхнего уровня, найдено " +
+                                std::to_string(parsed.elementCount);
+            return;
+        }
+        if (convert) {
+            value = parsed.isArray ? JsonValue(std::move(parsed.elements)) : std::move(parsed.elements.front());
+        }
+    } else if (!convert) {
+        ValidationResult validation = Validator(false).validate(content);
+        if (!validation.isValid) {
+            result.errorCount = std::max<size_t>(validation.errors.size(), 1);
+            if (!validation.errors.empty()) {
+                result.firstError = describe(validation.errors.front());
+            }
+            return;
+        }
+    } else {
+        value = Parser::parseString(content);
+    }
+
+    if (convert) {
+        bool written = false;
+        switch (m_options.format) {
+            case BatchFormat::Compact:
+                written = Serializer(Serializer::Options::compact()).saveToFile(value, result.outputPath);
+                break;
+            case BatchFormat::Pretty:
+                written = Serializer(Serializer::Options::pretty()).saveToFile(value, result.outputPath);
+                break;
+            case BatchFormat::Cbor:
+                written = CborWriter::toFile(value, result.outputPath);
+                break;
+        }
+        if (!written) {
+            throw JsonException("Не удалось записать файл: " + result.outputPath);
+        }
+    }
+    result.success = true;
+}
+
+BatchResult BatchProcessor::run(const std::vector<std::string>& files) const {
+    JSON_TRACE_SCOPE("BatchProcessor::run");
+    auto wallStart = std::chrono::steady_clock::now();
+    BatchResult batch;
+    batch.files.resize(files.size());
+
+    bool convert = m_options.operation == BatchOperation::Convert;
+    if (convert && !m_options.outputDir.empty()) {
+        std::error_code ec;
+        fs::create_directories(m_options.outputDir, ec);
+        if (ec) {
+            throw JsonException("Не удалось создать каталог: " + m_options.outputDir);
+        }
+    }
+
+    // Файлы, которые не читаются: совпадение результата с исходником
+    // или с результатом другого файла
+    std::vector<bool> rejected(files.size(), false);
+    std::map<std::string, size_t> outputs;
+    std::vector<size_t> sizes(files.size(), 0);
+    for (size_t i = 0; i < files.size(); ++i) {
+        BatchFileResult& file = batch.files[i];
+        file.path = files[i];
+        std::error_code ec;
+        auto size = fs::file_size(files[i], ec);
+        sizes[i] = ec ? 0 : static_cast<size_t>(size);
+
+        if (!convert) continue;
+        file.outputPath = outputPathFor(files[i]);
+        std::string output = normalizedPath(file.outputPath);
+        if (output == normalizedPath(files[i])) {
+            file.firstError = "Результат перезаписал бы исходный файл";
+        } else if (!outputs.emplace(output, i).second) {
+            file.firstError = "Результат совпадает с результатом " + files[outputs[output]];
+        } else {
+            continue;
+        }
+        file.errorCount = 1;
+        rejected[i] = true;
+    }
+
+    // Сначала большие: они дольше всех и не должны достаться последними
+    std::vector<size_t> order(files.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&sizes](size_t a, size_t b) { return sizes[a] > sizes[b]; });
+
+    std::mutex mutex;
+    std::condition_variable released;
+    size_t buffered = 0;
+    size_t done = 0;
+
+    // Под мьютексом: файл закончен, его буфер освобождён
+    auto finish = [&](size_t index, size_t bytes) {
+        buffered -= bytes;
+        ++done;
+        if (m_fileCallback) {
+            m_fileCallback(batch.files[index], done, files.size());
+        }
+        released.notify_all();
+    };
+
+    ForkJoinPool pool(m_options.threads);
+    ForkJoinPool::Group group;
+    for (size_t index : order) {
+        BatchFileResult& file = batch.files[index];
+        if (rejected[index]) {
+            std::lock_guard<std::mutex> lock(mutex);
+            finish(index, 0);
+            continue;
+        }
+
+        // Ждать места в буфере; файл больше бюджета - когда буфер пуст
+        size_t reserved = sizes[index];
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            released.wait(lock, [&]() {
+                return buffered == 0 || buffered + reserved <= m_options.readAheadBytes;
+            });
+            buffered += reserved;
+            batch.peakBufferedBytes = std::max(batch.peakBufferedBytes, buffered);
+        }
+
+        auto readStart = std::chrono::steady_clock::now();
+        auto content = std::make_shared<std::string>();
+        try {
+            JSON_TRACE_SCOPE("batch read");
+            *content = readFileContent(file.path);
+        } catch (const std::exception& e) {
+            file.readMs = elapsedMs(readStart);
+            file.errorCount = 1;
+            file.firstError = e.what();
+            std::lock_guard<std::mutex> lock(mutex);
+            finish(index, reserved);
+            continue;
+        }
+        file.readMs = elapsedMs(readStart);
+        file.bytes = content->size();
+
+        // Сжатый файл занимает в памяти больше, чем на диске;
+        // файл мог и измениться после file_size
+        if (content->size() != reserved) {
+            std::lock_guard<std::mutex> lock(mutex);
+            buffered = buffered - reserved + content->size();
+            batch.peakBufferedBytes = std::max(batch.peakBufferedBytes, buffered);
+            reserved = content->size();
+        }
+
+        pool.spawn(group, [this, &file, &pool, &mutex, &finish, content, index, reserved]() mutable {
+            auto processStart = std::chrono::steady_clock::now();
+            try {
+                processFile(*content, pool, file);
+            } catch (const std::exception& e) {
+                file.success = false;
+                file.errorCount = std::max<size_t>(file.errorCount, 1);
+                file.firstError = e.what();
+            } catch (...) {
+                file.success = false;
+                file.errorCount = std::max<size_t>(file.errorCount, 1);
+                file.firstError = "Неизвестная ошибка";
+            }
+            file.processMs = elapsedMs(processStart);
+            content.reset();
+
+            std::lock_guard<std::mutex> lock(mutex);
+            finish(index, reserved);
+        });
+    }
+    pool.wait(group);
+
+    for (const BatchFileResult& file : batch.files) {
+        if (file.success) {
+            ++batch.succeeded;
+        } else {
+            ++batch.failed;
+        }
+        batch.totalBytes += file.bytes;
+        batch.readMs += file.readMs;
+        batch.processMs += file.processMs;
+    }
+    batch.wallMs = elapsedMs(wallStart);
+    return batch;
+}
+
+} // namespace json
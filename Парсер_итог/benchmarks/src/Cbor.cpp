@@ -0,0 +1,504 @@
+#include "Cbor.hpp"
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace json {
+
+namespace {
+
+// Старшие типы CBOR
+constexpr uint8_t MAJOR_UNSIGNED = 0;
+constexpr uint8_t MAJOR_NEGATIVE = 1;
+constexpr uint8_t MAJOR_BYTES = 2;
+constexpr uint8_t MAJOR_TEXT = 3;
+constexpr uint8_t MAJOR_ARRAY = 4;
+constexpr uint8_t MAJOR_MAP = 5;
+constexpr uint8_t MAJOR_TAG = 6;
+constexpr uint8_t MAJOR_SIMPLE = 7;
+
+// Дополнительная информация (младшие 5 бит)
+constexpr uint8_t INFO_UINT8 = 24;
+constexpr uint8_t INFO_UINT16 = 25;
+constexpr uint8_t INFO_UINT32 = 26;
+constexpr uint8_t INFO_UINT64 = 27;
+constexpr uint8_t INFO_INDEFINITE = 31;
+
+constexpr uint8_t SIMPLE_FALSE = 0xf4;
+constexpr uint8_t SIMPLE_TRUE = 0xf5;
+constexpr uint8_t SIMPLE_NULL = 0xf6;
+constexpr uint8_t FLOAT32 = 0xfa;
+constexpr uint8_t FLOAT64 = 0xfb;
+constexpr uint8_t BREAK = 0xff;
+
+constexpr uint64_t MAX_EXACT_INTEGER = 9007199254740992ULL;     // 2^53
+
+// Половинная точность (только для чтения)
+double halfToDouble(uint16_t half) {
+    int exponent = (half >> 10) & 0x1f;
+    int mantissa = half & 0x3ff;
+    double value;
+    if (exponent == 0) {
+        value = std::ldexp(mantissa, -24);
+    } else if (exponent != 31) {
+        value = std::ldexp(mantissa + 1024, exponent - 25);
+    } else {
+        value = mantissa == 0 ? std::numeric_limits<double>::infinity()
+                              : std::numeric_limits<double>::quiet_NaN();
+    }
+    return (half & 0x8000) ? -value : value;
+}
+
+} // namespace
+
+// ============================================================================
+// CborWriter
+// ============================================================================
+
+CborWriter::CborWriter(std::string& output)
+    : m_out(&output), m_stream(nullptr), m_bufferSize(0),
+      m_startSize(output.size()), m_flushedBytes(0) {}
+
+CborWriter::CborWriter(std::ostream& os, size_t bufferSize)
+    : m_out(&m_buffer), m_stream(&os), m_bufferSize(bufferSize),
+      m_startSize(0), m_flushedBytes(0) {
+    m_buffer.reserve(m_bufferSize + 4096);
+}
+
+CborWriter::~CborWriter() {
+    if (m_stream) {
+        flush();
+    }
+}
+
+void CborWriter::flush() {
+    if (m_stream && !m_buffer.empty()) {
+        m_stream->write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+        m_flushedBytes += m_buffer.size();
+        m_buffer.clear();
+    }
+}
+
+void CborWriter::maybeFlush() {
+    if (m_stream && m_buffer.size() >= m_bufferSize) {
+        flush();
+    }
+}
+
+size_t CborWriter::bytesWritten() const {
+    return m_flushedBytes + m_out->size() - m_startSize;
+}
+
+void CborWriter::writeHead(uint8_t major, uint64_t argument) {
+    uint8_t head[9];
+    size_t length;
+    major = static_cast<uint8_t>(major << 5);
+
+    if (argument < INFO_UINT8) {
+        head[0] = static_cast<uint8_t>(major | argument);
+        length = 1;
+    } else if (argument <= 0xff) {
+        head[0] = major | INFO_UINT8;
+        length = 2;
+    } else if (argument <= 0xffff) {
+        head[0] = major | INFO_UINT16;
+        length = 3;
+    } else if (argument <= 0xffffffffULL) {
+        head[0] = major | INFO_UINT32;
+        length = 5;
+    } else {
+        head[0] = major | INFO_UINT64;
+        length = 9;
+    }
+
+    // Аргумент в порядке big-endian
+    for (size_t i = length - 1; i > 0; --i) {
+        head[i] = static_cast<uint8_t>(argument);
+        argument >>= 8;
+    }
+
+    m_out->append(reinterpret_cast<const char*>(head), length);
+}
+
+CborWriter& CborWriter::beginArray(size_t size) {
+    writeHead(MAJOR_ARRAY, size);
+    return *this;
+}
+
+CborWriter& CborWriter::beginObject(size_t size) {
+    writeHead(MAJOR_MAP, size);
+    return *this;
+}
+
+CborWriter& CborWriter::null() {
+    m_out->push_back(static_cast<char>(SIMPLE_NULL));
+    return *this;
+}
+
+CborWriter& CborWriter::value(bool b) {
+    m_out->push_back(static_cast<char>(b ? SIMPLE_TRUE : SIMPLE_FALSE));
+    return *this;
+}
+
+CborWriter& CborWriter::value(int64_t number) {
+    if (number >= 0) {
+        writeHead(MAJOR_UNSIGNED, static_cast<uint64_t>(number));
+    } else {
+        // Отрицательное n кодируется как -1 - n
+        writeHead(MAJOR_NEGATIVE, static_cast<uint64_t>(-(number + 1)));
+    }
+    return *this;
+}
+
+CborWriter& CborWriter::value(double number) {
+    // Целые значения (кроме -0.0) пишем как целые: короче и без потерь
+    constexpr double INT64_LIMIT = 9223372036854775808.0;   // 2^63
+    if (number >= -INT64_LIMIT && number < INT64_LIMIT &&
+        std::trunc(number) == number && !(number == 0.0 && std::signbit(number))) {
+        return value(static_cast<int64_t>(number));
+    }
+
+    float narrow = static_cast<float>(number);
+    if (static_cast<double>(narrow) == number) {
+        uint32_t bits;
+        std::memcpy(&bits, &narrow, sizeof(bits));
+        char out[5] = {static_cast<char>(FLOAT32),
+                       static_cast<char>(bits >> 24), static_cast<char>(bits >> 16),
+                       static_cast<char>(bits >> 8), static_cast<char>(bits)};
+        m_out->append(out, sizeof(out));
+        return *this;
+    }
+
+    uint64_t bits;
+    std::memcpy(&bits, &number, sizeof(bits));
+    char out[9];
+    out[0] = static_cast<char>(FLOAT64);
+    for (int i = 8; i >= 1; --i) {
+        out[i] = static_cast<char>(bits);
+        bits >>= 8;
+    }
+    m_out->append(out, sizeof(out));
+    return *this;
+}
+
+CborWriter& CborWriter::value(std::string_view str) {
+    writeHead(MAJOR_TEXT, str.size());
+    m_out->append(str.data(), str.size());
+    maybeFlush();
+    return *this;
+}
+
+CborWriter& CborWriter::selfDescribe() {
+    m_out->append(reinterpret_cast<const char*>(SELF_DESCRIBE_TAG), sizeof(SELF_DESCRIBE_TAG));
+    return *this;
+}
+
+CborWriter& CborWriter::value(const JsonValue& node) {
+    switch (node.type()) {
+        case JsonValue::Type::Null:
+            null();
+            break;
+        case JsonValue::Type::Bool:
+            value(node.asBool());
+            break;
+        case JsonValue::Type::Number:
+            value(node.asNumber());
+            break;
+        case JsonValue::Type::RawNumber: {
+            // Целые из исходной записи пишем точно, даже за пределами 2^53
+            const auto& raw = node.asRawNumber();
+            int64_t integer;
+            if (raw.toInt64(integer)) {
+                value(integer);
+            } else {
+                value(raw.value());
+            }
+            break;
+        }
+        case JsonValue::Type::String:
+            value(std::string_view(node.asString()));
+            break;
+        case JsonValue::Type::Array: {
+            const auto& arr = node.asArray();
+            beginArray(arr.size());
+            // Сброс после каждого элемента: массив чисел не копится в буфере целиком
+            for (const auto& item : arr) {
+                value(item);
+                maybeFlush();
+            }
+            break;
+        }
+        case JsonValue::Type::Object: {
+            const auto& obj = node.asObject();
+            beginObject(obj.size());
+            for (const auto& [k, item] : obj) {
+                key(k);
+                value(item);
+                maybeFlush();
+            }
+            break;
+        }
+    }
+
+    return *this;
+}
+
+std::string CborWriter::toBytes(const JsonValue& value) {
+    std::string out;
+    CborWriter writer(out);
+    writer.value(value);
+    return out;
+}
+
+bool CborWriter::toFile(const JsonValue& value, const std::string& filename) {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    {
+        CborWriter writer(file);
+        writer.selfDescribe();
+        writer.value(value);
+    }
+
+    return file.good();
+}
+
+// ============================================================================
+// CborReader
+// ============================================================================
+
+CborReader::CborReader(std::string_view data)
+    : m_data(reinterpret_cast<const uint8_t*>(data.data())), m_size(data.size()),
+      m_pos(0), m_depth(0) {}
+
+void CborReader::fail(const std::string& message) const {
+    throw JsonException("CBOR: " + message + " (смещение " + std::to_string(m_pos) + ")");
+}
+
+uint8_t CborReader::readByte() {
+    if (m_pos >= m_size) {
+        fail("неожиданный конец данных");
+    }
+    return m_data[m_pos++];
+}
+
+uint64_t CborReader::readArgument(uint8_t info) {
+    if (info < INFO_UINT8) {
+        return info;
+    }
+
+    size_t length;
+    switch (info) {
+        case INFO_UINT8:  length = 1; break;
+        case INFO_UINT16: length = 2; break;
+        case INFO_UINT32: length = 4; break;
+        case INFO_UINT64: length = 8; break;
+        default:
+            fail("недопустимая длина аргумента " + std::to_string(info));
+    }
+
+    if (m_size - m_pos < length) {
+        fail("неожиданный конец данных");
+    }
+
+    uint64_t result = 0;
+    for (size_t i = 0; i < length; ++i) {
+        result = (result << 8) | m_data[m_pos++];
+    }
+    return result;
+}
+
+void CborReader::readText(uint8_t info, std::string& out) {
+    if (info == INFO_INDEFINITE) {
+        // Строка из фрагментов до BREAK
+        while (true) {
+            uint8_t initial = readByte();
+            if (initial == BREAK) return;
+            if ((initial >> 5) != MAJOR_TEXT || (initial & 0x1f) == INFO_INDEFINITE) {
+                fail("ожидался фрагмент строки");
+            }
+            readText(initial & 0x1f, out);
+        }
+    }
+
+    uint64_t length = readArgument(info);
+    if (length > m_size - m_pos) {
+        fail("длина строки выходит за пределы данных");
+    }
+    out.append(reinterpret_cast<const char*>(m_data + m_pos), static_cast<size_t>(length));
+    m_pos += static_cast<size_t>(length);
+}
+
+double CborReader::readFloat(uint8_t info) {
+    uint64_t bits = readArgument(info);
+    if (info == INFO_UINT16) {
+        return halfToDouble(static_cast<uint16_t>(bits));
+    }
+    if (info == INFO_UINT32) {
+        uint32_t narrowBits = static_cast<uint32_t>(bits);
+        float narrow;
+        std::memcpy(&narrow, &narrowBits, sizeof(narrow));
+        return narrow;
+    }
+    double result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+JsonValue CborReader::readValue() {
+    uint8_t initial = readByte();
+    uint8_t major = initial >> 5;
+    uint8_t info = initial & 0x1f;
+
+    switch (major) {
+        case MAJOR_UNSIGNED: {
+            uint64_t number = readArgument(info);
+            // Целые больше 2^53 не представимы в double: храним запись
+            if (number > MAX_EXACT_INTEGER) {
+                return JsonValue(JsonRawNumber(std::to_string(number)));
+            }
+            return JsonValue(static_cast<double>(number));
+        }
+
+        case MAJOR_NEGATIVE: {
+            uint64_t number = readArgument(info);
+            if (number >= MAX_EXACT_INTEGER) {
+                std::string text = number == UINT64_MAX ? "-18446744073709551616"
+                                                        : "-" + std::to_string(number + 1);
+                return JsonValue(JsonRawNumber(std::move(text)));
+            }
+            return JsonValue(-1.0 - static_cast<double>(number));
+        }
+
+        case MAJOR_BYTES:
+            fail("байтовые строки не поддерживаются");
+
+        case MAJOR_TEXT: {
+            std::string text;
+            readText(info, text);
+            return JsonValue(std::move(text));
+        }
+
+        case MAJOR_ARRAY: {
+            if (++m_depth > MAX_DEPTH) fail("превышена глубина вложенности");
+
+            JsonArray arr;
+            if (info == INFO_INDEFINITE) {
+                while (m_pos < m_size && m_data[m_pos] != BREAK) {
+                    arr.push_back(readValue());
+                }
+                readByte();     // BREAK
+            } else {
+                uint64_t count = readArgument(info);
+                // Каждый элемент занимает хотя бы байт: защита от ложных длин
+                if (count > m_size - m_pos) {
+                    fail("длина массива выходит за пределы данных");
+                }
+                arr.reserve(static_cast<size_t>(count));
+                for (uint64_t i = 0; i < count; ++i) {
+                    arr.push_back(readValue());
+                }
+            }
+
+            --m_depth;
+            return JsonValue(std::move(arr));
+        }
+
+        case MAJOR_MAP: {
+            if (++m_depth > MAX_DEPTH) fail("превышена глубина вложенности");
+
+            bool indefinite = (info == INFO_INDEFINITE);
+            uint64_t count = indefinite ? 0 : readArgument(info);
+            if (!indefinite && count > (m_size - m_pos) / 2) {
+                fail("длина объекта выходит за пределы данных");
+            }
+
+            JsonObject obj;
+            std::string key;
+            for (uint64_t i = 0; indefinite || i < count; ++i) {
+                uint8_t keyInitial = readByte();
+                if (indefinite && keyInitial == BREAK) break;
+                if ((keyInitial >> 5) != MAJOR_TEXT) {
+                    fail("ключ объекта должен быть строкой");
+                }
+                key.clear();
+                readText(keyInitial & 0x1f, key);
+                // CborWriter пишет ключи в порядке std::map: вставка в конец за O(1)
+                obj.insert_or_assign(obj.end(), key, readValue());
+            }
+
+            --m_depth;
+            return JsonValue(std::move(obj));
+        }
+
+        case MAJOR_TAG: {
+            // Семантика меток не поддерживается: читаем помеченное значение
+            if (++m_depth > MAX_DEPTH) fail("превышена глубина вложенности");
+            readArgument(info);
+            JsonValue tagged = readValue();
+            --m_depth;
+            return tagged;
+        }
+
+        case MAJOR_SIMPLE:
+        default:
+            switch (initial) {
+                case SIMPLE_FALSE: return JsonValue(false);
+                case SIMPLE_TRUE: return JsonValue(true);
+                case SIMPLE_NULL: return JsonValue(nullptr);
+                case 0xf7: return JsonValue(nullptr);   // undefined
+                case 0xf9: case FLOAT32: case FLOAT64:
+                    return JsonValue(readFloat(info));
+                default:
+                    fail("неподдерживаемое простое значение " + std::to_string(info));
+            }
+    }
+}
+
+JsonValue CborReader::read() {
+    if (m_size - m_pos >= sizeof(CborWriter::SELF_DESCRIBE_TAG) &&
+        std::memcmp(m_data + m_pos, CborWriter::SELF_DESCRIBE_TAG,
+                    sizeof(CborWriter::SELF_DESCRIBE_TAG)) == 0) {
+        m_pos += sizeof(CborWriter::SELF_DESCRIBE_TAG);
+    }
+    return readValue();
+}
+
+JsonValue CborReader::parseBytes(std::string_view data) {
+    CborReader reader(data);
+    JsonValue result = reader.read();
+    if (reader.position() != data.size()) {
+        reader.fail("лишние данные после значения");
+    }
+    return result;
+}
+
+JsonValue CborReader::parseFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        throw JsonException("Не удалось открыть файл: " + filename);
+    }
+
+    std::string content(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    file.read(&content[0], static_cast<std::streamsize>(content.size()));
+    if (!file) {
+        throw JsonException("Ошибка чтения файла: " + filename);
+    }
+
+    return parseBytes(content);
+}
+
+bool CborReader::isCborFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    char head[sizeof(CborWriter::SELF_DESCRIBE_TAG)];
+    if (!file.read(head, sizeof(head))) {
+        return false;
+    }
+    return std::memcmp(head, CborWriter::SELF_DESCRIBE_TAG, sizeof(head)) == 0;
+}
+
+} // namespace json
@@ -0,0 +1,498 @@
+#include "DocumentCache.hpp"
+#include "MappedFile.hpp"
+#include "ContentHasher.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace json {
+
+namespace {
+
+// Формат файла кэша (порядок байт - родной для машины, проверяется меткой):
+//   CacheHeader | узлы и строки, выровненные по 8 байт
+// Массив ссылается на непрерывный блок из size узлов, объект - на блок из
+// size пар (узел-ключ, узел-значение), отсортированных по ключу.
+
+constexpr char CACHE_MAGIC[8] = {'J', 'P', 'C', 'A', 'C', 'H', 'E', '\0'};
+constexpr uint32_t CACHE_VERSION = 1;
+constexpr uint32_t ENDIAN_TAG = 0x01020304;
+
+struct CacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t endianTag;
+    uint64_t sourceSize;
+    int64_t sourceMtime;
+    uint64_t sourceHash;
+    uint64_t rootOffset;
+    uint64_t fileSize;
+};
+
+// Типы узлов совпадают с JsonValue::Type
+// (исходная запись числа сохраняется как обычное число)
+enum NodeType : uint8_t {
+    NODE_NULL = 0,
+    NODE_BOOL = 1,
+    NODE_NUMBER = 2,
+    NODE_STRING = 3,
+    NODE_ARRAY = 4,
+    NODE_OBJECT = 5
+};
+
+struct CacheNode {
+    uint8_t type;
+    uint8_t boolValue;
+    uint8_t reserved[6];
+    uint64_t a;         // Число (биты double) / смещение строки или блока детей
+    uint64_t b;         // Длина строки / количество элементов
+};
+
+static_assert(sizeof(CacheNode) == 24, "CacheNode должен занимать 24 байта");
+static_assert(sizeof(CacheHeader) % 8 == 0, "Заголовок должен быть выровнен");
+
+const char* const TYPE_NAMES[] = {"null", "boolean", "number", "string", "array", "object"};
+
+// Узлы выровнены по 8 байт, отображение - по границе страницы
+const CacheNode* asNode(const void* p) {
+    return static_cast<const CacheNode*>(p);
+}
+
+[[noreturn]] void corrupted() {
+    throw JsonException("Файл кэша повреждён");
+}
+
+// Построение образа дерева в памяти
+class ImageBuilder {
+private:
+    std::string m_out;
+
+    size_t allocate(size_t bytes) {
+        size_t offset = (m_out.size() + 7) & ~size_t(7);
+        m_out.resize(offset + bytes);
+        return offset;
+    }
+
+    void putNode(size_t at, const CacheNode& node) {
+        std::memcpy(&m_out[at], &node, sizeof(node));
+    }
+
+    uint64_t putString(const std::string& str) {
+        size_t offset = allocate(str.size());
+        if (!str.empty()) {
+            std::memcpy(&m_out[offset], str.data(), str.size());
+        }
+        return offset;
+    }
+
+    void fill(size_t at, const JsonValue& value) {
+        CacheNode node{};
+        node.type = value.isNumber() ? static_cast<uint8_t>(NODE_NUMBER) : static_cast<uint8_t>(value.type());
+
+        switch (node.type) {
+            case NODE_BOOL:
+                node.boolValue = value.asBool() ? 1 : 0;
+                break;
+            case NODE_NUMBER: {
+                double number = value.asNumber();
+                std::memcpy(&node.a, &number, sizeof(number));
+                break;
+            }
+            case NODE_STRING: {
+                const auto& str = value.asString();
+                node.a = putString(str);
+                node.b = str.size();
+                break;
+            }
+            case NODE_ARRAY: {
+                const auto& arr = value.asArray();
+                size_t block = allocate(arr.size() * sizeof(CacheNode));
+                node.a = block;
+                node.b = arr.size();
+                for (size_t i = 0; i < arr.size(); ++i) {
+                    fill(block + i * sizeof(CacheNode), arr[i]);
+                }
+                break;
+            }
+            case NODE_OBJECT: {
+                const auto& obj = value.asObject();
+                size_t block = allocate(obj.size() * 2 * sizeof(CacheNode));
+                node.a = block;
+                node.b = obj.size();
+                size_t slot = block;
+                for (const auto& [key, item] : obj) {
+                    CacheNode keyNode{};
+                    keyNode.type = NODE_STRING;
+                    keyNode.a = putString(key);
+                    keyNode.b = key.size();
+                    putNode(slot, keyNode);
+                    fill(slot + sizeof(CacheNode), item);
+                    slot += 2 * sizeof(CacheNode);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+
+        putNode(at, node);
+    }
+
+public:
+    std::string build(const JsonValue& value, const CacheSourceInfo& source) {
+        m_out.clear();
+        size_t headerOffset = allocate(sizeof(CacheHeader));
+        size_t rootOffset = allocate(sizeof(CacheNode));
+        fill(rootOffset, value);
+
+        CacheHeader header{};
+        std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        header.version = CACHE_VERSION;
+        header.endianTag = ENDIAN_TAG;
+        header.sourceSize = source.size;
+        header.sourceMtime = source.mtime;
+        header.sourceHash = source.hash;
+        header.rootOffset = rootOffset;
+        header.fileSize = m_out.size();
+        std::memcpy(&m_out[headerOffset], &header, sizeof(header));
+
+        return std::move(m_out);
+    }
+};
+
+std::string toHex(uint64_t value) {
+    std::ostringstream oss;
+    oss << std::hex << std::setw(16) << std::setfill('0') << value;
+    return oss.str();
+}
+
+} // namespace
+
+// ============================================================================
+// CachedValue
+// ============================================================================
+
+CachedValue::CachedValue(const char* base, size_t size, size_t offset)
+    : m_base(base), m_size(size), m_offset(offset) {}
+
+const void* CachedValue::node() const {
+    return m_base + m_offset;
+}
+
+CachedValue CachedValue::child(uint64_t offset) const {
+    if (offset % 8 != 0 || offset > m_size || m_size - offset < sizeof(CacheNode)) {
+        corrupted();
+    }
+    return CachedValue(m_base, m_size, static_cast<size_t>(offset));
+}
+
+bool CachedValue::isNull() const { return asNode(node())->type == NODE_NULL; }
+bool CachedValue::isBool() const { return asNode(node())->type == NODE_BOOL; }
+bool CachedValue::isNumber() const { return asNode(node())->type == NODE_NUMBER; }
+bool CachedValue::isString() const { return asNode(node())->type == NODE_STRING; }
+bool CachedValue::isArray() const { return asNode(node())->type == NODE_ARRAY; }
+bool CachedValue::isObject() const { return asNode(node())->type == NODE_OBJECT; }
+
+std::string CachedValue::typeName() const {
+    uint8_t type = asNode(node())->type;
+    return type <= NODE_OBJECT ? TYPE_NAMES[type] : "unknown";
+}
+
+bool CachedValue::asBool() const {
+    if (!isBool()) throw JsonException("Значение не является булевым");
+    return asNode(node())->boolValue != 0;
+}
+
+double CachedValue::asNumber() const {
+    if (!isNumber()) throw JsonException("Значение не является числом");
+    double number;
+    std::memcpy(&number, &asNode(node())->a, sizeof(number));
+    return number;
+}
+
+std::string_view CachedValue::asString() const {
+    if (!isString()) throw JsonException("Значение не является строкой");
+    const CacheNode* n = asNode(node());
+    if (n->a > m_size || m_size - n->a < n->b) {
+        corrupted();
+    }
+    return std::string_view(m_base + n->a, static_cast<size_t>(n->b));
+}
+
+size_t CachedValue::size() const {
+    const CacheNode* n = asNode(node());
+    if (n->type != NODE_ARRAY && n->type != NODE_OBJECT) {
+        throw JsonException("Размер доступен только для массивов и объектов");
+    }
+    return static_cast<size_t>(n->b);
+}
+
+CachedValue CachedValue::operator[](size_t index) const {
+    if (!isArray()) throw JsonException("Значение не является массивом");
+    const CacheNode* n = asNode(node());
+    if (index >= n->b) throw JsonException("Индекс выходит за границы массива");
+    return child(n->a + index * sizeof(CacheNode));
+}
+
+std::string_view CachedValue::keyAt(size_t index) const {
+    if (!isObject()) throw JsonException("Значение не является объектом");
+    const CacheNode* n = asNode(node());
+    if (index >= n->b) throw JsonException("Индекс выходит за границы объекта");
+    return child(n->a + index * 2 * sizeof(CacheNode)).asString();
+}
+
+CachedValue CachedValue::valueAt(size_t index) const {
+    if (!isObject()) throw JsonException("Значение не является объектом");
+    const CacheNode* n = asNode(node());
+    if (index >= n->b) throw JsonException("Индекс выходит за границы объекта");
+    return child(n->a + (index * 2 + 1) * sizeof(CacheNode));
+}
+
+std::optional<CachedValue> CachedValue::find(std::string_view key) const {
+    if (!isObject()) throw JsonException("Значение не является объектом");
+
+    // Ключи записаны в порядке std::map (лексикографически по байтам)
+    size_t low = 0;
+    size_t high = size();
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        int cmp = keyAt(mid).compare(key);
+        if (cmp == 0) return valueAt(mid);
+        if (cmp < 0) low = mid + 1;
+        else high = mid;
+    }
+    return std::nullopt;
+}
+
+CachedValue CachedValue::at(std::string_view key) const {
+    auto found = find(key);
+    if (!found) throw JsonException("Ключ не найден: " + std::string(key));
+    return *found;
+}
+
+std::optional<CachedValue> CachedValue::findByPath(const std::string& path) const {
+    CachedValue current = *this;
+    for (const std::string& part : JsonValue::splitPath(path)) {
+        if (current.isObject()) {
+            auto found = current.find(part);
+            if (!found) return std::nullopt;
+            current = *found;
+        } else if (current.isArray()) {
+            bool isIndex = std::all_of(part.begin(), part.end(),
+                                       [](char c) { return c >= '0' && c <= '9'; });
+            if (!isIndex || part.size() > 18) return std::nullopt;
+            size_t index = static_cast<size_t>(std::stoull(part));
+            if (index >= current.size()) return std::nullopt;
+            current = current[index];
+        } else {
+            return std::nullopt;
+        }
+    }
+    return current;
+}
+
+JsonValue CachedValue::toJsonValue() const {
+    switch (asNode(node())->type) {
+        case NODE_NULL:
+            return JsonValue(nullptr);
+        case NODE_BOOL:
+            return JsonValue(asBool());
+        case NODE_NUMBER:
+            return JsonValue(asNumber());
+        case NODE_STRING:
+            return JsonValue(std::string(asString()));
+        case NODE_ARRAY: {
+            size_t count = size();
+            JsonArray arr;
+            arr.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                arr.push_back((*this)[i].toJsonValue());
+            }
+            return JsonValue(std::move(arr));
+        }
+        case NODE_OBJECT: {
+            size_t count = size();
+            JsonObject obj;
+            for (size_t i = 0; i < count; ++i) {
+                // Ключи уже отсортированы: вставка в конец за O(1)
+                obj.emplace_hint(obj.end(), std::string(keyAt(i)), valueAt(i).toJsonValue());
+            }
+            return JsonValue(std::move(obj));
+        }
+        default:
+            corrupted();
+    }
+}
+
+// ============================================================================
+// CachedDocument
+// ============================================================================
+
+CachedDocument::CachedDocument() : m_mapping(new MappedFile()), m_rootOffset(0) {}
+
+CachedDocument::~CachedDocument() = default;
+
+std::unique_ptr<CachedDocument> CachedDocument::open(const std::string& cacheFile) {
+    std::unique_ptr<CachedDocument> doc(new CachedDocument());
+    if (!doc->m_mapping->open(cacheFile)) {
+        throw JsonException("Не удалось открыть файл кэша: " + cacheFile);
+    }
+
+    const MappedFile& map = *doc->m_mapping;
+    if (map.size() < sizeof(CacheHeader)) {
+        corrupted();
+    }
+
+    CacheHeader header;
+    std::memcpy(&header, map.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+        header.version != CACHE_VERSION || header.endianTag != ENDIAN_TAG) {
+        throw JsonException("Неподдерживаемый формат файла кэша: " + cacheFile);
+    }
+
+    if (header.fileSize != map.size() || header.rootOffset % 8 != 0 ||
+        header.rootOffset > map.size() || map.size() - header.rootOffset < sizeof(CacheNode)) {
+        corrupted();
+    }
+
+    doc->m_source.size = header.sourceSize;
+    doc->m_source.mtime = header.sourceMtime;
+    doc->m_source.hash = header.sourceHash;
+    doc->m_rootOffset = static_cast<size_t>(header.rootOffset);
+    return doc;
+}
+
+CachedValue CachedDocument::root() const {
+    return CachedValue(m_mapping->data(), m_mapping->size(), m_rootOffset);
+}
+
+size_t CachedDocument::sizeBytes() const {
+    return m_mapping->size();
+}
+
+// ============================================================================
+// DocumentCache
+// ============================================================================
+
+DocumentCache::DocumentCache(const std::string& directory) : m_directory(directory) {}
+
+std::string DocumentCache::cachePathFor(const std::string& sourceFile) const {
+    std::error_code ec;
+    fs::path absolute = fs::absolute(sourceFile, ec);
+    std::string key = (ec ? fs::path(sourceFile) : absolute).lexically_normal().string();
+
+    ContentHasher hasher;
+    hasher.update(key.data(), key.size());
+    return (fs::path(m_directory) / (toHex(hasher.finish()) + ".jpc")).string();
+}
+
+CacheSourceInfo DocumentCache::describe(const std::string& sourceFile, bool withHash) {
+    CacheSourceInfo info;
+    info.size = static_cast<uint64_t>(fs::file_size(sourceFile));
+    info.mtime = static_cast<int64_t>(fs::last_write_time(sourceFile).time_since_epoch().count());
+    if (withHash) {
+        info.hash = hashFile(sourceFile);
+    }
+    return info;
+}
+
+uint64_t DocumentCache::hashFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw JsonException("Не удалось открыть файл: " + filename);
+    }
+
+    ContentHasher hasher;
+    std::vector<char> buffer(1 << 20);
+    while (file) {
+        file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        std::streamsize got = file.gcount();
+        if (got > 0) {
+            hasher.update(buffer.data(), static_cast<size_t>(got));
+        }
+    }
+    return hasher.finish();
+}
+
+std::unique_ptr<CachedDocument> DocumentCache::open(const std::string& sourceFile, bool verifyHash) const {
+    std::string cacheFile = cachePathFor(sourceFile);
+
+    std::error_code ec;
+    if (!fs::exists(cacheFile, ec)) {
+        return nullptr;
+    }
+
+    std::unique_ptr<CachedDocument> doc;
+    bool fresh = false;
+    try {
+        doc = CachedDocument::open(cacheFile);
+        CacheSourceInfo current = describe(sourceFile, false);
+        fresh = doc->source().size == current.size && doc->source().mtime == current.mtime;
+        if (fresh && verifyHash) {
+            fresh = doc->source().hash == hashFile(sourceFile);
+        }
+    } catch (const std::exception&) {
+        // Повреждённый кэш или недоступный исходник - кэш не используется
+        fresh = false;
+    }
+
+    if (!fresh) {
+        doc.reset();
+        fs::remove(cacheFile, ec);
+        return nullptr;
+    }
+    return doc;
+}
+
+bool DocumentCache::store(const std::string& sourceFile, const JsonValue& value) const {
+    try {
+        CacheSourceInfo info = describe(sourceFile, true);
+        fs::create_directories(m_directory);
+        return writeCacheFile(value, info, cachePathFor(sourceFile));
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool DocumentCache::invalidate(const std::string& sourceFile) const {
+    std::error_code ec;
+    return fs::remove(cachePathFor(sourceFile), ec);
+}
+
+bool DocumentCache::writeCacheFile(const JsonValue& value, const CacheSourceInfo& source,
+                                   const std::string& cacheFile) {
+    std::string image = ImageBuilder().build(value, source);
+
+    // Запись во временный файл и переименование: читатель не увидит половину
+    std::string tempFile = cacheFile + ".tmp";
+    {
+        std::ofstream file(tempFile, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file.write(image.data(), static_cast<std::streamsize>(image.size()));
+        if (!file.good()) {
+            file.close();
+            std::error_code ec;
+            fs::remove(tempFile, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tempFile, cacheFile, ec);
+    if (ec) {
+        fs::remove(tempFile, ec);
+        return false;
+    }
+    return true;
+}
+
+} // namespace json
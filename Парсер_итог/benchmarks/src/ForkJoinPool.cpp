@@ -0,0 +1,93 @@
+#include "ForkJoinPool.hpp"
+
+namespace json {
+
+ForkJoinPool::ForkJoinPool(unsigned int workers) {
+    m_workers.reserve(workers);
+    for (unsigned int i = 0; i < workers; ++i) {
+        m_workers.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+ForkJoinPool::~ForkJoinPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void ForkJoinPool::spawn(Group& group, std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        group.m_pending++;
+        m_queue.push_back(Task{&group, std::move(task)});
+    }
+    m_cv.notify_one();
+}
+
+void ForkJoinPool::execute(Task& task) {
+    std::exception_ptr error;
+    try {
+        task.run();
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    bool done;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (error && !task.group->m_error) {
+            task.group->m_error = error;
+        }
+        done = --task.group->m_pending == 0;
+    }
+    if (done) {
+        // Ожидающий группу поток может спать на той же условной переменной
+        m_cv.notify_all();
+    }
+}
+
+void ForkJoinPool::workerLoop() {
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+            if (m_queue.empty()) {
+                return;     // m_stop
+            }
+            task = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+        execute(task);
+    }
+}
+
+void ForkJoinPool::wait(Group& group) {
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this, &group]() { return group.m_pending == 0 || !m_queue.empty(); });
+            if (group.m_pending == 0) {
+                break;
+            }
+            // Свежие задачи в конце очереди - обычно порции этой же группы
+            task = std::move(m_queue.back());
+            m_queue.pop_back();
+        }
+        execute(task);
+    }
+
+    if (group.m_error) {
+        std::exception_ptr error = group.m_error;
+        group.m_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace json
@@ -3,6 +3,9 @@
 #include <sstream>
 #include <ctime>
 #include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
 
 namespace json {
 
@@ -34,7 +37,7 @@ static const std::vector<std::string> KEYS = {
 };
 
 Generator::Generator(unsigned int seed)
-    : m_currentLine(1), m_currentColumn(1) {
+    : m_out(nullptr) {
     if (seed == 0) {
         m_rng.seed(static_cast<unsigned int>(std::time(nullptr)));
     } else {
@@ -46,14 +49,33 @@ void Generator::setOptions(const GeneratorOptions& options) {
     m_options = options;
 }
 
+// Диапазоны отображаются вручную: std::uniform_*_distribution в libstdc++
+// и libc++ устроены по-разному, и один seed давал бы разные файлы.
+// Целые - умножение со сдвигом (Lemire) с отбрасыванием смещённых значений
 int Generator::randomInt(int min, int max) {
-    std::uniform_int_distribution<int> dist(min, max);
-    return dist(m_rng);
+    uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+    uint32_t x = static_cast<uint32_t>(m_rng());
+    if (range > UINT32_MAX) {
+        return static_cast<int>(static_cast<int64_t>(min) + x);
+    }
+    uint64_t product = static_cast<uint64_t>(x) * range;
+    uint32_t low = static_cast<uint32_t>(product);
+    if (low < range) {
+        uint32_t threshold = static_cast<uint32_t>(((uint64_t{1} << 32) - range) % range);
+        while (low < threshold) {
+            x = static_cast<uint32_t>(m_rng());
+            product = static_cast<uint64_t>(x) * range;
+            low = static_cast<uint32_t>(product);
+        }
+    }
+    return static_cast<int>(static_cast<int64_t>(min) + static_cast<int64_t>(product >> 32));
 }
 
+// Дробные - старшие 53 бита двух выборок, равномерно в [0, 1)
 double Generator::randomDouble(double min, double max) {
-    std::uniform_real_distribution<double> dist(min, max);
-    return dist(m_rng);
+    uint64_t bits = (static_cast<uint64_t>(m_rng()) << 32) | static_cast<uint32_t>(m_rng());
+    double unit = static_cast<double>(bits >> 11) * 0x1.0p-53;
+    return min + unit * (max - min);
 }
 
 bool Generator::randomBool() {
@@ -64,202 +86,215 @@ bool Generator::shouldGenerateError() {
     return randomInt(1, 100) <= m_options.errorProbability;
 }
 
-std::string Generator::randomString(int minLen, int maxLen) {
+static void appendFrom(std::string& out, const std::vector<std::string>& list, int index) {
+    out.append(list[static_cast<size_t>(index)]);
+}
+
+void Generator::appendRandomString(int minLen, int maxLen) {
+    std::string& out = *m_out;
     int type = randomInt(0, 4);
 
     switch (type) {
         case 0: // Имя
-            return FIRST_NAMES[randomInt(0, FIRST_NAMES.size() - 1)];
+            appendFrom(out, FIRST_NAMES, randomInt(0, FIRST_NAMES.size() - 1));
+            break;
         case 1: // Фамилия
-            return LAST_NAMES[randomInt(0, LAST_NAMES.size() - 1)];
+            appendFrom(out, LAST_NAMES, randomInt(0, LAST_NAMES.size() - 1));
+            break;
         case 2: // Город
-            return CITIES[randomInt(0, CITIES.size() - 1)];
+            appendFrom(out, CITIES, randomInt(0, CITIES.size() - 1));
+            break;
         case 3: // Продукт
-            return PRODUCTS[randomInt(0, PRODUCTS.size() - 1)];
+            appendFrom(out, PRODUCTS, randomInt(0, PRODUCTS.size() - 1));
+            break;
         default: { // Случайная строка
-            static const std::string chars = "abcdefghijklmnopqrstuvwxyz0123456789";
+            static const char chars[] = "abcdefghijklmnopqrstuvwxyz0123456789";
             int len = randomInt(minLen, maxLen);
-            std::string result;
             for (int i = 0; i < len; ++i) {
-                result += chars[randomInt(0, chars.size() - 1)];
+                out.push_back(chars[randomInt(0, sizeof(chars) - 2)]);
             }
-            return result;
+            break;
         }
     }
 }
 
-std::string Generator::randomKey() {
-    if (randomBool()) {
-        return KEYS[randomInt(0, KEYS.size() - 1)] + std::to_string(randomInt(1, 99));
+void Generator::randomKey(std::string& key) {
+    bool withSuffix = randomBool();
+    key.assign(KEYS[randomInt(0, KEYS.size() - 1)]);
+    if (withSuffix) {
+        char buf[4];
+        auto res = std::to_chars(buf, buf + sizeof(buf), randomInt(1, 99));
+        key.append(buf, res.ptr - buf);
     }
-    return KEYS[randomInt(0, KEYS.size() - 1)];
 }
 
-void Generator::updatePosition(const std::string& str) {
-    for (char c : str) {
-        if (c == '\n') {
-            m_currentLine++;
-            m_currentColumn = 1;
-        } else {
-            m_currentColumn++;
-        }
+void Generator::appendIndent(int width) {
+    if (width > 0) {
+        m_out->append(static_cast<size_t>(width), ' ');
     }
 }
 
-std::string Generator::generateString() {
-    std::string str = randomString();
+void Generator::appendString() {
+    std::string& out = *m_out;
+    out.push_back('"');
+    appendRandomString();
     // Иногда добавляем escape-последовательности
     if (randomInt(0, 10) == 0) {
         int escapeType = randomInt(0, 3);
         switch (escapeType) {
-            case 0: str += "\\n"; break;
-            case 1: str += "\\t"; break;
-            case 2: str += "\\\""; break;
-            case 3: str += "\\\\"; break;
+            case 0: out.append("\\n", 2); break;
+            case 1: out.append("\\t", 2); break;
+            case 2: out.append("\\\"", 2); break;
+            case 3: out.append("\\\\", 2); break;
         }
     }
-    return "\"" + str + "\"";
+    out.push_back('"');
 }
 
-std::string Generator::generateNumber() {
+void Generator::appendNumber() {
     int type = randomInt(0, 3);
-    std::ostringstream oss;
+    char buf[64];
+    int len = 0;
 
     switch (type) {
-        case 0: // Целое положительное
-            oss << randomInt(0, 10000);
+        case 0: { // Целое положительное
+            auto res = std::to_chars(buf, buf + sizeof(buf), randomInt(0, 10000));
+            len = static_cast<int>(res.ptr - buf);
             break;
-        case 1: // Целое отрицательное
-            oss << -randomInt(1, 10000);
+        }
+        case 1: { // Целое отрицательное
+            auto res = std::to_chars(buf, buf + sizeof(buf), -randomInt(1, 10000));
+            len = static_cast<int>(res.ptr - buf);
             break;
-        case 2: // Дробное
-            oss << std::fixed;
-            oss.precision(randomInt(1, 4));
-            oss << randomDouble(-1000.0, 1000.0);
+        }
+        case 2: { // Дробное
+            int precision = randomInt(1, 4);
+            len = std::snprintf(buf, sizeof(buf), "%.*f", precision, randomDouble(-1000.0, 1000.0));
             break;
-        case 3: // Научная нотация
-            oss << randomDouble(1.0, 9.99) << "e" << randomInt(-10, 10);
+        }
+        case 3: { // Научная нотация
+            double mantissa = randomDouble(1.0, 9.99);
+            int exponent = randomInt(-10, 10);
+            len = std::snprintf(buf, sizeof(buf), "%ge%d", mantissa, exponent);
             break;
+        }
     }
 
-    return oss.str();
+    m_out->append(buf, static_cast<size_t>(len));
 }
 
-std::string Generator::generateBool() {
-    return randomBool() ? "true" : "false";
+void Generator::appendBool() {
+    if (randomBool()) {
+        m_out->append("true", 4);
+    } else {
+        m_out->append("false", 5);
+    }
 }
 
-std::string Generator::generateNull() {
-    return "null";
+void Generator::appendNull() {
+    m_out->append("null", 4);
 }
 
-std::string Generator::generateValue(int depth) {
+void Generator::appendValue(int depth) {
     // На максимальной глубине генерируем только примитивы
     if (depth >= m_options.maxDepth) {
         int type = randomInt(0, 3);
         switch (type) {
-            case 0: return generateString();
-            case 1: return generateNumber();
-            case 2: return generateBool();
-            case 3: return generateNull();
+            case 0: appendString(); return;
+            case 1: appendNumber(); return;
+            case 2: appendBool(); return;
+            default: appendNull(); return;
         }
     }
 
     // Выбираем тип значения
     int type = randomInt(0, 5);
     switch (type) {
-        case 0: return generateObject(depth + 1);
-        case 1: return generateArray(depth + 1);
-        case 2: return generateString();
-        case 3: return generateNumber();
-        case 4: return generateBool();
-        case 5: return generateNull();
+        case 0: appendObject(depth + 1); return;
+        case 1: appendArray(depth + 1); return;
+        case 2: appendString(); return;
+        case 3: appendNumber(); return;
+        case 4: appendBool(); return;
+        default: appendNull(); return;
     }
-
-    return generateNull();
 }
 
-std::string Generator::generateObject(int depth) {
-    std::ostringstream oss;
+void Generator::appendObject(int depth) {
     int keyCount = randomInt(m_options.minObjectKeys, m_options.maxObjectKeys);
-    std::vector<std::string> usedKeys;
-
-    if (m_options.compactOutput) {
-        oss << "{";
-        for (int i = 0; i < keyCount; ++i) {
-            std::string key;
-            do {
-                key = randomKey();
-            } while (std::find(usedKeys.begin(), usedKeys.end(), key) != usedKeys.end());
-            usedKeys.push_back(key);
+    bool compact = m_options.compactOutput;
 
-            if (i > 0) {
-                oss << ",";
-            }
-            oss << "\"" << key << "\":" << generateValue(depth);
-        }
-        oss << "}";
-        return oss.str();
+    // Набор ключей своего уровня; вложенные объекты используют следующий уровень
+    if (m_usedKeys.size() <= static_cast<size_t>(depth)) {
+        m_usedKeys.resize(depth + 1);
     }
+    m_usedKeys[depth].clear();
 
-    oss << "{\n";
+    m_out->append(compact ? "{" : "{\n");
 
     for (int i = 0; i < keyCount; ++i) {
         // Генерируем уникальный ключ
-        std::string key;
+        std::vector<std::string>& usedKeys = m_usedKeys[depth];
         do {
-            key = randomKey();
-        } while (std::find(usedKeys.begin(), usedKeys.end(), key) != usedKeys.end());
-        usedKeys.push_back(key);
+            randomKey(m_keyBuffer);
+        } while (std::find(usedKeys.begin(), usedKeys.end(), m_keyBuffer) != usedKeys.end());
+        usedKeys.push_back(m_keyBuffer);
 
-        // Отступы
-        std::string indent(depth * 2, ' ');
-        oss << indent << "\"" << key << "\": " << generateValue(depth);
-
-        if (i < keyCount - 1) {
-            oss << ",";
+        if (compact) {
+            if (i > 0) {
+                m_out->push_back(',');
+            }
+            m_out->push_back('"');
+            m_out->append(m_keyBuffer);
+            m_out->append("\":", 2);
+            appendValue(depth);
+        } else {
+            appendIndent(depth * 2);
+            m_out->push_back('"');
+            m_out->append(m_keyBuffer);
+            m_out->append("\": ", 3);
+            appendValue(depth);
+            if (i < keyCount - 1) {
+                m_out->push_back(',');
+            }
+            m_out->push_back('\n');
         }
-        oss << "\n";
     }
 
-    std::string closeIndent((depth - 1) * 2, ' ');
-    oss << closeIndent << "}";
-
-    return oss.str();
+    if (!compact) {
+        appendIndent((depth - 1) * 2);
+    }
+    m_out->push_back('}');
 }
 
-std::string Generator::generateArray(int depth) {
-    std::ostringstream oss;
+void Generator::appendArray(int depth) {
     int size = randomInt(m_options.minArraySize, m_options.maxArraySize);
 
     if (m_options.compactOutput) {
-        oss << "[";
+        m_out->push_back('[');
         for (int i = 0; i < size; ++i) {
             if (i > 0) {
-                oss << ",";
+                m_out->push_back(',');
             }
-            oss << generateValue(depth);
+            appendValue(depth);
         }
-        oss << "]";
-        return oss.str();
+        m_out->push_back(']');
+        return;
     }
 
-    oss << "[\n";
+    m_out->append("[\n", 2);
 
     for (int i = 0; i < size; ++i) {
-        std::string indent(depth * 2, ' ');
-        oss << indent << generateValue(depth);
+        appendIndent(depth * 2);
+        appendValue(depth);
 
         if (i < size - 1) {
-            oss << ",";
+            m_out->push_back(',');
         }
-        oss << "\n";
+        m_out->push_back('\n');
     }
 
-    std::string closeIndent((depth - 1) * 2, ' ');
-    oss << closeIndent << "]";
-
-    return oss.str();
+    appendIndent((depth - 1) * 2);
+    m_out->push_back(']');
 }
 
 ErrorType Generator::selectRandomError() {
@@ -283,99 +318,99 @@ std::string Generator::getErrorDescription(ErrorType type) {
     }
 }
 
-std::string Generator::injectError(const std::string& json, ErrorType errorType) {
-    std::string result = json;
-    size_t pos;
+void Generator::injectError(std::string& json, size_t start, ErrorType errorType) {
+    const size_t npos = std::string::npos;
+    size_t pos = npos;
 
     GeneratedError error;
     error.type = errorType;
     error.description = getErrorDescription(errorType);
 
+    // Поиск с конца не должен выходить за начало текущего элемента
+    auto rfindFrom = [&json, start, npos](const char* pattern) {
+        size_t found = json.rfind(pattern);
+        return (found != npos && found >= start) ? found : npos;
+    };
+
     switch (errorType) {
         case ErrorType::MissingComma:
             // Удаляем случайную запятую
-            pos = result.find(",\n");
-            if (pos != std::string::npos && pos > 10) {
-                // Находим случайную позицию запятой
+            pos = json.find(",\n", start);
+            if (pos != npos && pos > start + 10) {
                 std::vector<size_t> commaPositions;
-                size_t searchPos = 0;
-                while ((searchPos = result.find(",\n", searchPos)) != std::string::npos) {
+                size_t searchPos = start;
+                while ((searchPos = json.find(",\n", searchPos)) != npos) {
                     commaPositions.push_back(searchPos);
                     searchPos++;
                 }
-                if (!commaPositions.empty()) {
-                    pos = commaPositions[randomInt(0, commaPositions.size() - 1)];
-                    result.erase(pos, 1);
-                }
+                pos = commaPositions[randomInt(0, commaPositions.size() - 1)];
+                json.erase(pos, 1);
             }
             break;
 
         case ErrorType::MissingColon:
             // Удаляем случайное двоеточие
-            pos = result.find("\": ");
-            if (pos != std::string::npos) {
+            pos = json.find("\": ", start);
+            if (pos != npos) {
                 std::vector<size_t> colonPositions;
-                size_t searchPos = 0;
-                while ((searchPos = result.find("\": ", searchPos)) != std::string::npos) {
+                size_t searchPos = start;
+                while ((searchPos = json.find("\": ", searchPos)) != npos) {
                     colonPositions.push_back(searchPos + 1);
                     searchPos++;
                 }
-                if (!colonPositions.empty()) {
-                    pos = colonPositions[randomInt(0, colonPositions.size() - 1)];
-                    result.erase(pos, 1);
-                }
+                pos = colonPositions[randomInt(0, colonPositions.size() - 1)];
+                json.erase(pos, 1);
             }
             break;
 
-        case ErrorType::MissingQuote:
+        case ErrorType::MissingQuote: {
             // Удаляем закрывающую кавычку у строки
-            pos = result.rfind("\"");
-            if (pos > 5) {
+            size_t length = json.size() - start;
+            pos = rfindFrom("\"");
+            if (pos != npos && pos > start + 5 && length / 2 >= 5) {
                 // Ищем строковое значение
-                size_t searchPos = randomInt(5, result.size() / 2);
-                pos = result.find("\",", searchPos);
-                if (pos == std::string::npos) {
-                    pos = result.find("\"\n", searchPos);
+                size_t searchPos = start + randomInt(5, static_cast<int>(length / 2));
+                pos = json.find("\",", searchPos);
+                if (pos == npos) {
+                    pos = json.find("\"\n", searchPos);
                 }
-                if (pos != std::string::npos) {
-                    result.erase(pos, 1);
+                if (pos != npos) {
+                    json.erase(pos, 1);
                 }
             }
             break;
+        }
 
         case ErrorType::MissingBracket:
             // Удаляем закрывающую скобку
-            if (randomBool()) {
-                pos = result.rfind("}");
-            } else {
-                pos = result.rfind("]");
-            }
-            if (pos != std::string::npos && pos > 5) {
-                result.erase(pos, 1);
+            pos = randomBool() ? rfindFrom("}") : rfindFrom("]");
+            if (pos != npos && pos > start + 5) {
+                json.erase(pos, 1);
             }
             break;
 
         case ErrorType::ExtraComma:
             // Добавляем запятую перед закрывающей скобкой
-            pos = result.rfind("\n}");
-            if (pos == std::string::npos) {
-                pos = result.rfind("\n]");
+            pos = rfindFrom("\n}");
+            if (pos == npos) {
+                pos = rfindFrom("\n]");
             }
-            if (pos != std::string::npos) {
-                result.insert(pos, ",");
+            if (pos != npos) {
+                json.insert(pos, 1, ',');
             }
             break;
 
         case ErrorType::InvalidNumber:
             // Заменяем число на некорректное
-            pos = result.find(": ");
-            if (pos != std::string::npos) {
+            pos = json.find(": ", start);
+            if (pos != npos) {
                 std::vector<size_t> numPositions;
-                size_t searchPos = 0;
-                while ((searchPos = result.find(": ", searchPos)) != std::string::npos) {
+                size_t searchPos = start;
+                while ((searchPos = json.find(": ", searchPos)) != npos) {
                     // Проверяем, что это число
-                    if (searchPos + 2 < result.size() &&
-                        (std::isdigit(result[searchPos + 2]) || result[searchPos + 2] == '-')) {
+                    if (searchPos + 2 < json.size() &&
+                        (std::isdigit(static_cast<unsigned char>(json[searchPos + 2])) ||
+                         json[searchPos + 2] == '-')) {
                         numPositions.push_back(searchPos + 2);
                     }
                     searchPos++;
@@ -384,29 +419,30 @@ std::string Generator::injectError(const std::string& json, ErrorType errorType)
                     pos = numPositions[randomInt(0, numPositions.size() - 1)];
                     // Находим конец числа
                     size_t endPos = pos;
-                    while (endPos < result.size() &&
-                           (std::isdigit(result[endPos]) || result[endPos] == '.' ||
-                            result[endPos] == '-' || result[endPos] == 'e' || result[endPos] == 'E')) {
+                    while (endPos < json.size() &&
+                           (std::isdigit(static_cast<unsigned char>(json[endPos])) ||
+                            json[endPos] == '.' || json[endPos] == '-' ||
+                            json[endPos] == 'e' || json[endPos] == 'E')) {
                         endPos++;
                     }
-                    result.replace(pos, endPos - pos, "1.2.3.4");
+                    json.replace(pos, endPos - pos, "1.2.3.4");
                 }
             }
             break;
 
         case ErrorType::InvalidKeyword:
             // Заменяем true/false/null на неправильный вариант
-            pos = result.find("true");
-            if (pos != std::string::npos) {
-                result.replace(pos, 4, "True");
+            pos = json.find("true", start);
+            if (pos != npos) {
+                json[pos] = 'T';
             } else {
-                pos = result.find("false");
-                if (pos != std::string::npos) {
-                    result.replace(pos, 5, "False");
+                pos = json.find("false", start);
+                if (pos != npos) {
+                    json[pos] = 'F';
                 } else {
-                    pos = result.find("null");
-                    if (pos != std::string::npos) {
-                        result.replace(pos, 4, "Null");
+                    pos = json.find("null", start);
+                    if (pos != npos) {
+                        json[pos] = 'N';
                     }
                 }
             }
@@ -414,41 +450,43 @@ std::string Generator::injectError(const std::string& json, ErrorType errorType)
 
         case ErrorType::UnquotedKey:
             // Удаляем кавычки вокруг ключа
-            pos = result.find("  \"");
-            if (pos != std::string::npos) {
-                size_t endQuote = result.find("\":", pos + 3);
-                if (endQuote != std::string::npos) {
-                    result.erase(endQuote, 1);
-                    result.erase(pos + 2, 1);
+            pos = json.find("  \"", start);
+            if (pos != npos) {
+                size_t endQuote = json.find("\":", pos + 3);
+                if (endQuote != npos) {
+                    json.erase(endQuote, 1);
+                    json.erase(pos + 2, 1);
                 }
             }
             break;
 
         case ErrorType::SingleQuotes:
             // Заменяем двойные кавычки на одинарные
-            pos = result.find("\"", 5);
-            if (pos != std::string::npos) {
-                result[pos] = '\'';
-                size_t nextQuote = result.find("\"", pos + 1);
-                if (nextQuote != std::string::npos) {
-                    result[nextQuote] = '\'';
+            pos = json.find('"', start + 5);
+            if (pos != npos) {
+                json[pos] = '\'';
+                size_t nextQuote = json.find('"', pos + 1);
+                if (nextQuote != npos) {
+                    json[nextQuote] = '\'';
                 }
             }
             break;
 
         case ErrorType::TrailingData:
             // Добавляем мусор в конец
-            result += "\n{\"extra\": \"data\"}";
+            pos = json.size();
+            json.append("\n{\"extra\": \"data\"}");
             break;
 
         default:
             break;
     }
 
-    // Вычисляем примерную позицию ошибки
+    // Позиция ошибки относительно начала элемента (считается только здесь)
     int line = 1, col = 1;
-    for (size_t i = 0; i < std::min(pos, result.size()); ++i) {
-        if (result[i] == '\n') {
+    size_t limit = std::min(pos, json.size());
+    for (size_t i = start; i < limit; ++i) {
+        if (json[i] == '\n') {
             line++;
             col = 1;
         } else {
@@ -459,53 +497,56 @@ std::string Generator::injectError(const std::string& json, ErrorType errorType)
     error.column = col;
 
     m_errors.push_back(error);
-
-    return result;
 }
 
-std::string Generator::generate() {
-    m_errors.clear();
-    m_currentLine = 1;
-    m_currentColumn = 1;
-
-    std::string json;
-
+void Generator::appendRoot() {
     // Генерируем корневой элемент (объект или массив)
     if (randomBool()) {
-        json = generateObject(1);
+        appendObject(1);
     } else {
-        json = generateArray(1);
+        appendArray(1);
     }
+}
+
+void Generator::generateInto(std::string& out) {
+    if (m_usedKeys.size() < static_cast<size_t>(m_options.maxDepth) + 2) {
+        m_usedKeys.resize(static_cast<size_t>(m_options.maxDepth) + 2);
+    }
+
+    size_t start = out.size();
+    m_out = &out;
+    appendRoot();
+    m_out = nullptr;
 
     // Если нужно внести ошибки
     if (m_options.errorProbability > 0 && shouldGenerateError()) {
         ErrorType errorType = selectRandomError();
-        json = injectError(json, errorType);
+        injectError(out, start, errorType);
     }
+}
 
+std::string Generator::generate() {
+    m_errors.clear();
+
+    std::string json;
+    generateInto(json);
     return json;
 }
 
 std::string Generator::generateWithErrors(int errorCount) {
     m_errors.clear();
-    m_currentLine = 1;
-    m_currentColumn = 1;
 
     // Временно отключаем случайные ошибки
     int savedProbability = m_options.errorProbability;
     m_options.errorProbability = 0;
 
     std::string json;
-    if (randomBool()) {
-        json = generateObject(1);
-    } else {
-        json = generateArray(1);
-    }
+    generateInto(json);
 
     // Вносим заданное количество ошибок
     for (int i = 0; i < errorCount; ++i) {
         ErrorType errorType = selectRandomError();
-        json = injectError(json, errorType);
+        injectError(json, 0, errorType);
     }
 
     m_options.errorProbability = savedProbability;
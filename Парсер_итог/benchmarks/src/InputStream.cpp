@@ -0,0 +1,435 @@
+#include "InputStream.hpp"
+#include "JsonValue.hpp"
+#include "MappedFile.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef JSON_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef JSON_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace json {
+
+namespace {
+
+constexpr size_t READ_BLOCK = 1024 * 1024;
+
+// Несжатый файл
+class PlainInput : public InputStream {
+private:
+    std::ifstream m_file;
+
+public:
+    PlainInput(const std::string& filename) : m_file(filename, std::ios::binary | std::ios::ate) {
+        if (!m_file.is_open()) {
+            throw JsonException("Не удалось открыть файл: " + filename);
+        }
+        m_fileSize = static_cast<uint64_t>(m_file.tellg());
+        m_file.seekg(0);
+    }
+
+    size_t read(char* buffer, size_t size) override {
+        if (!m_file.good()) return 0;
+        m_file.read(buffer, static_cast<std::streamsize>(size));
+        if (m_file.bad()) {
+            throw JsonException("Ошибка чтения файла");
+        }
+        size_t count = static_cast<size_t>(m_file.gcount());
+        m_position += count;
+        return count;
+    }
+
+    Compression compression() const override { return Compression::None; }
+};
+
+#ifdef JSON_HAVE_ZLIB
+
+// gzip: члены, склеенные подряд (как у pigz или cat a.gz b.gz), читаются
+// один за другим. Границы членов без распаковки не найти, поэтому
+// распаковка последовательная.
+class GzipInput : public InputStream {
+private:
+    std::ifstream m_file;
+    std::vector<char> m_input;
+    z_stream m_zs{};
+    bool m_inMember = false;        // Член начат и ещё не закончен
+
+public:
+    GzipInput(const std::string& filename)
+        : m_file(filename, std::ios::binary | std::ios::ate), m_input(256 * 1024) {
+        if (!m_file.is_open()) {
+            throw JsonException("Не удалось открыть файл: " + filename);
+        }
+        m_fileSize = static_cast<uint64_t>(m_file.tellg());
+        m_file.seekg(0);
+        // 16 + MAX_WBITS - только заголовок gzip
+        if (inflateInit2(&m_zs, 16 + MAX_WBITS) != Z_OK) {
+            throw JsonException("Не удалось инициализировать zlib");
+        }
+    }
+
+    ~GzipInput() override {
+        inflateEnd(&m_zs);
+    }
+
+    size_t read(char* buffer, size_t size) override {
+        m_zs.next_out = reinterpret_cast<Bytef*>(buffer);
+        m_zs.avail_out = static_cast<uInt>(std::min<size_t>(size, UINT32_MAX));
+        uInt requested = m_zs.avail_out;
+
+        while (m_zs.avail_out > 0) {
+            if (m_zs.avail_in == 0) {
+                m_file.read(m_input.data(), static_cast<std::streamsize>(m_input.size()));
+                if (m_file.bad()) {
+                    throw JsonException("Ошибка чтения файла");
+                }
+                size_t count = static_cast<size_t>(m_file.gcount());
+                if (count == 0) {
+                    if (m_inMember) {
+                        throw JsonException("Сжатый поток gzip обрывается");
+                    }
+                    break;
+                }
+                m_position += count;
+                m_zs.next_in = reinterpret_cast<Bytef*>(m_input.data());
+                m_zs.avail_in = static_cast<uInt>(count);
+            }
+
+            if (!m_inMember) {
+                inflateReset(&m_zs);
+                m_inMember = true;
+            }
+
+            int status = inflate(&m_zs, Z_NO_FLUSH);
+            if (status == Z_STREAM_END) {
+                m_inMember = false;
+            } else if (status != Z_OK && !(status == Z_BUF_ERROR && m_zs.avail_in == 0)) {
+                throw JsonException(std::string("Повреждённые данные gzip: ") +
+                                    (m_zs.msg ? m_zs.msg : std::to_string(status)));
+            }
+        }
+        return requested - m_zs.avail_out;
+    }
+
+    Compression compression() const override { return Compression::Gzip; }
+};
+
+#endif // JSON_HAVE_ZLIB
+
+#ifdef JSON_HAVE_ZSTD
+
+// zstd: файл отображается в память и делится на кадры по их заголовкам.
+// Несколько кадров (zstd -T, pzstd, склеенные файлы) распаковываются
+// рабочими потоками, каждый кадр целиком в свой буфер; read() выдаёт
+// буферы по порядку. Вперёд распаковывается не больше окна кадров.
+// Один кадр или один поток - потоковая распаковка без рабочих потоков.
+class ZstdInput : public InputStream {
+private:
+    struct Frame {
+        size_t offset;
+        size_t size;
+        std::string data;
+        std::string error;          // Ошибка распаковки кадра
+        bool ready = false;
+    };
+
+    MappedFile m_map;
+    std::vector<Frame> m_frames;
+
+    // Последовательный режим
+    ZSTD_DStream* m_stream = nullptr;
+    ZSTD_inBuffer m_in{};
+    size_t m_lastResult = 0;        // 0 - кадр закончен
+
+    // Параллельный режим
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    size_t m_window = 0;
+    size_t m_nextFrame = 0;         // Следующий кадр для рабочих
+    size_t m_current = 0;           // Кадр, который выдаёт read()
+    size_t m_offset = 0;            // Позиция в данных текущего кадра
+    bool m_stop = false;
+
+    static std::string errorText(size_t code) {
+        return std::string("Повреждённые данные zstd: ") + ZSTD_getErrorName(code);
+    }
+
+    static void decompressFrame(ZSTD_DCtx* context, Frame& frame, const char* source) {
+        ZSTD_DCtx_reset(context, ZSTD_reset_session_only);
+        unsigned long long contentSize = ZSTD_getFrameContentSize(source, frame.size);
+        if (contentSize != ZSTD_CONTENTSIZE_UNKNOWN && contentSize != ZSTD_CONTENTSIZE_ERROR) {
+            frame.data.reserve(static_cast<size_t>(contentSize));
+        }
+
+        ZSTD_inBuffer in{source, frame.size, 0};
+        while (true) {
+            size_t used = frame.data.size();
+            size_t grow = std::max(ZSTD_DStreamOutSize(), frame.data.capacity() - used);
+            frame.data.resize(used + grow);
+            ZSTD_outBuffer out{&frame.data[used], grow, 0};
+            size_t result = ZSTD_decompressStream(context, &out, &in);
+            frame.data.resize(used + out.pos);
+            if (ZSTD_isError(result)) {
+                throw JsonException(errorText(result));
+            }
+            if (result == 0) {
+                return;
+            }
+            if (in.pos == in.size && out.pos < out.size) {
+                throw JsonException("Кадр zstd обрывается");
+            }
+        }
+    }
+
+    void workerLoop() {
+        JSON_TRACE_THREAD_NAME("zstd worker");
+        ZSTD_DCtx* context = ZSTD_createDCtx();
+        while (true) {
+            size_t index;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock, [this]() {
+                    return m_stop || m_nextFrame >= m_frames.size() || m_nextFrame < m_current + m_window;
+                });
+                if (m_stop || m_nextFrame >= m_frames.size()) break;
+                index = m_nextFrame++;
+            }
+
+            // Кадр пишется без мьютекса: до ready его никто не читает
+            Frame& frame = m_frames[index];
+            try {
+                JSON_TRACE_SCOPE("zstd frame");
+                if (!context) {
+                    throw JsonException("Не удалось создать контекст zstd");
+                }
+                decompressFrame(context, frame, m_map.data() + frame.offset);
+            } catch (const std::exception& e) {
+                frame.error = e.what();
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            frame.ready = true;
+            m_cv.notify_all();
+        }
+        ZSTD_freeDCtx(context);
+    }
+
+    size_t readSequential(char* buffer, size_t size) {
+        ZSTD_outBuffer out{buffer, size, 0};
+        while (out.pos < out.size) {
+            if (m_in.pos == m_in.size && m_lastResult == 0) {
+                break;
+            }
+            size_t before = out.pos;
+            size_t result = ZSTD_decompressStream(m_stream, &out, &m_in);
+            if (ZSTD_isError(result)) {
+                throw JsonException(errorText(result));
+            }
+            m_lastResult = result;
+            if (m_in.pos == m_in.size && result != 0 && out.pos == before) {
+                throw JsonException("Кадр zstd обрывается");
+            }
+        }
+        m_position = m_in.pos;
+        return out.pos;
+    }
+
+    size_t readParallel(char* buffer, size_t size) {
+        size_t done = 0;
+        while (done < size && m_current < m_frames.size()) {
+            Frame& frame = m_frames[m_current];
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock, [&frame]() { return frame.ready; });
+            }
+            if (!frame.error.empty()) {
+                throw JsonException(frame.error);
+            }
+
+            size_t count = std::min(size - done, frame.data.size() - m_offset);
+            std::memcpy(buffer + done, frame.data.data() + m_offset, count);
+            done += count;
+            m_offset += count;
+
+            if (m_offset == frame.data.size()) {
+                std::string().swap(frame.data);
+                m_offset = 0;
+                m_position = frame.offset + frame.size;
+                std::lock_guard<std::mutex> lock(m_mutex);
+                ++m_current;
+                m_cv.notify_all();
+            }
+        }
+        return done;
+    }
+
+public:
+    ZstdInput(const std::string& filename, unsigned int threads) {
+        if (!m_map.open(filename)) {
+            throw JsonException("Не удалось открыть файл: " + filename);
+        }
+        m_fileSize = m_map.size();
+
+        // Границы кадров по заголовкам; при ошибке - последовательно,
+        // тогда ошибка всплывёт в read() на своём месте
+        bool split = true;
+        for (size_t pos = 0; pos < m_map.size();) {
+            size_t size = ZSTD_findFrameCompressedSize(m_map.data() + pos, m_map.size() - pos);
+            if (ZSTD_isError(size)) {
+                split = false;
+                break;
+            }
+            m_frames.push_back(Frame{pos, size, {}, {}, false});
+            pos += size;
+        }
+
+        if (threads == 0) {
+            threads = std::thread::hardware_concurrency();
+        }
+        if (!split || m_frames.size() < 2 || threads < 2) {
+            m_frames.clear();
+            m_stream = ZSTD_createDStream();
+            if (!m_stream) {
+                throw JsonException("Не удалось создать контекст zstd");
+            }
+            m_in = ZSTD_inBuffer{m_map.data(), m_map.size(), 0};
+            return;
+        }
+
+        size_t workerCount = std::min<size_t>(threads, m_frames.size());
+        m_window = workerCount * 2;
+        for (size_t i = 0; i < workerCount; ++i) {
+            m_workers.emplace_back(&ZstdInput::workerLoop, this);
+        }
+    }
+
+    ~ZstdInput() override {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        for (auto& worker : m_workers) {
+            worker.join();
+        }
+        if (m_stream) {
+            ZSTD_freeDStream(m_stream);
+        }
+    }
+
+    size_t read(char* buffer, size_t size) override {
+        return m_stream ? readSequential(buffer, size) : readParallel(buffer, size);
+    }
+
+    Compression compression() const override { return Compression::Zstd; }
+};
+
+#endif // JSON_HAVE_ZSTD
+
+} // namespace
+
+Compression detectCompression(std::string_view prefix) {
+    if (prefix.size() >= 2 && static_cast<unsigned char>(prefix[0]) == 0x1f &&
+        static_cast<unsigned char>(prefix[1]) == 0x8b) {
+        return Compression::Gzip;
+    }
+    if (prefix.size() >= 4 && std::memcmp(prefix.data(), "\x28\xb5\x2f\xfd", 4) == 0) {
+        return Compression::Zstd;
+    }
+    return Compression::None;
+}
+
+const char* compressionName(Compression compression) {
+    switch (compression) {
+        case Compression::None: return "нет";
+        case Compression::Gzip: return "gzip";
+        case Compression::Zstd: return "zstd";
+    }
+    return "?";
+}
+
+bool compressionAvailable(Compression compression) {
+    switch (compression) {
+        case Compression::None:
+            return true;
+        case Compression::Gzip:
+#ifdef JSON_HAVE_ZLIB
+            return true;
+#else
+            return false;
+#endif
+        case Compression::Zstd:
+#ifdef JSON_HAVE_ZSTD
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+bool isCompressedExtension(const std::string& extension) {
+    return extension == ".gz" || extension == ".zst";
+}
+
+std::string InputStream::readAll() {
+    std::string content;
+    if (compression() == Compression::None && m_fileSize > m_position) {
+        content.reserve(static_cast<size_t>(m_fileSize - m_position));
+    }
+    while (true) {
+        size_t used = content.size();
+        size_t block = std::max(READ_BLOCK, content.capacity() - used);
+        content.resize(used + block);
+        size_t count = read(&content[used], block);
+        content.resize(used + count);
+        if (count == 0) break;
+    }
+    return content;
+}
+
+std::unique_ptr<InputStream> InputStream::open(const std::string& filename, unsigned int threads) {
+    char magic[4];
+    size_t magicSize;
+    {
+        std::ifstream probe(filename, std::ios::binary);
+        if (!probe.is_open()) {
+            throw JsonException("Не удалось открыть файл: " + filename);
+        }
+        probe.read(magic, sizeof(magic));
+        magicSize = static_cast<size_t>(probe.gcount());
+    }
+
+    Compression compression = detectCompression(std::string_view(magic, magicSize));
+    if (!compressionAvailable(compression)) {
+        throw JsonException(std::string("Сжатие ") + compressionName(compression) +
+                            " не поддерживается этой сборкой: " + filename);
+    }
+    switch (compression) {
+#ifdef JSON_HAVE_ZLIB
+        case Compression::Gzip:
+            return std::make_unique<GzipInput>(filename);
+#endif
+#ifdef JSON_HAVE_ZSTD
+        case Compression::Zstd:
+            return std::make_unique<ZstdInput>(filename, threads);
+#endif
+        default:
+            (void)threads;
+            return std::make_unique<PlainInput>(filename);
+    }
+}
+
+} // namespace json
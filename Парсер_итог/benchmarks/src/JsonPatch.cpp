@@ -0,0 +1,366 @@
+#include "JsonPatch.hpp"
+#include <algorithm>
+
+namespace json {
+
+namespace {
+
+JsonValue makeOperation(const char* op, const std::string& path) {
+    JsonObject operation;
+    operation["op"] = op;
+    operation["path"] = path;
+    return JsonValue(std::move(operation));
+}
+
+JsonValue makeOperation(const char* op, const std::string& path, const JsonValue& value) {
+    JsonValue operation = makeOperation(op, path);
+    operation["value"] = value;
+    return operation;
+}
+
+bool scalarEqual(const JsonValue& a, const JsonValue& b) {
+    if (a.isNumber() && b.isNumber()) {
+        if (a.isRawNumber() && b.isRawNumber() && a.numberText() == b.numberText()) {
+            return true;
+        }
+        try {
+            return a.asNumber() == b.asNumber();
+        } catch (const JsonException&) {
+            return false;       // Запись вне диапазона double и разный текст
+        }
+    }
+    if (a.type() != b.type()) return false;
+    switch (a.type()) {
+        case JsonValue::Type::Null:   return true;
+        case JsonValue::Type::Bool:   return a.asBool() == b.asBool();
+        case JsonValue::Type::String: return a.asString() == b.asString();
+        default:                      return false;
+    }
+}
+
+// Спуск по дереву: path - JSON Pointer текущего узла (дописывается и
+// восстанавливается по ходу обхода). Узлы заведомо различаются: детей
+// вызывающий сравнивает через JsonPatch::equal, поэтому хэш считается
+// только у поддеревьев, не разделяемых копиями.
+void diffValues(const JsonValue& from, const JsonValue& to, std::string& path, JsonArray& ops) {
+    if (from.isObject() && to.isObject()) {
+        const JsonObject& a = from.asObject();
+        const JsonObject& b = to.asObject();
+        size_t base = path.size();
+
+        // Ключи упорядочены: слияние двух отсортированных списков
+        auto left = a.begin();
+        auto right = b.begin();
+        while (left != a.end() || right != b.end()) {
+            if (right == b.end() || (left != a.end() && left->first < right->first)) {
+                path += '/';
+                path += JsonPatch::escapeToken(left->first);
+                ops.push_back(makeOperation("remove", path));
+                ++left;
+            } else if (left == a.end() || right->first < left->first) {
+                path += '/';
+                path += JsonPatch::escapeToken(right->first);
+                ops.push_back(makeOperation("add", path, right->second));
+                ++right;
+            } else {
+                if (!JsonPatch::equal(left->second, right->second)) {
+                    path += '/';
+                    path += JsonPatch::escapeToken(left->first);
+                    diffValues(left->second, right->second, path, ops);
+                }
+                ++left;
+                ++right;
+            }
+            path.resize(base);
+        }
+        return;
+    }
+
+    if (from.isArray() && to.isArray()) {
+        const JsonArray& a = from.asArray();
+        const JsonArray& b = to.asArray();
+        size_t base = path.size();
+
+        // Общие начало и конец
+        size_t prefix = 0;
+        while (prefix < a.size() && prefix < b.size() && JsonPatch::equal(a[prefix], b[prefix])) {
+            ++prefix;
+        }
+        size_t suffix = 0;
+        while (suffix < a.size() - prefix && suffix < b.size() - prefix &&
+               JsonPatch::equal(a[a.size() - 1 - suffix], b[b.size() - 1 - suffix])) {
+            ++suffix;
+        }
+
+        size_t removed = a.size() - prefix - suffix;
+        size_t added = b.size() - prefix - suffix;
+        size_t common = std::min(removed, added);
+
+        for (size_t i = prefix; i < prefix + common; ++i) {
+            if (!JsonPatch::equal(a[i], b[i])) {
+                path += '/';
+                path += std::to_string(i);
+                diffValues(a[i], b[i], path, ops);
+                path.resize(base);
+            }
+        }
+
+        // Лишние элементы удаляются с одной позиции: следующие сдвигаются
+        size_t position = prefix + common;
+        path += '/';
+        path += std::to_string(position);
+        for (size_t i = common; i < removed; ++i) {
+            ops.push_back(makeOperation("remove", path));
+        }
+        path.resize(base);
+
+        for (size_t i = common; i < added; ++i) {
+            path += '/';
+            path += std::to_string(prefix + i);
+            ops.push_back(makeOperation("add", path, b[prefix + i]));
+            path.resize(base);
+        }
+        return;
+    }
+
+    if (!JsonPatch::equal(from, to)) {
+        ops.push_back(makeOperation("replace", path, to));
+    }
+}
+
+// Индекс массива из сегмента пути (без ведущих нулей, "-" - конец)
+size_t parseIndex(const std::string& token, size_t size, bool allowEnd) {
+    if (allowEnd && token == "-") {
+        return size;
+    }
+    if (token.empty() || (token.size() > 1 && token[0] == '0')) {
+        throw JsonException("Неверный индекс массива в пути: " + token);
+    }
+    size_t index = 0;
+    for (char c : token) {
+        if (c < '0' || c > '9') {
+            throw JsonException("Неверный индекс массива в пути: " + token);
+        }
+        index = index * 10 + static_cast<size_t>(c - '0');
+        if (index > size) {
+            break;
+        }
+    }
+    if (index > size || (!allowEnd && index == size)) {
+        throw JsonException("Индекс за границами массива: " + token);
+    }
+    return index;
+}
+
+// Узел по сегментам [0, count). Для неконстантного документа доступ
+// отделяет путь (copy-on-write), для константного - только читает.
+template<typename Value>
+Value& locate(Value& root, const std::vector<std::string>& tokens, size_t count) {
+    Value* node = &root;
+    for (size_t i = 0; i < count; ++i) {
+        if (node->isObject()) {
+            auto& obj = node->asObject();
+            auto it = obj.find(tokens[i]);
+            if (it == obj.end()) {
+                throw JsonException("Путь не найден: ключ " + tokens[i]);
+            }
+            node = &it->second;
+        } else if (node->isArray()) {
+            auto& arr = node->asArray();
+            node = &arr[parseIndex(tokens[i], arr.size(), false)];
+        } else {
+            throw JsonException("Путь проходит через скалярное значение: " + tokens[i]);
+        }
+    }
+    return *node;
+}
+
+const JsonValue& member(const JsonValue& operation, const char* name) {
+    if (!operation.contains(name)) {
+        throw JsonException(std::string("В операции патча нет поля \"") + name + "\"");
+    }
+    return operation.at(name);
+}
+
+void addValue(JsonValue& root, const std::vector<std::string>& tokens, JsonValue value) {
+    if (tokens.empty()) {
+        root = std::move(value);
+        return;
+    }
+    JsonValue& parent = locate(root, tokens, tokens.size() - 1);
+    const std::string& last = tokens.back();
+    if (parent.isObject()) {
+        parent.asObject()[last] = std::move(value);
+    } else if (parent.isArray()) {
+        JsonArray& arr = parent.asArray();
+        size_t index = parseIndex(last, arr.size(), true);
+        arr.insert(arr.begin() + static_cast<std::ptrdiff_t>(index), std::move(value));
+    } else {
+        throw JsonException("Добавление внутрь скалярного значения: " + last);
+    }
+}
+
+JsonValue removeValue(JsonValue& root, const std::vector<std::string>& tokens) {
+    if (tokens.empty()) {
+        throw JsonException("Нельзя удалить корень документа");
+    }
+    JsonValue& parent = locate(root, tokens, tokens.size() - 1);
+    const std::string& last = tokens.back();
+    JsonValue removed;
+    if (parent.isObject()) {
+        JsonObject& obj = parent.asObject();
+        auto it = obj.find(last);
+        if (it == obj.end()) {
+            throw JsonException("Путь не найден: ключ " + last);
+        }
+        removed = std::move(it->second);
+        obj.erase(it);
+    } else if (parent.isArray()) {
+        JsonArray& arr = parent.asArray();
+        size_t index = parseIndex(last, arr.size(), false);
+        removed = std::move(arr[index]);
+        arr.erase(arr.begin() + static_cast<std::ptrdiff_t>(index));
+    } else {
+        throw JsonException("Удаление внутри скалярного значения: " + last);
+    }
+    return removed;
+}
+
+} // namespace
+
+bool JsonPatch::equal(const JsonValue& a, const JsonValue& b) {
+    if (a.sharesPayloadWith(b)) {
+        return true;
+    }
+    bool aContainer = a.isArray() || a.isObject();
+    bool bContainer = b.isArray() || b.isObject();
+    if (!aContainer && !bContainer) {
+        return scalarEqual(a, b);
+    }
+    if (a.type() != b.type() || a.size() != b.size() || a.hash() != b.hash()) {
+        return false;
+    }
+
+    // Хэш без ключа и обратим: коллизию легко подобрать, поэтому равные
+    // хэши только пропускают к обходу. Хэши детей уже посчитаны, так что
+    // отличающиеся поддеревья по-прежнему отсекаются без обхода.
+    if (a.isArray()) {
+        const JsonArray& left = a.asArray();
+        const JsonArray& right = b.asArray();
+        for (size_t i = 0; i < left.size(); ++i) {
+            if (!equal(left[i], right[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+    const JsonObject& left = a.asObject();
+    const JsonObject& right = b.asObject();
+    for (auto l = left.begin(), r = right.begin(); l != left.end(); ++l, ++r) {
+        if (l->first != r->first || !equal(l->second, r->second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<std::string> JsonPatch::parsePointer(const std::string& pointer) {
+    std::vector<std::string> tokens;
+    if (pointer.empty()) {
+        return tokens;
+    }
+    if (pointer[0] != '/') {
+        throw JsonException("JSON Pointer должен начинаться с '/': " + pointer);
+    }
+
+    std::string token;
+    for (size_t i = 1; i <= pointer.size(); ++i) {
+        if (i == pointer.size() || pointer[i] == '/') {
+            tokens.push_back(std::move(token));
+            token.clear();
+        } else if (pointer[i] == '~') {
+            char next = i + 1 < pointer.size() ? pointer[i + 1] : '\0';
+            if (next != '0' && next != '1') {
+                throw JsonException("Неверная escape-последовательность в JSON Pointer: " + pointer);
+            }
+            token += next == '0' ? '~' : '/';
+            ++i;
+        } else {
+            token += pointer[i];
+        }
+    }
+    return tokens;
+}
+
+std::string JsonPatch::escapeToken(const std::string& token) {
+    if (token.find_first_of("~/") == std::string::npos) {
+        return token;
+    }
+    std::string result;
+    result.reserve(token.size() + 2);
+    for (char c : token) {
+        if (c == '~') {
+            result += "~0";
+        } else if (c == '/') {
+            result += "~1";
+        } else {
+            result += c;
+        }
+    }
+    return result;
+}
+
+JsonValue JsonPatch::diff(const JsonValue& from, const JsonValue& to) {
+    JsonArray ops;
+    std::string path;
+    diffValues(from, to, path, ops);
+    return JsonValue(std::move(ops));
+}
+
+void JsonPatch::apply(JsonValue& document, const JsonValue& patch) {
+    if (!patch.isArray()) {
+        throw JsonException("Патч должен быть массивом операций");
+    }
+
+    JsonValue result = document;
+    for (const JsonValue& operation : patch.asArray()) {
+        if (!operation.isObject()) {
+            throw JsonException("Операция патча должна быть объектом");
+        }
+        const std::string& op = member(operation, "op").asString();
+        std::vector<std::string> path = parsePointer(member(operation, "path").asString());
+
+        if (op == "add") {
+            addValue(result, path, member(operation, "value"));
+        } else if (op == "remove") {
+            removeValue(result, path);
+        } else if (op == "replace") {
+            locate(result, path, path.size()) = member(operation, "value");
+        } else if (op == "move" || op == "copy") {
+            const std::string& fromPointer = member(operation, "from").asString();
+            std::vector<std::string> from = parsePointer(fromPointer);
+            if (op == "move") {
+                const std::string& target = member(operation, "path").asString();
+                if (target.size() > fromPointer.size() && target.compare(0, fromPointer.size(), fromPointer) == 0 &&
+                    target[fromPointer.size()] == '/') {
+                    throw JsonException("Нельзя переместить значение внутрь него самого: " + target);
+                }
+                addValue(result, path, removeValue(result, from));
+            } else {
+                JsonValue copy = locate(static_cast<const JsonValue&>(result), from, from.size());
+                addValue(result, path, std::move(copy));
+            }
+        } else if (op == "test") {
+            const JsonValue& current = locate(static_cast<const JsonValue&>(result), path, path.size());
+            if (!equal(current, member(operation, "value"))) {
+                throw JsonException("Проверка патча не пройдена: " + member(operation, "path").asString());
+            }
+        } else {
+            throw JsonException("Неизвестная операция патча: " + op);
+        }
+    }
+
+    document = std::move(result);
+}
+
+} // namespace json
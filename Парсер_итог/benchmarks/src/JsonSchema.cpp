@@ -0,0 +1,546 @@
+#include "JsonSchema.hpp"
+#include "JsonPatch.hpp"
+#include "Parser.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <map>
+
+namespace json {
+
+using Node = JsonSchema::Node;
+
+namespace {
+
+bool isContainer(const JsonValue& value) {
+    return value.isArray() || value.isObject();
+}
+
+// Узел без ограничений - то же, что схема true
+bool isTrivial(const Node& node) {
+    return node.types == JsonSchema::ANY_TYPE && !node.hasMinimum && !node.hasMaximum && node.multipleOf == 0.0 &&
+           node.minLength == 0 && node.maxLength == JsonSchema::UNLIMITED && node.pattern == JsonSchema::NONE &&
+           !node.hasEnum && node.items == JsonSchema::TRUE_NODE && !node.tupleItems &&
+           node.contains == JsonSchema::NONE && node.minItems == 0 && node.maxItems == JsonSchema::UNLIMITED &&
+           !node.uniqueItems && node.properties.empty() && node.patternProperties.empty() &&
+           node.additionalProperties == JsonSchema::TRUE_NODE && node.propertyNames == JsonSchema::NONE &&
+           node.dependencies.empty() && node.minProperties == 0 && node.maxProperties == JsonSchema::UNLIMITED &&
+           !node.hasApplicators();
+}
+
+// Все ссылки узла на другие узлы
+template<typename F>
+void forEachChild(Node& node, F&& visit) {
+    visit(node.items);
+    for (uint32_t& index : node.tuple) visit(index);
+    visit(node.additionalItems);
+    visit(node.contains);
+    for (JsonSchema::Property& property : node.properties) visit(property.node);
+    for (auto& pattern : node.patternProperties) visit(pattern.second);
+    visit(node.additionalProperties);
+    visit(node.propertyNames);
+    for (JsonSchema::Dependency& dependency : node.dependencies) visit(dependency.node);
+    for (uint32_t& index : node.allOf) visit(index);
+    for (uint32_t& index : node.anyOf) visit(index);
+    for (uint32_t& index : node.oneOf) visit(index);
+    visit(node.notNode);
+    visit(node.ifNode);
+    visit(node.thenNode);
+    visit(node.elseNode);
+}
+
+// Схемы, которые проверяют то же значение (без перехода к вложенному)
+template<typename F>
+void forEachApplicator(const Node& node, F&& visit) {
+    for (uint32_t index : node.allOf) visit(index);
+    for (uint32_t index : node.anyOf) visit(index);
+    for (uint32_t index : node.oneOf) visit(index);
+    for (uint32_t index : {node.notNode, node.ifNode, node.thenNode, node.elseNode}) visit(index);
+    for (const JsonSchema::Dependency& dependency : node.dependencies) visit(dependency.node);
+}
+
+// "%2F" в $ref - экранирование URI-фрагмента
+std::string percentDecode(const std::string& text) {
+    std::string result;
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '%' && i + 2 < text.size() && std::isxdigit(static_cast<unsigned char>(text[i + 1])) &&
+            std::isxdigit(static_cast<unsigned char>(text[i + 2]))) {
+            result += static_cast<char>(std::stoi(text.substr(i + 1, 2), nullptr, 16));
+            i += 2;
+        } else {
+            result += text[i];
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+// Компиляция: узел создаётся при первом обходе подсхемы (по её JSON
+// Pointer), $ref запоминаются и разрешаются после обхода
+class SchemaCompiler {
+private:
+    struct Ref {
+        uint32_t node;
+        std::string pointer;        // Где стоит $ref
+        std::string target;
+    };
+
+    const JsonValue& m_document;
+    JsonSchema& m_schema;
+    std::map<std::string, uint32_t> m_byPointer;
+    std::map<std::string, uint32_t> m_patternIndex;
+    std::vector<Ref> m_refs;
+    std::vector<uint32_t> m_refTarget;      // По узлу: цель $ref или NONE
+
+    [[noreturn]] static void fail(const std::string& pointer, const std::string& message) {
+        throw JsonException("Некорректная схема (#" + pointer + "): " + message);
+    }
+
+    static std::string child(const std::string& pointer, const std::string& key) {
+        return pointer + "/" + JsonPatch::escapeToken(key);
+    }
+
+    static double number(const JsonValue& value, const std::string& pointer, const char* keyword) {
+        if (!value.isNumber()) {
+            fail(pointer, std::string(keyword) + " должен быть числом");
+        }
+        return value.asNumber();
+    }
+
+    static size_t count(const JsonValue& value, const std::string& pointer, const char* keyword) {
+        double result = value.isNumber() ? value.asNumber() : -1.0;
+        if (result < 0.0 || result != std::floor(result)) {
+            fail(pointer, std::string(keyword) + " должен быть неотрицательным целым");
+        }
+        return result >= 1e18 ? JsonSchema::UNLIMITED : static_cast<size_t>(result);
+    }
+
+    static uint8_t typeBits(const JsonValue& name, const std::string& pointer) {
+        if (name.isString()) {
+            const std::string& type = name.asString();
+            if (type == "null") return JsonSchema::NULL_TYPE;
+            if (type == "boolean") return JsonSchema::BOOLEAN_TYPE;
+            if (type == "integer") return JsonSchema::INTEGER_TYPE;
+            if (type == "number") return JsonSchema::INTEGER_TYPE | JsonSchema::FRACTION_TYPE;
+            if (type == "string") return JsonSchema::STRING_TYPE;
+            if (type == "array") return JsonSchema::ARRAY_TYPE;
+            if (type == "object") return JsonSchema::OBJECT_TYPE;
+        }
+        fail(pointer, "неизвестный тип в type");
+    }
+
+    uint32_t pattern(const JsonValue& source, const std::string& pointer) {
+        if (!source.isString()) {
+            fail(pointer, "pattern должен быть строкой");
+        }
+        const std::string& text = source.asString();
+        auto found = m_patternIndex.find(text);
+        if (found != m_patternIndex.end()) {
+            return found->second;
+        }
+        try {
+            m_schema.m_patterns.emplace_back(text);
+        } catch (const JsonException& e) {
+            fail(pointer, "некорректное регулярное выражение \"" + text + "\": " + e.what());
+        }
+        m_schema.m_patternSources.push_back(text);
+        uint32_t index = static_cast<uint32_t>(m_schema.m_patterns.size() - 1);
+        m_patternIndex.emplace(text, index);
+        return index;
+    }
+
+    std::vector<uint32_t> schemaList(const JsonValue& list, const std::string& pointer) {
+        if (!list.isArray() || list.size() == 0) {
+            fail(pointer, "ожидался непустой массив схем");
+        }
+        std::vector<uint32_t> nodes;
+        for (size_t i = 0; i < list.size(); ++i) {
+            nodes.push_back(compile(list[i], child(pointer, std::to_string(i))));
+        }
+        return nodes;
+    }
+
+    // Отметка "ключ встретился"; ключ без properties только отслеживается
+    static uint32_t seenMark(Node& node, const std::string& name) {
+        auto it = std::lower_bound(node.properties.begin(), node.properties.end(), name,
+                                   [](const JsonSchema::Property& p, const std::string& n) { return p.name < n; });
+        if (it == node.properties.end() || it->name != name) {
+            it = node.properties.insert(it, JsonSchema::Property{name, JsonSchema::TRUE_NODE, false, JsonSchema::NONE});
+        }
+        if (it->seen == JsonSchema::NONE) {
+            it->seen = static_cast<uint32_t>(node.seenNames.size());
+            node.seenNames.push_back(name);
+        }
+        return it->seen;
+    }
+
+    void compileKeywords(const JsonObject& schema, const std::string& pointer, Node& node);
+
+public:
+    SchemaCompiler(const JsonValue& document, JsonSchema& schema) : m_document(document), m_schema(schema) {
+        // Узлы true и false
+        m_schema.m_nodes.resize(2);
+        m_schema.m_nodes[JsonSchema::FALSE_NODE].types = 0;
+        m_refTarget.resize(2, JsonSchema::NONE);
+    }
+
+    uint32_t compile(const JsonValue& schema, const std::string& pointer);
+
+    // Разрешить $ref (цели компилируются по мере надобности)
+    void resolveRefs();
+
+    // Ссылки на $ref и пустые схемы - прямо в цель и в true; проверка
+    // циклов и признаки узлов
+    void finish();
+};
+
+uint32_t SchemaCompiler::compile(const JsonValue& schema, const std::string& pointer) {
+    if (schema.isBool()) {
+        return schema.asBool() ? JsonSchema::TRUE_NODE : JsonSchema::FALSE_NODE;
+    }
+    if (!schema.isObject()) {
+        fail(pointer, "схема должна быть объектом или true/false");
+    }
+    auto found = m_byPointer.find(pointer);
+    if (found != m_byPointer.end()) {
+        return found->second;
+    }
+
+    uint32_t index = static_cast<uint32_t>(m_schema.m_nodes.size());
+    m_schema.m_nodes.emplace_back();
+    m_refTarget.push_back(JsonSchema::NONE);
+    m_byPointer.emplace(pointer, index);
+
+    const JsonObject& object = schema.asObject();
+    auto ref = object.find("$ref");
+    if (ref != object.end()) {
+        // Остальные ключевые слова рядом с $ref не действуют
+        if (!ref->second.isString()) {
+            fail(pointer, "$ref должен быть строкой");
+        }
+        m_refs.push_back(Ref{index, pointer, ref->second.asString()});
+        return index;
+    }
+
+    // Узел собирается отдельно: вложенные схемы добавляют узлы в таблицу
+    Node node;
+    compileKeywords(object, pointer, node);
+    m_schema.m_nodes[index] = std::move(node);
+    return index;
+}
+
+void SchemaCompiler::compileKeywords(const JsonObject& schema, const std::string& pointer, Node& node) {
+    auto keyword = [&schema](const char* name) -> const JsonValue* {
+        auto it = schema.find(name);
+        return it == schema.end() ? nullptr : &it->second;
+    };
+
+    if (const JsonValue* type = keyword("type")) {
+        if (type->isArray()) {
+            if (type->size() == 0) {
+                fail(pointer, "пустой список type");
+            }
+            node.types = 0;
+            for (const JsonValue& name : type->asArray()) {
+                node.types |= typeBits(name, pointer);
+            }
+        } else {
+            node.types = typeBits(*type, pointer);
+        }
+    }
+
+    if (const JsonValue* values = keyword("enum")) {
+        if (!values->isArray()) {
+            fail(pointer, "enum должен быть массивом");
+        }
+        node.hasEnum = true;
+        node.enumValues = values->asArray();
+    }
+    if (const JsonValue* value = keyword("const")) {
+        if (node.hasEnum) {
+            // enum и const вместе: подходят значения enum, равные const
+            JsonArray both;
+            for (const JsonValue& candidate : node.enumValues) {
+                if (JsonPatch::equal(candidate, *value)) both.push_back(candidate);
+            }
+            node.enumValues = std::move(both);
+        } else {
+            node.hasEnum = true;
+            node.isConst = true;
+            node.enumValues = JsonArray{*value};
+        }
+    }
+
+    // Из нескольких нижних (верхних) границ действует самая строгая
+    auto lower = [&node](double value, bool exclusive) {
+        if (!node.hasMinimum || value > node.minimum || (value == node.minimum && exclusive)) {
+            node.hasMinimum = true;
+            node.minimum = value;
+            node.exclusiveMinimum = exclusive;
+        }
+    };
+    auto upper = [&node](double value, bool exclusive) {
+        if (!node.hasMaximum || value < node.maximum || (value == node.maximum && exclusive)) {
+            node.hasMaximum = true;
+            node.maximum = value;
+            node.exclusiveMaximum = exclusive;
+        }
+    };
+    if (const JsonValue* value = keyword("minimum")) lower(number(*value, pointer, "minimum"), false);
+    if (const JsonValue* value = keyword("exclusiveMinimum")) lower(number(*value, pointer, "exclusiveMinimum"), true);
+    if (const JsonValue* value = keyword("maximum")) upper(number(*value, pointer, "maximum"), false);
+    if (const JsonValue* value = keyword("exclusiveMaximum")) upper(number(*value, pointer, "exclusiveMaximum"), true);
+    if (const JsonValue* value = keyword("multipleOf")) {
+        node.multipleOf = number(*value, pointer, "multipleOf");
+        if (!(node.multipleOf > 0.0)) {
+            fail(pointer, "multipleOf должен быть больше нуля");
+        }
+    }
+
+    if (const JsonValue* value = keyword("minLength")) node.minLength = count(*value, pointer, "minLength");
+    if (const JsonValue* value = keyword("maxLength")) node.maxLength = count(*value, pointer, "maxLength");
+    if (const JsonValue* value = keyword("pattern")) node.pattern = pattern(*value, pointer);
+
+    if (const JsonValue* items = keyword("items")) {
+        if (items->isArray()) {
+            node.tupleItems = true;
+            for (size_t i = 0; i < items->size(); ++i) {
+                node.tuple.push_back(compile((*items)[i], child(child(pointer, "items"), std::to_string(i))));
+            }
+        } else {
+            node.items = compile(*items, child(pointer, "items"));
+        }
+    }
+    if (const JsonValue* value = keyword("additionalItems")) {
+        node.additionalItems = compile(*value, child(pointer, "additionalItems"));
+    }
+    if (const JsonValue* value = keyword("contains")) node.contains = compile(*value, child(pointer, "contains"));
+    if (const JsonValue* value = keyword("minItems")) node.minItems = count(*value, pointer, "minItems");
+    if (const JsonValue* value = keyword("maxItems")) node.maxItems = count(*value, pointer, "maxItems");
+    if (const JsonValue* value = keyword("uniqueItems")) {
+        if (!value->isBool()) {
+            fail(pointer, "uniqueItems должен быть true или false");
+        }
+        node.uniqueItems = value->asBool();
+    }
+
+    // properties идут первыми: required и dependencies добавляют к ним
+    // только отслеживаемые ключи
+    if (const JsonValue* properties = keyword("properties")) {
+        if (!properties->isObject()) {
+            fail(pointer, "properties должен быть объектом");
+        }
+        std::string base = child(pointer, "properties");
+        for (const auto& [name, schema] : properties->asObject()) {
+            uint32_t index = compile(schema, child(base, name));
+            node.properties.push_back(JsonSchema::Property{name, index, true, JsonSchema::NONE});
+        }
+    }
+    if (const JsonValue* patterns = keyword("patternProperties")) {
+        if (!patterns->isObject()) {
+            fail(pointer, "patternProperties должен быть объектом");
+        }
+        std::string base = child(pointer, "patternProperties");
+        for (const auto& [source, schema] : patterns->asObject()) {
+            uint32_t regex = pattern(JsonValue(source), pointer);
+            node.patternProperties.emplace_back(regex, compile(schema, child(base, source)));
+        }
+    }
+    if (const JsonValue* value = keyword("additionalProperties")) {
+        node.additionalProperties = compile(*value, child(pointer, "additionalProperties"));
+    }
+    if (const JsonValue* required = keyword("required")) {
+        if (!required->isArray()) {
+            fail(pointer, "required должен быть массивом строк");
+        }
+        for (const JsonValue& name : required->asArray()) {
+            if (!name.isString()) {
+                fail(pointer, "required должен быть массивом строк");
+            }
+            uint32_t mark = seenMark(node, name.asString());
+            if (std::find(node.required.begin(), node.required.end(), mark) == node.required.end()) {
+                node.required.push_back(mark);
+            }
+        }
+    }
+    if (const JsonValue* value = keyword("propertyNames")) {
+        node.propertyNames = compile(*value, child(pointer, "propertyNames"));
+    }
+    if (const JsonValue* dependencies = keyword("dependencies")) {
+        if (!dependencies->isObject()) {
+            fail(pointer, "dependencies должен быть объектом");
+        }
+        std::string base = child(pointer, "dependencies");
+        for (const auto& [name, dependency] : dependencies->asObject()) {
+            JsonSchema::Dependency entry;
+            entry.seen = seenMark(node, name);
+            if (dependency.isArray()) {
+                for (const JsonValue& other : dependency.asArray()) {
+                    if (!other.isString()) {
+                        fail(pointer, "dependencies: ожидался массив строк или схема");
+                    }
+                    entry.requiredSeen.push_back(seenMark(node, other.asString()));
+                }
+            } else {
+                entry.node = compile(dependency, child(base, name));
+            }
+            node.dependencies.push_back(std::move(entry));
+        }
+    }
+    if (const JsonValue* value = keyword("minProperties")) node.minProperties = count(*value, pointer, "minProperties");
+    if (const JsonValue* value = keyword("maxProperties")) node.maxProperties = count(*value, pointer, "maxProperties");
+
+    if (const JsonValue* list = keyword("allOf")) node.allOf = schemaList(*list, child(pointer, "allOf"));
+    if (const JsonValue* list = keyword("anyOf")) node.anyOf = schemaList(*list, child(pointer, "anyOf"));
+    if (const JsonValue* list = keyword("oneOf")) node.oneOf = schemaList(*list, child(pointer, "oneOf"));
+    if (const JsonValue* value = keyword("not")) node.notNode = compile(*value, child(pointer, "not"));
+    // then и else без if ничего не значат
+    if (const JsonValue* condition = keyword("if")) {
+        node.ifNode = compile(*condition, child(pointer, "if"));
+        if (const JsonValue* value = keyword("then")) node.thenNode = compile(*value, child(pointer, "then"));
+        if (const JsonValue* value = keyword("else")) node.elseNode = compile(*value, child(pointer, "else"));
+    }
+}
+
+void SchemaCompiler::resolveRefs() {
+    // Список растёт: цель $ref может сама содержать $ref
+    for (size_t i = 0; i < m_refs.size(); ++i) {
+        Ref ref = m_refs[i];
+        if (ref.target.empty() || ref.target[0] != '#' || (ref.target.size() > 1 && ref.target[1] != '/')) {
+            fail(ref.pointer, "поддерживаются только $ref внутри схемы (\"#/...\"): " + ref.target);
+        }
+
+        const JsonValue* target = &m_document;
+        std::string pointer;
+        for (const std::string& segment : JsonPatch::parsePointer(percentDecode(ref.target.substr(1)))) {
+            if (target->isObject() && target->contains(segment)) {
+                target = &target->at(segment);
+            } else if (target->isArray() && !segment.empty() &&
+                       std::all_of(segment.begin(), segment.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)); }) &&
+                       std::stoull(segment) < target->size()) {
+                target = &(*target)[static_cast<size_t>(std::stoull(segment))];
+            } else {
+                fail(ref.pointer, "$ref указывает на несуществующую часть схемы: " + ref.target);
+            }
+            pointer = child(pointer, segment);
+        }
+        m_refTarget[ref.node] = compile(*target, pointer);
+    }
+}
+
+void SchemaCompiler::finish() {
+    std::vector<Node>& nodes = m_schema.m_nodes;
+    size_t count = nodes.size();
+
+    // Цель цепочки $ref
+    std::vector<uint32_t> resolved(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t current = i;
+        size_t steps = 0;
+        while (m_refTarget[current] != JsonSchema::NONE) {
+            current = m_refTarget[current];
+            if (++steps > count) {
+                fail("", "цикл из $ref");
+            }
+        }
+        resolved[i] = current;
+    }
+
+    // Подстановка до неподвижной точки: узел может стать пустым, когда
+    // пустыми окажутся его подсхемы
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        std::vector<uint32_t> target(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            uint32_t r = resolved[i];
+            target[i] = r > JsonSchema::FALSE_NODE && isTrivial(nodes[r]) ? JsonSchema::TRUE_NODE : r;
+        }
+        auto remap = [&](uint32_t& index) {
+            if (index != JsonSchema::NONE && target[index] != index) {
+                index = target[index];
+                changed = true;
+            }
+        };
+        for (Node& node : nodes) {
+            forEachChild(node, remap);
+            // true в allOf ничего не добавляет, true в anyOf делает его выполненным
+            auto trueNode = [](uint32_t index) { return index == JsonSchema::TRUE_NODE; };
+            size_t before = node.allOf.size();
+            node.allOf.erase(std::remove_if(node.allOf.begin(), node.allOf.end(), trueNode), node.allOf.end());
+            if (std::any_of(node.anyOf.begin(), node.anyOf.end(), trueNode)) {
+                node.anyOf.clear();
+                changed = true;
+            }
+            changed = changed || node.allOf.size() != before;
+        }
+        remap(m_schema.m_root);
+    }
+
+    // Цикл по схемам того же значения не закончится никогда
+    std::vector<uint8_t> state(count, 0);      // 0 - не посещён, 1 - в пути, 2 - готов
+    std::vector<std::pair<uint32_t, std::vector<uint32_t>>> stack;
+    for (uint32_t start = 0; start < count; ++start) {
+        if (state[start] != 0) continue;
+        auto applicators = [&nodes](uint32_t index) {
+            std::vector<uint32_t> list;
+            forEachApplicator(nodes[index], [&list](uint32_t next) {
+                if (next != JsonSchema::NONE) list.push_back(next);
+            });
+            return list;
+        };
+        stack.emplace_back(start, applicators(start));
+        state[start] = 1;
+        while (!stack.empty()) {
+            auto& [index, pending] = stack.back();
+            if (pending.empty()) {
+                state[index] = 2;
+                stack.pop_back();
+                continue;
+            }
+            uint32_t next = pending.back();
+            pending.pop_back();
+            if (state[next] == 1) {
+                fail("", "схема применяет сама себя к тому же значению (бесконечная рекурсия $ref)");
+            }
+            if (state[next] == 0) {
+                state[next] = 1;
+                stack.emplace_back(next, applicators(next));
+            }
+        }
+    }
+
+    for (Node& node : nodes) {
+        node.dependencySchemas = static_cast<size_t>(std::count_if(
+            node.dependencies.begin(), node.dependencies.end(),
+            [](const JsonSchema::Dependency& dependency) { return dependency.node != JsonSchema::NONE; }));
+        node.arrayChildren = node.tupleItems || node.items != JsonSchema::TRUE_NODE || node.contains != JsonSchema::NONE;
+        node.objectChildren = !node.properties.empty() || !node.patternProperties.empty() ||
+                              node.additionalProperties != JsonSchema::TRUE_NODE ||
+                              node.propertyNames != JsonSchema::NONE;
+        node.needsValue = node.uniqueItems ||
+                          (node.hasEnum && std::any_of(node.enumValues.begin(), node.enumValues.end(), isContainer));
+    }
+}
+
+JsonSchema JsonSchema::compile(const JsonValue& schema) {
+    JsonSchema result;
+    SchemaCompiler compiler(schema, result);
+    result.m_root = compiler.compile(schema, "");
+    compiler.resolveRefs();
+    compiler.finish();
+    return result;
+}
+
+JsonSchema JsonSchema::compileFile(const std::string& filename) {
+    return compile(Parser::parseFile(filename));
+}
+
+const JsonSchema::Property* JsonSchema::findProperty(const Node& node, const std::string& name) {
+    auto it = std::lower_bound(node.properties.begin(), node.properties.end(), name,
+                               [](const Property& p, const std::string& n) { return p.name < n; });
+    return it != node.properties.end() && it->name == name ? &*it : nullptr;
+}
+
+} // namespace json
@@ -1,10 +1,292 @@
 #include "JsonValue.hpp"
+#include "ContentHasher.hpp"
 #include <sstream>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <thread>
 
 namespace json {
 
-// Вспомогательная функция для разбора пути
-static std::vector<std::string> splitPath(const std::string& path) {
+double JsonRawNumber::value() const {
+    uint64_t bits = m_cached.load(std::memory_order_relaxed);
+    if (bits != NOT_CONVERTED) {
+        double cached;
+        std::memcpy(&cached, &bits, sizeof(cached));
+        return cached;
+    }
+
+    double result = 0.0;
+    auto conversion = std::from_chars(m_text.data(), m_text.data() + m_text.size(), result);
+    if (conversion.ec != std::errc() || conversion.ptr != m_text.data() + m_text.size()) {
+        throw JsonException("Некорректное число: " + m_text);
+    }
+
+    std::memcpy(&bits, &result, sizeof(bits));
+    m_cached.store(bits, std::memory_order_relaxed);
+    return result;
+}
+
+bool JsonRawNumber::toInt64(int64_t& out) const {
+    auto conversion = std::from_chars(m_text.data(), m_text.data() + m_text.size(), out);
+    if (conversion.ec == std::errc() && conversion.ptr == m_text.data() + m_text.size()) {
+        return true;
+    }
+    if (conversion.ec == std::errc::result_out_of_range) {
+        return false;
+    }
+
+    // Дробная или экспоненциальная запись ("5.0", "1e3")
+    double number = value();
+    if (std::trunc(number) != number || number < -9223372036854775808.0 ||
+        number >= 9223372036854775808.0) {
+        return false;
+    }
+    out = static_cast<int64_t>(number);
+    return true;
+}
+
+void JsonValue::unref() noexcept {
+    // Последняя ссылка освобождает данные (и рекурсивно - детей)
+    if (m_payload.shared->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+    switch (m_type) {
+        case Type::String:    delete static_cast<detail::SharedBox<JsonString>*>(m_payload.shared);    break;
+        case Type::Array:     delete static_cast<detail::SharedBox<JsonArray>*>(m_payload.shared);     break;
+        case Type::Object:    delete static_cast<detail::SharedBox<JsonObject>*>(m_payload.shared);    break;
+        case Type::RawNumber: delete static_cast<detail::SharedBox<JsonRawNumber>*>(m_payload.shared); break;
+        default: break;
+    }
+}
+
+uint32_t SourceSpan::newSource() {
+    static std::atomic<uint32_t> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+namespace {
+
+template<typename T>
+detail::SharedBox<T>* spannedBox(detail::SharedPayload* payload) {
+    return static_cast<detail::SharedBox<T>*>(payload);
+}
+
+} // namespace
+
+bool JsonValue::sourceSpan(SourceSpan& span) const {
+    if (m_type != Type::Array && m_type != Type::Object) return false;
+    const detail::SharedPayload* payload = m_payload.shared;
+    if (payload->spanSource == 0) return false;
+
+    span.source = payload->spanSource;
+    if (m_type == Type::Array) {
+        const auto* box = spannedBox<JsonArray>(m_payload.shared);
+        span.offset = box->spanOffset;
+        span.length = box->spanLength;
+    } else {
+        const auto* box = spannedBox<JsonObject>(m_payload.shared);
+        span.offset = box->spanOffset;
+        span.length = box->spanLength;
+    }
+    return true;
+}
+
+void JsonValue::setSourceSpan(const SourceSpan& span) const {
+    if (m_type == Type::Array) {
+        auto* box = spannedBox<JsonArray>(m_payload.shared);
+        box->spanOffset = span.offset;
+        box->spanLength = span.length;
+    } else if (m_type == Type::Object) {
+        auto* box = spannedBox<JsonObject>(m_payload.shared);
+        box->spanOffset = span.offset;
+        box->spanLength = span.length;
+    } else {
+        return;
+    }
+    m_payload.shared->spanSource = span.source;
+}
+
+namespace {
+
+// Метки типов в хэше (числа обеих форм хэшируются одинаково)
+enum HashTag : uint64_t {
+    HASH_NULL = 1,
+    HASH_BOOL,
+    HASH_NUMBER,
+    HASH_STRING,
+    HASH_ARRAY,
+    HASH_OBJECT
+};
+
+uint64_t hashText(HashTag tag, const std::string& text) {
+    ContentHasher hasher;
+    hasher.update(text.data(), text.size());
+    ContentHasher tagged;
+    tagged.update(tag);
+    tagged.update(hasher.finish());
+    return tagged.finish();
+}
+
+uint64_t hashWord(HashTag tag, uint64_t word) {
+    ContentHasher hasher;
+    hasher.update(tag);
+    hasher.update(word);
+    return hasher.finish();
+}
+
+uint64_t hashNumber(double number) {
+    if (number == 0) number = 0;     // -0 и 0 равны
+    uint64_t bits;
+    std::memcpy(&bits, &number, sizeof(bits));
+    return hashWord(HASH_NUMBER, bits);
+}
+
+} // namespace
+
+uint64_t JsonValue::hash() const {
+    switch (m_type) {
+        case Type::Null:
+            return hashWord(HASH_NULL, 0);
+        case Type::Bool:
+            return hashWord(HASH_BOOL, m_payload.boolean ? 1 : 0);
+        case Type::Number:
+            return hashNumber(m_payload.number);
+        case Type::RawNumber: {
+            const auto& raw = shared<JsonRawNumber>();
+            try {
+                return hashNumber(raw.value());
+            } catch (const JsonException&) {
+                return hashText(HASH_NUMBER, raw.text());    // Вне диапазона double
+            }
+        }
+        case Type::String:
+            return hashText(HASH_STRING, shared<JsonString>());
+        case Type::Array: {
+            const auto* box = static_cast<const detail::SharedBox<JsonArray>*>(m_payload.shared);
+            uint64_t cached = box->hash.load(std::memory_order_relaxed);
+            if (cached != 0) return cached;
+
+            ContentHasher hasher;
+            hasher.update(HASH_ARRAY);
+            hasher.update(box->value.size());
+            for (const auto& item : box->value) {
+                hasher.update(item.hash());
+            }
+            uint64_t result = hasher.finish();
+            box->hash.store(result, std::memory_order_relaxed);
+            return result;
+        }
+        case Type::Object: {
+            const auto* box = static_cast<const detail::SharedBox<JsonObject>*>(m_payload.shared);
+            uint64_t cached = box->hash.load(std::memory_order_relaxed);
+            if (cached != 0) return cached;
+
+            ContentHasher hasher;
+            hasher.update(HASH_OBJECT);
+            hasher.update(box->value.size());
+            for (const auto& [key, item] : box->value) {
+                hasher.update(hashText(HASH_STRING, key));
+                hasher.update(item.hash());
+            }
+            uint64_t result = hasher.finish();
+            box->hash.store(result, std::memory_order_relaxed);
+            return result;
+        }
+    }
+    return 0;
+}
+
+void JsonValue::computeHashes(unsigned int threads) const {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Работа есть только в контейнерах без готового хэша: раскрываем такие
+    // узлы по уровням, пока их не хватит на все потоки с запасом для
+    // балансировки. Скаляры и готовые поддеревья достаются последнему
+    // последовательному проходу, где они стоят O(1) каждый.
+    auto needsHash = [](const JsonValue& node) {
+        if (node.isArray()) {
+            return static_cast<const detail::SharedBox<JsonArray>*>(node.m_payload.shared)
+                       ->hash.load(std::memory_order_relaxed) == 0;
+        }
+        if (node.isObject()) {
+            return static_cast<const detail::SharedBox<JsonObject>*>(node.m_payload.shared)
+                       ->hash.load(std::memory_order_relaxed) == 0;
+        }
+        return false;
+    };
+
+    const size_t target = static_cast<size_t>(threads) * 8;
+    std::vector<const JsonValue*> frontier;
+    if (needsHash(*this)) {
+        frontier.push_back(this);
+    }
+    while (threads > 1 && !frontier.empty() && frontier.size() < target) {
+        std::vector<const JsonValue*> next;
+        for (const JsonValue* node : frontier) {
+            if (node->isArray()) {
+                for (const auto& item : node->shared<JsonArray>()) {
+                    if (needsHash(item)) next.push_back(&item);
+                }
+            } else {
+                for (const auto& [_, item] : node->shared<JsonObject>()) {
+                    if (needsHash(item)) next.push_back(&item);
+                }
+            }
+        }
+        if (next.empty()) break;
+        frontier.swap(next);
+    }
+
+    if (threads > 1 && frontier.size() > 1) {
+        // Поддеревья разбираются порциями: размеры сильно различаются
+        const size_t batch = std::max<size_t>(1, frontier.size() / target);
+        std::atomic<size_t> nextIndex{0};
+        std::vector<std::thread> workers;
+        unsigned int workerCount = static_cast<unsigned int>(std::min<size_t>(threads, frontier.size()));
+        for (unsigned int t = 0; t < workerCount; ++t) {
+            workers.emplace_back([&]() {
+                while (true) {
+                    size_t begin = nextIndex.fetch_add(batch, std::memory_order_relaxed);
+                    if (begin >= frontier.size()) break;
+                    size_t end = std::min(begin + batch, frontier.size());
+                    for (size_t i = begin; i < end; ++i) {
+                        frontier[i]->hash();
+                    }
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    // Верхние уровни собираются из готовых хэшей детей
+    hash();
+}
+
+int64_t JsonValue::asInt64() const {
+    if (isRawNumber()) {
+        int64_t result;
+        const auto& raw = shared<JsonRawNumber>();
+        if (!raw.toInt64(result)) {
+            throw JsonException("Число не является целым 64-битным: " + raw.text());
+        }
+        return result;
+    }
+
+    double number = asNumber();
+    if (std::trunc(number) != number || number < -9223372036854775808.0 ||
+        number >= 9223372036854775808.0) {
+        throw JsonException("Число не является целым 64-битным");
+    }
+    return static_cast<int64_t>(number);
+}
+
+std::vector<std::string> JsonValue::splitPath(const std::string& path) {
     std::vector<std::string> parts;
     std::string current;
     bool inBracket = false;
@@ -0,0 +1,316 @@
+#include "JsonWriter.hpp"
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+
+namespace json {
+
+JsonWriter::JsonWriter(std::string& output, const Options& options)
+    : m_options(options), m_out(&output), m_stream(nullptr),
+      m_rootWritten(false), m_startSize(output.size()), m_flushedBytes(0) {
+    m_stack.reserve(32);
+}
+
+JsonWriter::JsonWriter(std::ostream& os, const Options& options)
+    : m_options(options), m_out(&m_buffer), m_stream(&os),
+      m_rootWritten(false), m_startSize(0), m_flushedBytes(0) {
+    m_buffer.reserve(m_options.bufferSize + 4096);
+    m_stack.reserve(32);
+}
+
+JsonWriter::~JsonWriter() {
+    if (m_stream) {
+        flush();
+    }
+}
+
+void JsonWriter::flush() {
+    if (m_stream && !m_buffer.empty()) {
+        m_stream->write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+        m_flushedBytes += m_buffer.size();
+        m_buffer.clear();
+    }
+}
+
+void JsonWriter::maybeFlush() {
+    if (m_stream && m_buffer.size() >= m_options.bufferSize) {
+        flush();
+    }
+}
+
+size_t JsonWriter::bytesWritten() const {
+    return m_flushedBytes + m_out->size() - m_startSize;
+}
+
+void JsonWriter::writeIndent(size_t depth) {
+    m_out->push_back('\n');
+    m_out->append(depth * static_cast<size_t>(m_options.indentSize), ' ');
+}
+
+void JsonWriter::beforeValue() {
+    if (m_stack.empty()) {
+        if (m_rootWritten) {
+            throw JsonException("JsonWriter: корневое значение уже записано");
+        }
+        return;
+    }
+
+    Frame& frame = m_stack.back();
+    if (frame.isObject) {
+        if (!frame.hasKey) {
+            throw JsonException("JsonWriter: значение в объекте без ключа");
+        }
+        // Разделитель уже записан вместе с ключом
+        return;
+    }
+
+    if (frame.count > 0) {
+        m_out->push_back(',');
+    }
+    if (m_options.prettyPrint) {
+        writeIndent(m_stack.size());
+    }
+}
+
+void JsonWriter::afterValue() {
+    if (m_stack.empty()) {
+        m_rootWritten = true;
+    } else {
+        Frame& frame = m_stack.back();
+        frame.count++;
+        frame.hasKey = false;
+    }
+    maybeFlush();
+}
+
+JsonWriter& JsonWriter::beginObject() {
+    beforeValue();
+    m_out->push_back('{');
+    m_stack.push_back({true, false, 0});
+    return *this;
+}
+
+JsonWriter& JsonWriter::beginArray() {
+    beforeValue();
+    m_out->push_back('[');
+    m_stack.push_back({false, false, 0});
+    return *this;
+}
+
+JsonWriter& JsonWriter::endObject() {
+    if (m_stack.empty() || !m_stack.back().isObject) {
+        throw JsonException("JsonWriter: endObject без открытого объекта");
+    }
+    if (m_stack.back().hasKey) {
+        throw JsonException("JsonWriter: ключ без значения перед закрытием объекта");
+    }
+    size_t count = m_stack.back().count;
+    m_stack.pop_back();
+    if (m_options.prettyPrint && count > 0) {
+        writeIndent(m_stack.size());
+    }
+    m_out->push_back('}');
+    afterValue();
+    return *this;
+}
+
+JsonWriter& JsonWriter::endArray() {
+    if (m_stack.empty() || m_stack.back().isObject) {
+        throw JsonException("JsonWriter: endArray без открытого массива");
+    }
+    size_t count = m_stack.back().count;
+    m_stack.pop_back();
+    if (m_options.prettyPrint && count > 0) {
+        writeIndent(m_stack.size());
+    }
+    m_out->push_back(']');
+    afterValue();
+    return *this;
+}
+
+JsonWriter& JsonWriter::key(std::string_view name) {
+    if (m_stack.empty() || !m_stack.back().isObject) {
+        throw JsonException("JsonWriter: ключ вне объекта");
+    }
+    Frame& frame = m_stack.back();
+    if (frame.hasKey) {
+        throw JsonException("JsonWriter: два ключа подряд без значения");
+    }
+
+    if (frame.count > 0) {
+        m_out->push_back(',');
+    }
+    if (m_options.prettyPrint) {
+        writeIndent(m_stack.size());
+    }
+    writeEscaped(name);
+    m_out->push_back(':');
+    if (m_options.prettyPrint) {
+        m_out->push_back(' ');
+    }
+    frame.hasKey = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::null() {
+    beforeValue();
+    m_out->append("null", 4);
+    afterValue();
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(bool b) {
+    beforeValue();
+    if (b) {
+        m_out->append("true", 4);
+    } else {
+        m_out->append("false", 5);
+    }
+    afterValue();
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(double number) {
+    beforeValue();
+    writeNumber(number);
+    afterValue();
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(std::string_view str) {
+    beforeValue();
+    writeEscaped(str);
+    afterValue();
+    return *this;
+}
+
+JsonWriter& JsonWriter::rawValue(std::string_view json) {
+    beforeValue();
+    m_out->append(json.data(), json.size());
+    afterValue();
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(const JsonValue& node) {
+    beforeValue();
+    writeValue(node);
+    afterValue();
+    return *this;
+}
+
+// Рекурсивная запись поддерева; разделители внутри поддерева пишутся здесь же
+void JsonWriter::writeValue(const JsonValue& node) {
+    if (node.isNull()) {
+        m_out->append("null", 4);
+    } else if (node.isBool()) {
+        if (node.asBool()) {
+            m_out->append("true", 4);
+        } else {
+            m_out->append("false", 5);
+        }
+    } else if (node.isRawNumber()) {
+        m_out->append(node.numberText());
+    } else if (node.isNumber()) {
+        writeNumber(node.asNumber());
+    } else if (node.isString()) {
+        writeEscaped(node.asString());
+    } else if (node.isArray()) {
+        const auto& arr = node.asArray();
+        m_out->push_back('[');
+        m_stack.push_back({false, false, 0});
+        for (size_t i = 0; i < arr.size(); ++i) {
+            if (i > 0) m_out->push_back(',');
+            if (m_options.prettyPrint) writeIndent(m_stack.size());
+            writeValue(arr[i]);
+            maybeFlush();
+        }
+        m_stack.pop_back();
+        if (m_options.prettyPrint && !arr.empty()) writeIndent(m_stack.size());
+        m_out->push_back(']');
+    } else if (node.isObject()) {
+        const auto& obj = node.asObject();
+        m_out->push_back('{');
+        m_stack.push_back({true, false, 0});
+        bool first = true;
+        for (const auto& [k, v] : obj) {
+            if (!first) m_out->push_back(',');
+            first = false;
+            if (m_options.prettyPrint) writeIndent(m_stack.size());
+            writeEscaped(k);
+            m_out->push_back(':');
+            if (m_options.prettyPrint) m_out->push_back(' ');
+            writeValue(v);
+            maybeFlush();
+        }
+        m_stack.pop_back();
+        if (m_options.prettyPrint && !obj.empty()) writeIndent(m_stack.size());
+        m_out->push_back('}');
+    }
+}
+
+void JsonWriter::writeNumber(double number) {
+    if (!std::isfinite(number)) {
+        throw JsonException("JsonWriter: NaN и бесконечность не представимы в JSON");
+    }
+
+    // Целые значения в пределах точности double пишем без дробной части
+    if (number >= -9007199254740992.0 && number <= 9007199254740992.0 &&
+        number == static_cast<double>(static_cast<long long>(number))) {
+        writeInteger(static_cast<long long>(number));
+        return;
+    }
+
+    char buf[32];
+    int len = std::snprintf(buf, sizeof(buf), "%.17g", number);
+    m_out->append(buf, static_cast<size_t>(len));
+}
+
+void JsonWriter::writeInteger(long long number) {
+    char buf[24];
+    auto res = std::to_chars(buf, buf + sizeof(buf), number);
+    m_out->append(buf, static_cast<size_t>(res.ptr - buf));
+}
+
+void JsonWriter::writeUnsigned(unsigned long long number) {
+    char buf[24];
+    auto res = std::to_chars(buf, buf + sizeof(buf), number);
+    m_out->append(buf, static_cast<size_t>(res.ptr - buf));
+}
+
+void JsonWriter::writeEscaped(std::string_view str) {
+    static const char HEX[] = "0123456789abcdef";
+
+    m_out->push_back('"');
+
+    // Участки без спецсимволов копируем одним append
+    size_t runStart = 0;
+    for (size_t i = 0; i < str.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(str[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+
+        m_out->append(str.data() + runStart, i - runStart);
+        runStart = i + 1;
+
+        switch (c) {
+            case '"':  m_out->append("\\\"", 2); break;
+            case '\\': m_out->append("\\\\", 2); break;
+            case '\b': m_out->append("\\b", 2);  break;
+            case '\f': m_out->append("\\f", 2);  break;
+            case '\n': m_out->append("\\n", 2);  break;
+            case '\r': m_out->append("\\r", 2);  break;
+            case '\t': m_out->append("\\t", 2);  break;
+            default: {
+                char esc[6] = {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0x0F]};
+                m_out->append(esc, 6);
+                break;
+            }
+        }
+    }
+    m_out->append(str.data() + runStart, str.size() - runStart);
+
+    m_out->push_back('"');
+}
+
+} // namespace json
@@ -1,12 +1,138 @@
 #include "Lexer.hpp"
+#include "Utf8.hpp"
+#include <array>
 #include <cctype>
+#include <cstdint>
+#include <cstring>
 #include <sstream>
 #include <iomanip>
 
+#if defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#define JSON_LEXER_SSE2 1
+#include <emmintrin.h>
+#endif
+
 namespace json {
 
+namespace {
+
+// Значения шестнадцатеричных цифр, -1 для остальных байтов
+constexpr std::array<int8_t, 256> makeHexTable() {
+    std::array<int8_t, 256> table{};
+    for (int i = 0; i < 256; ++i) {
+        table[i] = -1;
+    }
+    for (int i = 0; i < 10; ++i) {
+        table['0' + i] = static_cast<int8_t>(i);
+    }
+    for (int i = 0; i < 6; ++i) {
+        table['a' + i] = static_cast<int8_t>(10 + i);
+        table['A' + i] = static_cast<int8_t>(10 + i);
+    }
+    return table;
+}
+
+constexpr std::array<int8_t, 256> HEX_VALUES = makeHexTable();
+
+inline bool isStringSpecial(unsigned char c) {
+    return c == '"' || c == '\\' || c < 0x20;
+}
+
+} // namespace
+
+const char* findStringSpecial(const char* pos, const char* end) {
+#ifdef JSON_LEXER_SSE2
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i controlMax = _mm_set1_epi8(0x1F);
+
+    while (end - pos >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+        // c <= 0x1F  <=>  max(c, 0x1F) == 0x1F (беззнаковое сравнение)
+        __m128i special = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+            _mm_cmpeq_epi8(_mm_max_epu8(chunk, controlMax), controlMax));
+        int mask = _mm_movemask_epi8(special);
+        if (mask != 0) {
+            return pos + __builtin_ctz(static_cast<unsigned>(mask));
+        }
+        pos += 16;
+    }
+#endif
+    while (pos < end && !isStringSpecial(static_cast<unsigned char>(*pos))) {
+        ++pos;
+    }
+    return pos;
+}
+
+namespace {
+
+void appendUTF8(std::string& out, char32_t cp) {
+    if (cp <= 0x7F) {
+        out += static_cast<char>(cp);
+    } else if (cp <= 0x7FF) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp <= 0xFFFF) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp <= 0x10FFFF) {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+} // namespace
+
 Lexer::Lexer(const std::string& input)
-    : m_input(input), m_pos(0), m_line(1), m_column(1) {}
+    : m_input(input), m_pos(0), m_line(1), m_column(1), m_checkedBytes(0), m_finished(true), m_resumeAt(0),
+      m_base(0) {}
+
+Lexer::Lexer()
+    : m_pos(0), m_line(1), m_column(1), m_checkedBytes(0), m_finished(false), m_resumeAt(0), m_base(0) {}
+
+void Lexer::discardConsumed() {
+    // Проверенная часть и точка повтора не раньше m_pos
+    m_input.erase(0, m_pos);
+    m_checkedBytes -= m_pos;
+    m_resumeAt = m_resumeAt > m_pos ? m_resumeAt - m_pos : 0;
+    m_base += m_pos;
+    m_pos = 0;
+}
+
+void Lexer::setStartPosition(size_t line, size_t column, size_t offset) {
+    m_line = line;
+    m_column = column;
+    m_base = offset;
+}
+
+void Lexer::checkEncoding(size_t end) {
+    size_t from = m_checkedBytes;
+    m_checkedBytes = end;
+
+    size_t offset = utf8::findInvalid(m_input.data() + from, end - from);
+    if (offset == utf8::npos) {
+        return;
+    }
+    offset += from;
+
+    // Строка и столбец (в байтах, как у остальных ошибок лексера);
+    // проверяется только ещё не разобранный вход
+    size_t line = m_line;
+    size_t column = m_column;
+    for (size_t i = m_pos; i < offset; ++i) {
+        if (m_input[i] == '\n') {
+            ++line;
+            column = 1;
+        } else {
+            ++column;
+        }
+    }
+    throw LexerException("Некорректная последовательность UTF-8", line, column);
+}
 
 char Lexer::current() const {
     if (isAtEnd()) return '\0';
@@ -46,7 +172,35 @@ Token Lexer::parseString() {
 
     advance(); // пропускаем открывающую кавычку
 
+    const char* data = m_input.data();
+    const char* end = data + m_input.size();
+
+    // Участок до ближайшего спецсимвола пропускается целиком. Перевода строки
+    // в нём быть не может, поэтому столбец сдвигается на длину участка.
+    auto skipRun = [&]() {
+        size_t from = m_pos;
+        m_pos = static_cast<size_t>(findStringSpecial(data + m_pos, end) - data);
+        m_column += m_pos - from;
+    };
+
+    size_t runStart = m_pos;
+    skipRun();
+
+    // Частый случай: строка без escape-последовательностей
+    if (!isAtEnd() && current() == '"') {
+        std::string result(data + runStart, m_pos - runStart);
+        advance();
+        return Token(TokenType::String, std::move(result), startLine, startColumn);
+    }
+
+    // Escape-последовательности только укорачивают строку, поэтому расстояние
+    // до ближайшей кавычки не превышает длины результата
     std::string result;
+    if (const void* quote = std::memchr(data + m_pos, '"', static_cast<size_t>(end - data) - m_pos)) {
+        result.reserve(static_cast<size_t>(static_cast<const char*>(quote) - data) - runStart);
+    }
+    result.append(data + runStart, m_pos - runStart);
+
     while (!isAtEnd() && current() != '"') {
         if (current() == '\\') {
             advance(); // пропускаем backslash
@@ -54,7 +208,8 @@ Token Lexer::parseString() {
                 throw LexerException("Неожиданный конец строки после escape-символа", m_line, m_column);
             }
 
-            switch (current()) {
+            char escape = current();
+            switch (escape) {
                 case '"':  result += '"';  break;
                 case '\\': result += '\\'; break;
                 case '/':  result += '/';  break;
@@ -85,19 +240,24 @@ Token Lexer::parseString() {
                         }
                     }
 
-                    result += codePointToUTF8(codePoint);
-                    continue; // не вызываем advance() в конце switch
+                    appendUTF8(result, codePoint);
+                    break;
                 }
                 default:
                     throw LexerException("Неизвестная escape-последовательность: \\" +
                                         std::string(1, current()), m_line, m_column);
             }
-        } else if (static_cast<unsigned char>(current()) < 0x20) {
-            throw LexerException("Управляющий символ в строке не допускается", m_line, m_column);
+            if (escape != 'u') {
+                advance(); // parseUnicodeEscape уже сдвинул позицию
+            }
         } else {
-            result += current();
+            // findStringSpecial останавливается только на '"', '\' и управляющих символах
+            throw LexerException("Управляющий символ в строке не допускается", m_line, m_column);
         }
-        advance();
+
+        runStart = m_pos;
+        skipRun();
+        result.append(data + runStart, m_pos - runStart);
     }
 
     if (isAtEnd()) {
@@ -105,39 +265,32 @@ Token Lexer::parseString() {
     }
 
     advance(); // пропускаем закрывающую кавычку
-    return Token(TokenType::String, result, startLine, startColumn);
+    return Token(TokenType::String, std::move(result), startLine, startColumn);
 }
 
 char32_t Lexer::parseUnicodeEscape() {
-    std::string hex;
+    if (m_input.size() - m_pos >= 4) {
+        const auto* digits = reinterpret_cast<const unsigned char*>(m_input.data() + m_pos);
+        int d0 = HEX_VALUES[digits[0]];
+        int d1 = HEX_VALUES[digits[1]];
+        int d2 = HEX_VALUES[digits[2]];
+        int d3 = HEX_VALUES[digits[3]];
+        // Некорректная цифра (-1) делает объединение отрицательным
+        if ((d0 | d1 | d2 | d3) >= 0) {
+            m_pos += 4;
+            m_column += 4;
+            return static_cast<char32_t>((d0 << 12) | (d1 << 8) | (d2 << 4) | d3);
+        }
+    }
+
+    // Позиция ошибки - первая некорректная цифра
     for (int i = 0; i < 4; i++) {
-        if (isAtEnd() || !std::isxdigit(static_cast<unsigned char>(current()))) {
+        if (isAtEnd() || HEX_VALUES[static_cast<unsigned char>(current())] < 0) {
             throw LexerException("Ожидалось 4 шестнадцатеричных цифры в unicode escape", m_line, m_column);
         }
-        hex += current();
         advance();
     }
-    return static_cast<char32_t>(std::stoul(hex, nullptr, 16));
-}
-
-std::string Lexer::codePointToUTF8(char32_t cp) {
-    std::string result;
-    if (cp <= 0x7F) {
-        result += static_cast<char>(cp);
-    } else if (cp <= 0x7FF) {
-        result += static_cast<char>(0xC0 | (cp >> 6));
-        result += static_cast<char>(0x80 | (cp & 0x3F));
-    } else if (cp <= 0xFFFF) {
-        result += static_cast<char>(0xE0 | (cp >> 12));
-        result += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
-        result += static_cast<char>(0x80 | (cp & 0x3F));
-    } else if (cp <= 0x10FFFF) {
-        result += static_cast<char>(0xF0 | (cp >> 18));
-        result += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
-        result += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
-        result += static_cast<char>(0x80 | (cp & 0x3F));
-    }
-    return result;
+    return 0; // недостижимо: быстрый путь не сработал только при ошибке
 }
 
 Token Lexer::parseNumber() {
@@ -219,44 +372,57 @@ Token Lexer::parseKeyword() {
 }
 
 Token Lexer::nextToken() {
+    if (m_finished && m_checkedBytes < m_input.size()) {
+        checkEncoding(m_input.size());
+    }
+
     skipWhitespace();
 
     if (isAtEnd()) {
-        return Token(TokenType::EndOfFile, "", m_line, m_column);
+        return Token(TokenType::EndOfFile, "", m_line, m_column, m_base + m_pos);
     }
 
     size_t startLine = m_line;
     size_t startColumn = m_column;
+    size_t startOffset = m_base + m_pos;
     char c = current();
 
     switch (c) {
         case '{':
             advance();
-            return Token(TokenType::LeftBrace, "{", startLine, startColumn);
+            return Token(TokenType::LeftBrace, "{", startLine, startColumn, startOffset);
         case '}':
             advance();
-            return Token(TokenType::RightBrace, "}", startLine, startColumn);
+            return Token(TokenType::RightBrace, "}", startLine, startColumn, startOffset);
         case '[':
             advance();
-            return Token(TokenType::LeftBracket, "[", startLine, startColumn);
+            return Token(TokenType::LeftBracket, "[", startLine, startColumn, startOffset);
         case ']':
             advance();
-            return Token(TokenType::RightBracket, "]", startLine, startColumn);
+            return Token(TokenType::RightBracket, "]", startLine, startColumn, startOffset);
         case ':':
             advance();
-            return Token(TokenType::Colon, ":", startLine, startColumn);
+            return Token(TokenType::Colon, ":", startLine, startColumn, startOffset);
         case ',':
             advance();
-            return Token(TokenType::Comma, ",", startLine, startColumn);
-        case '"':
-            return parseString();
+            return Token(TokenType::Comma, ",", startLine, startColumn, startOffset);
+        case '"': {
+            Token token = parseString();
+            token.offset = startOffset;
+            return token;
+        }
         case '-':
         case '0': case '1': case '2': case '3': case '4':
-        case '5': case '6': case '7': case '8': case '9':
-            return parseNumber();
+        case '5': case '6': case '7': case '8': case '9': {
+            Token token = parseNumber();
+            token.offset = startOffset;
+            return token;
+        }
         default:
             if (std::isalpha(static_cast<unsigned char>(c))) {
-                return parseKeyword();
+                Token token = parseKeyword();
+                token.offset = startOffset;
+                return token;
             }
             throw LexerException("Неожиданный символ: " + std::string(1, c), m_line, m_column);
     }
@@ -266,13 +432,68 @@ std::vector<Token> Lexer::tokenize() {
     std::vector<Token> tokens;
     Token token = nextToken();
     while (token.type != TokenType::EndOfFile) {
-        tokens.push_back(token);
+        tokens.push_back(std::move(token));
         token = nextToken();
     }
     tokens.push_back(token); // добавляем EndOfFile
     return tokens;
 }
 
+bool Lexer::tokenizeAvailable(std::vector<Token>& tokens) {
+    if (m_finished) {
+        Token token = nextToken();
+        while (token.type != TokenType::EndOfFile) {
+            tokens.push_back(std::move(token));
+            token = nextToken();
+        }
+        tokens.push_back(std::move(token));
+        return true;
+    }
+
+    // Отложенный токен повторяется, когда данных за ним стало хотя бы
+    // вдвое больше: так длинная строка через много частей сканируется
+    // O(длины) раз в сумме, а не на каждой части
+    if (m_input.size() < m_resumeAt) {
+        return false;
+    }
+
+    // Последовательность UTF-8, обрезанная концом данных, проверяется со
+    // следующей частью
+    size_t end = m_input.size();
+    for (size_t back = 1; back <= 3 && back <= end - m_checkedBytes; ++back) {
+        auto byte = static_cast<unsigned char>(m_input[end - back]);
+        if (byte >= 0xC0) {
+            end -= back;
+            break;
+        }
+        if (byte < 0x80) break;
+    }
+    if (end > m_checkedBytes) {
+        checkEncoding(end);
+    }
+
+    while (true) {
+        size_t pos = m_pos;
+        size_t line = m_line;
+        size_t column = m_column;
+        try {
+            Token token = nextToken();
+            // Токен закончился раньше проверенных данных - дальше он не изменится
+            if (token.type != TokenType::EndOfFile && m_pos < m_checkedBytes) {
+                tokens.push_back(std::move(token));
+                continue;
+            }
+        } catch (const LexerException&) {
+            // Ошибка может исчезнуть с продолжением данных
+        }
+        m_pos = pos;
+        m_line = line;
+        m_column = column;
+        m_resumeAt = m_input.size() + (m_input.size() - pos);
+        return false;
+    }
+}
+
 std::string tokenTypeName(TokenType type) {
     switch (type) {
         case TokenType::LeftBrace: return "LeftBrace";
@@ -1,11 +1,14 @@
 #include "ParallelProcessor.hpp"
 #include "Generator.hpp"
 #include "Lexer.hpp"
+#include "InputStream.hpp"
+#include "Trace.hpp"
 #include <fstream>
 #include <sstream>
 #include <algorithm>
 #include <chrono>
 #include <cstring>
+#include <map>
 
 namespace json {
 
@@ -144,23 +147,29 @@ ParallelResult ParallelProcessor::validateLargeFile(
     resetProgress();
 
     // Читаем файл
-    std::ifstream file(filename, std::ios::binary | std::ios::ate);
-    if (!file.is_open()) {
-        ValidationError err(0, 0, "Не удалось открыть файл: " + filename, "");
-        result.errors.push_back(err);
+    StageTiming readTiming;
+    StageTimer readTimer(&readTiming);
+    std::string content;
+    try {
+        content = InputStream::open(filename, m_threadCount)->readAll();
+    } catch (const std::exception& e) {
+        result.errors.emplace_back(0, 0, e.what(), "");
         return result;
     }
+    size_t fileSize = content.size();
+    readTimer.stop();
 
-    size_t fileSize = file.tellg();
-    file.seekg(0, std::ios::beg);
+    m_progress.totalBytes = fileSize;
 
-    std::string content(fileSize, '\0');
-    file.read(&content[0], fileSize);
-    file.close();
+    result = validateContent(content, progressCallback);
 
-    m_progress.totalBytes = fileSize;
+    // Чтение входит и в общее время
+    result.stats.read.add(readTiming);
+    result.stats.total.wallMs += readTiming.wallMs;
+    result.stats.total.cpuMs += readTiming.cpuMs;
+    result.totalTimeMs += readTiming.wallMs;
 
-    return validateContent(content, progressCallback);
+    return result;
 }
 
 ParallelResult ParallelProcessor::validateContent(
@@ -174,17 +183,31 @@ ParallelResult ParallelProcessor::validateContent(
     resetProgress();
     m_progress.totalBytes = content.size();
 
+    JSON_TRACE_SCOPE("ParallelProcessor::validateContent");
     auto startTime = std::chrono::high_resolution_clock::now();
+    StageTimer totalTimer(&result.stats.total);
+    result.stats.bytes = content.size();
 
     // Разбиваем на чанки (границы элементов массива)
-    auto chunks = splitIntoChunks(content, m_threadCount);
+    StageTimer scanTimer(&result.stats.boundaryScan);
+    std::vector<std::pair<size_t, size_t>> chunks;
+    {
+        JSON_TRACE_SCOPE("boundary scan");
+        chunks = splitIntoChunks(content, m_threadCount);
+    }
+    scanTimer.stop();
     result.totalChunks = chunks.size();
     m_progress.totalChunks = chunks.size();
 
     // Если всего один чанк, используем однопоточную валидацию
     if (chunks.size() == 1) {
         Validator validator(false);
-        auto validationResult = validator.validate(content);
+        ParseStats chunkStats;
+        auto validationResult = validator.validate(content, &chunkStats);
+        result.stats.tokenize.add(chunkStats.tokenize);
+        result.stats.parse.add(chunkStats.parse);
+        result.stats.tokens += chunkStats.tokens;
+        result.stats.chunkSizes.push_back(content.size());
 
         result.errors = std::move(validationResult.errors);
         result.processedChunks = 1;
@@ -203,6 +226,7 @@ ParallelResult ParallelProcessor::validateContent(
         m_progress.errorsFound = result.totalErrors;
         m_progress.isComplete = true;
 
+        totalTimer.stop();
         return result;
     }
 
@@ -210,9 +234,20 @@ ParallelResult ParallelProcessor::validateContent(
     std::vector<std::vector<ValidationError>> threadErrors(chunks.size());
     std::mutex errorMutex;
 
+    // Статистика потоков: каждый пишет только в свой элемент
+    std::vector<ParseStats> chunkStats(chunks.size());
+    std::vector<WorkerStats> workerStats(chunks.size());
+    auto phaseStart = std::chrono::steady_clock::now();
+
     // Запускаем потоки для валидации элементов
     for (size_t i = 0; i < chunks.size(); ++i) {
-        threads.emplace_back([this, &content, &chunks, &threadErrors, &errorMutex, i, progressCallback]() {
+        threads.emplace_back([this, &content, &chunks, &threadErrors, &errorMutex,
+                              &chunkStats, &workerStats, i, progressCallback]() {
+            JSON_TRACE_THREAD_NAME("validate worker " + std::to_string(i));
+            JSON_TRACE_SCOPE("validate chunk");
+            auto busyStart = std::chrono::steady_clock::now();
+            double cpuStart = threadCpuTimeMs();
+
             auto& chunk = chunks[i];
             std::string chunkContent = content.substr(chunk.first, chunk.second - chunk.first);
 
@@ -221,12 +256,15 @@ ParallelResult ParallelProcessor::validateContent(
 
             // Валидируем чанк как массив JSON элементов
             Validator validator(false);
-            auto chunkResult = validator.validate(wrappedContent);
+            auto chunkResult = validator.validate(wrappedContent, &chunkStats[i]);
 
             // Корректируем позиции ошибок относительно начала файла
             size_t lineOffset = 0;
-            for (size_t j = 0; j < chunk.first && j < content.size(); ++j) {
-                if (content[j] == '\n') lineOffset++;
+            {
+                JSON_TRACE_SCOPE("line offset");
+                for (size_t j = 0; j < chunk.first && j < content.size(); ++j) {
+                    if (content[j] == '\n') lineOffset++;
+                }
             }
 
             for (auto& err : chunkResult.errors) {
@@ -243,6 +281,14 @@ ParallelResult ParallelProcessor::validateContent(
             m_progress.processedBytes.fetch_add(chunkContent.size(), std::memory_order_relaxed);
             m_progress.errorsFound.fetch_add(threadErrors[i].size(), std::memory_order_relaxed);
 
+            WorkerStats& worker = workerStats[i];
+            worker.workerId = i;
+            worker.chunks = 1;
+            worker.bytes = chunkContent.size();
+            worker.busyMs = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - busyStart).count();
+            worker.cpuMs = threadCpuTimeMs() - cpuStart;
+
             if (progressCallback) {
                 progressCallback(m_progress);
             }
@@ -250,19 +296,37 @@ ParallelResult ParallelProcessor::validateContent(
     }
 
     // Ждём завершения всех потоков
-    for (auto& t : threads) {
-        t.join();
+    {
+        JSON_TRACE_SCOPE("join workers");
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+
+    double phaseMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - phaseStart).count();
+    result.stats.parallelPhaseMs = phaseMs;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        result.stats.tokenize.add(chunkStats[i].tokenize);
+        result.stats.parse.add(chunkStats[i].parse);
+        result.stats.tokens += chunkStats[i].tokens;
+        result.stats.chunkSizes.push_back(chunks[i].second - chunks[i].first);
+
+        workerStats[i].idleMs = std::max(0.0, phaseMs - workerStats[i].busyMs);
+        result.stats.workers.push_back(workerStats[i]);
     }
 
     auto endTime = std::chrono::high_resolution_clock::now();
     result.totalTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
 
     // Собираем все ошибки
+    StageTimer mergeTimer(&result.stats.merge);
     for (auto& errors : threadErrors) {
         for (auto& err : errors) {
             result.errors.push_back(std::move(err));
         }
     }
+    mergeTimer.stop();
 
     result.processedChunks = m_progress.processedChunks.load();
     result.totalErrors = result.errors.size();
@@ -275,25 +339,41 @@ ParallelResult ParallelProcessor::validateContent(
 
     m_progress.isComplete = true;
 
+    totalTimer.stop();
     return result;
 }
 
 // ==================== ParallelGenerator ====================
 
-ParallelGenerator::ParallelGenerator(unsigned int threadCount) {
+ParallelGenerator::ParallelGenerator(unsigned int threadCount)
+    : m_chunkSize(4 * 1024 * 1024), m_maxChunksInFlight(0), m_seed(0), m_lastSeed(0) {
     if (threadCount == 0) {
         m_threadCount = std::thread::hardware_concurrency();
         if (m_threadCount == 0) m_threadCount = 1;
     } else {
         m_threadCount = threadCount;
     }
+    m_maxChunksInFlight = 2 * static_cast<size_t>(m_threadCount);
 }
 
 void ParallelGenerator::setThreadCount(unsigned int count) {
     m_threadCount = count > 0 ? count : 1;
+    m_maxChunksInFlight = 2 * static_cast<size_t>(m_threadCount);
+}
+
+unsigned int ParallelGenerator::chunkSeed(uint64_t seed, size_t index) {
+    // splitmix64 от (seed, index): счётчиковый ГПСЧ, чанки независимы друг от друга
+    uint64_t z = seed + (static_cast<uint64_t>(index) + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+
+    // Seed 0 у Generator означает "по времени", поэтому его избегаем
+    unsigned int result = static_cast<unsigned int>(z ^ (z >> 32));
+    return result != 0 ? result : 1;
 }
 
-std::string ParallelGenerator::generateChunk(size_t targetSize, int depth, int seed, int errorProbability) {
+std::string ParallelGenerator::generateChunk(size_t targetSize, int depth, unsigned int seed, int errorProbability) {
     Generator generator(seed);
     GeneratorOptions opts;
     opts.maxDepth = depth;
@@ -303,25 +383,19 @@ std::string ParallelGenerator::generateChunk(size_t targetSize, int depth, int s
     opts.compactOutput = true;
     generator.setOptions(opts);
 
-    std::ostringstream oss;
-    size_t currentSize = 0;
-    bool firstElement = true;
-
-    while (currentSize < targetSize) {
-        std::string element = generator.generate();
+    // Элементы дописываются прямо в буфер чанка, без промежуточных строк
+    std::string chunk;
+    chunk.reserve(targetSize + 64 * 1024);
 
+    while (chunk.size() < targetSize) {
         // Добавляем запятую ПЕРЕД элементом (кроме первого)
-        if (!firstElement) {
-            oss << ",\n";
-            currentSize += 2;
+        if (!chunk.empty()) {
+            chunk.append(",\n", 2);
         }
-        firstElement = false;
-
-        oss << element;
-        currentSize += element.size();
+        generator.generateInto(chunk);
     }
 
-    return oss.str();
+    return chunk;
 }
 
 bool ParallelGenerator::generateLargeFile(
@@ -329,8 +403,11 @@ bool ParallelGenerator::generateLargeFile(
     size_t targetSizeBytes,
     int depth,
     int errorProbability,
-    std::function<void(size_t current, size_t total)> progressCallback) {
+    std::function<void(size_t current, size_t total)> progressCallback,
+    ParseStats* stats) {
 
+    JSON_TRACE_SCOPE("ParallelGenerator::generateLargeFile");
+    StageTimer totalTimer(stats ? &stats->total : nullptr);
     m_generatedBytes = 0;
     m_targetBytes = targetSizeBytes;
 
@@ -341,63 +418,188 @@ bool ParallelGenerator::generateLargeFile(
     }
 
     // Начало массива
-    file << "[\n";
+    file.write("[\n", 2);
     m_generatedBytes += 2;
 
-    const size_t chunkSize = 4 * 1024 * 1024; // 4MB
-    std::mt19937 rng(static_cast<unsigned int>(std::time(nullptr)));
+    // Разбиение на чанки фиксировано заранее и не зависит от числа потоков
+    const size_t payloadBytes = targetSizeBytes > 2 ? targetSizeBytes - 2 : 0;
+    const size_t chunkCount = (payloadBytes + m_chunkSize - 1) / m_chunkSize;
 
-    // Записываем результаты по мере готовности
-    bool first = true;
-    while (m_generatedBytes < targetSizeBytes) {
-        size_t remaining = targetSizeBytes > m_generatedBytes
-            ? targetSizeBytes - m_generatedBytes
-            : 0;
-        if (remaining == 0) {
-            break;
-        }
+    uint64_t baseSeed = m_seed;
+    if (baseSeed == 0) {
+        baseSeed = static_cast<uint64_t>(
+            std::chrono::high_resolution_clock::now().time_since_epoch().count());
+        if (baseSeed == 0) baseSeed = 1;
+    }
+    m_lastSeed = baseSeed;
+
+    // Очередь переупорядочивания: готовые чанки ждут, пока писатель дойдёт до их номера.
+    // Рабочие не берут чанк дальше окна m_maxChunksInFlight от записываемого,
+    // поэтому в памяти одновременно не больше окна чанков.
+    std::mutex queueMutex;
+    std::condition_variable chunkReady;
+    std::condition_variable windowMoved;
+    std::map<size_t, std::string> readyChunks;
+    size_t nextToWrite = 0;
+    bool aborted = false;
+    std::exception_ptr workerError;
+    std::atomic<size_t> nextChunk{0};
+
+    // Статистика потоков: каждый пишет только в свой элемент
+    struct WorkerLocal {
+        WorkerStats worker;
+        StageTiming generate;
+    };
+    std::vector<WorkerLocal> workerLocals;
+
+    auto worker = [&](WorkerLocal* local, size_t workerIndex) {
+        JSON_TRACE_THREAD_NAME("generate worker " + std::to_string(workerIndex));
+        (void)workerIndex;
+        while (true) {
+            size_t index = nextChunk.fetch_add(1);
+            if (index >= chunkCount) {
+                return;
+            }
 
-        size_t batchCount = std::min(static_cast<size_t>(m_threadCount),
-            (remaining + chunkSize - 1) / chunkSize);
+            {
+                JSON_TRACE_SCOPE("wait window");
+                auto waitStart = std::chrono::steady_clock::now();
+                std::unique_lock<std::mutex> lock(queueMutex);
+                windowMoved.wait(lock, [&]() {
+                    return aborted || index < nextToWrite + m_maxChunksInFlight;
+                });
+                if (local) {
+                    local->worker.idleMs += std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - waitStart).count();
+                }
+                if (aborted) {
+                    return;
+                }
+            }
 
-        std::vector<std::future<std::string>> futures;
-        futures.reserve(batchCount);
+            size_t thisChunkSize = std::min(m_chunkSize, payloadBytes - index * m_chunkSize);
+
+            try {
+                JSON_TRACE_SCOPE("generate chunk");
+                StageTimer timer(local ? &local->generate : nullptr);
+                std::string chunk = generateChunk(thisChunkSize, depth, chunkSeed(baseSeed, index), errorProbability);
+                timer.stop();
+                if (local) {
+                    local->worker.chunks++;
+                    local->worker.bytes += chunk.size();
+                }
+
+                std::lock_guard<std::mutex> lock(queueMutex);
+                readyChunks.emplace(index, std::move(chunk));
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                if (!workerError) {
+                    workerError = std::current_exception();
+                }
+                aborted = true;
+                windowMoved.notify_all();
+            }
+            chunkReady.notify_one();
+        }
+    };
 
-        for (size_t i = 0; i < batchCount; ++i) {
-            size_t thisChunkSize = std::min(chunkSize, remaining);
-            remaining -= thisChunkSize;
+    size_t workerCount = std::min<size_t>(m_threadCount, std::max<size_t>(chunkCount, 1));
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount);
+    if (stats) {
+        workerLocals.resize(workerCount);
+    }
+    auto phaseStart = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < workerCount; ++i) {
+        workers.emplace_back(worker, stats ? &workerLocals[i] : nullptr, i);
+    }
 
-            futures.push_back(std::async(std::launch::async,
-                &ParallelGenerator::generateChunk, this, thisChunkSize, depth, rng(), errorProbability));
+    // Писатель: сбрасывает чанки строго по порядку, пока рабочие генерируют следующие
+    bool writeOk = true;
+    for (size_t index = 0; index < chunkCount; ++index) {
+        std::string chunk;
+        {
+            JSON_TRACE_SCOPE("wait chunk");
+            std::unique_lock<std::mutex> lock(queueMutex);
+            chunkReady.wait(lock, [&]() {
+                return aborted || readyChunks.count(index) > 0;
+            });
+            if (aborted) {
+                break;
+            }
+            auto it = readyChunks.find(index);
+            chunk = std::move(it->second);
+            readyChunks.erase(it);
         }
 
-        for (auto& future : futures) {
-            std::string chunk = future.get();
+        JSON_TRACE_SCOPE("write chunk");
+        StageTimer writeTimer(stats ? &stats->write : nullptr);
+        if (index > 0) {
+            file.write(",\n", 2);
+            m_generatedBytes += 2;
+        }
+        file.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        m_generatedBytes += chunk.size();
+        writeTimer.stop();
 
-            std::lock_guard<std::mutex> lock(m_fileMutex);
+        if (stats) {
+            stats->chunkSizes.push_back(chunk.size());
+        }
 
-            if (!first) {
-                file << ",\n";
-                m_generatedBytes += 2;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            nextToWrite = index + 1;
+            if (!file.good()) {
+                writeOk = false;
+                aborted = true;
             }
-            first = false;
+        }
+        windowMoved.notify_all();
 
-            file << chunk;
-            m_generatedBytes += chunk.size();
+        if (!writeOk) {
+            break;
+        }
 
-            if (progressCallback) {
-                progressCallback(m_generatedBytes, targetSizeBytes);
-            }
+        if (progressCallback) {
+            progressCallback(m_generatedBytes, targetSizeBytes);
+        }
+    }
+
+    for (auto& t : workers) {
+        t.join();
+    }
+
+    if (stats) {
+        stats->parallelPhaseMs += std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - phaseStart).count();
+        for (size_t i = 0; i < workerLocals.size(); ++i) {
+            WorkerLocal& local = workerLocals[i];
+            local.worker.workerId = i;
+            local.worker.busyMs = local.generate.wallMs;
+            local.worker.cpuMs = local.generate.cpuMs;
+            stats->generate.add(local.generate);
+            stats->workers.push_back(local.worker);
         }
     }
 
+    if (workerError) {
+        std::rethrow_exception(workerError);
+    }
+    if (!writeOk) {
+        return false;
+    }
+
     // Конец массива
-    file << "\n]";
+    file.write("\n]", 2);
     m_generatedBytes += 2;
 
     file.close();
 
-    return true;
+    if (stats) {
+        stats->bytes += m_generatedBytes;
+    }
+
+    return file.good();
 }
 
 } // namespace json
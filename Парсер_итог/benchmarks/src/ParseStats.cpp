@@ -0,0 +1,113 @@
+#include "ParseStats.hpp"
+#include <algorithm>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace json {
+
+double threadCpuTimeMs() {
+#if defined(_WIN32)
+    FILETIME creation, exitTime, kernel, user;
+    if (GetThreadTimes(GetCurrentThread(), &creation, &exitTime, &kernel, &user)) {
+        ULARGE_INTEGER k, u;
+        k.LowPart = kernel.dwLowDateTime;
+        k.HighPart = kernel.dwHighDateTime;
+        u.LowPart = user.dwLowDateTime;
+        u.HighPart = user.dwHighDateTime;
+        return static_cast<double>(k.QuadPart + u.QuadPart) / 10000.0; // 100 нс -> мс
+    }
+    return 0.0;
+#elif defined(CLOCK_THREAD_CPUTIME_ID)
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+        return static_cast<double>(ts.tv_sec) * 1000.0 + static_cast<double>(ts.tv_nsec) / 1e6;
+    }
+    return 0.0;
+#else
+    // Время процесса, если потокового нет
+    return static_cast<double>(std::clock()) * 1000.0 / CLOCKS_PER_SEC;
+#endif
+}
+
+size_t ParseStats::minChunkSize() const {
+    if (chunkSizes.empty()) return 0;
+    return *std::min_element(chunkSizes.begin(), chunkSizes.end());
+}
+
+size_t ParseStats::maxChunkSize() const {
+    if (chunkSizes.empty()) return 0;
+    return *std::max_element(chunkSizes.begin(), chunkSizes.end());
+}
+
+double ParseStats::averageChunkSize() const {
+    if (chunkSizes.empty()) return 0.0;
+    double sum = 0.0;
+    for (size_t size : chunkSizes) sum += static_cast<double>(size);
+    return sum / static_cast<double>(chunkSizes.size());
+}
+
+double ParseStats::throughputMBps() const {
+    if (total.wallMs <= 0.0) return 0.0;
+    return (static_cast<double>(bytes) / (1024.0 * 1024.0)) / (total.wallMs / 1000.0);
+}
+
+std::string ParseStats::toString() const {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+
+    auto stage = [&oss](const char* name, const StageTiming& t) {
+        if (t.calls == 0) return;
+        oss << "  " << std::left << std::setw(16) << name
+            << std::right << std::setw(12) << t.wallMs << " мс"
+            << std::setw(12) << t.cpuMs << " мс CPU"
+            << "  (" << t.calls << ")\n";
+    };
+
+    oss << "Этапы (время / процессорное время):\n";
+    stage("Чтение", read);
+    stage("Границы чанков", boundaryScan);
+    stage("Токенизация", tokenize);
+    stage("Разбор", parse);
+    stage("Сборка", merge);
+    stage("Генерация", generate);
+    stage("Запись", write);
+    stage("Всего", total);
+
+    if (parallelPhaseMs > 0.0) {
+        oss << "  Параллельная фаза: " << parallelPhaseMs << " мс\n";
+    }
+
+    oss << "Объём: " << bytes << " байт, токенов: " << tokens
+        << ", элементов: " << elements;
+    if (total.wallMs > 0.0) {
+        oss << ", " << throughputMBps() << " МБ/с";
+    }
+    oss << "\n";
+
+    if (!chunkSizes.empty()) {
+        oss << "Чанки: " << chunkSizes.size()
+            << ", размер мин/сред/макс: " << minChunkSize() << " / "
+            << static_cast<size_t>(averageChunkSize()) << " / " << maxChunkSize() << " байт\n";
+    }
+
+    if (!workers.empty()) {
+        oss << "Потоки:\n";
+        for (const auto& w : workers) {
+            oss << "  #" << w.workerId
+                << ": чанков " << w.chunks
+                << ", байт " << w.bytes
+                << ", работа " << w.busyMs << " мс"
+                << ", простой " << w.idleMs << " мс"
+                << ", CPU " << w.cpuMs << " мс\n";
+        }
+    }
+
+    return oss.str();
+}
+
+} // namespace json
@@ -1,4 +1,6 @@
 #include "Parser.hpp"
+#include "InputStream.hpp"
+#include "Trace.hpp"
 #include <fstream>
 #include <sstream>
 #include <cstdlib>
@@ -6,14 +8,27 @@
 #include <vector>
 #include <future>
 #include <mutex>
+#include <chrono>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 
 namespace json {
 
 Parser::Parser(const std::vector<Token>& tokens)
-    : m_tokens(tokens), m_current(0), m_progressCallback(nullptr), m_totalTokens(tokens.size()) {}
+    : m_tokens(tokens), m_current(0), m_progressCallback(nullptr), m_totalTokens(tokens.size()),
+      m_valueCount(0), m_numberMode(NumberMode::Eager), m_maxDepth(DEFAULT_MAX_DEPTH),
+      m_spanSource(0), m_spanBase(0) {
+    m_stack.reserve(INITIAL_STACK_CAPACITY);
+}
 
 Parser::Parser(std::vector<Token>&& tokens)
-    : m_tokens(std::move(tokens)), m_current(0), m_progressCallback(nullptr), m_totalTokens(m_tokens.size()) {}
+    : m_tokens(std::move(tokens)), m_current(0), m_progressCallback(nullptr), m_totalTokens(m_tokens.size()),
+      m_valueCount(0), m_numberMode(NumberMode::Eager), m_maxDepth(DEFAULT_MAX_DEPTH),
+      m_spanSource(0), m_spanBase(0) {
+    m_stack.reserve(INITIAL_STACK_CAPACITY);
+}
 
 void Parser::setProgressCallback(ProgressCallback callback) {
     m_progressCallback = callback;
@@ -78,116 +93,136 @@ JsonValue Parser::parse() {
     return result;
 }
 
-JsonValue Parser::parseValue() {
-    switch (current().type) {
-        case TokenType::LeftBrace:
-            return parseObject();
-        case TokenType::LeftBracket:
-            return parseArray();
-        case TokenType::String:
-            return parseString();
-        case TokenType::Number:
-            return parseNumber();
-        case TokenType::True:
-        case TokenType::False:
-            return parseBool();
-        case TokenType::Null:
-            return parseNull();
-        default:
-            throw ParserException("Неожиданный токен: " + tokenTypeName(current().type),
-                                 current().line, current().column);
-    }
+void Parser::recordSpan(const JsonValue& container, size_t openOffset) const {
+    // Текущий токен - закрывающая скобка контейнера
+    if (m_spanSource == 0) return;
+    SourceSpan span;
+    span.source = m_spanSource;
+    span.offset = m_spanBase + openOffset;
+    span.length = current().offset + 1 - openOffset;
+    container.setSourceSpan(span);
 }
 
-JsonValue Parser::parseObject() {
-    expect(TokenType::LeftBrace, "Ожидалась '{'");
-
-    JsonObject obj;
-
-    // Пустой объект
-    if (check(TokenType::RightBrace)) {
-        advance();
-        return JsonValue(std::move(obj));
-    }
+JsonValue Parser::parseValue() {
+    m_stack.clear();
 
     while (true) {
-        // Ключ (строка)
-        if (!check(TokenType::String)) {
-            throw ParserException("Ожидался ключ (строка) в объекте",
-                                 current().line, current().column);
-        }
-        std::string key = current().value;
-        advance();
-
-        // Двоеточие
-        expect(TokenType::Colon, "Ожидалось ':'");
-
-        // Значение
-        JsonValue value = parseValue();
-        obj[key] = std::move(value);
+        JsonValue value;
+        m_valueCount++;
+
+        switch (current().type) {
+            case TokenType::LeftBrace:
+            case TokenType::LeftBracket: {
+                bool isObject = check(TokenType::LeftBrace);
+                if (m_stack.size() >= m_maxDepth) {
+                    throw ParserException("Превышена максимальная глубина вложенности (" +
+                                         std::to_string(m_maxDepth) + ")",
+                                         current().line, current().column);
+                }
+                size_t openOffset = current().offset;
+                advance();
+
+                // Пустой контейнер сразу становится готовым значением
+                if (check(isObject ? TokenType::RightBrace : TokenType::RightBracket)) {
+                    value = isObject ? JsonValue(JsonObject()) : JsonValue(JsonArray());
+                    recordSpan(value, openOffset);
+                    advance();
+                    break;
+                }
 
-        // Запятая или конец объекта
-        if (check(TokenType::Comma)) {
-            advance();
-            // Проверка на trailing comma (не допускается в JSON)
-            if (check(TokenType::RightBrace)) {
-                throw ParserException("Запятая перед закрывающей скобкой не допускается",
-                                     current().line, current().column);
+                m_stack.emplace_back();
+                m_stack.back().isObject = isObject;
+                m_stack.back().openOffset = openOffset;
+                if (isObject) {
+                    parseKey(m_stack.back());
+                }
+                continue; // Первый элемент контейнера
             }
-        } else if (check(TokenType::RightBrace)) {
-            advance();
-            break;
-        } else {
-            throw ParserException("Ожидалась ',' или '}'",
-                                 current().line, current().column);
+            case TokenType::String:
+                value = parseString();
+                break;
+            case TokenType::Number:
+                value = parseNumber();
+                break;
+            case TokenType::True:
+            case TokenType::False:
+                value = parseBool();
+                break;
+            case TokenType::Null:
+                value = parseNull();
+                break;
+            default:
+                throw ParserException("Неожиданный токен: " + tokenTypeName(current().type),
+                                     current().line, current().column);
         }
-    }
-
-    return JsonValue(std::move(obj));
-}
 
-JsonValue Parser::parseArray() {
-    expect(TokenType::LeftBracket, "Ожидалась '['");
-
-    JsonArray arr;
+        // Значение готово: добавляем его в открытый контейнер
+        // и закрываем все контейнеры, которые на этом завершились
+        while (true) {
+            if (m_stack.empty()) {
+                return value;
+            }
 
-    // Пустой массив
-    if (check(TokenType::RightBracket)) {
-        advance();
-        return JsonValue(std::move(arr));
-    }
+            Frame& frame = m_stack.back();
+            if (frame.isObject) {
+                frame.object[std::move(frame.key)] = std::move(value);
+            } else {
+                frame.array.push_back(std::move(value));
+            }
 
-    while (true) {
-        // Элемент
-        arr.push_back(parseValue());
+            TokenType closing = frame.isObject ? TokenType::RightBrace : TokenType::RightBracket;
+            if (check(TokenType::Comma)) {
+                advance();
+                // Проверка на trailing comma (не допускается в JSON)
+                if (check(closing)) {
+                    throw ParserException("Запятая перед закрывающей скобкой не допускается",
+                                         current().line, current().column);
+                }
+                if (frame.isObject) {
+                    parseKey(frame);
+                }
+                break; // Следующий элемент
+            }
 
-        // Запятая или конец массива
-        if (check(TokenType::Comma)) {
-            advance();
-            // Проверка на trailing comma
-            if (check(TokenType::RightBracket)) {
-                throw ParserException("Запятая перед закрывающей скобкой не допускается",
+            if (!check(closing)) {
+                throw ParserException(frame.isObject ? "Ожидалась ',' или '}'" : "Ожидалась ',' или ']'",
                                      current().line, current().column);
             }
-        } else if (check(TokenType::RightBracket)) {
+            value = frame.isObject ? JsonValue(std::move(frame.object))
+                                   : JsonValue(std::move(frame.array));
+            recordSpan(value, frame.openOffset);
             advance();
-            break;
-        } else {
-            throw ParserException("Ожидалась ',' или ']'",
-                                 current().line, current().column);
+            m_stack.pop_back();
         }
     }
+}
+
+void Parser::parseKey(Frame& frame) {
+    if (!check(TokenType::String)) {
+        throw ParserException("Ожидался ключ (строка) в объекте",
+                             current().line, current().column);
+    }
+    frame.key = std::move(m_tokens[m_current].value);
+    advance();
 
-    return JsonValue(std::move(arr));
+    expect(TokenType::Colon, "Ожидалось ':'");
 }
 
 JsonValue Parser::parseString() {
-    std::string value = current().value;
+    // Значение токена больше не нужно - забираем без копирования
+    std::string value = std::move(m_tokens[m_current].value);
     advance();
     return JsonValue(std::move(value));
 }
 
 JsonValue Parser::parseNumber() {
+    if (m_numberMode == NumberMode::Lazy) {
+        // Лексема уже проверена лексером: забираем её без преобразования
+        JsonRawNumber raw(std::move(m_tokens[m_current].value));
+        advance();
+        return JsonValue(std::move(raw));
+    }
+
     double value = std::stod(current().value);
     advance();
     return JsonValue(value);
@@ -205,62 +240,202 @@ JsonValue Parser::parseNull() {
 }
 
 // Статические методы
-JsonValue Parser::parseString(const std::string& jsonStr) {
-    Lexer lexer(jsonStr);
-    std::vector<Token> tokens = lexer.tokenize();
+JsonValue Parser::parseContent(const std::string& content, ParseStats* stats, NumberMode mode) {
+    std::vector<Token> tokens;
+    {
+        JSON_TRACE_SCOPE("tokenize");
+        StageTimer timer(stats ? &stats->tokenize : nullptr);
+        Lexer lexer(content);
+        tokens = lexer.tokenize();
+    }
+
+    if (stats) {
+        stats->bytes += content.size();
+        stats->tokens += tokens.size();
+    }
+
+    JSON_TRACE_SCOPE("parse");
+    StageTimer timer(stats ? &stats->parse : nullptr);
     Parser parser(std::move(tokens));
-    return parser.parse();
-}
+    parser.setNumberMode(mode);
+    JsonValue result = parser.parse();
+    timer.stop();
 
-JsonValue Parser::parseFile(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        throw JsonException("Не удалось открыть файл: " + filename);
+    if (stats) {
+        stats->elements += parser.m_valueCount;
     }
+    return result;
+}
 
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    return parseString(buffer.str());
+JsonValue Parser::parseString(const std::string& jsonStr, ParseStats* stats) {
+    return parseString(jsonStr, NumberMode::Eager, stats);
 }
 
-JsonValue Parser::parseFileWithProgress(const std::string& filename, ProgressCallback callback) {
-    std::ifstream file(filename, std::ios::binary);
-    if (!file.is_open()) {
-        throw JsonException("Не удалось открыть файл: " + filename);
-    }
+JsonValue Parser::parseString(const std::string& jsonStr, NumberMode mode, ParseStats* stats) {
+    StageTimer totalTimer(stats ? &stats->total : nullptr);
+    return parseContent(jsonStr, stats, mode);
+}
+
+JsonValue Parser::parseFile(const std::string& filename, ParseStats* stats) {
+    return parseFile(filename, NumberMode::Eager, stats);
+}
 
-    // Получаем размер файла
-    file.seekg(0, std::ios::end);
-    size_t fileSize = file.tellg();
-    file.seekg(0, std::ios::beg);
+JsonValue Parser::parseFile(const std::string& filename, NumberMode mode, ParseStats* stats) {
+    JSON_TRACE_SCOPE("Parser::parseFile");
+    StageTimer totalTimer(stats ? &stats->total : nullptr);
+    StageTimer readTimer(stats ? &stats->read : nullptr);
 
-    // Читаем файл с прогрессом
     std::string content;
-    content.reserve(fileSize);
+    {
+        JSON_TRACE_SCOPE("read");
+        content = InputStream::open(filename)->readAll();
+    }
+    readTimer.stop();
 
-    const size_t chunkSize = 1024 * 1024; // 1 МБ чанки
-    std::vector<char> buffer(chunkSize);
-    size_t totalRead = 0;
+    return parseContent(content, stats, mode);
+}
 
-    while (file.good()) {
-        file.read(buffer.data(), chunkSize);
-        std::streamsize bytesRead = file.gcount();
+namespace {
+
+// Чтение файла блоками в отдельном потоке (тройная буферизация): пока
+// потребитель обрабатывает один блок, следующие уже читаются (и
+// распаковываются, если файл сжат). Блоков в памяти не больше BUFFER_COUNT.
+class BlockReader {
+public:
+    static constexpr size_t BLOCK_SIZE = 1024 * 1024;
+    static constexpr size_t BUFFER_COUNT = 3;
+
+    struct Block {
+        size_t buffer;
+        size_t size;
+        uint64_t position;              // Прочитано байт файла после блока
+    };
+
+private:
+    InputStream& m_input;
+    std::vector<std::vector<char>> m_buffers;
+    std::vector<size_t> m_free;         // Свободные буферы
+    std::deque<Block> m_ready;          // Прочитанные блоки по порядку
+    bool m_done = false;                // Файл дочитан (или ошибка чтения)
+    std::string m_error;                // Ошибка чтения или распаковки
+    bool m_stop = false;                // Потребитель прекратил чтение
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::thread m_thread;
+
+    void readLoop() {
+        JSON_TRACE_THREAD_NAME("file reader");
+        while (true) {
+            size_t buffer;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock, [this]() { return m_stop || !m_free.empty(); });
+                if (m_stop) return;
+                buffer = m_free.back();
+                m_free.pop_back();
+            }
 
-        if (bytesRead > 0) {
-            content.append(buffer.data(), bytesRead);
-            totalRead += bytesRead;
+            size_t size = 0;
+            std::string error;
+            try {
+                size = m_input.read(m_buffers[buffer].data(), BLOCK_SIZE);
+            } catch (const std::exception& e) {
+                error = e.what();
+            }
+            bool last = size == 0;
 
-            if (callback) {
-                callback(totalRead, fileSize);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (size > 0) {
+                m_ready.push_back({buffer, size, m_input.position()});
+            } else {
+                m_free.push_back(buffer);
+            }
+            if (last) {
+                m_done = true;
+                m_error = std::move(error);
             }
+            m_cv.notify_all();
+            if (last) return;
         }
     }
 
-    file.close();
+public:
+    explicit BlockReader(InputStream& input)
+        : m_input(input), m_buffers(BUFFER_COUNT, std::vector<char>(BLOCK_SIZE)) {
+        for (size_t i = 0; i < BUFFER_COUNT; ++i) {
+            m_free.push_back(i);
+        }
+        m_thread = std::thread(&BlockReader::readLoop, this);
+    }
 
-    // Токенизация
-    Lexer lexer(content);
-    std::vector<Token> tokens = lexer.tokenize();
+    // Ждать чтения можно и при исключении у потребителя
+    ~BlockReader() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        m_thread.join();
+    }
+
+    // Следующий блок; false - файл кончился. JsonException при ошибке
+    // чтения или распаковки.
+    bool next(Block& block) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this]() { return m_done || !m_ready.empty(); });
+        if (m_ready.empty()) {
+            if (!m_error.empty()) {
+                throw JsonException(m_error);
+            }
+            return false;
+        }
+        block = m_ready.front();
+        m_ready.pop_front();
+        return true;
+    }
+
+    const char* data(const Block& block) const { return m_buffers[block.buffer].data(); }
+
+    // Вернуть буфер блока для чтения следующих
+    void release(const Block& block) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_free.push_back(block.buffer);
+        m_cv.notify_all();
+    }
+};
+
+} // namespace
+
+JsonValue Parser::parseFileWithProgress(const std::string& filename, ProgressCallback callback) {
+    JSON_TRACE_SCOPE("Parser::parseFileWithProgress");
+    std::unique_ptr<InputStream> input = InputStream::open(filename);
+    size_t fileSize = static_cast<size_t>(input->fileSize());
+
+    // Чтение и токенизация перекрываются: лексер разбирает полученные
+    // блоки, пока поток чтения читает (и распаковывает) следующие.
+    // Прогресс - по байтам файла, для сжатого тоже.
+    Lexer lexer;
+    if (input->compression() == Compression::None) {
+        lexer.reserve(fileSize);
+    }
+    std::vector<Token> tokens;
+    {
+        BlockReader reader(*input);
+        BlockReader::Block block;
+        while (reader.next(block)) {
+            lexer.append(reader.data(block), block.size);
+            reader.release(block);
+
+            if (callback) {
+                callback(static_cast<size_t>(block.position), fileSize);
+            }
+
+            JSON_TRACE_SCOPE("tokenize block");
+            lexer.tokenizeAvailable(tokens);
+        }
+    }
+    lexer.finish();
+    lexer.tokenizeAvailable(tokens);
 
     // Парсинг с прогрессом
     Parser parser(std::move(tokens));
@@ -467,29 +642,25 @@ std::vector<std::pair<size_t, size_t>> Parser::splitContentIntoChunks(
 
 // Многопоточный парсинг файла
 JsonValue Parser::parseFileParallel(const std::string& filename, unsigned int threadCount,
-                                    ProgressCallback callback) {
+                                    ProgressCallback callback, ParseStats* stats) {
+    JSON_TRACE_SCOPE("Parser::parseFileParallel");
+    StageTimer totalTimer(stats ? &stats->total : nullptr);
+
     // Определяем количество потоков
     if (threadCount == 0) {
         threadCount = std::thread::hardware_concurrency();
         if (threadCount == 0) threadCount = 1;
     }
 
-    // Читаем файл
-    std::ifstream file(filename, std::ios::binary);
-    if (!file.is_open()) {
-        throw JsonException("Не удалось открыть файл: " + filename);
-    }
-
-    // Получаем размер файла
-    file.seekg(0, std::ios::end);
-    size_t fileSize = file.tellg();
-    file.seekg(0, std::ios::beg);
-
-    // Читаем содержимое
+    // Читаем файл (сжатый распаковывается тем же числом потоков)
+    StageTimer readTimer(stats ? &stats->read : nullptr);
     std::string content;
-    content.resize(fileSize);
-    file.read(&content[0], fileSize);
-    file.close();
+    {
+        JSON_TRACE_SCOPE("read");
+        content = InputStream::open(filename, threadCount)->readAll();
+    }
+    size_t fileSize = content.size();
+    readTimer.stop();
 
     if (callback) callback(fileSize / 10, fileSize); // 10% - чтение завершено
 
@@ -502,23 +673,25 @@ JsonValue Parser::parseFileParallel(const std::string& filename, unsigned int th
 
     if (firstNonSpace >= content.size() || content[firstNonSpace] != '[') {
         // Не массив - используем обычный последовательный парсинг
-        Lexer lexer(content);
-        std::vector<Token> tokens = lexer.tokenize();
-        Parser parser(std::move(tokens));
+        JsonValue result = parseContent(content, stats);
         if (callback) callback(fileSize, fileSize);
-        return parser.parse();
+        return result;
     }
 
     // Разбиваем содержимое на текстовые чанки по границам элементов массива
-    auto textChunks = splitContentIntoChunks(content, threadCount);
+    StageTimer scanTimer(stats ? &stats->boundaryScan : nullptr);
+    std::vector<std::pair<size_t, size_t>> textChunks;
+    {
+        JSON_TRACE_SCOPE("boundary scan");
+        textChunks = splitContentIntoChunks(content, threadCount);
+    }
+    scanTimer.stop();
 
     if (textChunks.size() == 1) {
         // Не удалось разбить - используем последовательный парсинг
-        Lexer lexer(content);
-        std::vector<Token> tokens = lexer.tokenize();
-        Parser parser(std::move(tokens));
+        JsonValue result = parseContent(content, stats);
         if (callback) callback(fileSize, fileSize);
-        return parser.parse();
+        return result;
     }
 
     // ПАРАЛЛЕЛЬНАЯ ТОКЕНИЗАЦИЯ И ПАРСИНГ
@@ -529,9 +702,29 @@ JsonValue Parser::parseFileParallel(const std::string& filename, unsigned int th
     std::atomic<size_t> completedChunks{0};
     size_t totalChunks = textChunks.size();
 
-    for (const auto& chunk : textChunks) {
+    // Статистика чанков: каждый поток пишет только в свой элемент
+    struct ChunkStats {
+        StageTiming tokenize;
+        StageTiming parse;
+        WorkerStats worker;
+        size_t tokens = 0;
+        size_t values = 0;
+    };
+    std::vector<ChunkStats> chunkStats(stats ? totalChunks : 0);
+
+    auto phaseStart = std::chrono::steady_clock::now();
+
+    for (size_t index = 0; index < totalChunks; ++index) {
+        const auto chunk = textChunks[index];
+        ChunkStats* local = stats ? &chunkStats[index] : nullptr;
+
         futures.push_back(std::async(std::launch::async,
-            [&content, chunk, callback, &progressMutex, &completedChunks, totalChunks, fileSize]() {
+            [&content, chunk, callback, &progressMutex, &completedChunks, totalChunks, fileSize, local, index]() {
+            JSON_TRACE_THREAD_NAME("parse worker " + std::to_string(index));
+            JSON_TRACE_SCOPE("parse chunk");
+            auto busyStart = std::chrono::steady_clock::now();
+            double cpuStart = local ? threadCpuTimeMs() : 0.0;
+
             // Извлекаем текстовый чанк
             std::string chunkText = content.substr(chunk.first, chunk.second - chunk.first);
 
@@ -539,12 +732,33 @@ JsonValue Parser::parseFileParallel(const std::string& filename, unsigned int th
             std::string wrappedChunk = "[" + chunkText + "]";
 
             // Токенизация чанка (параллельно!)
-            Lexer lexer(wrappedChunk);
-            std::vector<Token> tokens = lexer.tokenize();
+            std::vector<Token> tokens;
+            {
+                JSON_TRACE_SCOPE("tokenize");
+                StageTimer timer(local ? &local->tokenize : nullptr);
+                Lexer lexer(wrappedChunk);
+                tokens = lexer.tokenize();
+            }
+            if (local) local->tokens = tokens.size();
 
             // Парсинг чанка (параллельно!)
+            StageTimer parseTimer(local ? &local->parse : nullptr);
             Parser parser(std::move(tokens));
-            JsonValue result = parser.parse();
+            JsonValue result;
+            {
+                JSON_TRACE_SCOPE("parse");
+                result = parser.parse();
+            }
+            parseTimer.stop();
+
+            if (local) {
+                local->values = parser.m_valueCount;
+                local->worker.chunks = 1;
+                local->worker.bytes = chunkText.size();
+                local->worker.busyMs = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - busyStart).count();
+                local->worker.cpuMs = threadCpuTimeMs() - cpuStart;
+            }
 
             // Обновляем прогресс
             completedChunks++;
@@ -556,18 +770,45 @@ JsonValue Parser::parseFileParallel(const std::string& filename, unsigned int th
 
             // Возвращаем массив элементов
             if (result.isArray()) {
-                return result.asArray();
+                return std::move(result.asArray());
             }
             return JsonArray();
         }));
     }
 
     // Собираем результаты
+    StageTiming mergeTiming;
     JsonArray finalArray;
     for (auto& future : futures) {
-        JsonArray chunkArray = future.get();
-        for (const JsonValue& elem : chunkArray) {
-            finalArray.push_back(elem);
+        JsonArray chunkArray;
+        {
+            JSON_TRACE_SCOPE("wait chunk");
+            chunkArray = future.get();
+        }
+        JSON_TRACE_SCOPE("merge");
+        StageTimer timer(stats ? &mergeTiming : nullptr);
+        finalArray.insert(finalArray.end(), std::make_move_iterator(chunkArray.begin()),
+                          std::make_move_iterator(chunkArray.end()));
+    }
+
+    if (stats) {
+        double phaseMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - phaseStart).count();
+        stats->parallelPhaseMs += phaseMs;
+        stats->merge.add(mergeTiming);
+        stats->bytes += fileSize;
+        stats->elements += finalArray.size();
+
+        for (size_t i = 0; i < chunkStats.size(); ++i) {
+            ChunkStats& cs = chunkStats[i];
+            stats->tokenize.add(cs.tokenize);
+            stats->parse.add(cs.parse);
+            stats->tokens += cs.tokens;
+            stats->chunkSizes.push_back(textChunks[i].second - textChunks[i].first);
+
+            cs.worker.workerId = i;
+            cs.worker.idleMs = std::max(0.0, phaseMs - cs.worker.busyMs);
+            stats->workers.push_back(cs.worker);
         }
     }
 
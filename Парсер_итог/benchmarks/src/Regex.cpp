@@ -0,0 +1,568 @@
+#include "Regex.hpp"
+#include "JsonValue.hpp"
+#include <algorithm>
+
+namespace json {
+
+using Op = Regex::Op;
+using Ranges = Regex::Ranges;
+
+namespace {
+
+constexpr char32_t MAX_CODE_POINT = 0x10FFFF;
+constexpr size_t UNBOUNDED = static_cast<size_t>(-1);
+constexpr size_t MAX_PROGRAM = 20000;      // Команд НКА (повторы {n,m} разворачиваются)
+constexpr size_t MAX_NESTING = 256;        // Вложенность групп при разборе
+constexpr size_t MAX_REPEAT = 1000;
+
+// Выражение не поддерживается НКА (обратные ссылки, просмотр, ...)
+struct Unsupported {};
+
+// Синтаксическая ошибка; окончательно решает std::regex
+struct SyntaxError {};
+
+// Следующая кодовая точка UTF-8. Строки после лексера корректны; байт
+// вне последовательности читается как есть.
+char32_t decode(std::string_view text, size_t& pos) {
+    unsigned char lead = static_cast<unsigned char>(text[pos]);
+    size_t length = lead < 0xC0 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+    if (length == 1 || pos + length > text.size()) {
+        ++pos;
+        return lead;
+    }
+    char32_t cp = lead & (0x7F >> length);
+    for (size_t i = 1; i < length; ++i) {
+        cp = (cp << 6) | (static_cast<unsigned char>(text[pos + i]) & 0x3F);
+    }
+    pos += length;
+    return cp;
+}
+
+Ranges normalize(Ranges ranges) {
+    std::sort(ranges.begin(), ranges.end());
+    Ranges merged;
+    for (const auto& range : ranges) {
+        if (!merged.empty() && range.first <= merged.back().second + 1) {
+            merged.back().second = std::max(merged.back().second, range.second);
+        } else {
+            merged.push_back(range);
+        }
+    }
+    return merged;
+}
+
+Ranges complement(const Ranges& ranges) {
+    Ranges sorted = normalize(ranges);
+    Ranges result;
+    char32_t next = 0;
+    for (const auto& range : sorted) {
+        if (range.first > next) result.emplace_back(next, range.first - 1);
+        next = range.second + 1;
+    }
+    if (next <= MAX_CODE_POINT) result.emplace_back(next, MAX_CODE_POINT);
+    return result;
+}
+
+bool contains(const Ranges& ranges, char32_t cp) {
+    auto it = std::upper_bound(ranges.begin(), ranges.end(), cp,
+                               [](char32_t value, const std::pair<char32_t, char32_t>& range) {
+                                   return value < range.first;
+                               });
+    return it != ranges.begin() && cp <= std::prev(it)->second;
+}
+
+const Ranges DIGITS = {{'0', '9'}};
+const Ranges WORD = {{'0', '9'}, {'A', 'Z'}, {'_', '_'}, {'a', 'z'}};
+const Ranges SPACES = {{'\t', '\r'}, {' ', ' '}, {0xA0, 0xA0}, {0x1680, 0x1680}, {0x2000, 0x200A},
+                       {0x2028, 0x2029}, {0x202F, 0x202F}, {0x205F, 0x205F}, {0x3000, 0x3000}, {0xFEFF, 0xFEFF}};
+const Ranges LINE_TERMINATORS = {{'\n', '\n'}, {'\r', '\r'}, {0x2028, 0x2029}};
+
+bool isWord(char32_t cp) {
+    return (cp >= '0' && cp <= '9') || (cp >= 'A' && cp <= 'Z') || cp == '_' || (cp >= 'a' && cp <= 'z');
+}
+
+int hexDigit(char32_t c) {
+    if (c >= '0' && c <= '9') return static_cast<int>(c - '0');
+    if (c >= 'a' && c <= 'f') return static_cast<int>(c - 'a' + 10);
+    if (c >= 'A' && c <= 'F') return static_cast<int>(c - 'A' + 10);
+    return -1;
+}
+
+// Узел разобранного выражения
+struct Ast {
+    enum Kind : uint8_t { Empty, Class, Concat, Alternation, Repeat, Assertion } kind = Empty;
+    uint32_t cls = 0;               // Class
+    Op assertion = Op::LineStart;   // Assertion
+    size_t min = 0;                 // Repeat
+    size_t max = 0;
+    std::vector<Ast> children;
+};
+
+// Разбор выражения рекурсивным спуском (глубина ограничена вложенностью
+// групп самого выражения, а не входом) и генерация программы НКА
+class RegexCompiler {
+private:
+    std::u32string m_pattern;
+    size_t m_pos = 0;
+    size_t m_depth = 0;
+    std::vector<Ranges>& m_classes;
+    std::vector<Regex::Instruction>& m_program;
+
+    bool atEnd() const { return m_pos >= m_pattern.size(); }
+    char32_t peek() const { return m_pattern[m_pos]; }
+
+    Ast classNode(Ranges ranges) {
+        Ast node;
+        node.kind = Ast::Class;
+        node.cls = static_cast<uint32_t>(m_classes.size());
+        m_classes.push_back(normalize(std::move(ranges)));
+        return node;
+    }
+
+    Ast alternation() {
+        Ast node;
+        node.kind = Ast::Alternation;
+        node.children.push_back(concatenation());
+        while (!atEnd() && peek() == '|') {
+            ++m_pos;
+            node.children.push_back(concatenation());
+        }
+        return node.children.size() == 1 ? std::move(node.children.front()) : std::move(node);
+    }
+
+    Ast concatenation() {
+        Ast node;
+        node.kind = Ast::Concat;
+        while (!atEnd() && peek() != '|' && peek() != ')') {
+            node.children.push_back(quantified());
+        }
+        if (node.children.empty()) return Ast{};
+        return node.children.size() == 1 ? std::move(node.children.front()) : std::move(node);
+    }
+
+    // {n}, {n,}, {n,m}; false (позиция не сдвигается), если это не квантификатор
+    bool braces(size_t& min, size_t& max) {
+        size_t pos = m_pos + 1;
+        auto number = [&](size_t& out) {
+            size_t start = pos;
+            out = 0;
+            while (pos < m_pattern.size() && m_pattern[pos] >= '0' && m_pattern[pos] <= '9') {
+                out = std::min<size_t>(out * 10 + (m_pattern[pos] - '0'), MAX_REPEAT + 1);
+                ++pos;
+            }
+            return pos > start;
+        };
+        if (!number(min)) return false;
+        max = min;
+        if (pos < m_pattern.size() && m_pattern[pos] == ',') {
+            ++pos;
+            if (!number(max)) max = UNBOUNDED;
+        }
+        if (pos >= m_pattern.size() || m_pattern[pos] != '}') return false;
+        m_pos = pos + 1;
+        return true;
+    }
+
+    bool quantifier(size_t& min, size_t& max) {
+        if (atEnd()) return false;
+        switch (peek()) {
+            case '*': min = 0; max = UNBOUNDED; ++m_pos; break;
+            case '+': min = 1; max = UNBOUNDED; ++m_pos; break;
+            case '?': min = 0; max = 1; ++m_pos; break;
+            case '{':
+                if (!braces(min, max)) return false;
+                break;
+            default:
+                return false;
+        }
+        // Ленивость на ответ "есть ли совпадение" не влияет
+        if (!atEnd() && peek() == '?') ++m_pos;
+        return true;
+    }
+
+    Ast quantified() {
+        Ast atom = this->atom();
+        size_t min = 0;
+        size_t max = 0;
+        if (!quantifier(min, max)) return atom;
+        if (atom.kind == Ast::Assertion || min > max) throw SyntaxError{};
+        if (min > MAX_REPEAT || (max != UNBOUNDED && max > MAX_REPEAT)) throw Unsupported{};
+        size_t again = 0;
+        if (quantifier(again, again)) throw SyntaxError{};
+        Ast node;
+        node.kind = Ast::Repeat;
+        node.min = min;
+        node.max = max;
+        node.children.push_back(std::move(atom));
+        return node;
+    }
+
+    Ast assertion(Op op) {
+        Ast node;
+        node.kind = Ast::Assertion;
+        node.assertion = op;
+        return node;
+    }
+
+    Ast atom() {
+        char32_t c = peek();
+        switch (c) {
+            case '(': {
+                ++m_pos;
+                if (!atEnd() && peek() == '?') {
+                    ++m_pos;
+                    if (atEnd()) throw SyntaxError{};
+                    if (peek() == ':') {
+                        ++m_pos;
+                    } else if (peek() == '<' && m_pos + 1 < m_pattern.size() && m_pattern[m_pos + 1] != '=' &&
+                               m_pattern[m_pos + 1] != '!') {
+                        // Именованная группа: имя для проверки не нужно
+                        size_t close = m_pattern.find('>', m_pos);
+                        if (close == std::u32string::npos) throw SyntaxError{};
+                        m_pos = close + 1;
+                    } else {
+                        throw Unsupported{};    // (?=, (?!, (?<=, (?<!
+                    }
+                }
+                if (++m_depth > MAX_NESTING) throw Unsupported{};
+                Ast inner = alternation();
+                --m_depth;
+                if (atEnd() || peek() != ')') throw SyntaxError{};
+                ++m_pos;
+                return inner;
+            }
+            case ')':
+            case '*':
+            case '+':
+            case '?':
+                throw SyntaxError{};
+            case '^':
+                ++m_pos;
+                return assertion(Op::LineStart);
+            case '$':
+                ++m_pos;
+                return assertion(Op::LineEnd);
+            case '.':
+                ++m_pos;
+                return classNode(complement(LINE_TERMINATORS));
+            case '[':
+                return characterClass();
+            case '\\': {
+                ++m_pos;
+                if (atEnd()) throw SyntaxError{};
+                char32_t e = peek();
+                if (e == 'b' || e == 'B') {
+                    ++m_pos;
+                    return assertion(e == 'b' ? Op::WordBoundary : Op::NotWordBoundary);
+                }
+                if ((e >= '1' && e <= '9') || e == 'k') throw Unsupported{};   // Обратные ссылки
+                return classNode(escape(false));
+            }
+            default:
+                // "{", "}" и "]" вне квантификатора и класса - литералы (приложение B)
+                ++m_pos;
+                return classNode({{c, c}});
+        }
+    }
+
+    // Экранирование после "\" (позиция на следующем символе)
+    Ranges escape(bool inClass) {
+        char32_t e = peek();
+        ++m_pos;
+        switch (e) {
+            case 'd': return DIGITS;
+            case 'D': return complement(DIGITS);
+            case 'w': return WORD;
+            case 'W': return complement(WORD);
+            case 's': return SPACES;
+            case 'S': return complement(SPACES);
+            case 't': return {{'\t', '\t'}};
+            case 'n': return {{'\n', '\n'}};
+            case 'v': return {{'\v', '\v'}};
+            case 'f': return {{'\f', '\f'}};
+            case 'r': return {{'\r', '\r'}};
+            case '0':
+                if (!atEnd() && peek() >= '0' && peek() <= '9') throw Unsupported{};   // Восьмеричные
+                return {{0, 0}};
+            case 'c':
+                if (!atEnd() && ((peek() >= 'a' && peek() <= 'z') || (peek() >= 'A' && peek() <= 'Z'))) {
+                    char32_t letter = peek();
+                    ++m_pos;
+                    return {{letter % 32, letter % 32}};
+                }
+                throw Unsupported{};
+            case 'x':
+                if (m_pos + 1 < m_pattern.size() && hexDigit(m_pattern[m_pos]) >= 0 &&
+                    hexDigit(m_pattern[m_pos + 1]) >= 0) {
+                    char32_t cp = static_cast<char32_t>(hexDigit(m_pattern[m_pos]) * 16 + hexDigit(m_pattern[m_pos + 1]));
+                    m_pos += 2;
+                    return {{cp, cp}};
+                }
+                return {{'x', 'x'}};
+            case 'u': {
+                char32_t cp = 0;
+                if (!hex4(cp)) {
+                    if (!atEnd() && peek() == '{') throw Unsupported{};
+                    return {{'u', 'u'}};
+                }
+                // Суррогатная пара \uD83D\uDE00 - один символ
+                if (cp >= 0xD800 && cp <= 0xDBFF && m_pos + 1 < m_pattern.size() && m_pattern[m_pos] == '\\' &&
+                    m_pattern[m_pos + 1] == 'u') {
+                    size_t saved = m_pos;
+                    m_pos += 2;
+                    char32_t low = 0;
+                    if (hex4(low) && low >= 0xDC00 && low <= 0xDFFF) {
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    } else {
+                        m_pos = saved;
+                    }
+                }
+                return {{cp, cp}};
+            }
+            case 'p':
+            case 'P':
+                throw Unsupported{};
+            case 'b':
+                if (inClass) return {{'\b', '\b'}};
+                throw SyntaxError{};
+            default:
+                if (inClass && e >= '1' && e <= '9') throw Unsupported{};
+                return {{e, e}};
+        }
+    }
+
+    bool hex4(char32_t& cp) {
+        if (m_pos + 4 > m_pattern.size()) return false;
+        cp = 0;
+        for (size_t i = 0; i < 4; ++i) {
+            int digit = hexDigit(m_pattern[m_pos + i]);
+            if (digit < 0) return false;
+            cp = cp * 16 + static_cast<char32_t>(digit);
+        }
+        m_pos += 4;
+        return true;
+    }
+
+    // Элемент класса: один символ (single = true) или набор вроде \d
+    Ranges classAtom(bool& single) {
+        if (atEnd()) throw SyntaxError{};
+        char32_t c = peek();
+        ++m_pos;
+        if (c != '\\') {
+            single = true;
+            return {{c, c}};
+        }
+        if (atEnd()) throw SyntaxError{};
+        char32_t e = peek();
+        Ranges ranges = e == '-' ? (++m_pos, Ranges{{'-', '-'}}) : escape(true);
+        single = ranges.size() == 1 && ranges.front().first == ranges.front().second;
+        return ranges;
+    }
+
+    Ast characterClass() {
+        ++m_pos;
+        bool negated = !atEnd() && peek() == '^';
+        if (negated) ++m_pos;
+        Ranges ranges;
+        while (!atEnd() && peek() != ']') {
+            bool single = false;
+            Ranges first = classAtom(single);
+            if (!atEnd() && peek() == '-' && m_pos + 1 < m_pattern.size() && m_pattern[m_pos + 1] != ']') {
+                ++m_pos;
+                bool singleLast = false;
+                Ranges last = classAtom(singleLast);
+                if (single && singleLast) {
+                    if (first.front().first > last.front().first) throw SyntaxError{};
+                    ranges.emplace_back(first.front().first, last.front().first);
+                } else {
+                    // [\d-x]: дефис - обычный символ (приложение B)
+                    ranges.insert(ranges.end(), first.begin(), first.end());
+                    ranges.emplace_back('-', '-');
+                    ranges.insert(ranges.end(), last.begin(), last.end());
+                }
+                continue;
+            }
+            ranges.insert(ranges.end(), first.begin(), first.end());
+        }
+        if (atEnd()) throw SyntaxError{};
+        ++m_pos;
+        return classNode(negated ? complement(ranges) : std::move(ranges));
+    }
+
+    uint32_t emit(Op op, uint32_t x = 0, uint32_t y = 0) {
+        if (m_program.size() >= MAX_PROGRAM) throw Unsupported{};
+        m_program.push_back({op, x, y});
+        return static_cast<uint32_t>(m_program.size() - 1);
+    }
+
+    uint32_t here() const { return static_cast<uint32_t>(m_program.size()); }
+
+    void generate(const Ast& node) {
+        switch (node.kind) {
+            case Ast::Empty:
+                break;
+            case Ast::Class:
+                emit(Op::Class, node.cls);
+                break;
+            case Ast::Assertion:
+                emit(node.assertion);
+                break;
+            case Ast::Concat:
+                for (const Ast& child : node.children) generate(child);
+                break;
+            case Ast::Alternation: {
+                std::vector<uint32_t> jumps;
+                for (size_t i = 0; i + 1 < node.children.size(); ++i) {
+                    uint32_t split = emit(Op::Split, here() + 1);
+                    generate(node.children[i]);
+                    jumps.push_back(emit(Op::Jump));
+                    m_program[split].y = here();
+                }
+                generate(node.children.back());
+                for (uint32_t jump : jumps) m_program[jump].x = here();
+                break;
+            }
+            case Ast::Repeat: {
+                const Ast& child = node.children.front();
+                for (size_t i = 0; i < node.min; ++i) generate(child);
+                if (node.max == UNBOUNDED) {
+                    uint32_t loop = emit(Op::Split, here() + 1);
+                    generate(child);
+                    emit(Op::Jump, loop);
+                    m_program[loop].y = here();
+                } else {
+                    std::vector<uint32_t> splits;
+                    for (size_t i = node.min; i < node.max; ++i) {
+                        splits.push_back(emit(Op::Split, here() + 1));
+                        generate(child);
+                    }
+                    for (uint32_t split : splits) m_program[split].y = here();
+                }
+                break;
+            }
+        }
+    }
+
+public:
+    RegexCompiler(const std::string& pattern, std::vector<Ranges>& classes,
+                  std::vector<Regex::Instruction>& program)
+        : m_classes(classes), m_program(program) {
+        for (size_t pos = 0; pos < pattern.size();) {
+            m_pattern.push_back(decode(pattern, pos));
+        }
+    }
+
+    void compile() {
+        Ast root = alternation();
+        if (!atEnd()) throw SyntaxError{};     // Лишняя ")"
+        generate(root);
+        emit(Op::Match);
+    }
+};
+
+// Буферы поиска потока: выражения общие для потоков проверки
+struct SearchState {
+    std::vector<uint32_t> current;      // Команды Class, ждущие символ
+    std::vector<uint32_t> next;         // Продолжения после символа
+    std::vector<uint32_t> stack;
+    std::vector<size_t> mark;           // Поколение, в котором команда уже добавлена
+    size_t generation = 0;
+};
+
+} // namespace
+
+Regex::Regex(const std::string& pattern) {
+    try {
+        RegexCompiler(pattern, m_classes, m_program).compile();
+        m_anchored = m_program.front().op == Op::LineStart;
+        return;
+    } catch (const Unsupported&) {
+    } catch (const SyntaxError&) {
+    }
+    m_program.clear();
+    m_classes.clear();
+    try {
+        m_fallback = std::make_shared<const std::regex>(pattern, std::regex::ECMAScript);
+    } catch (const std::regex_error& e) {
+        throw JsonException(e.what());
+    }
+}
+
+bool Regex::search(std::string_view text) const {
+    if (m_fallback) {
+        return std::regex_search(text.begin(), text.end(), *m_fallback);
+    }
+
+    thread_local SearchState state;
+    if (state.mark.size() < m_program.size()) {
+        state.mark.resize(m_program.size(), 0);
+    }
+    state.next.clear();
+
+    bool hasPrevious = false;
+    char32_t previous = 0;
+    size_t pos = 0;
+    for (;;) {
+        bool end = pos >= text.size();
+        size_t following = pos;
+        char32_t cp = end ? 0 : decode(text, following);
+        size_t generation = ++state.generation;
+
+        // Замыкание по переходам без символа; true - достигнут Match
+        auto add = [&](uint32_t start) {
+            state.stack.clear();
+            state.stack.push_back(start);
+            while (!state.stack.empty()) {
+                uint32_t pc = state.stack.back();
+                state.stack.pop_back();
+                if (state.mark[pc] == generation) continue;
+                state.mark[pc] = generation;
+                const Instruction& instruction = m_program[pc];
+                switch (instruction.op) {
+                    case Op::Class:
+                        state.current.push_back(pc);
+                        break;
+                    case Op::Split:
+                        state.stack.push_back(instruction.y);
+                        state.stack.push_back(instruction.x);
+                        break;
+                    case Op::Jump:
+                        state.stack.push_back(instruction.x);
+                        break;
+                    case Op::LineStart:
+                        if (!hasPrevious) state.stack.push_back(pc + 1);
+                        break;
+                    case Op::LineEnd:
+                        if (end) state.stack.push_back(pc + 1);
+                        break;
+                    case Op::WordBoundary:
+                    case Op::NotWordBoundary: {
+                        bool boundary = (hasPrevious && isWord(previous)) != (!end && isWord(cp));
+                        if (boundary == (instruction.op == Op::WordBoundary)) state.stack.push_back(pc + 1);
+                        break;
+                    }
+                    case Op::Match:
+                        return true;
+                }
+            }
+            return false;
+        };
+
+        state.current.clear();
+        for (uint32_t pc : state.next) {
+            if (add(pc)) return true;
+        }
+        if ((!m_anchored || !hasPrevious) && add(0)) return true;
+        if (end || (m_anchored && state.current.empty())) return false;
+
+        state.next.clear();
+        for (uint32_t pc : state.current) {
+            if (contains(m_classes[m_program[pc].x], cp)) state.next.push_back(pc + 1);
+        }
+        hasPrevious = true;
+        previous = cp;
+        pos = following;
+    }
+}
+
+} // namespace json
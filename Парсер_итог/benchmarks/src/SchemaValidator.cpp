@@ -0,0 +1,1272 @@
+#include "SchemaValidator.hpp"
+#include "InputStream.hpp"
+#include "JsonPatch.hpp"
+#include "Lexer.hpp"
+#include "Parser.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+namespace json {
+
+namespace {
+
+using Node = JsonSchema::Node;
+constexpr uint32_t NONE = JsonSchema::NONE;
+
+// Блок потокового чтения файла
+constexpr size_t STREAM_BLOCK_SIZE = 1024 * 1024;
+
+// Как результат проверки дочернего значения влияет на проверку родителя
+enum class Role : uint8_t {
+    Must,           // items, properties, ...: нарушение - нарушение родителя
+    Contains        // contains: считается число подошедших элементов
+};
+
+// Проверка одного узла схемы для открытого контейнера
+struct Check {
+    uint32_t node;
+    uint32_t owner;             // Корень кадра: проверка в кадре родителя (NONE у документа)
+    Role role;
+    bool reportable;            // Нарушения сразу становятся ошибками
+    bool failed = false;
+    uint32_t firstChild = 0;    // Проверки allOf/anyOf/... того же значения
+    uint32_t childCount = 0;
+    uint32_t seenOffset = 0;    // Отметки ключей в Frame::seen
+    size_t containsPassed = 0;
+};
+
+// Открытый контейнер
+struct Frame {
+    bool isObject = false;
+    size_t count = 0;           // Элементов / ключей (у массива - индекс следующего)
+    std::string key;            // Текущий ключ
+    size_t keyLine = 0;
+    size_t keyColumn = 0;
+    size_t line = 0;
+    size_t column = 0;
+    size_t rootCount = 0;       // Проверки, пришедшие от родителя (в начале checks)
+    std::vector<Check> checks;  // Дети каждой проверки идут подряд после неё
+    std::vector<uint8_t> seen;
+    bool capturing = false;     // Значение собирается целиком
+    JsonArray array;
+    JsonObject object;
+};
+
+// Скалярное значение: число и длина вычисляются по требованию
+struct Scalar {
+    TokenType type;
+    const std::string& text;
+    bool numberReady = false;
+    bool integral = false;
+    double number = 0.0;
+    bool lengthReady = false;
+    size_t length = 0;
+
+    Scalar(TokenType t, const std::string& value) : type(t), text(value) {}
+
+    void readNumber() {
+        if (numberReady) return;
+        numberReady = true;
+        std::from_chars(text.data(), text.data() + text.size(), number);
+        // 1.0 и 1e2 - тоже целые (draft-07)
+        integral = text.find_first_of(".eE") == std::string::npos ||
+                   (std::isfinite(number) && number == std::floor(number));
+    }
+
+    // Длина в символах Unicode
+    size_t codePoints() {
+        if (!lengthReady) {
+            lengthReady = true;
+            length = static_cast<size_t>(std::count_if(text.begin(), text.end(), [](char c) {
+                return (static_cast<unsigned char>(c) & 0xC0) != 0x80;
+            }));
+        }
+        return length;
+    }
+};
+
+std::string formatNumber(double value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.15g", value);
+    return buffer;
+}
+
+std::string typeNames(uint8_t types) {
+    std::string result;
+    auto add = [&result](const char* name) {
+        if (!result.empty()) result += ", ";
+        result += name;
+    };
+    if (types & JsonSchema::NULL_TYPE) add("null");
+    if (types & JsonSchema::BOOLEAN_TYPE) add("boolean");
+    if (types & JsonSchema::FRACTION_TYPE) add("number");
+    else if (types & JsonSchema::INTEGER_TYPE) add("integer");
+    if (types & JsonSchema::STRING_TYPE) add("string");
+    if (types & JsonSchema::ARRAY_TYPE) add("array");
+    if (types & JsonSchema::OBJECT_TYPE) add("object");
+    return result;
+}
+
+std::string typeMessage(uint8_t types, const char* actual) {
+    if (types == 0) {
+        return "Значение не допускается схемой (false)";
+    }
+    return "Неверный тип: ожидается " + typeNames(types) + ", получено " + actual;
+}
+
+// Есть ли в enum контейнер того же вида
+bool enumHasContainer(const Node& node, bool isObject) {
+    return std::any_of(node.enumValues.begin(), node.enumValues.end(), [isObject](const JsonValue& value) {
+        return isObject ? value.isObject() : value.isArray();
+    });
+}
+
+bool scalarEquals(const JsonValue& expected, Scalar& value) {
+    switch (value.type) {
+        case TokenType::Null:   return expected.isNull();
+        case TokenType::True:   return expected.isBool() && expected.asBool();
+        case TokenType::False:  return expected.isBool() && !expected.asBool();
+        case TokenType::String: return expected.isString() && expected.asString() == value.text;
+        case TokenType::Number:
+            value.readNumber();
+            return expected.isNumber() && expected.asNumber() == value.number;
+        default:                return false;
+    }
+}
+
+JsonValue scalarValue(const Token& token) {
+    switch (token.type) {
+        case TokenType::True:   return JsonValue(true);
+        case TokenType::False:  return JsonValue(false);
+        case TokenType::String: return JsonValue(token.value);
+        case TokenType::Number: {
+            double number = 0.0;
+            std::from_chars(token.value.data(), token.value.data() + token.value.size(), number);
+            return JsonValue(number);
+        }
+        default:                return JsonValue();
+    }
+}
+
+// Все элементы различны: сравниваются только значения с равным хэшем
+bool uniqueItems(const JsonArray& items) {
+    std::vector<std::pair<uint64_t, size_t>> hashes;
+    hashes.reserve(items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        hashes.emplace_back(items[i].hash(), i);
+    }
+    std::sort(hashes.begin(), hashes.end());
+    for (size_t i = 0; i < hashes.size(); ++i) {
+        for (size_t j = i + 1; j < hashes.size() && hashes[j].first == hashes[i].first; ++j) {
+            if (JsonPatch::equal(items[hashes[i].second], items[hashes[j].second])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Корень проверяется по элементам независимо: без схем, которым нужен
+// результат по всему массиву сразу
+bool splittable(const JsonSchema& schema, uint32_t index) {
+    if (index <= JsonSchema::FALSE_NODE) return true;
+    const Node& node = schema.node(index);
+    if (!node.anyOf.empty() || !node.oneOf.empty() || node.notNode != NONE || node.ifNode != NONE || node.needsValue) {
+        return false;
+    }
+    return std::all_of(node.allOf.begin(), node.allOf.end(),
+                       [&schema](uint32_t child) { return splittable(schema, child); });
+}
+
+// Ожидаемый токен
+enum class State : uint8_t {
+    Value,          // Значение
+    FirstValue,     // Значение или ']' сразу после '['
+    FirstKey,       // Ключ или '}' сразу после '{'
+    Key,            // Ключ после ','
+    Colon,
+    Next,           // ',' или закрывающая скобка
+    End             // Документ закончился
+};
+
+// Проверка по потоку токенов
+class SchemaMachine {
+private:
+    const JsonSchema& m_schema;
+    size_t m_maxDepth;
+    bool m_stopOnFirstError;
+
+    std::vector<Frame> m_frames;        // Кадры переиспользуются
+    size_t m_depth = 0;
+    std::vector<Check> m_pending;       // Проверки следующего значения
+    State m_state = State::Value;
+    bool m_stopped = false;
+    bool m_chunkMode = false;           // Порция элементов массива верхнего уровня
+    bool m_lastChunk = false;
+    size_t m_tokens = 0;
+    SchemaResult m_result;
+
+    Frame& top() { return m_frames[m_depth - 1]; }
+
+    // JSON Pointer значения на глубине frames
+    std::string pathTo(size_t frames) const {
+        std::string path;
+        for (size_t i = 0; i < frames; ++i) {
+            const Frame& frame = m_frames[i];
+            path += '/';
+            path += frame.isObject ? JsonPatch::escapeToken(frame.key) : std::to_string(frame.count - 1);
+        }
+        return path;
+    }
+
+    void report(size_t line, size_t column, size_t pathFrames, std::string message) {
+        m_result.errors.emplace_back(line, column, pathTo(pathFrames), std::move(message));
+    }
+
+    void fail(Check& check, size_t line, size_t column, size_t pathFrames, std::string message) {
+        check.failed = true;
+        if (check.reportable) {
+            report(line, column, pathFrames, std::move(message));
+        }
+    }
+
+    void syntaxError(const Token& token, const std::string& message) {
+        m_result.errors.emplace_back(token.line, token.column, "", message);
+        m_result.syntaxError = true;
+        m_stopped = true;
+    }
+
+    static void applyResult(Check& owner, Role role, bool passed) {
+        if (role == Role::Must && !passed) {
+            owner.failed = true;
+        } else if (role == Role::Contains && passed) {
+            owner.containsPassed++;
+        }
+    }
+
+    void addPending(Check& owner, uint32_t ownerIndex, uint32_t node, Role role, const Token& token) {
+        if (node == JsonSchema::TRUE_NODE) {
+            applyResult(owner, role, true);
+            return;
+        }
+        if (node == JsonSchema::FALSE_NODE) {
+            if (role == Role::Must) {
+                fail(owner, token.line, token.column, m_depth, "Значение не допускается схемой (false)");
+            }
+            return;
+        }
+        m_pending.push_back(Check{node, ownerIndex, role, owner.reportable && role == Role::Must});
+    }
+
+    void dispatch(const Token& token);
+    void key(const Token& token);
+    void beginValue(const Token& token);
+    void scalar(const Token& token);
+    void pushFrame(const Token& token, bool isObject);
+    void expand(Frame& frame, uint32_t index);
+    void endContainer(const Token& token);
+    void finalizeTop();
+    void finalizeCheck(Frame& frame, Check& check, size_t pathFrames, const JsonValue& captured);
+    bool checkScalar(uint32_t index, Scalar& value, bool reportable, size_t line, size_t column);
+
+    void capture(Frame& frame, JsonValue value) {
+        if (frame.isObject) {
+            frame.object[frame.key] = std::move(value);
+        } else {
+            frame.array.push_back(std::move(value));
+        }
+    }
+
+public:
+    SchemaMachine(const JsonSchema& schema, size_t maxDepth, bool stopOnFirstError)
+        : m_schema(schema), m_maxDepth(maxDepth), m_stopOnFirstError(stopOnFirstError) {}
+
+    // Очередной токен; false - проверка закончена досрочно
+    bool feed(const Token& token);
+
+    void lexerError(const LexerException& e) {
+        m_result.errors.emplace_back(e.line, e.column, "", e.what());
+        m_result.syntaxError = true;
+        m_stopped = true;
+    }
+
+    // Порция элементов массива верхнего уровня: кадр корня - копия root
+    // без накопленных результатов, элементы нумеруются с firstIndex
+    void beginChunk(const Frame& root, size_t firstIndex, bool first, bool last) {
+        m_frames.assign(1, root);
+        m_frames[0].count = firstIndex;
+        for (Check& check : m_frames[0].checks) {
+            check.failed = false;
+            check.containsPassed = 0;
+        }
+        m_depth = 1;
+        m_state = first ? State::FirstValue : State::Value;
+        m_chunkMode = true;
+        m_lastChunk = last;
+    }
+
+    Frame& rootFrame() { return m_frames[0]; }
+
+    // Закрыть корень после сборки порций
+    void finishRoot() {
+        if (!m_stopped) {
+            finalizeTop();
+        }
+        m_state = State::End;
+    }
+
+    bool stopped() const { return m_stopped; }
+    size_t tokenCount() const { return m_tokens; }
+    SchemaResult& result() { return m_result; }
+
+    SchemaResult takeResult() {
+        m_result.isValid = m_result.errors.empty();
+        return std::move(m_result);
+    }
+};
+
+bool SchemaMachine::feed(const Token& token) {
+    if (m_stopped) return false;
+    ++m_tokens;
+
+    if (token.type == TokenType::EndOfFile && m_chunkMode) {
+        // Порция кончается после ',' между элементами или концом документа
+        bool complete = m_lastChunk ? m_state == State::End : m_state == State::Value && m_depth == 1;
+        if (!complete) {
+            syntaxError(token, "Неожиданный конец порции");
+        }
+        return false;
+    }
+
+    switch (m_state) {
+        case State::FirstValue:
+            if (token.type == TokenType::RightBracket) {
+                endContainer(token);
+                break;
+            }
+            [[fallthrough]];
+        case State::Value:
+            beginValue(token);
+            break;
+        case State::FirstKey:
+            if (token.type == TokenType::RightBrace) {
+                endContainer(token);
+                break;
+            }
+            [[fallthrough]];
+        case State::Key:
+            if (token.type == TokenType::String) {
+                key(token);
+                m_state = State::Colon;
+            } else if (token.type == TokenType::RightBrace) {
+                syntaxError(token, "Запятая перед закрывающей скобкой '}' не допускается");
+            } else if (token.type == TokenType::EndOfFile) {
+                syntaxError(token, "Незакрытый объект (пропущена '}')");
+            } else {
+                syntaxError(token, "Ожидался ключ (строка) в объекте, получено: " + tokenTypeName(token.type));
+            }
+            break;
+        case State::Colon:
+            if (token.type == TokenType::Colon) {
+                m_state = State::Value;
+            } else if (token.type == TokenType::EndOfFile) {
+                syntaxError(token, "Незакрытый объект (пропущена '}')");
+            } else {
+                syntaxError(token, "Ожидалось ':' после ключа");
+            }
+            break;
+        case State::Next: {
+            bool isObject = top().isObject;
+            if (token.type == TokenType::Comma) {
+                m_state = isObject ? State::Key : State::Value;
+            } else if (token.type == (isObject ? TokenType::RightBrace : TokenType::RightBracket)) {
+                endContainer(token);
+            } else if (token.type == TokenType::EndOfFile) {
+                syntaxError(token, isObject ? "Незакрытый объект (пропущена '}')" : "Незакрытый массив (пропущена ']')");
+            } else {
+                syntaxError(token, isObject ? "Ожидалась ',' или '}' в объекте" : "Ожидалась ',' или ']' в массиве");
+            }
+            break;
+        }
+        case State::End:
+            if (token.type != TokenType::EndOfFile) {
+                syntaxError(token, "Неожиданные данные после JSON");
+            }
+            break;
+    }
+
+    if (m_stopOnFirstError && !m_result.errors.empty()) {
+        m_stopped = true;
+    }
+    return !m_stopped && !(m_state == State::End && token.type == TokenType::EndOfFile);
+}
+
+void SchemaMachine::beginValue(const Token& token) {
+    switch (token.type) {
+        case TokenType::LeftBrace:
+        case TokenType::LeftBracket:
+            if (m_depth >= m_maxDepth) {
+                syntaxError(token, "Превышена максимальная глубина вложенности (" + std::to_string(m_maxDepth) + ")");
+                return;
+            }
+            dispatch(token);
+            pushFrame(token, token.type == TokenType::LeftBrace);
+            m_state = token.type == TokenType::LeftBrace ? State::FirstKey : State::FirstValue;
+            return;
+        case TokenType::String:
+        case TokenType::Number:
+        case TokenType::True:
+        case TokenType::False:
+        case TokenType::Null:
+            dispatch(token);
+            scalar(token);
+            m_state = m_depth == 0 ? State::End : State::Next;
+            return;
+        case TokenType::RightBrace:
+        case TokenType::RightBracket: {
+            char bracket = token.type == TokenType::RightBrace ? '}' : ']';
+            // ']' на месте элемента - после запятой
+            if (m_depth > 0 && !top().isObject && bracket == ']') {
+                syntaxError(token, "Запятая перед закрывающей скобкой ']' не допускается");
+            } else {
+                syntaxError(token, std::string("Неожиданная закрывающая скобка '") + bracket + "'");
+            }
+            return;
+        }
+        case TokenType::Comma:
+            syntaxError(token, "Неожиданная запятая");
+            return;
+        case TokenType::Colon:
+            syntaxError(token, "Неожиданное двоеточие");
+            return;
+        case TokenType::EndOfFile:
+            if (m_depth > 0) {
+                syntaxError(token, top().isObject ? "Незакрытый объект (пропущена '}')" : "Незакрытый массив (пропущена ']')");
+            } else {
+                syntaxError(token, m_result.valueCount == 0 ? "Пустой JSON" : "Неожиданный конец файла");
+            }
+            return;
+    }
+}
+
+void SchemaMachine::dispatch(const Token& token) {
+    m_pending.clear();
+    m_result.valueCount++;
+
+    if (m_depth == 0) {
+        uint32_t root = m_schema.root();
+        if (root == JsonSchema::FALSE_NODE) {
+            report(token.line, token.column, 0, "Значение не допускается схемой (false)");
+        } else if (root != JsonSchema::TRUE_NODE) {
+            m_pending.push_back(Check{root, NONE, Role::Must, true});
+        }
+        return;
+    }
+
+    Frame& frame = top();
+    size_t index = frame.isObject ? 0 : frame.count++;
+    for (uint32_t i = 0; i < frame.checks.size(); ++i) {
+        Check& check = frame.checks[i];
+        if (check.failed && !check.reportable) continue;
+        const Node& node = m_schema.node(check.node);
+
+        if (!frame.isObject) {
+            if (!node.arrayChildren) continue;
+            if (!node.tupleItems) {
+                addPending(check, i, node.items, Role::Must, token);
+            } else if (index < node.tuple.size()) {
+                addPending(check, i, node.tuple[index], Role::Must, token);
+            } else if (node.additionalItems == JsonSchema::FALSE_NODE) {
+                fail(check, token.line, token.column, m_depth,
+                     "Лишний элемент массива: допускается не больше " + std::to_string(node.tuple.size()) +
+                     " (additionalItems: false)");
+            } else {
+                addPending(check, i, node.additionalItems, Role::Must, token);
+            }
+            if (node.contains != NONE) {
+                addPending(check, i, node.contains, Role::Contains, token);
+            }
+            continue;
+        }
+
+        if (!node.objectChildren) continue;
+        bool matched = false;
+        const JsonSchema::Property* property = JsonSchema::findProperty(node, frame.key);
+        if (property && property->declared) {
+            addPending(check, i, property->node, Role::Must, token);
+            matched = true;
+        }
+        for (const auto& [pattern, child] : node.patternProperties) {
+            const Regex& regex = m_schema.pattern(pattern);
+            if (!regex.canSearch(frame.key.size())) {
+                fail(check, frame.keyLine, frame.keyColumn, m_depth,
+                     "Ключ длиннее " + std::to_string(Regex::FALLBACK_MAX_LENGTH) + " байт не проверяется шаблоном \"" +
+                         m_schema.patternSource(pattern) + "\" (patternProperties)");
+                matched = true;
+                continue;
+            }
+            if (regex.search(frame.key)) {
+                addPending(check, i, child, Role::Must, token);
+                matched = true;
+            }
+        }
+        if (matched) continue;
+        if (node.additionalProperties == JsonSchema::FALSE_NODE) {
+            fail(check, frame.keyLine, frame.keyColumn, m_depth,
+                 "Ключ '" + frame.key + "' не допускается (additionalProperties: false)");
+        } else {
+            addPending(check, i, node.additionalProperties, Role::Must, token);
+        }
+    }
+}
+
+void SchemaMachine::key(const Token& token) {
+    Frame& frame = top();
+    frame.count++;
+    frame.key = token.value;
+    frame.keyLine = token.line;
+    frame.keyColumn = token.column;
+
+    for (Check& check : frame.checks) {
+        if (check.failed && !check.reportable) continue;
+        const Node& node = m_schema.node(check.node);
+        if (!node.seenNames.empty()) {
+            const JsonSchema::Property* property = JsonSchema::findProperty(node, frame.key);
+            if (property && property->seen != NONE) {
+                frame.seen[check.seenOffset + property->seen] = 1;
+            }
+        }
+        if (node.propertyNames != NONE) {
+            Scalar name(TokenType::String, frame.key);
+            if (!checkScalar(node.propertyNames, name, false, token.line, token.column)) {
+                fail(check, token.line, token.column, m_depth,
+                     "Имя ключа '" + frame.key + "' не подходит под propertyNames");
+            }
+        }
+    }
+}
+
+void SchemaMachine::scalar(const Token& token) {
+    Scalar value(token.type, token.value);
+    for (const Check& pending : m_pending) {
+        bool passed = checkScalar(pending.node, value, pending.reportable, token.line, token.column);
+        if (pending.owner != NONE) {
+            applyResult(top().checks[pending.owner], pending.role, passed);
+        }
+    }
+    if (m_depth > 0 && top().capturing) {
+        capture(top(), scalarValue(token));
+    }
+}
+
+bool SchemaMachine::checkScalar(uint32_t index, Scalar& value, bool reportable, size_t line, size_t column) {
+    if (index == JsonSchema::TRUE_NODE) return true;
+    const Node& node = m_schema.node(index);
+    bool ok = true;
+    // Без отчёта хватает первого нарушения
+    auto violated = [&](const std::string& message) {
+        ok = false;
+        if (reportable) {
+            report(line, column, m_depth, message);
+        }
+    };
+
+    uint8_t type = 0;
+    const char* typeName = "";
+    switch (value.type) {
+        case TokenType::Null:   type = JsonSchema::NULL_TYPE; typeName = "null"; break;
+        case TokenType::True:
+        case TokenType::False:  type = JsonSchema::BOOLEAN_TYPE; typeName = "boolean"; break;
+        case TokenType::String: type = JsonSchema::STRING_TYPE; typeName = "string"; break;
+        default:
+            value.readNumber();
+            type = value.integral ? JsonSchema::INTEGER_TYPE : JsonSchema::FRACTION_TYPE;
+            typeName = value.integral ? "integer" : "number";
+            break;
+    }
+    if (!(node.types & type)) {
+        if (!reportable) return false;
+        violated(typeMessage(node.types, typeName));
+    }
+
+    if (value.type == TokenType::Number) {
+        double number = value.number;
+        if (node.hasMinimum && (number < node.minimum || (node.exclusiveMinimum && number == node.minimum))) {
+            if (!reportable) return false;
+            violated(node.exclusiveMinimum ? "Число должно быть больше " + formatNumber(node.minimum) + " (exclusiveMinimum)"
+                                           : "Число меньше " + formatNumber(node.minimum) + " (minimum)");
+        }
+        if (node.hasMaximum && (number > node.maximum || (node.exclusiveMaximum && number == node.maximum))) {
+            if (!reportable) return false;
+            violated(node.exclusiveMaximum ? "Число должно быть меньше " + formatNumber(node.maximum) + " (exclusiveMaximum)"
+                                           : "Число больше " + formatNumber(node.maximum) + " (maximum)");
+        }
+        if (node.multipleOf > 0.0) {
+            double quotient = number / node.multipleOf;
+            if (!std::isfinite(quotient) || std::fabs(quotient - std::round(quotient)) > 1e-9) {
+                if (!reportable) return false;
+                violated("Число не кратно " + formatNumber(node.multipleOf) + " (multipleOf)");
+            }
+        }
+    } else if (value.type == TokenType::String) {
+        if (node.minLength > 0 && value.codePoints() < node.minLength) {
+            if (!reportable) return false;
+            violated("Строка короче " + std::to_string(node.minLength) + " символов (minLength)");
+        }
+        if (node.maxLength != JsonSchema::UNLIMITED && value.codePoints() > node.maxLength) {
+            if (!reportable) return false;
+            violated("Строка длиннее " + std::to_string(node.maxLength) + " символов (maxLength)");
+        }
+        if (node.pattern != NONE) {
+            const Regex& regex = m_schema.pattern(node.pattern);
+            if (!regex.canSearch(value.text.size())) {
+                if (!reportable) return false;
+                violated("Строка длиннее " + std::to_string(Regex::FALLBACK_MAX_LENGTH) +
+                         " байт не проверяется шаблоном \"" + m_schema.patternSource(node.pattern) + "\" (pattern)");
+            } else if (!regex.search(value.text)) {
+                if (!reportable) return false;
+                violated("Строка не соответствует шаблону \"" + m_schema.patternSource(node.pattern) + "\" (pattern)");
+            }
+        }
+    }
+
+    if (node.hasEnum) {
+        bool found = std::any_of(node.enumValues.begin(), node.enumValues.end(),
+                                 [&value](const JsonValue& expected) { return scalarEquals(expected, value); });
+        if (!found) {
+            if (!reportable) return false;
+            violated(node.isConst ? "Значение не равно const" : "Значение не входит в enum");
+        }
+    }
+
+    for (uint32_t child : node.allOf) {
+        if (!checkScalar(child, value, reportable, line, column)) {
+            if (!reportable) return false;
+            ok = false;
+        }
+    }
+    if (!node.anyOf.empty()) {
+        bool any = std::any_of(node.anyOf.begin(), node.anyOf.end(), [&](uint32_t child) {
+            return checkScalar(child, value, false, line, column);
+        });
+        if (!any) {
+            if (!reportable) return false;
+            violated("Значение не подходит ни под одну схему anyOf");
+        }
+    }
+    if (!node.oneOf.empty()) {
+        size_t passed = 0;
+        for (uint32_t child : node.oneOf) {
+            if (checkScalar(child, value, false, line, column) && ++passed > 1) break;
+        }
+        if (passed != 1) {
+            if (!reportable) return false;
+            violated(passed == 0 ? "Значение не подходит ни под одну схему oneOf"
+                                 : "Значение подходит больше чем под одну схему oneOf");
+        }
+    }
+    if (node.notNode != NONE && checkScalar(node.notNode, value, false, line, column)) {
+        if (!reportable) return false;
+        violated("Значение подходит под схему not");
+    }
+    if (node.ifNode != NONE) {
+        bool condition = checkScalar(node.ifNode, value, false, line, column);
+        uint32_t branch = condition ? node.thenNode : node.elseNode;
+        if (branch != NONE && !checkScalar(branch, value, false, line, column)) {
+            if (!reportable) return false;
+            violated(condition ? "Значение не подходит под then (условие if выполнено)"
+                               : "Значение не подходит под else (условие if не выполнено)");
+        }
+    }
+    return ok;
+}
+
+void SchemaMachine::pushFrame(const Token& token, bool isObject) {
+    bool capturing = m_depth > 0 && top().capturing;
+    if (m_frames.size() == m_depth) {
+        m_frames.emplace_back();
+    }
+    Frame& frame = m_frames[m_depth++];
+    frame.isObject = isObject;
+    frame.count = 0;
+    frame.key.clear();
+    frame.line = token.line;
+    frame.column = token.column;
+    frame.checks.swap(m_pending);
+    frame.rootCount = frame.checks.size();
+    frame.seen.clear();
+    frame.capturing = capturing;
+    frame.array.clear();
+    frame.object.clear();
+
+    // Список растёт по ходу: дети проверки добавляются в конец
+    for (uint32_t i = 0; i < frame.checks.size(); ++i) {
+        expand(frame, i);
+    }
+}
+
+void SchemaMachine::expand(Frame& frame, uint32_t index) {
+    Check& check = frame.checks[index];
+    const Node& node = m_schema.node(check.node);
+    size_t pathFrames = m_depth - 1;
+
+    uint8_t type = frame.isObject ? JsonSchema::OBJECT_TYPE : JsonSchema::ARRAY_TYPE;
+    if (!(node.types & type)) {
+        fail(check, frame.line, frame.column, pathFrames, typeMessage(node.types, frame.isObject ? "object" : "array"));
+    }
+    if (node.hasEnum) {
+        if (enumHasContainer(node, frame.isObject)) {
+            frame.capturing = true;
+        } else {
+            fail(check, frame.line, frame.column, pathFrames,
+                 node.isConst ? "Значение не равно const" : "Значение не входит в enum");
+        }
+    }
+    if (node.uniqueItems && !frame.isObject) {
+        frame.capturing = true;
+    }
+    if (frame.isObject && !node.seenNames.empty()) {
+        check.seenOffset = static_cast<uint32_t>(frame.seen.size());
+        frame.seen.resize(frame.seen.size() + node.seenNames.size(), 0);
+    }
+    if ((check.failed && !check.reportable) || !node.hasApplicators()) {
+        return;
+    }
+
+    // Порядок детей: allOf, anyOf, oneOf, not, if, then, else, схемы
+    // dependencies. Отчёт о своих нарушениях дают только дети allOf.
+    bool reportable = check.reportable;
+    uint32_t first = static_cast<uint32_t>(frame.checks.size());
+    auto add = [&frame, index](uint32_t child, bool report) {
+        frame.checks.push_back(Check{child, index, Role::Must, report});
+    };
+    for (uint32_t child : node.allOf) add(child, reportable);
+    for (uint32_t child : node.anyOf) add(child, false);
+    for (uint32_t child : node.oneOf) add(child, false);
+    for (uint32_t child : {node.notNode, node.ifNode, node.thenNode, node.elseNode}) {
+        if (child != NONE) add(child, false);
+    }
+    if (frame.isObject) {
+        for (const JsonSchema::Dependency& dependency : node.dependencies) {
+            if (dependency.node != NONE) add(dependency.node, false);
+        }
+    }
+    frame.checks[index].firstChild = first;
+    frame.checks[index].childCount = static_cast<uint32_t>(frame.checks.size()) - first;
+}
+
+void SchemaMachine::endContainer(const Token& token) {
+    if (m_chunkMode && m_depth == 1) {
+        // Корень закрывает последняя порция; проверки корня - после сборки
+        if (!m_lastChunk) {
+            syntaxError(token, "Неожиданный конец массива в порции");
+            return;
+        }
+        m_state = State::End;
+        return;
+    }
+    finalizeTop();
+    m_state = m_depth == 0 ? State::End : State::Next;
+}
+
+void SchemaMachine::finalizeTop() {
+    size_t index = m_depth - 1;
+    Frame& frame = m_frames[index];
+    JsonValue captured;
+    if (frame.capturing) {
+        captured = frame.isObject ? JsonValue(std::move(frame.object)) : JsonValue(std::move(frame.array));
+    }
+
+    // Дети проверок стоят после них: обратный порядок завершает их раньше
+    for (size_t i = frame.checks.size(); i-- > 0;) {
+        finalizeCheck(frame, frame.checks[i], index, captured);
+    }
+
+    m_depth--;
+    if (index > 0) {
+        Frame& parent = m_frames[index - 1];
+        for (size_t i = 0; i < frame.rootCount; ++i) {
+            const Check& check = frame.checks[i];
+            applyResult(parent.checks[check.owner], check.role, !check.failed);
+        }
+        if (parent.capturing) {
+            capture(parent, std::move(captured));
+        }
+    }
+}
+
+void SchemaMachine::finalizeCheck(Frame& frame, Check& check, size_t pathFrames, const JsonValue& captured) {
+    if (check.failed && !check.reportable) return;
+    const Node& node = m_schema.node(check.node);
+    auto violated = [&](const std::string& message) {
+        fail(check, frame.line, frame.column, pathFrames, message);
+    };
+
+    if (!frame.isObject) {
+        if (frame.count < node.minItems) {
+            violated("В массиве меньше " + std::to_string(node.minItems) + " элементов (minItems)");
+        }
+        if (node.maxItems != JsonSchema::UNLIMITED && frame.count > node.maxItems) {
+            violated("В массиве больше " + std::to_string(node.maxItems) + " элементов (maxItems)");
+        }
+        if (node.contains != NONE && check.containsPassed == 0) {
+            violated("Ни один элемент массива не подходит под contains");
+        }
+        if (node.uniqueItems && captured.isArray() && !uniqueItems(captured.asArray())) {
+            violated("Элементы массива повторяются (uniqueItems)");
+        }
+    } else {
+        if (frame.count < node.minProperties) {
+            violated("В объекте меньше " + std::to_string(node.minProperties) + " ключей (minProperties)");
+        }
+        if (node.maxProperties != JsonSchema::UNLIMITED && frame.count > node.maxProperties) {
+            violated("В объекте больше " + std::to_string(node.maxProperties) + " ключей (maxProperties)");
+        }
+        const uint8_t* seen = frame.seen.data() + check.seenOffset;
+        for (uint32_t mark : node.required) {
+            if (!seen[mark]) {
+                violated("Отсутствует обязательный ключ '" + node.seenNames[mark] + "'");
+            }
+        }
+        for (const JsonSchema::Dependency& dependency : node.dependencies) {
+            if (!seen[dependency.seen]) continue;
+            for (uint32_t mark : dependency.requiredSeen) {
+                if (!seen[mark]) {
+                    violated("Ключ '" + node.seenNames[dependency.seen] + "' требует ключ '" + node.seenNames[mark] +
+                             "' (dependencies)");
+                }
+            }
+        }
+    }
+
+    if (node.hasEnum && enumHasContainer(node, frame.isObject) && captured.type() != JsonValue::Type::Null) {
+        bool found = std::any_of(node.enumValues.begin(), node.enumValues.end(),
+                                 [&captured](const JsonValue& expected) { return JsonPatch::equal(expected, captured); });
+        if (!found) {
+            violated(node.isConst ? "Значение не равно const" : "Значение не входит в enum");
+        }
+    }
+
+    if (check.childCount == 0) return;
+    const Check* child = frame.checks.data() + check.firstChild;
+    auto passed = [&child]() { return !(child++)->failed; };
+
+    for (size_t i = 0; i < node.allOf.size(); ++i) {
+        // Нарушения детей allOf уже в отчёте
+        if (!passed()) check.failed = true;
+    }
+    if (!node.anyOf.empty()) {
+        size_t count = 0;
+        for (size_t i = 0; i < node.anyOf.size(); ++i) count += passed();
+        if (count == 0) violated("Значение не подходит ни под одну схему anyOf");
+    }
+    if (!node.oneOf.empty()) {
+        size_t count = 0;
+        for (size_t i = 0; i < node.oneOf.size(); ++i) count += passed();
+        if (count == 0) violated("Значение не подходит ни под одну схему oneOf");
+        if (count > 1) violated("Значение подходит больше чем под одну схему oneOf");
+    }
+    if (node.notNode != NONE && passed()) {
+        violated("Значение подходит под схему not");
+    }
+    if (node.ifNode != NONE) {
+        bool condition = passed();
+        bool thenPassed = node.thenNode == NONE || passed();
+        bool elsePassed = node.elseNode == NONE || passed();
+        if (condition && !thenPassed) violated("Значение не подходит под then (условие if выполнено)");
+        if (!condition && !elsePassed) violated("Значение не подходит под else (условие if не выполнено)");
+    }
+    if (frame.isObject) {
+        const uint8_t* seen = frame.seen.data() + check.seenOffset;
+        for (const JsonSchema::Dependency& dependency : node.dependencies) {
+            if (dependency.node == NONE) continue;
+            if (!passed() && seen[dependency.seen]) {
+                violated("Объект не подходит под схему dependencies для ключа '" + node.seenNames[dependency.seen] + "'");
+            }
+        }
+    }
+}
+
+// Значение как поток токенов (без строк и столбцов)
+bool emitValue(SchemaMachine& machine, const JsonValue& value) {
+    auto emit = [&machine](TokenType type, std::string text) {
+        return machine.feed(Token(type, std::move(text), 0, 0));
+    };
+    switch (value.type()) {
+        case JsonValue::Type::Null:
+            return emit(TokenType::Null, "null");
+        case JsonValue::Type::Bool:
+            return value.asBool() ? emit(TokenType::True, "true") : emit(TokenType::False, "false");
+        case JsonValue::Type::RawNumber:
+            return emit(TokenType::Number, value.numberText());
+        case JsonValue::Type::Number: {
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%.17g", value.asNumber());
+            return emit(TokenType::Number, buffer);
+        }
+        case JsonValue::Type::String:
+            return emit(TokenType::String, value.asString());
+        case JsonValue::Type::Array: {
+            if (!emit(TokenType::LeftBracket, "[")) return false;
+            bool first = true;
+            for (const JsonValue& item : value.asArray()) {
+                if (!first && !emit(TokenType::Comma, ",")) return false;
+                first = false;
+                if (!emitValue(machine, item)) return false;
+            }
+            return emit(TokenType::RightBracket, "]");
+        }
+        case JsonValue::Type::Object: {
+            if (!emit(TokenType::LeftBrace, "{")) return false;
+            bool first = true;
+            for (const auto& [key, item] : value.asObject()) {
+                if (!first && !emit(TokenType::Comma, ",")) return false;
+                first = false;
+                if (!emit(TokenType::String, key) || !emit(TokenType::Colon, ":")) return false;
+                if (!emitValue(machine, item)) return false;
+            }
+            return emit(TokenType::RightBrace, "}");
+        }
+    }
+    return false;
+}
+
+// Начало порции: сразу после ',' между элементами массива верхнего уровня
+struct ChunkStart {
+    size_t offset;
+    size_t line;
+    size_t column;
+    size_t index;       // Номер первого элемента
+};
+
+// Границы порций по запятым верхнего уровня массива, открытого в open.
+// Строки пропускаются векторным поиском; на некорректном входе разбиение
+// просто обрывается - ошибку найдёт проверка порции.
+std::vector<ChunkStart> chunkStarts(std::string_view content, size_t open, size_t chunkSize) {
+    const char* data = content.data();
+    const char* end = data + content.size();
+    size_t line = 1 + static_cast<size_t>(std::count(data, data + open, '\n'));
+    size_t lineStart = open;
+    while (lineStart > 0 && data[lineStart - 1] != '\n') --lineStart;
+
+    std::vector<ChunkStart> starts;
+    starts.push_back(ChunkStart{open + 1, line, open + 2 - lineStart, 0});
+    size_t depth = 0;
+    size_t index = 0;
+    for (const char* p = data + open + 1; p < end; ++p) {
+        switch (*p) {
+            case '"': {
+                const char* q = p + 1;
+                while (true) {
+                    q = findStringSpecial(q, end);
+                    if (q >= end || static_cast<unsigned char>(*q) < 0x20) return starts;
+                    if (*q == '"') break;
+                    q += 2;     // escape-последовательность
+                }
+                p = q;
+                break;
+            }
+            case '[':
+            case '{':
+                ++depth;
+                break;
+            case ']':
+            case '}':
+                if (depth == 0) return starts;
+                --depth;
+                break;
+            case '\n':
+                ++line;
+                lineStart = static_cast<size_t>(p - data) + 1;
+                break;
+            case ',':
+                if (depth == 0) {
+                    ++index;
+                    size_t next = static_cast<size_t>(p - data) + 1;
+                    if (next - starts.back().offset >= chunkSize) {
+                        starts.push_back(ChunkStart{next, line, next - lineStart + 1, index});
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return starts;
+}
+
+} // namespace
+
+SchemaValidator::SchemaValidator(JsonSchema schema, unsigned int threadCount)
+    : m_schema(std::make_shared<const JsonSchema>(std::move(schema))),
+      m_chunkSize(DEFAULT_CHUNK_SIZE), m_maxDepth(Parser::DEFAULT_MAX_DEPTH), m_stopOnFirstError(false) {
+    setThreadCount(threadCount);
+    m_splittable = splittable(*m_schema, m_schema->root());
+}
+
+void SchemaValidator::setThreadCount(unsigned int count) {
+    if (count == 0) {
+        count = std::thread::hardware_concurrency();
+    }
+    m_threadCount = count > 0 ? count : 1;
+}
+
+SchemaResult SchemaValidator::validate(std::string_view content, ParseStats* stats) const {
+    JSON_TRACE_SCOPE("SchemaValidator::validate");
+    StageTimer totalTimer(stats ? &stats->total : nullptr);
+
+    if (m_splittable && m_threadCount > 1 && content.size() > m_chunkSize) {
+        size_t first = 0;
+        while (first < content.size() && std::isspace(static_cast<unsigned char>(content[first]))) ++first;
+        if (first < content.size() && content[first] == '[') {
+            return validateParallel(content, first, stats);
+        }
+    }
+
+    return validateSequential(content, stats);
+}
+
+SchemaResult SchemaValidator::validateSequential(std::string_view content, ParseStats* stats) const {
+    StageTimer parseTimer(stats ? &stats->parse : nullptr);
+    SchemaMachine machine(*m_schema, m_maxDepth, m_stopOnFirstError);
+    try {
+        Lexer lexer;
+        lexer.append(content.data(), content.size());
+        lexer.finish();
+        while (machine.feed(lexer.nextToken())) {
+        }
+    } catch (const LexerException& e) {
+        machine.lexerError(e);
+    }
+    machine.result().chunkCount = 1;
+    if (stats) {
+        stats->bytes += content.size();
+        stats->tokens += machine.tokenCount();
+        stats->elements += machine.result().valueCount;
+    }
+    return machine.takeResult();
+}
+
+SchemaResult SchemaValidator::validateParallel(std::string_view content, size_t open, ParseStats* stats) const {
+    StageTimer scanTimer(stats ? &stats->boundaryScan : nullptr);
+    std::vector<ChunkStart> starts = chunkStarts(content, open, m_chunkSize);
+    scanTimer.stop();
+    size_t chunkCount = starts.size();
+    if (chunkCount < 2) {
+        return validateSequential(content, stats);
+    }
+
+    // '[' проверяется здесь: кадр корня - общий образец для порций
+    SchemaMachine main(*m_schema, m_maxDepth, m_stopOnFirstError);
+    main.feed(Token(TokenType::LeftBracket, "[", starts[0].line, starts[0].column - 1, open));
+
+    struct ChunkOutput {
+        std::unique_ptr<SchemaMachine> machine;
+        StageTiming parse;
+    };
+    std::vector<ChunkOutput> outputs(chunkCount);
+    std::atomic<size_t> nextChunk{0};
+    std::mutex errorMutex;
+    std::exception_ptr workerError;
+    const Frame& root = main.rootFrame();
+
+    auto worker = [&](WorkerStats* workerStats) {
+        while (true) {
+            size_t index = nextChunk.fetch_add(1);
+            if (index >= chunkCount) return;
+
+            ChunkOutput& output = outputs[index];
+            const ChunkStart& start = starts[index];
+            size_t end = index + 1 < chunkCount ? starts[index + 1].offset : content.size();
+            try {
+                JSON_TRACE_SCOPE("schema chunk");
+                StageTimer timer(&output.parse);
+                output.machine = std::make_unique<SchemaMachine>(*m_schema, m_maxDepth, m_stopOnFirstError);
+                output.machine->beginChunk(root, start.index, index == 0, index + 1 == chunkCount);
+                try {
+                    Lexer lexer;
+                    lexer.setStartPosition(start.line, start.column, start.offset);
+                    lexer.append(content.data() + start.offset, end - start.offset);
+                    lexer.finish();
+                    while (output.machine->feed(lexer.nextToken())) {
+                    }
+                } catch (const LexerException& e) {
+                    output.machine->lexerError(e);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!workerError) workerError = std::current_exception();
+                nextChunk = chunkCount;
+                return;
+            }
+
+            if (workerStats) {
+                workerStats->chunks++;
+                workerStats->bytes += end - start.offset;
+                workerStats->busyMs += output.parse.wallMs;
+                workerStats->cpuMs += output.parse.cpuMs;
+            }
+        }
+    };
+
+    size_t workerCount = std::min<size_t>(m_threadCount, chunkCount);
+    std::vector<WorkerStats> workerStats(stats ? workerCount : 0);
+    auto phaseStart = std::chrono::steady_clock::now();
+    {
+        JSON_TRACE_SCOPE("validate chunks");
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < workerCount; ++i) {
+            threads.emplace_back([&, i]() {
+                JSON_TRACE_THREAD_NAME("schema worker " + std::to_string(i));
+                worker(stats ? &workerStats[i] : nullptr);
+            });
+        }
+        worker(stats ? &workerStats[0] : nullptr);
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+    if (workerError) {
+        std::rethrow_exception(workerError);
+    }
+
+    if (stats) {
+        double phaseMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - phaseStart).count();
+        stats->parallelPhaseMs += phaseMs;
+        for (size_t i = 0; i < workerCount; ++i) {
+            workerStats[i].workerId = i;
+            workerStats[i].idleMs = std::max(0.0, phaseMs - workerStats[i].busyMs);
+            stats->workers.push_back(workerStats[i]);
+        }
+        for (size_t i = 0; i < chunkCount; ++i) {
+            stats->parse.add(outputs[i].parse);
+            stats->tokens += outputs[i].machine->tokenCount();
+            size_t end = i + 1 < chunkCount ? starts[i + 1].offset : content.size();
+            stats->chunkSizes.push_back(end - starts[i].offset);
+        }
+    }
+
+    // Синтаксическая ошибка: порции могли разойтись с настоящей структурой,
+    // ошибку с верным местом найдёт последовательная проверка
+    for (const ChunkOutput& output : outputs) {
+        if (output.machine->result().syntaxError) {
+            return validateSequential(content, stats);
+        }
+    }
+
+    // Сборка: ошибки в порядке порций, отметки корня объединяются
+    StageTimer mergeTimer(stats ? &stats->merge : nullptr);
+    Frame& merged = main.rootFrame();
+    SchemaResult& result = main.result();
+    for (ChunkOutput& output : outputs) {
+        SchemaResult& part = output.machine->result();
+        std::move(part.errors.begin(), part.errors.end(), std::back_inserter(result.errors));
+        result.valueCount += part.valueCount;
+        const Frame& chunkRoot = output.machine->rootFrame();
+        for (size_t i = 0; i < merged.checks.size(); ++i) {
+            merged.checks[i].failed = merged.checks[i].failed || chunkRoot.checks[i].failed;
+            merged.checks[i].containsPassed += chunkRoot.checks[i].containsPassed;
+        }
+        merged.count = chunkRoot.count;
+    }
+    if (m_stopOnFirstError && !result.errors.empty()) {
+        result.errors.erase(result.errors.begin() + 1, result.errors.end());
+    } else {
+        main.finishRoot();
+    }
+    result.chunkCount = chunkCount;
+    mergeTimer.stop();
+
+    if (stats) {
+        stats->bytes += content.size();
+        stats->elements += result.valueCount;
+    }
+    return main.takeResult();
+}
+
+SchemaResult SchemaValidator::validateFile(const std::string& filename, ParseStats* stats) const {
+    JSON_TRACE_SCOPE("SchemaValidator::validateFile");
+    StageTiming readTiming;
+    StageTimer readTimer(stats ? &readTiming : nullptr);
+    std::unique_ptr<InputStream> input = InputStream::open(filename, m_threadCount);
+
+    // Параллельной проверке нужен весь текст
+    if (m_splittable && m_threadCount > 1 && input->fileSize() > m_chunkSize) {
+        std::string content = input->readAll();
+        readTimer.stop();
+        SchemaResult result = validate(content, stats);
+        if (stats) {
+            stats->read.add(readTiming);
+            stats->total.wallMs += readTiming.wallMs;
+            stats->total.cpuMs += readTiming.cpuMs;
+        }
+        return result;
+    }
+    readTimer.stop();
+
+    // Последовательно - блоками: в памяти только незавершённый токен
+    StageTimer totalTimer(stats ? &stats->total : nullptr);
+    SchemaMachine machine(*m_schema, m_maxDepth, m_stopOnFirstError);
+    std::vector<char> buffer(STREAM_BLOCK_SIZE);
+    std::vector<Token> tokens;
+    size_t bytes = 0;
+    try {
+        Lexer lexer;
+        bool done = false;
+        while (!done) {
+            size_t count;
+            {
+                StageTimer timer(stats ? &stats->read : nullptr);
+                count = input->read(buffer.data(), buffer.size());
+            }
+            bytes += count;
+            if (count == 0) {
+                lexer.finish();
+            } else {
+                lexer.append(buffer.data(), count);
+            }
+            {
+                StageTimer timer(stats ? &stats->tokenize : nullptr);
+                done = lexer.tokenizeAvailable(tokens);
+            }
+            StageTimer timer(stats ? &stats->parse : nullptr);
+            for (const Token& token : tokens) {
+                if (!machine.feed(token)) {
+                    done = true;
+                    break;
+                }
+            }
+            tokens.clear();
+            lexer.discardConsumed();
+        }
+    } catch (const LexerException& e) {
+        machine.lexerError(e);
+    }
+    machine.result().chunkCount = 1;
+    if (stats) {
+        stats->bytes += bytes;
+        stats->tokens += machine.tokenCount();
+        stats->elements += machine.result().valueCount;
+    }
+    return machine.takeResult();
+}
+
+SchemaResult SchemaValidator::validateValue(const JsonValue& value) const {
+    SchemaMachine machine(*m_schema, m_maxDepth, m_stopOnFirstError);
+    if (emitValue(machine, value)) {
+        machine.feed(Token(TokenType::EndOfFile, "", 0, 0));
+    }
+    machine.result().chunkCount = 1;
+    return machine.takeResult();
+}
+
+} // namespace json
@@ -1,11 +1,192 @@
 #include "Serializer.hpp"
+#include "MappedFile.hpp"
 #include <sstream>
 #include <fstream>
 #include <iomanip>
 #include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <streambuf>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace fs = std::filesystem;
 
 namespace json {
 
+namespace {
+
+// Буфер-посредник, считающий записанные байты (смещение в новом файле)
+class CountingBuffer : public std::streambuf {
+private:
+    std::streambuf* m_target;
+    uint64_t m_count = 0;
+
+protected:
+    int_type overflow(int_type ch) override {
+        if (traits_type::eq_int_type(ch, traits_type::eof())) {
+            return traits_type::not_eof(ch);
+        }
+        if (traits_type::eq_int_type(m_target->sputc(traits_type::to_char_type(ch)), traits_type::eof())) {
+            return traits_type::eof();
+        }
+        ++m_count;
+        return ch;
+    }
+
+    std::streamsize xsputn(const char* data, std::streamsize size) override {
+        std::streamsize written = m_target->sputn(data, size);
+        m_count += static_cast<uint64_t>(written);
+        return written;
+    }
+
+public:
+    explicit CountingBuffer(std::streambuf* target) : m_target(target) {}
+
+    uint64_t count() const { return m_count; }
+};
+
+// Перенести участки скопированного поддерева в новый файл
+void moveSpans(const JsonValue& value, uint32_t oldSource, uint32_t newSource, int64_t delta) {
+    SourceSpan span;
+    if (!value.sourceSpan(span) || span.source != oldSource) {
+        return;
+    }
+    span.source = newSource;
+    span.offset = static_cast<uint64_t>(static_cast<int64_t>(span.offset) + delta);
+    value.setSourceSpan(span);
+
+    if (value.isArray()) {
+        for (const auto& item : value.asArray()) {
+            moveSpans(item, oldSource, newSource, delta);
+        }
+    } else {
+        for (const auto& [_, item] : value.asObject()) {
+            moveSpans(item, oldSource, newSource, delta);
+        }
+    }
+}
+
+// Записан ли text так, как его записал бы Serializer: без пробелов
+// (compact) или с переводом строки и отступом indentSize * глубина после
+// '[', '{' и ',', перед закрывающей скобкой и одним пробелом после ':'.
+// Пустые контейнеры - "[]" и "{}", в конце допустимы пробелы.
+bool hasLayout(std::string_view text, bool pretty, size_t indentSize) {
+    size_t end = text.size();
+    while (end > 0 && (text[end - 1] == '\n' || text[end - 1] == ' ')) --end;
+    size_t depth = 0;
+    size_t i = 0;
+
+    // Перевод строки и ровно spaces пробелов с позиции i
+    auto lineBreak = [&](size_t spaces) {
+        if (!pretty) return true;
+        if (i >= end || text[i] != '\n') return false;
+        ++i;
+        for (size_t k = 0; k < spaces; ++k, ++i) {
+            if (i >= end || text[i] != ' ') return false;
+        }
+        return true;
+    };
+
+    while (i < end) {
+        char c = text[i++];
+        switch (c) {
+            case '"':
+                while (i < end && text[i] != '"') {
+                    i += text[i] == '\\' ? 2 : 1;
+                }
+                if (i >= end) return false;
+                ++i;
+                break;
+            case '[':
+            case '{':
+                if (i < end && text[i] == (c == '[' ? ']' : '}')) {
+                    ++i;
+                    break;
+                }
+                ++depth;
+                if (!lineBreak(depth * indentSize)) return false;
+                break;
+            case ',':
+                if (!lineBreak(depth * indentSize)) return false;
+                break;
+            case ':':
+                if (pretty && (i >= end || text[i++] != ' ')) return false;
+                break;
+            case '\n':
+                // Только перед закрывающей скобкой непустого контейнера
+                --i;
+                if (!pretty || depth == 0 || !lineBreak((depth - 1) * indentSize)) return false;
+                if (i >= end || (text[i] != ']' && text[i] != '}')) return false;
+                break;
+            case ']':
+            case '}':
+                if (depth == 0 || (pretty && text[i - 2] != '\n' && text[i - 2] != ' ')) return false;
+                --depth;
+                break;
+            case ' ':
+            case '\t':
+            case '\r':
+                return false;
+            default:
+                break;
+        }
+    }
+    return depth == 0;
+}
+
+// Форматирование исходного файла: режим и отступ берутся по первому
+// переводу строки и проверяются по всему тексту
+void detectLayout(SourceFile& source, std::string_view text) {
+    size_t newline = text.find('\n');
+    size_t spaces = 0;
+    while (newline != std::string_view::npos && newline + 1 + spaces < text.size() &&
+           text[newline + 1 + spaces] == ' ') {
+        ++spaces;
+    }
+    if (hasLayout(text, false, 0)) {
+        source.layout = SourceFile::Layout::Compact;
+    } else if (newline != std::string_view::npos && hasLayout(text, true, spaces)) {
+        source.layout = SourceFile::Layout::Pretty;
+        source.indentSize = static_cast<int>(spaces);
+    } else {
+        source.layout = SourceFile::Layout::Other;
+    }
+}
+
+} // namespace
+
+SourceFile SourceFile::capture(const std::string& path) {
+    SourceFile source;
+    source.path = path;
+    source.id = SourceSpan::newSource();
+    source.size = static_cast<uint64_t>(fs::file_size(path));
+    source.mtime = static_cast<int64_t>(fs::last_write_time(path).time_since_epoch().count());
+    return source;
+}
+
+bool SourceFile::unchanged() const {
+    std::error_code ec;
+    uint64_t currentSize = static_cast<uint64_t>(fs::file_size(path, ec));
+    if (ec || currentSize != size) return false;
+    auto modified = fs::last_write_time(path, ec);
+    return !ec && static_cast<int64_t>(modified.time_since_epoch().count()) == mtime;
+}
+
+// Состояние одного инкрементального сохранения
+struct Serializer::IncrementalWriter {
+    std::ostream& out;
+    const CountingBuffer& counter;
+    const MappedFile* source;       // nullptr - копировать нечего
+    uint32_t sourceId;
+    uint32_t targetId;
+    IncrementalStats stats;
+
+    // Скопированные контейнеры и сдвиг их участков
+    std::vector<std::pair<const JsonValue*, int64_t>> copied;
+};
+
 Serializer::Serializer(const Options& options)
     : m_options(options) {}
 
@@ -58,6 +239,9 @@ void Serializer::serializeValue(const JsonValue& value, std::ostream& os, int de
         os << "null";
     } else if (value.isBool()) {
         os << (value.asBool() ? "true" : "false");
+    } else if (value.isRawNumber()) {
+        // Исходная запись числа выводится без изменений
+        os << value.numberText();
     } else if (value.isNumber()) {
         double num = value.asNumber();
         // Проверка на целое число
@@ -155,6 +339,144 @@ bool Serializer::saveToFile(const JsonValue& value, const std::string& filename)
     return file.good();
 }
 
+void Serializer::writeIncremental(const JsonValue& value, IncrementalWriter& writer, int depth) const {
+    if (!value.isArray() && !value.isObject()) {
+        serializeValue(value, writer.out, depth);
+        return;
+    }
+
+    uint64_t start = writer.counter.count();
+    SourceSpan span;
+    if (writer.source && value.sourceSpan(span) && span.source == writer.sourceId &&
+        span.length >= 2 && span.offset <= writer.source->size() &&
+        span.length <= writer.source->size() - span.offset) {
+        // Участок должен быть тем же контейнером: скобки по краям
+        const char* text = writer.source->data() + span.offset;
+        char open = value.isArray() ? '[' : '{';
+        char close = value.isArray() ? ']' : '}';
+        if (text[0] == open && text[span.length - 1] == close) {
+            writer.out.write(text, static_cast<std::streamsize>(span.length));
+            writer.stats.copiedBytes += span.length;
+            writer.stats.copiedSpans++;
+            writer.copied.emplace_back(&value, static_cast<int64_t>(start) - static_cast<int64_t>(span.offset));
+            return;
+        }
+    }
+
+    if (value.isArray()) {
+        const JsonArray& arr = value.asArray();
+        if (arr.empty()) {
+            writer.out << "[]";
+        } else {
+            writer.out << "[" << newline();
+            for (size_t i = 0; i < arr.size(); ++i) {
+                writer.out << indent(depth + 1);
+                writeIncremental(arr[i], writer, depth + 1);
+                if (i < arr.size() - 1) {
+                    writer.out << ",";
+                }
+                writer.out << newline();
+            }
+            writer.out << indent(depth) << "]";
+        }
+    } else {
+        const JsonObject& obj = value.asObject();
+        if (obj.empty()) {
+            writer.out << "{}";
+        } else {
+            writer.out << "{" << newline();
+            size_t i = 0;
+            for (const auto& [key, item] : obj) {
+                writer.out << indent(depth + 1);
+                serializeString(key, writer.out);
+                writer.out << ":" << (m_options.prettyPrint ? " " : "");
+                writeIncremental(item, writer, depth + 1);
+                if (++i < obj.size()) {
+                    writer.out << ",";
+                }
+                writer.out << newline();
+            }
+            writer.out << indent(depth) << "}";
+        }
+    }
+
+    // Записанный заново контейнер тоже получает участок в новом файле
+    // (если сохранение не удастся, источник с таким номером не появится)
+    span.source = writer.targetId;
+    span.offset = start;
+    span.length = writer.counter.count() - start;
+    value.setSourceSpan(span);
+}
+
+bool Serializer::saveIncremental(const JsonValue& value, SourceFile& source, const std::string& filename,
+                                 IncrementalStats* stats) const {
+    // Копировать можно только то, что текущие опции записали бы так же
+    std::unique_ptr<MappedFile> mapping;
+    if (source.id != 0 && !m_options.sortKeys && !m_options.escapeUnicode && source.unchanged()) {
+        mapping = std::make_unique<MappedFile>();
+        if (!mapping->open(source.path)) {
+            mapping.reset();
+        } else {
+            if (source.layout == SourceFile::Layout::Unchecked) {
+                detectLayout(source, std::string_view(mapping->data(), mapping->size()));
+            }
+            bool same = m_options.prettyPrint
+                ? source.layout == SourceFile::Layout::Pretty && source.indentSize == m_options.indentSize
+                : source.layout == SourceFile::Layout::Compact;
+            if (!same) {
+                mapping.reset();
+            }
+        }
+    }
+
+    std::string tempFile = filename + ".tmp";
+    std::ofstream file(tempFile, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    CountingBuffer counter(file.rdbuf());
+    std::ostream out(&counter);
+    IncrementalWriter writer{out, counter, mapping.get(), source.id, SourceSpan::newSource(), {}, {}};
+
+    writeIncremental(value, writer, 0);
+    out << "\n";
+    out.flush();
+    file.close();
+
+    // Отображение закрывается до переименования (иначе Windows не заменит файл)
+    mapping.reset();
+
+    std::error_code ec;
+    if (!out.good() || file.fail()) {
+        fs::remove(tempFile, ec);
+        return false;
+    }
+    fs::rename(tempFile, filename, ec);
+    if (ec) {
+        fs::remove(tempFile, ec);
+        return false;
+    }
+
+    for (const auto& [node, delta] : writer.copied) {
+        moveSpans(*node, source.id, writer.targetId, delta);
+    }
+
+    SourceFile saved = SourceFile::capture(filename);
+    saved.id = writer.targetId;
+    if (!m_options.sortKeys && !m_options.escapeUnicode) {
+        saved.layout = m_options.prettyPrint ? SourceFile::Layout::Pretty : SourceFile::Layout::Compact;
+        saved.indentSize = m_options.indentSize;
+    }
+    source = saved;
+
+    writer.stats.serializedBytes = counter.count() - writer.stats.copiedBytes;
+    if (stats) {
+        *stats = writer.stats;
+    }
+    return true;
+}
+
 // Статические методы
 std::string Serializer::toString(const JsonValue& value, bool pretty) {
     Serializer serializer(pretty ? Options::pretty() : Options::compact());
@@ -0,0 +1,845 @@
+#include "TolerantParser.hpp"
+#include "Lexer.hpp"
+#include "MappedFile.hpp"
+#include "InputStream.hpp"
+#include "Utf8.hpp"
+#include "Trace.hpp"
+#include "ForkJoinPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <thread>
+
+namespace json {
+
+namespace {
+
+constexpr size_t NO_INDENT = static_cast<size_t>(-1);
+constexpr size_t CONTEXT_LENGTH = 60;       // Как у Validator::extractContext
+
+// Пробельные символы - те же, что пропускает Lexer (std::isspace)
+inline bool isSpace(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+inline bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+int hexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+void appendUTF8(std::string& out, char32_t cp) {
+    if (cp <= 0x7F) {
+        out += static_cast<char>(cp);
+    } else if (cp <= 0x7FF) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp <= 0xFFFF) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+// Ошибка до пересчёта смещения в строку и столбец
+struct PendingError {
+    size_t offset;
+    std::string message;
+};
+
+// Разметка входа, общая для всех порций
+struct Layout {
+    std::string_view input;
+    bool isArray = false;           // Вход - массив "[...]"
+    size_t indent = NO_INDENT;      // Отступ строк, с которых начинаются элементы
+    size_t maxDepth = Parser::DEFAULT_MAX_DEPTH;
+    uint32_t spanSource = 0;
+    bool keepElements = true;       // false - элементы только считаются
+
+    // Строка файла начинается в pos с '{' или '[' на отступе элементов
+    bool isElementLine(size_t pos) const {
+        if (indent == NO_INDENT || pos < indent) return false;
+        char c = input[pos];
+        if (c != '{' && c != '[') return false;
+        size_t lineStart = pos - indent;
+        if (lineStart > 0 && input[lineStart - 1] != '\n') return false;
+        for (size_t i = lineStart; i < pos; ++i) {
+            if (input[i] != ' ' && input[i] != '\t') return false;
+        }
+        return true;
+    }
+};
+
+// Разбор одной порции: элементы верхнего уровня в [begin, end)
+class ChunkParser {
+public:
+    JsonArray elements;
+    std::vector<PendingError> errors;
+    size_t valid = 0;
+    size_t skipped = 0;
+
+    ChunkParser(const Layout& layout, size_t begin, size_t end)
+        : m_layout(layout), m_input(layout.input), m_pos(begin), m_end(end),
+          m_elementStart(begin), m_badUtf8(utf8::npos) {
+        m_stack.reserve(32);
+        findBadUtf8();
+    }
+
+    // last - порция содержит конец входа (и закрывающую ']')
+    void run(bool last);
+
+private:
+    struct Frame {
+        bool isObject = false;
+        JsonObject object;
+        JsonArray array;
+        std::string key;
+        size_t openOffset = 0;
+    };
+
+    const Layout& m_layout;
+    std::string_view m_input;
+    size_t m_pos;
+    size_t m_end;
+    size_t m_elementStart;
+    size_t m_badUtf8;               // Первый некорректный байт UTF-8 не раньше m_pos
+    std::vector<Frame> m_stack;
+    std::vector<char> m_closers;    // Ожидаемые закрывающие скобки при пропуске
+
+    // Проверка UTF-8 выполняется векторно для всей оставшейся порции
+    // и повторяется только после пропуска ошибки
+    void findBadUtf8() {
+        size_t offset = utf8::findInvalid(m_input.data() + m_pos, m_end - m_pos);
+        m_badUtf8 = offset == utf8::npos ? utf8::npos : m_pos + offset;
+    }
+
+    void skipWhitespace() {
+        while (m_pos < m_end && isSpace(m_input[m_pos])) ++m_pos;
+    }
+
+    bool fail(size_t offset, std::string message) {
+        errors.push_back({offset, std::move(message)});
+        return false;
+    }
+
+    // Конец порции внутри элемента: либо конец файла, либо начало
+    // следующей порции (новый элемент на отступе элементов)
+    bool failAtEnd() {
+        return fail(m_pos, m_end == m_input.size() ? "Неожиданный конец файла"
+                                                   : "Элемент не закрыт до начала следующего");
+    }
+
+    bool parseElement(JsonValue& out);
+    bool parseKey(Frame& frame);
+    bool readString(std::string& out);
+    bool readEscape(const char*& p, std::string& out);
+    bool readNumber(JsonValue& out);
+    bool readKeyword(JsonValue& out);
+    void recordSpan(const JsonValue& container, size_t openOffset) const;
+    void synchronize();
+};
+
+void ChunkParser::run(bool last) {
+    bool afterElement = false;      // Перед позицией элемент или пропущенный участок
+    bool lastValid = false;
+    bool afterComma = false;
+    bool closed = false;
+    const bool isArray = m_layout.isArray;
+
+    while (true) {
+        skipWhitespace();
+        if (m_pos >= m_end) break;
+        char c = m_input[m_pos];
+
+        if (c == ',') {
+            // В последовательности значений запятые между ними допустимы
+            if (isArray && !afterElement) {
+                fail(m_pos, "Неожиданная запятая");
+            }
+            ++m_pos;
+            afterElement = false;
+            afterComma = true;
+            continue;
+        }
+
+        if (c == ']' && isArray) {
+            size_t at = m_pos++;
+            skipWhitespace();
+            if (last && m_pos >= m_end) {
+                if (afterComma) {
+                    fail(at, "Запятая перед закрывающей скобкой ']' не допускается");
+                }
+                closed = true;
+                break;
+            }
+            fail(at, "Неожиданная закрывающая скобка ']'");
+            continue;
+        }
+
+        if (isArray && afterElement && lastValid) {
+            // Элементы без запятой между ними: оба элемента сохраняются
+            fail(m_pos, "Ожидалась ',' или ']' в массиве");
+        }
+
+        m_elementStart = m_pos;
+        JsonValue value;
+        lastValid = parseElement(value);
+        if (lastValid) {
+            ++valid;
+            if (m_layout.keepElements) {
+                elements.push_back(std::move(value));
+            }
+        } else {
+            ++skipped;
+            synchronize();
+        }
+        afterElement = true;
+        afterComma = false;
+    }
+
+    if (last && isArray && !closed) {
+        fail(m_end, "Незакрытый массив (пропущена ']')");
+    }
+}
+
+bool ChunkParser::parseElement(JsonValue& out) {
+    m_stack.clear();
+
+    while (true) {
+        JsonValue value;
+        skipWhitespace();
+        if (m_pos >= m_end) return failAtEnd();
+
+        char c = m_input[m_pos];
+        switch (c) {
+            case '{':
+            case '[': {
+                bool isObject = c == '{';
+                if (!m_stack.empty() && m_layout.isElementLine(m_pos)) {
+                    // Вложенное значение на отступе элементов - это следующий
+                    // элемент, а текущий не закрыт (так же режутся порции)
+                    return fail(m_pos, "Элемент не закрыт до начала следующего");
+                }
+                if (m_stack.size() >= m_layout.maxDepth) {
+                    return fail(m_pos, "Превышена максимальная глубина вложенности (" +
+                                       std::to_string(m_layout.maxDepth) + ")");
+                }
+                size_t openOffset = m_pos++;
+                skipWhitespace();
+
+                // Пустой контейнер сразу становится готовым значением
+                if (m_pos < m_end && m_input[m_pos] == (isObject ? '}' : ']')) {
+                    value = isObject ? JsonValue(JsonObject()) : JsonValue(JsonArray());
+                    recordSpan(value, openOffset);
+                    ++m_pos;
+                    break;
+                }
+
+                m_stack.emplace_back();
+                m_stack.back().isObject = isObject;
+                m_stack.back().openOffset = openOffset;
+                if (isObject && !parseKey(m_stack.back())) {
+                    return false;
+                }
+                continue;
+            }
+            case '"': {
+                std::string text;
+                if (!readString(text)) return false;
+                value = JsonValue(std::move(text));
+                break;
+            }
+            case '-':
+            case '0': case '1': case '2': case '3': case '4':
+            case '5': case '6': case '7': case '8': case '9':
+                if (!readNumber(value)) return false;
+                break;
+            case '}':
+                return fail(m_pos, "Неожиданная закрывающая скобка '}'");
+            case ']':
+                return fail(m_pos, "Неожиданная закрывающая скобка ']'");
+            case ',':
+                return fail(m_pos, "Неожиданная запятая");
+            case ':':
+                return fail(m_pos, "Неожиданное двоеточие");
+            default:
+                if (std::isalpha(static_cast<unsigned char>(c))) {
+                    if (!readKeyword(value)) return false;
+                    break;
+                }
+                return fail(m_pos, "Неожиданный символ: " + std::string(1, c));
+        }
+
+        // Значение готово: добавляем его в открытый контейнер
+        // и закрываем все контейнеры, которые на этом завершились
+        while (true) {
+            if (m_stack.empty()) {
+                out = std::move(value);
+                return true;
+            }
+
+            Frame& frame = m_stack.back();
+            if (frame.isObject) {
+                frame.object[std::move(frame.key)] = std::move(value);
+            } else {
+                frame.array.push_back(std::move(value));
+            }
+
+            char closing = frame.isObject ? '}' : ']';
+            skipWhitespace();
+            if (m_pos >= m_end) return failAtEnd();
+
+            if (m_input[m_pos] == ',') {
+                ++m_pos;
+                skipWhitespace();
+                if (m_pos < m_end && m_input[m_pos] == closing) {
+                    return fail(m_pos, "Запятая перед закрывающей скобкой не допускается");
+                }
+                if (frame.isObject && !parseKey(frame)) {
+                    return false;
+                }
+                break; // Следующий элемент
+            }
+
+            if (m_input[m_pos] != closing) {
+                return fail(m_pos, frame.isObject ? "Ожидалась ',' или '}'" : "Ожидалась ',' или ']'");
+            }
+            value = frame.isObject ? JsonValue(std::move(frame.object))
+                                   : JsonValue(std::move(frame.array));
+            recordSpan(value, frame.openOffset);
+            ++m_pos;
+            m_stack.pop_back();
+        }
+    }
+}
+
+bool ChunkParser::parseKey(Frame& frame) {
+    skipWhitespace();
+    if (m_pos >= m_end) return failAtEnd();
+    if (m_input[m_pos] != '"') {
+        return fail(m_pos, "Ожидался ключ (строка) в объекте");
+    }
+    if (!readString(frame.key)) return false;
+
+    skipWhitespace();
+    if (m_pos >= m_end) return failAtEnd();
+    if (m_input[m_pos] != ':') {
+        return fail(m_pos, "Ожидалось ':' после ключа");
+    }
+    ++m_pos;
+    return true;
+}
+
+bool ChunkParser::readString(std::string& out) {
+    // При ошибке m_pos остаётся на открывающей кавычке: пропуск начнётся с неё
+    const char* data = m_input.data();
+    const char* end = data + m_end;
+    const char* run = data + m_pos + 1;
+    const char* p = findStringSpecial(run, end);
+
+    out.clear();
+    while (true) {
+        out.append(run, static_cast<size_t>(p - run));
+        if (p >= end) {
+            return fail(m_pos, "Незакрытая строка");
+        }
+        if (*p == '"') break;
+        if (*p != '\\') {
+            return fail(static_cast<size_t>(p - data), "Управляющий символ в строке не допускается");
+        }
+        if (!readEscape(p, out)) return false;
+        run = p;
+        p = findStringSpecial(run, end);
+    }
+
+    size_t close = static_cast<size_t>(p - data);
+    if (m_badUtf8 < close) {
+        return fail(m_badUtf8, "Некорректная последовательность UTF-8");
+    }
+    m_pos = close + 1;
+    return true;
+}
+
+bool ChunkParser::readEscape(const char*& p, std::string& out) {
+    // p указывает на '\'
+    const char* data = m_input.data();
+    const char* end = data + m_end;
+    size_t at = static_cast<size_t>(p - data);
+    if (end - p < 2) {
+        return fail(at, "Неожиданный конец строки после escape-символа");
+    }
+
+    char escape = p[1];
+    p += 2;
+    switch (escape) {
+        case '"':  out += '"';  return true;
+        case '\\': out += '\\'; return true;
+        case '/':  out += '/';  return true;
+        case 'b':  out += '\b'; return true;
+        case 'f':  out += '\f'; return true;
+        case 'n':  out += '\n'; return true;
+        case 'r':  out += '\r'; return true;
+        case 't':  out += '\t'; return true;
+        case 'u':  break;
+        default:
+            return fail(at, "Неизвестная escape-последовательность: \\" + std::string(1, escape));
+    }
+
+    auto readHex4 = [&](char32_t& value) {
+        if (end - p < 4) return false;
+        value = 0;
+        for (int i = 0; i < 4; ++i) {
+            int digit = hexDigit(p[i]);
+            if (digit < 0) return false;
+            value = (value << 4) | static_cast<char32_t>(digit);
+        }
+        p += 4;
+        return true;
+    };
+
+    char32_t codePoint;
+    if (!readHex4(codePoint)) {
+        return fail(static_cast<size_t>(p - data), "Ожидалось 4 шестнадцатеричных цифры в unicode escape");
+    }
+    if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+        if (end - p < 2 || p[0] != '\\' || p[1] != 'u') {
+            return fail(static_cast<size_t>(p - data), "Ожидался low surrogate после high surrogate");
+        }
+        p += 2;
+        char32_t low;
+        if (!readHex4(low)) {
+            return fail(static_cast<size_t>(p - data), "Ожидалось 4 шестнадцатеричных цифры в unicode escape");
+        }
+        if (low < 0xDC00 || low > 0xDFFF) {
+            return fail(static_cast<size_t>(p - data), "Неверный low surrogate в unicode escape");
+        }
+        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+    }
+    appendUTF8(out, codePoint);
+    return true;
+}
+
+bool ChunkParser::readNumber(JsonValue& out) {
+    size_t start = m_pos;
+    size_t pos = m_pos;
+
+    if (m_input[pos] == '-') ++pos;
+
+    if (pos < m_end && m_input[pos] == '0') {
+        ++pos;
+    } else if (pos < m_end && isDigit(m_input[pos])) {
+        while (pos < m_end && isDigit(m_input[pos])) ++pos;
+    } else {
+        return fail(pos, "Ожидалась цифра в числе");
+    }
+
+    if (pos < m_end && m_input[pos] == '.') {
+        ++pos;
+        if (pos >= m_end || !isDigit(m_input[pos])) {
+            return fail(pos, "Ожидалась цифра после точки");
+        }
+        while (pos < m_end && isDigit(m_input[pos])) ++pos;
+    }
+
+    if (pos < m_end && (m_input[pos] == 'e' || m_input[pos] == 'E')) {
+        ++pos;
+        if (pos < m_end && (m_input[pos] == '+' || m_input[pos] == '-')) ++pos;
+        if (pos >= m_end || !isDigit(m_input[pos])) {
+            return fail(pos, "Ожидалась цифра в экспоненте");
+        }
+        while (pos < m_end && isDigit(m_input[pos])) ++pos;
+    }
+
+    double value = 0.0;
+    auto result = std::from_chars(m_input.data() + start, m_input.data() + pos, value);
+    if (result.ec == std::errc::result_out_of_range) {
+        return fail(start, "Число вне диапазона: " + std::string(m_input.substr(start, pos - start)));
+    }
+    m_pos = pos;
+    out = JsonValue(value);
+    return true;
+}
+
+bool ChunkParser::readKeyword(JsonValue& out) {
+    size_t start = m_pos;
+    size_t pos = m_pos;
+    while (pos < m_end && std::isalpha(static_cast<unsigned char>(m_input[pos]))) ++pos;
+
+    std::string_view word = m_input.substr(start, pos - start);
+    if (word == "true") {
+        out = JsonValue(true);
+    } else if (word == "false") {
+        out = JsonValue(false);
+    } else if (word == "null") {
+        out = JsonValue(nullptr);
+    } else {
+        return fail(start, "Неизвестное ключевое слово: " + std::string(word));
+    }
+    m_pos = pos;
+    return true;
+}
+
+void ChunkParser::recordSpan(const JsonValue& container, size_t openOffset) const {
+    // m_pos - закрывающая скобка контейнера
+    if (m_layout.spanSource == 0) return;
+    SourceSpan span;
+    span.source = m_layout.spanSource;
+    span.offset = openOffset;
+    span.length = m_pos + 1 - openOffset;
+    container.setSourceSpan(span);
+}
+
+void ChunkParser::synchronize() {
+    // Открытые контейнеры ошибочного элемента становятся ожидаемыми
+    // закрывающими скобками; дальше разбор идёт только по структуре
+    m_closers.clear();
+    for (const Frame& frame : m_stack) {
+        m_closers.push_back(frame.isObject ? '}' : ']');
+    }
+    m_stack.clear();
+
+    bool inString = false;
+    bool escaped = false;
+    while (m_pos < m_end) {
+        char c = m_input[m_pos];
+
+        if (inString) {
+            if (escaped) {
+                escaped = false;
+            } else if (c == '\\') {
+                escaped = true;
+            } else if (c == '"') {
+                inString = false;
+            } else if (c == '\n') {
+                // Незакрытая строка: дальше снова структура
+                inString = false;
+            }
+            ++m_pos;
+            continue;
+        }
+
+        if (c == '"') {
+            inString = true;
+        } else if (c == '{' || c == '[') {
+            if (m_pos > m_elementStart && m_layout.isElementLine(m_pos)) {
+                break;              // Начало следующего элемента
+            }
+            m_closers.push_back(c == '{' ? '}' : ']');
+        } else if (c == '}' || c == ']') {
+            // Закрываем всё до парной скобки; непарная пропускается
+            auto match = std::find(m_closers.rbegin(), m_closers.rend(), c);
+            if (match != m_closers.rend()) {
+                m_closers.erase(std::prev(match.base()), m_closers.end());
+            } else if (m_closers.empty() && c == ']' && m_layout.isArray) {
+                break;              // Конец массива верхнего уровня
+            }
+        } else if (c == ',' && m_closers.empty()) {
+            break;
+        }
+        ++m_pos;
+    }
+
+    if (m_badUtf8 < m_pos) {
+        findBadUtf8();
+    }
+}
+
+// Начала порций: первая подходящая строка не раньше каждого chunkSize-го байта
+std::vector<size_t> chunkStarts(const Layout& layout, size_t begin, size_t chunkSize) {
+    std::vector<size_t> starts{begin};
+    std::string_view input = layout.input;
+    if (layout.indent == NO_INDENT) return starts;
+
+    size_t target = begin + chunkSize;
+    while (target < input.size()) {
+        const char* newline = static_cast<const char*>(
+            std::memchr(input.data() + target, '\n', input.size() - target));
+        if (!newline) break;
+        size_t lineEnd = static_cast<size_t>(newline - input.data());
+        size_t next = lineEnd + 1 + layout.indent;
+        target = lineEnd + 1;
+        if (next >= input.size() || !layout.isElementLine(next)) continue;
+
+        // Перед строкой - запятая между элементами (для массива)
+        size_t prev = lineEnd;
+        while (prev > begin && isSpace(input[prev - 1])) --prev;
+        if (prev <= starts.back()) continue;
+        if (layout.isArray && input[prev - 1] != ',') continue;
+
+        starts.push_back(next);
+        target = next + chunkSize;
+    }
+    return starts;
+}
+
+// Пересчёт смещений ошибок в строку, столбец и контекст (один проход)
+void resolveErrors(std::string_view input, std::vector<PendingError>& pending,
+                   std::vector<ValidationError>& out) {
+    std::stable_sort(pending.begin(), pending.end(),
+                     [](const PendingError& a, const PendingError& b) { return a.offset < b.offset; });
+
+    size_t line = 1;
+    size_t lineStart = 0;
+    out.reserve(out.size() + pending.size());
+    for (PendingError& error : pending) {
+        size_t offset = std::min(error.offset, input.size());
+        while (const void* newline = std::memchr(input.data() + lineStart, '\n', offset - lineStart)) {
+            ++line;
+            lineStart = static_cast<size_t>(static_cast<const char*>(newline) - input.data()) + 1;
+        }
+
+        const void* lineEnd = std::memchr(input.data() + lineStart, '\n', input.size() - lineStart);
+        size_t lineLength = lineEnd ? static_cast<size_t>(static_cast<const char*>(lineEnd) - input.data()) - lineStart
+                                    : input.size() - lineStart;
+        std::string context(input.substr(lineStart, std::min(lineLength, CONTEXT_LENGTH)));
+        if (lineLength > CONTEXT_LENGTH) {
+            context += "...";
+        }
+        out.emplace_back(line, offset - lineStart + 1, std::move(error.message), std::move(context));
+    }
+}
+
+} // namespace
+
+TolerantParser::TolerantParser(unsigned int threadCount)
+    : m_chunkSize(DEFAULT_CHUNK_SIZE), m_maxDepth(Parser::DEFAULT_MAX_DEPTH), m_spanSource(0),
+      m_keepElements(true) {
+    if (threadCount == 0) {
+        m_threadCount = std::thread::hardware_concurrency();
+        if (m_threadCount == 0) m_threadCount = 1;
+    } else {
+        m_threadCount = threadCount;
+    }
+}
+
+void TolerantParser::setThreadCount(unsigned int count) {
+    m_threadCount = count > 0 ? count : 1;
+}
+
+TolerantResult TolerantParser::parse(std::string_view content, ParseStats* stats) const {
+    return parseOn(content, nullptr, stats);
+}
+
+TolerantResult TolerantParser::parse(std::string_view content, ForkJoinPool& pool, ParseStats* stats) const {
+    return parseOn(content, &pool, stats);
+}
+
+TolerantResult TolerantParser::parseOn(std::string_view content, ForkJoinPool* pool, ParseStats* stats) const {
+    JSON_TRACE_SCOPE("TolerantParser::parse");
+    StageTimer totalTimer(stats ? &stats->total : nullptr);
+    TolerantResult result;
+
+    Layout layout;
+    layout.input = content;
+    layout.maxDepth = m_maxDepth;
+    layout.spanSource = m_spanSource;
+    layout.keepElements = m_keepElements;
+
+    size_t first = 0;
+    while (first < content.size() && isSpace(content[first])) ++first;
+    if (first == content.size()) {
+        result.errors.emplace_back(1, 1, "Пустой JSON", "");
+        return result;
+    }
+
+    // Массив или последовательность значений; отступ элементов - по первому
+    size_t begin = 0;
+    size_t element = first;
+    if (content[first] == '[') {
+        layout.isArray = true;
+        result.isArray = true;
+        begin = first + 1;
+        element = begin;
+        while (element < content.size() && isSpace(content[element])) ++element;
+    }
+    size_t lineStart = element;
+    while (lineStart > 0 && (content[lineStart - 1] == ' ' || content[lineStart - 1] == '\t')) --lineStart;
+    if (lineStart == 0 || content[lineStart - 1] == '\n') {
+        layout.indent = element - lineStart;
+    }
+
+    StageTimer scanTimer(stats ? &stats->boundaryScan : nullptr);
+    std::vector<size_t> starts = chunkStarts(layout, begin, m_chunkSize);
+    starts.push_back(content.size());
+    scanTimer.stop();
+    size_t chunkCount = starts.size() - 1;
+    result.chunkCount = chunkCount;
+
+    // Каждая порция пишет только в свой элемент
+    struct ChunkOutput {
+        JsonArray elements;
+        std::vector<PendingError> errors;
+        size_t valid = 0;
+        size_t skipped = 0;
+        StageTiming parse;
+    };
+    std::vector<ChunkOutput> outputs(chunkCount);
+    std::atomic<size_t> nextChunk{0};
+    std::mutex progressMutex;
+    size_t bytesDone = 0;
+    std::exception_ptr workerError;
+
+    auto worker = [&](WorkerStats* workerStats) {
+        while (true) {
+            size_t index = nextChunk.fetch_add(1);
+            if (index >= chunkCount) return;
+
+            ChunkOutput& output = outputs[index];
+            try {
+                JSON_TRACE_SCOPE("tolerant chunk");
+                StageTimer timer(&output.parse);
+                ChunkParser chunk(layout, starts[index], starts[index + 1]);
+                chunk.run(index + 1 == chunkCount);
+                output.elements = std::move(chunk.elements);
+                output.errors = std::move(chunk.errors);
+                output.valid = chunk.valid;
+                output.skipped = chunk.skipped;
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(progressMutex);
+                if (!workerError) workerError = std::current_exception();
+                nextChunk = chunkCount;
+                return;
+            }
+
+            size_t chunkBytes = starts[index + 1] - starts[index];
+            if (workerStats) {
+                workerStats->chunks++;
+                workerStats->bytes += chunkBytes;
+                workerStats->busyMs += output.parse.wallMs;
+                workerStats->cpuMs += output.parse.cpuMs;
+            }
+            if (m_progressCallback) {
+                std::lock_guard<std::mutex> lock(progressMutex);
+                bytesDone += chunkBytes;
+                m_progressCallback(bytesDone, content.size());
+            }
+        }
+    };
+
+    size_t threadCount = pool ? pool->workerCount() + 1 : m_threadCount;
+    size_t workerCount = std::min<size_t>(threadCount, chunkCount);
+    std::vector<WorkerStats> workerStats(stats ? workerCount : 0);
+    auto phaseStart = std::chrono::steady_clock::now();
+    if (pool) {
+        // Задачи пула разбирают порции вместе с вызывающим потоком; worker
+        // не выпускает исключений, так что wait() дойдёт всегда
+        JSON_TRACE_SCOPE("parse chunks");
+        ForkJoinPool::Group group;
+        for (size_t i = 1; i < workerCount; ++i) {
+            pool->spawn(group, [&, i]() {
+                worker(stats ? &workerStats[i] : nullptr);
+            });
+        }
+        worker(stats ? &workerStats[0] : nullptr);
+        pool->wait(group);
+    } else {
+        JSON_TRACE_SCOPE("parse chunks");
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < workerCount; ++i) {
+            threads.emplace_back([&, i]() {
+                JSON_TRACE_THREAD_NAME("tolerant worker " + std::to_string(i));
+                worker(stats ? &workerStats[i] : nullptr);
+            });
+        }
+        // Вызывающий поток разбирает порции наравне с остальными
+        worker(stats ? &workerStats[0] : nullptr);
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+    if (workerError) {
+        std::rethrow_exception(workerError);
+    }
+
+    // Сборка: элементы и ошибки в порядке порций
+    StageTimer mergeTimer(stats ? &stats->merge : nullptr);
+    size_t total = 0;
+    for (const ChunkOutput& output : outputs) {
+        total += output.elements.size();
+    }
+    result.elements.reserve(total);
+    std::vector<PendingError> pending;
+    for (ChunkOutput& output : outputs) {
+        std::move(output.elements.begin(), output.elements.end(), std::back_inserter(result.elements));
+        std::move(output.errors.begin(), output.errors.end(), std::back_inserter(pending));
+        result.elementCount += output.valid;
+        result.skippedElements += output.skipped;
+    }
+    resolveErrors(content, pending, result.errors);
+    mergeTimer.stop();
+
+    if (stats) {
+        double phaseMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - phaseStart).count();
+        stats->parallelPhaseMs += phaseMs;
+        for (size_t i = 0; i < workerCount; ++i) {
+            workerStats[i].workerId = i;
+            workerStats[i].idleMs = std::max(0.0, phaseMs - workerStats[i].busyMs);
+            stats->workers.push_back(workerStats[i]);
+        }
+        for (size_t i = 0; i < chunkCount; ++i) {
+            stats->parse.add(outputs[i].parse);
+            stats->chunkSizes.push_back(starts[i + 1] - starts[i]);
+        }
+        stats->bytes += content.size();
+        stats->elements += result.elementCount;
+    }
+
+    return result;
+}
+
+TolerantResult TolerantParser::parseFile(const std::string& filename, ParseStats* stats) const {
+    StageTiming readTiming;
+    StageTimer readTimer(stats ? &readTiming : nullptr);
+    MappedFile file;
+    if (!file.open(filename)) {
+        // Пустой файл не отображается, но открывается
+        if (std::ifstream(filename).is_open()) {
+            return parse(std::string_view(), stats);
+        }
+        throw JsonException("Не удалось открыть файл: " + filename);
+    }
+    std::string_view content(file.data(), file.size());
+
+    // Сжатый файл распаковывается целиком. Участки указывали бы в
+    // распакованный текст, а не в файл, поэтому не записываются
+    std::string unpacked;
+    const TolerantParser* parser = this;
+    TolerantParser plain(*this);
+    if (detectCompression(content) != Compression::None) {
+        unpacked = InputStream::open(filename, m_threadCount)->readAll();
+        content = unpacked;
+        plain.m_spanSource = 0;
+        parser = &plain;
+    }
+    readTimer.stop();
+
+    TolerantResult result = parser->parse(content, stats);
+
+    // Отображение (и распаковка) входит и в общее время
+    if (stats) {
+        stats->read.add(readTiming);
+        stats->total.wallMs += readTiming.wallMs;
+        stats->total.cpuMs += readTiming.cpuMs;
+    }
+    return result;
+}
+
+} // namespace json
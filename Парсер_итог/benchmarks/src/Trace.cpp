@@ -0,0 +1,199 @@
+#include "Trace.hpp"
+#include "JsonWriter.hpp"
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace json {
+namespace trace {
+
+namespace {
+
+struct Event {
+    const char* name;
+    double startUs;
+    double durationUs;
+};
+
+// Буфер событий одного потока. Пишет в него только владелец, поэтому
+// мьютекс не конкурирует; он нужен лишь для чтения при записи файла.
+struct ThreadBuffer {
+    std::mutex mutex;
+    std::vector<Event> events;
+    std::string name;
+    size_t id = 0;
+    bool exited = false;    // Поток завершился; буфер ждёт записи файла
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    size_t nextId = 1;
+    std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+// Буфер потока создаётся при первом событии. При завершении потока
+// буфер без событий уходит из реестра сразу, с событиями - при следующем
+// start(), так что рабочие потоки без трассировки реестр не растят.
+struct ThreadSlot {
+    std::shared_ptr<ThreadBuffer> buffer;
+    std::string pendingName;    // Имя, заданное до первого события
+
+    ~ThreadSlot() {
+        if (!buffer) return;
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->exited = true;
+        if (buffer->events.empty()) {
+            reg.buffers.erase(std::find(reg.buffers.begin(), reg.buffers.end(), buffer));
+        }
+    }
+};
+
+ThreadSlot& threadSlot() {
+    thread_local ThreadSlot slot;
+    return slot;
+}
+
+ThreadBuffer& threadBuffer() {
+    ThreadSlot& slot = threadSlot();
+    if (!slot.buffer) {
+        auto created = std::make_shared<ThreadBuffer>();
+        created->name = std::move(slot.pendingName);
+        created->events.reserve(1024);
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        created->id = reg.nextId++;
+        reg.buffers.push_back(created);
+        slot.buffer = std::move(created);
+    }
+    return *slot.buffer;
+}
+
+} // namespace
+
+namespace detail {
+
+std::atomic<bool> g_enabled{false};
+
+double nowMicros() {
+    return std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - registry().epoch).count();
+}
+
+void record(const char* name, double startUs, double endUs) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.events.push_back({name, startUs, endUs - startUs});
+}
+
+} // namespace detail
+
+void start() {
+    Registry& reg = registry();
+    {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        // Буферы завершённых потоков нужны были только для прошлого файла
+        reg.buffers.erase(std::remove_if(reg.buffers.begin(), reg.buffers.end(),
+                                         [](const std::shared_ptr<ThreadBuffer>& buffer) {
+                                             std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+                                             return buffer->exited;
+                                         }),
+                          reg.buffers.end());
+        for (auto& buffer : reg.buffers) {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            buffer->events.clear();
+        }
+    }
+    detail::g_enabled.store(true, std::memory_order_relaxed);
+}
+
+void stop() {
+    detail::g_enabled.store(false, std::memory_order_relaxed);
+}
+
+void setThreadName(const std::string& name) {
+    ThreadSlot& slot = threadSlot();
+    if (!slot.buffer) {
+        slot.pendingName = name;
+        return;
+    }
+    std::lock_guard<std::mutex> lock(slot.buffer->mutex);
+    slot.buffer->name = name;
+}
+
+size_t threadBufferCount() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    return reg.buffers.size();
+}
+
+size_t eventCount() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    size_t count = 0;
+    for (auto& buffer : reg.buffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        count += buffer->events.size();
+    }
+    return count;
+}
+
+bool writeChromeTrace(const std::string& filename) {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    {
+        JsonWriter writer(file, JsonWriter::Options::compact());
+        writer.beginObject();
+        writer.key("displayTimeUnit").value("ms");
+        writer.key("traceEvents").beginArray();
+
+        for (auto& buffer : reg.buffers) {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+
+            if (!buffer->name.empty()) {
+                writer.beginObject()
+                      .key("name").value("thread_name")
+                      .key("ph").value("M")
+                      .key("pid").value(1)
+                      .key("tid").value(buffer->id)
+                      .key("args").beginObject().key("name").value(buffer->name).endObject()
+                      .endObject();
+            }
+
+            // Полные события ("X"): начало и длительность в микросекундах
+            for (const Event& e : buffer->events) {
+                writer.beginObject()
+                      .key("name").value(e.name)
+                      .key("ph").value("X")
+                      .key("ts").value(e.startUs)
+                      .key("dur").value(e.durationUs)
+                      .key("pid").value(1)
+                      .key("tid").value(buffer->id)
+                      .endObject();
+            }
+        }
+
+        writer.endArray();
+        writer.endObject();
+    }
+
+    return file.good();
+}
+
+} // namespace trace
+} // namespace json
@@ -0,0 +1,103 @@
+#include "TreeVisitor.hpp"
+#include "DocumentCache.hpp"
+
+namespace json {
+
+// ==================== TreeVisitor ====================
+
+TreeVisitor::TreeVisitor(unsigned int threads, size_t grainSize)
+    : m_threadCount(threads), m_grainSize(grainSize > 0 ? grainSize : 1) {
+    if (m_threadCount == 0) {
+        m_threadCount = std::thread::hardware_concurrency();
+        if (m_threadCount == 0) m_threadCount = 1;
+    }
+    if (m_threadCount > 1) {
+        m_pool = std::make_unique<ForkJoinPool>(m_threadCount - 1);
+    }
+}
+
+TreeVisitor::~TreeVisitor() = default;
+
+// ==================== TreeStats ====================
+
+void TreeStats::merge(const TreeStats& other) {
+    objects += other.objects;
+    arrays += other.arrays;
+    strings += other.strings;
+    numbers += other.numbers;
+    bools += other.bools;
+    nulls += other.nulls;
+    keys += other.keys;
+    stringBytes += other.stringBytes;
+    maxDepth = std::max(maxDepth, other.maxDepth);
+}
+
+TreeStats TreeStats::collect(const JsonValue& root, const TreeVisitor& visitor) {
+    return visitor.reduce<TreeStats>(root, [](TreeStats& stats, const JsonValue& value, size_t depth) {
+        stats.maxDepth = std::max(stats.maxDepth, depth);
+        switch (value.type()) {
+            case JsonValue::Type::Null:
+                stats.nulls++;
+                break;
+            case JsonValue::Type::Bool:
+                stats.bools++;
+                break;
+            case JsonValue::Type::Number:
+            case JsonValue::Type::RawNumber:
+                stats.numbers++;
+                break;
+            case JsonValue::Type::String:
+                stats.strings++;
+                stats.stringBytes += value.asString().size();
+                break;
+            case JsonValue::Type::Array:
+                stats.arrays++;
+                break;
+            case JsonValue::Type::Object: {
+                const JsonObject& obj = value.asObject();
+                stats.objects++;
+                stats.keys += obj.size();
+                for (const auto& [key, _] : obj) {
+                    stats.stringBytes += key.size();
+                }
+                break;
+            }
+        }
+    });
+}
+
+TreeStats TreeStats::collect(const CachedValue& root) {
+    TreeStats stats;
+    std::vector<std::pair<CachedValue, size_t>> pending{{root, 0}};
+    while (!pending.empty()) {
+        auto [value, depth] = pending.back();
+        pending.pop_back();
+        stats.maxDepth = std::max(stats.maxDepth, depth);
+
+        if (value.isNull()) {
+            stats.nulls++;
+        } else if (value.isBool()) {
+            stats.bools++;
+        } else if (value.isNumber()) {
+            stats.numbers++;
+        } else if (value.isString()) {
+            stats.strings++;
+            stats.stringBytes += value.asString().size();
+        } else if (value.isArray()) {
+            stats.arrays++;
+            for (size_t i = value.size(); i-- > 0;) {
+                pending.emplace_back(value[i], depth + 1);
+            }
+        } else {
+            stats.objects++;
+            stats.keys += value.size();
+            for (size_t i = value.size(); i-- > 0;) {
+                stats.stringBytes += value.keyAt(i).size();
+                pending.emplace_back(value.valueAt(i), depth + 1);
+            }
+        }
+    }
+    return stats;
+}
+
+} // namespace json
@@ -0,0 +1,312 @@
+#include "TypedJson.hpp"
+#include "Parser.hpp"
+#include "InputStream.hpp"
+#include <fstream>
+
+namespace json {
+
+namespace {
+
+int hexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+void appendUTF8(std::string& out, char32_t cp) {
+    if (cp <= 0x7F) {
+        out += static_cast<char>(cp);
+    } else if (cp <= 0x7FF) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp <= 0xFFFF) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+} // namespace
+
+void TypedReader::fail(const std::string& message) const {
+    // Строка и столбец вычисляются только при ошибке
+    size_t line = 1;
+    size_t column = 1;
+    size_t end = std::min(m_pos, m_input.size());
+    for (size_t i = 0; i < end; ++i) {
+        if (m_input[i] == '\n') {
+            ++line;
+            column = 1;
+        } else {
+            ++column;
+        }
+    }
+    throw ParserException(message, line, column);
+}
+
+void TypedReader::expect(char c) {
+    if (!consume(c)) {
+        char found = peek();
+        fail(std::string("Ожидался '") + c + "', получено " +
+             (found ? "'" + std::string(1, found) + "'" : std::string("конец данных")));
+    }
+}
+
+void TypedReader::readEscaped(std::string& out) {
+    // m_pos указывает на символ после '\'
+    if (m_pos >= m_input.size()) {
+        fail("Неожиданный конец строки после escape-символа");
+    }
+
+    char c = m_input[m_pos++];
+    switch (c) {
+        case '"':  out += '"';  return;
+        case '\\': out += '\\'; return;
+        case '/':  out += '/';  return;
+        case 'b':  out += '\b'; return;
+        case 'f':  out += '\f'; return;
+        case 'n':  out += '\n'; return;
+        case 'r':  out += '\r'; return;
+        case 't':  out += '\t'; return;
+        case 'u':  break;
+        default:
+            --m_pos;
+            fail(std::string("Неизвестная escape-последовательность: \\") + c);
+    }
+
+    auto readHex4 = [this]() {
+        if (m_input.size() - m_pos < 4) {
+            fail("Ожидалось 4 шестнадцатеричных цифры в unicode escape");
+        }
+        char32_t value = 0;
+        for (int i = 0; i < 4; ++i) {
+            int digit = hexDigit(m_input[m_pos + i]);
+            if (digit < 0) {
+                fail("Ожидалось 4 шестнадцатеричных цифры в unicode escape");
+            }
+            value = (value << 4) | static_cast<char32_t>(digit);
+        }
+        m_pos += 4;
+        return value;
+    };
+
+    char32_t codePoint = readHex4();
+    if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+        if (m_input.size() - m_pos < 2 || m_input[m_pos] != '\\' || m_input[m_pos + 1] != 'u') {
+            fail("Ожидался low surrogate после high surrogate");
+        }
+        m_pos += 2;
+        char32_t low = readHex4();
+        if (low < 0xDC00 || low > 0xDFFF) {
+            fail("Неверный low surrogate в unicode escape");
+        }
+        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+    }
+    appendUTF8(out, codePoint);
+}
+
+void TypedReader::readString(std::string& out) {
+    if (peek() != '"') {
+        fail("Ожидалась строка");
+    }
+    ++m_pos;
+    out.clear();
+
+    while (true) {
+        // Копируем участки без спецсимволов целиком
+        size_t start = m_pos;
+        while (m_pos < m_input.size()) {
+            unsigned char c = static_cast<unsigned char>(m_input[m_pos]);
+            if (c == '"' || c == '\\' || c < 0x20) break;
+            ++m_pos;
+        }
+        out.append(m_input.data() + start, m_pos - start);
+
+        if (m_pos >= m_input.size()) {
+            fail("Незакрытая строка");
+        }
+
+        char c = m_input[m_pos++];
+        if (c == '"') return;
+        if (c == '\\') {
+            readEscaped(out);
+        } else {
+            --m_pos;
+            fail("Управляющий символ в строке не допускается");
+        }
+    }
+}
+
+std::string_view TypedReader::readKey(std::string& scratch) {
+    if (peek() != '"') {
+        fail("Ожидался ключ объекта");
+    }
+
+    // Быстрый путь: ключ без escape-последовательностей
+    size_t start = m_pos + 1;
+    size_t pos = start;
+    while (pos < m_input.size()) {
+        unsigned char c = static_cast<unsigned char>(m_input[pos]);
+        if (c == '"') {
+            m_pos = pos + 1;
+            return m_input.substr(start, pos - start);
+        }
+        if (c == '\\' || c < 0x20) break;
+        ++pos;
+    }
+
+    readString(scratch);
+    return scratch;
+}
+
+std::string_view TypedReader::readNumberToken() {
+    skipWhitespace();
+    size_t start = m_pos;
+    size_t pos = m_pos;
+    size_t size = m_input.size();
+
+    if (pos < size && m_input[pos] == '-') ++pos;
+
+    if (pos < size && m_input[pos] == '0') {
+        ++pos;
+    } else if (pos < size && isDigit(m_input[pos])) {
+        while (pos < size && isDigit(m_input[pos])) ++pos;
+    } else {
+        m_pos = pos;
+        fail("Ожидалось число");
+    }
+
+    if (pos < size && m_input[pos] == '.') {
+        ++pos;
+        if (pos >= size || !isDigit(m_input[pos])) {
+            m_pos = pos;
+            fail("Ожидалась цифра после десятичной точки");
+        }
+        while (pos < size && isDigit(m_input[pos])) ++pos;
+    }
+
+    if (pos < size && (m_input[pos] == 'e' || m_input[pos] == 'E')) {
+        ++pos;
+        if (pos < size && (m_input[pos] == '+' || m_input[pos] == '-')) ++pos;
+        if (pos >= size || !isDigit(m_input[pos])) {
+            m_pos = pos;
+            fail("Ожидалась цифра в экспоненте");
+        }
+        while (pos < size && isDigit(m_input[pos])) ++pos;
+    }
+
+    m_pos = pos;
+    return m_input.substr(start, pos - start);
+}
+
+double TypedReader::readDouble() {
+    std::string_view token = readNumberToken();
+    double value = 0.0;
+    auto result = std::from_chars(token.data(), token.data() + token.size(), value);
+    if (result.ec == std::errc::result_out_of_range) {
+        fail("Число вне диапазона: " + std::string(token));
+    }
+    return value;
+}
+
+void TypedReader::readLiteral(std::string_view literal) {
+    if (m_input.compare(m_pos, literal.size(), literal) != 0) {
+        fail("Неизвестное ключевое слово");
+    }
+    m_pos += literal.size();
+}
+
+bool TypedReader::readBool() {
+    char c = peek();
+    if (c == 't') {
+        readLiteral("true");
+        return true;
+    }
+    if (c == 'f') {
+        readLiteral("false");
+        return false;
+    }
+    fail("Ожидалось true или false");
+}
+
+bool TypedReader::readNull() {
+    if (peek() != 'n') return false;
+    readLiteral("null");
+    return true;
+}
+
+// Без рекурсии: открытые контейнеры хранятся в векторе, так что глубина
+// вложенности пропускаемого значения не ограничена стеком
+void TypedReader::skipValue() {
+    std::vector<char> closing;      // '}' или ']' открытых контейнеров
+    std::string scratch;
+    while (true) {
+        switch (peek()) {
+            case '"':
+                readString(scratch);
+                break;
+            case '{':
+                ++m_pos;
+                if (consume('}')) break;
+                closing.push_back('}');
+                readKey(scratch);
+                expect(':');
+                continue;
+            case '[':
+                ++m_pos;
+                if (consume(']')) break;
+                closing.push_back(']');
+                continue;
+            case 't':
+            case 'f':
+                readBool();
+                break;
+            case 'n':
+                readNull();
+                break;
+            default:
+                readNumberToken();
+                break;
+        }
+
+        // Значение прочитано: следующий элемент или закрытие контейнеров
+        while (!closing.empty() && !consume(',')) {
+            expect(closing.back());
+            closing.pop_back();
+        }
+        if (closing.empty()) return;
+        if (closing.back() == '}') {
+            readKey(scratch);
+            expect(':');
+        }
+    }
+}
+
+JsonValue TypedReader::readValue() {
+    skipWhitespace();
+    size_t start = m_pos;
+    skipValue();
+    return Parser::parseString(std::string(m_input.substr(start, m_pos - start)));
+}
+
+void TypedReader::finish() {
+    if (peek() != '\0' || m_pos < m_input.size()) {
+        fail("Неожиданные данные после значения");
+    }
+}
+
+std::string readFileContent(const std::string& filename) {
+    return InputStream::open(filename)->readAll();
+}
+
+} // namespace json
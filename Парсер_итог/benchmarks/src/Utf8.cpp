@@ -0,0 +1,254 @@
+#include "Utf8.hpp"
+#include <cstdint>
+#include <cstring>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define JSON_UTF8_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace json {
+namespace utf8 {
+
+size_t findInvalidScalar(const char* data, size_t size) {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(data);
+    size_t i = 0;
+
+    while (i < size) {
+        // ASCII по 8 байт
+        if (size - i >= 8) {
+            uint64_t word;
+            std::memcpy(&word, bytes + i, sizeof(word));
+            if ((word & 0x8080808080808080ULL) == 0) {
+                i += 8;
+                continue;
+            }
+        }
+
+        uint8_t lead = bytes[i];
+        if (lead < 0x80) {
+            ++i;
+            continue;
+        }
+
+        // Длина и допустимый диапазон второго байта (RFC 3629, таблица 3-7)
+        size_t length;
+        uint8_t low = 0x80;
+        uint8_t high = 0xBF;
+        if (lead >= 0xC2 && lead <= 0xDF) {
+            length = 2;
+        } else if (lead == 0xE0) {
+            length = 3;
+            low = 0xA0;                     // Избыточная форма
+        } else if (lead == 0xED) {
+            length = 3;
+            high = 0x9F;                    // Суррогаты U+D800..U+DFFF
+        } else if (lead >= 0xE1 && lead <= 0xEF) {
+            length = 3;
+        } else if (lead == 0xF0) {
+            length = 4;
+            low = 0x90;                     // Избыточная форма
+        } else if (lead >= 0xF1 && lead <= 0xF3) {
+            length = 4;
+        } else if (lead == 0xF4) {
+            length = 4;
+            high = 0x8F;                    // Больше U+10FFFF
+        } else {
+            return i;                       // Продолжение без начала, C0, C1, F5..FF
+        }
+
+        if (size - i < length || bytes[i + 1] < low || bytes[i + 1] > high) {
+            return i;
+        }
+        for (size_t k = 2; k < length; ++k) {
+            if ((bytes[i + k] & 0xC0) != 0x80) {
+                return i;
+            }
+        }
+        i += length;
+    }
+
+    return npos;
+}
+
+#ifdef JSON_UTF8_AVX2
+
+namespace {
+
+#define JSON_AVX2 __attribute__((target("avx2")))
+
+// Классы ошибок для таблиц по полубайтам
+constexpr uint8_t TOO_SHORT = 1 << 0;       // Начальный байт без продолжения
+constexpr uint8_t TOO_LONG = 1 << 1;        // Продолжение после ASCII
+constexpr uint8_t OVERLONG_3 = 1 << 2;
+constexpr uint8_t TOO_LARGE = 1 << 3;
+constexpr uint8_t SURROGATE = 1 << 4;
+constexpr uint8_t OVERLONG_2 = 1 << 5;
+constexpr uint8_t TOO_LARGE_1000 = 1 << 6;
+constexpr uint8_t OVERLONG_4 = 1 << 6;
+constexpr uint8_t TWO_CONTS = 1 << 7;       // Два продолжения подряд (если не 3/4 байт)
+constexpr uint8_t CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+#define JSON_TABLE16(...) _mm256_setr_epi8(__VA_ARGS__, __VA_ARGS__)
+
+struct Avx2State {
+    __m256i error;
+    __m256i prevInput;
+    __m256i prevIncomplete;
+};
+
+// Байты input, сдвинутые на N позиций назад с подстановкой хвоста prevInput
+template<int N>
+JSON_AVX2 inline __m256i previous(__m256i input, __m256i prevInput) {
+    return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prevInput, input, 0x21), 16 - N);
+}
+
+JSON_AVX2 inline __m256i lookup(__m256i table, __m256i nibbles) {
+    return _mm256_shuffle_epi8(table, nibbles);
+}
+
+// Ошибки, определяемые парой (предыдущий байт, текущий байт)
+JSON_AVX2 inline __m256i specialCases(__m256i input, __m256i prev1) {
+    const __m256i lowMask = _mm256_set1_epi8(0x0F);
+
+    const __m256i byte1High = lookup(JSON_TABLE16(
+        TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+        TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+        TOO_SHORT | OVERLONG_2,
+        TOO_SHORT,
+        TOO_SHORT | OVERLONG_3 | SURROGATE,
+        TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4),
+        _mm256_and_si256(_mm256_srli_epi16(prev1, 4), lowMask));
+
+    const __m256i byte1Low = lookup(JSON_TABLE16(
+        CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+        CARRY | OVERLONG_2,
+        CARRY,
+        CARRY,
+        CARRY | TOO_LARGE,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000),
+        _mm256_and_si256(prev1, lowMask));
+
+    const __m256i byte2High = lookup(JSON_TABLE16(
+        TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+        static_cast<char>(TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4),
+        static_cast<char>(TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE),
+        static_cast<char>(TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE),
+        static_cast<char>(TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE),
+        TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT),
+        _mm256_and_si256(_mm256_srli_epi16(input, 4), lowMask));
+
+    return _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+}
+
+// Третий и четвёртый байты обязаны быть продолжениями; TWO_CONTS в них - не ошибка
+JSON_AVX2 inline __m256i multibyteLengths(__m256i input, __m256i prevInput, __m256i special) {
+    __m256i prev2 = previous<2>(input, prevInput);
+    __m256i prev3 = previous<3>(input, prevInput);
+    __m256i isThird = _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+    __m256i isFourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    __m256i must23 = _mm256_and_si256(_mm256_or_si256(isThird, isFourth),
+                                      _mm256_set1_epi8(static_cast<char>(0x80)));
+    return _mm256_xor_si256(must23, special);
+}
+
+// Ненулевые байты - последовательность, начатая в конце блока, не завершена
+JSON_AVX2 inline __m256i incompleteTail(__m256i input) {
+    const __m256i maxValue = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+    return _mm256_subs_epu8(input, maxValue);
+}
+
+JSON_AVX2 inline void checkBlock(Avx2State& state, __m256i input) {
+    if (_mm256_movemask_epi8(input) == 0) {
+        state.error = _mm256_or_si256(state.error, state.prevIncomplete);
+        state.prevIncomplete = _mm256_setzero_si256();
+    } else {
+        __m256i prev1 = previous<1>(input, state.prevInput);
+        __m256i special = specialCases(input, prev1);
+        state.error = _mm256_or_si256(state.error, multibyteLengths(input, state.prevInput, special));
+        state.prevIncomplete = incompleteTail(input);
+    }
+    state.prevInput = input;
+}
+
+JSON_AVX2 bool validateAvx2(const char* data, size_t size) {
+    Avx2State state;
+    state.error = _mm256_setzero_si256();
+    state.prevInput = _mm256_setzero_si256();
+    state.prevIncomplete = _mm256_setzero_si256();
+
+    size_t pos = 0;
+    for (; pos + 64 <= size; pos += 64) {
+        __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+        __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos + 32));
+
+        // Чистый ASCII - самый частый случай: одна проверка на 64 байта
+        if (_mm256_movemask_epi8(_mm256_or_si256(first, second)) == 0) {
+            state.error = _mm256_or_si256(state.error, state.prevIncomplete);
+            state.prevIncomplete = _mm256_setzero_si256();
+            state.prevInput = second;
+            continue;
+        }
+
+        checkBlock(state, first);
+        checkBlock(state, second);
+    }
+
+    // Хвост дополняется нулями (ASCII)
+    if (pos < size) {
+        alignas(32) char tail[64] = {};
+        std::memcpy(tail, data + pos, size - pos);
+        checkBlock(state, _mm256_load_si256(reinterpret_cast<const __m256i*>(tail)));
+        if (size - pos > 32) {
+            checkBlock(state, _mm256_load_si256(reinterpret_cast<const __m256i*>(tail + 32)));
+        }
+    }
+
+    state.error = _mm256_or_si256(state.error, state.prevIncomplete);
+    return _mm256_testz_si256(state.error, state.error) != 0;
+}
+
+#undef JSON_TABLE16
+#undef JSON_AVX2
+
+} // namespace
+
+bool hasSimd() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+size_t findInvalid(const char* data, size_t size) {
+    if (hasSimd() && validateAvx2(data, size)) {
+        return npos;
+    }
+    return findInvalidScalar(data, size);
+}
+
+#else
+
+bool hasSimd() {
+    return false;
+}
+
+size_t findInvalid(const char* data, size_t size) {
+    return findInvalidScalar(data, size);
+}
+
+#endif
+
+} // namespace utf8
+} // namespace json
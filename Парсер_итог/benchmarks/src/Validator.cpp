@@ -1,4 +1,7 @@
 #include "Validator.hpp"
+#include "Parser.hpp"
+#include "InputStream.hpp"
+#include "Trace.hpp"
 #include <fstream>
 #include <sstream>
 #include <algorithm>
@@ -6,7 +9,7 @@
 namespace json {
 
 Validator::Validator(bool stopOnFirstError)
-    : m_current(0), m_stopOnFirstError(stopOnFirstError) {}
+    : m_current(0), m_stopOnFirstError(stopOnFirstError), m_depth(0), m_maxDepth(Parser::DEFAULT_MAX_DEPTH) {}
 
 const Token& Validator::current() const {
     return m_tokens[m_current];
@@ -88,6 +91,23 @@ void Validator::synchronize() {
     }
 }
 
+void Validator::skipNested() {
+    // Пропуск контейнера целиком со всем содержимым (без рекурсии)
+    size_t depth = 0;
+    while (!isAtEnd()) {
+        TokenType t = current().type;
+        if (t == TokenType::LeftBrace || t == TokenType::LeftBracket) {
+            ++depth;
+        } else if (t == TokenType::RightBrace || t == TokenType::RightBracket) {
+            --depth;
+        }
+        advance();
+        if (depth == 0) {
+            return;
+        }
+    }
+}
+
 bool Validator::validateValue() {
     if (!m_result.isValid && m_stopOnFirstError) {
         return false;
@@ -95,10 +115,19 @@ bool Validator::validateValue() {
 
     switch (current().type) {
         case TokenType::LeftBrace:
-            return validateObject();
-
-        case TokenType::LeftBracket:
-            return validateArray();
+        case TokenType::LeftBracket: {
+            // Глубже лимита не спускаемся: стек вызовов остаётся ограниченным
+            if (m_depth >= m_maxDepth) {
+                addError("Превышена максимальная глубина вложенности (" +
+                        std::to_string(m_maxDepth) + ")");
+                skipNested();
+                return false;
+            }
+            ++m_depth;
+            bool ok = check(TokenType::LeftBrace) ? validateObject() : validateArray();
+            --m_depth;
+            return ok;
+        }
 
         case TokenType::String:
         case TokenType::Number:
@@ -291,9 +320,16 @@ bool Validator::validateArray() {
     return !hadError;
 }
 
-ValidationResult Validator::validate(const std::string& jsonStr) {
+ValidationResult Validator::validate(const std::string& jsonStr, ParseStats* stats) {
+    JSON_TRACE_SCOPE("Validator::validate");
+    StageTimer totalTimer(stats ? &stats->total : nullptr);
+    if (stats) {
+        stats->bytes += jsonStr.size();
+    }
+
     m_input = jsonStr;
     m_current = 0;
+    m_depth = 0;
     m_result = ValidationResult();
 
     // Подсчёт строк
@@ -301,9 +337,14 @@ ValidationResult Validator::validate(const std::string& jsonStr) {
 
     // Токенизация
     try {
+        JSON_TRACE_SCOPE("tokenize");
+        StageTimer timer(stats ? &stats->tokenize : nullptr);
         Lexer lexer(jsonStr);
         m_tokens = lexer.tokenize();
         m_result.tokenCount = m_tokens.size();
+        if (stats) {
+            stats->tokens += m_tokens.size();
+        }
     } catch (const LexerException& e) {
         m_result.isValid = false;
         m_result.errors.emplace_back(e.line, e.column, e.what(), extractContext(e.line));
@@ -317,28 +358,42 @@ ValidationResult Validator::validate(const std::string& jsonStr) {
     }
 
     // Валидация
+    JSON_TRACE_SCOPE("validate tokens");
+    StageTimer parseTimer(stats ? &stats->parse : nullptr);
     validateValue();
 
     // Проверка на лишние данные после JSON
     if (!isAtEnd()) {
         addError("Неожиданные данные после JSON");
     }
+    parseTimer.stop();
 
     return m_result;
 }
 
-ValidationResult Validator::validateFile(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
+ValidationResult Validator::validateFile(const std::string& filename, ParseStats* stats) {
+    StageTiming readTiming;
+    StageTimer readTimer(stats ? &readTiming : nullptr);
+
+    std::string content;
+    try {
+        content = InputStream::open(filename)->readAll();
+    } catch (const JsonException& e) {
         ValidationResult result;
         result.isValid = false;
-        result.errors.emplace_back(0, 0, "Не удалось открыть файл: " + filename, "");
+        result.errors.emplace_back(0, 0, e.what(), "");
         return result;
     }
+    readTimer.stop();
+
+    // Чтение входит и в общее время
+    if (stats) {
+        stats->read.add(readTiming);
+        stats->total.wallMs += readTiming.wallMs;
+        stats->total.cpuMs += readTiming.cpuMs;
+    }
 
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    return validate(buffer.str());
+    return validate(content, stats);
 }
 
 bool Validator::isValid(const std::string& jsonStr) {
@@ -2,11 +2,18 @@
 #include "Lexer.hpp"
 #include "Parser.hpp"
 #include "Serializer.hpp"
+#include "Cbor.hpp"
+#include "DocumentCache.hpp"
 #include "Generator.hpp"
 #include "Validator.hpp"
 #include "ParallelProcessor.hpp"
+#include "TreeVisitor.hpp"
+#include "TolerantParser.hpp"
+#include "BatchProcessor.hpp"
+#include "InputStream.hpp"
 #include "SystemInfo.hpp"
 #include "ProgressBar.hpp"
+#include "Trace.hpp"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -17,6 +24,11 @@
 #include <filesystem>
 #include <cctype>
 #include <atomic>
+#include <cstdlib>
+#include <deque>
+#include <algorithm>
+#include <utility>
+#include <string_view>
 
 namespace fs = std::filesystem;
 
@@ -44,21 +56,25 @@ struct StreamParseResult {
     size_t errorLine = 0;
 };
 
-struct TolerantParseResult {
-    JsonArray validElements;           // Успешно загруженные элементы
-    std::vector<std::string> errors;   // Список ошибок (строка + описание)
-    size_t totalLines = 0;
-    size_t successCount = 0;
-    size_t errorCount = 0;
-    int maxDepth = 0;
-};
-
 // Глобальные переменные для текущего состояния
 JsonValue g_currentJson;
 std::string g_currentFile;
 bool g_isModified = false;
 bool g_isStreamMode = false; // Флаг потокового режима
 
+// История правок: снимки документа до каждого изменения. Снимок разделяет
+// с документом все неизменённые поддеревья, поэтому стоит O(1) по памяти
+std::deque<JsonValue> g_undoHistory;
+const size_t UNDO_HISTORY_LIMIT = 100;
+
+// Исходный файл с участками контейнеров: сохранение копирует из него
+// неизменённые элементы (пустой, если документ загружен не из текста)
+SourceFile g_source;
+
+// Документ, открытый из кэша: просмотр, поиск и статистика читают его
+// напрямую, g_currentJson строится только перед первой правкой
+std::unique_ptr<CachedDocument> g_cached;
+
 // Папка для данных (относительно корня проекта)
 const std::string DATA_DIR = "data";
 const size_t STREAMING_THRESHOLD_BYTES = 256ULL * 1024 * 1024;
@@ -148,7 +164,8 @@ std::vector<std::pair<std::string, size_t>> getDataFiles() {
                         continue;
                     }
 
-                    if (ext.empty() || ext == ".json" || ext == ".JSON") {
+                    if (ext.empty() || ext == ".json" || ext == ".JSON" || ext == ".cbor" ||
+                        isCompressedExtension(ext)) {
                         files.emplace_back(filename, entry.file_size());
                     }
                 }
@@ -173,15 +190,21 @@ int getMenuChoice();
 std::string getInput(const std::string& prompt);
 std::string trimAscii(const std::string& input);
 StreamParseResult parseStreamFile(const std::string& filename);
-TolerantParseResult parseTolerantFile(const std::string& filename);
+TolerantResult parseTolerantFile(const std::string& filename, uint32_t sourceId = 0);
 
 void loadFile();
-void displayTree(const JsonValue& value, const std::string& prefix = "", bool isLast = true, int depth = 0, int maxDepth = 3, size_t maxItems = 20);
+template<typename Value>
+void displayTree(const Value& value, const std::string& prefix = "", bool isLast = true, int depth = 0, int maxDepth = 3, size_t maxItems = 20);
+template<typename Value>
+void printStructure(const Value& root);
+void materializeCached();
 void showStructure();
 void searchByPath();
 void editValue();
 void addElement();
 void removeElement();
+void undoLastChange();
+void pushUndoSnapshot(JsonValue snapshot);
 void saveFile();
 void validateJson();
 void showStatistics();
@@ -192,6 +215,7 @@ void showSystemInfo();
 void parallelParsing();
 void generateLargeFile();
 int calculateDepth(const JsonValue& value, int currentDepth = 0);
+const TreeVisitor& treeVisitor();
 
 // Очистка экрана (кроссплатформенно)
 void clearScreen() {
@@ -210,7 +234,7 @@ void printHeader() {
     clearScreen();
     printSeparator();
     std::cout << "               JSON PARSER - Курсовая работа                  \n";
-    std::cout << "              Парсер JSON на C++17 (std::variant)             \n";
+    std::cout << "              Парсер JSON на C++17 (узлы copy-on-write)       \n";
     printSeparator();
 
     if (!g_currentFile.empty()) {
@@ -241,6 +265,11 @@ void printMenu() {
     std::cout << "  [12] Информация о системе\n";
     std::cout << "  [13] Генератор больших файлов (ГБ)\n";
     std::cout << "  [14] Многопоточный парсинг файла\n";
+    std::cout << "  [15] Отменить последнее изменение";
+    if (!g_undoHistory.empty()) {
+        std::cout << " (" << g_undoHistory.size() << ")";
+    }
+    std::cout << "\n";
     std::cout << "  [0]  Выход\n";
     std::cout << "\n";
 }
@@ -387,89 +416,22 @@ StreamParseResult parseStreamFile(const std::string& filename) {
     return result;
 }
 
-// Толерантная загрузка файла - пропускает ошибочные строки и загружает валидные элементы
-TolerantParseResult parseTolerantFile(const std::string& filename) {
-    TolerantParseResult result;
-    std::ifstream file(filename, std::ios::binary);
-    if (!file.is_open()) {
-        result.errors.push_back("Строка 0: Не удалось открыть файл");
-        return result;
-    }
-
-    // Получаем размер файла для прогресс-бара
-    file.seekg(0, std::ios::end);
-    size_t fileSize = file.tellg();
-    file.seekg(0, std::ios::beg);
-
-    ProgressBar progressBar(fileSize, "Загрузка");
-
-    std::string line;
-    size_t fileLine = 0;
-    size_t bytesRead = 0;
-
-    while (std::getline(file, line)) {
-        fileLine++;
-        result.totalLines++;
-        bytesRead += line.size() + 1;
-
-        // Обновляем прогресс-бар каждые 1000 строк
-        if (fileLine % 1000 == 0) {
-            progressBar.update(bytesRead);
-        }
-
-        std::string trimmed = trimAscii(line);
-        if (trimmed.empty()) {
-            continue;
-        }
-
-        // Убираем trailing comma
-        if (!trimmed.empty() && trimmed.back() == ',') {
-            trimmed.pop_back();
-            trimmed = trimAscii(trimmed);
-        }
-
-        // Пропускаем структурные символы
-        if (trimmed == "[" || trimmed == "]" || trimmed == "{" || trimmed == "}") {
-            continue;
-        }
-
-        if (trimmed.empty()) {
-            continue;
-        }
-
-        try {
-            Lexer lexer(trimmed);
-            auto tokens = lexer.tokenize();
-
-            Parser parser(std::move(tokens));
-            JsonValue value = parser.parse();
-
-            // Успешно спарсили - добавляем в массив
-            result.validElements.push_back(std::move(value));
-            result.successCount++;
-
-            int depth = calculateDepth(result.validElements.back());
-            if (depth > result.maxDepth) {
-                result.maxDepth = depth;
-            }
-        } catch (const LexerException& e) {
-            // Записываем ошибку и продолжаем
-            result.errorCount++;
-            std::string errorMsg = "Строка " + std::to_string(fileLine) + " [LEXER]: " + e.what();
-            result.errors.push_back(errorMsg);
-        } catch (const ParserException& e) {
-            result.errorCount++;
-            std::string errorMsg = "Строка " + std::to_string(fileLine) + " [PARSER]: " + e.what();
-            result.errors.push_back(errorMsg);
-        } catch (const std::exception& e) {
-            result.errorCount++;
-            std::string errorMsg = "Строка " + std::to_string(fileLine) + " [ERROR]: " + e.what();
-            result.errors.push_back(errorMsg);
-        }
-    }
+// Толерантная загрузка файла - пропускает ошибочные элементы и загружает валидные.
+// Если sourceId задан, контейнеры запоминают свой участок в файле
+TolerantResult parseTolerantFile(const std::string& filename, uint32_t sourceId) {
+    TolerantParser parser;
+    parser.setSourceSpans(sourceId);
+
+    std::error_code ec;
+    size_t fileSize = static_cast<size_t>(fs::file_size(filename, ec));
+    ProgressBar progressBar(ec ? 0 : fileSize, "Загрузка");
+    // Для сжатого файла total - распакованный размер, шкала - размер файла
+    parser.setProgressCallback([&progressBar, fileSize](size_t current, size_t total) {
+        progressBar.update(total > 0 ? static_cast<size_t>(static_cast<double>(current) / total * fileSize) : current);
+    });
 
+    TolerantResult result = parser.parseFile(filename);
     progressBar.finish();
-
     return result;
 }
 
@@ -573,6 +535,68 @@ void loadFile() {
 
         std::cout << "\nРазмер файла: " << formatFileSizeShort(g_metrics.fileSize) << "\n";
 
+        // Двоичный CBOR: без лексера и разбора текста
+        if (CborReader::isCborFile(filename)) {
+            std::cout << "Формат: CBOR (двоичный)\n\nЗагрузка файла...\n";
+
+            auto startTime = std::chrono::high_resolution_clock::now();
+            g_currentJson = CborReader::parseFile(filename);
+            g_undoHistory.clear();
+            g_cached.reset();
+            g_source = SourceFile();
+            auto endTime = std::chrono::high_resolution_clock::now();
+            g_metrics.parseTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+            g_metrics.maxDepth = static_cast<int>(TreeStats::collect(g_currentJson, treeVisitor()).maxDepth);
+            g_metrics.tokenCount = 0;
+            g_currentFile = filename;
+            g_isStreamMode = false;
+            g_isModified = false;
+
+            std::cout << "\n";
+            printSeparator();
+            std::cout << "[OK] Файл загружен!\n";
+            printSeparator();
+            std::cout << "Тип корня: " << g_currentJson.typeName() << "\n";
+            std::cout << "Время загрузки: " << std::fixed << std::setprecision(3) << (g_metrics.parseTimeMs / 1000.0) << " сек\n";
+            std::cout << "Максимальная глубина: " << g_metrics.maxDepth << "\n";
+            printSeparator();
+
+            pressEnterToContinue();
+            return;
+        }
+
+        // Кэш разобранного документа: повторная загрузка без разбора текста
+        DocumentCache cache((fs::path(getDataPath()) / ".cache").string());
+        auto cacheStart = std::chrono::high_resolution_clock::now();
+        if (auto cached = cache.open(filename)) {
+            auto mapEnd = std::chrono::high_resolution_clock::now();
+            g_cached = std::move(cached);
+            g_currentJson = JsonValue();
+            g_undoHistory.clear();
+            g_source = SourceFile();
+
+            g_metrics.parseTimeMs = std::chrono::duration<double, std::milli>(mapEnd - cacheStart).count();
+            g_metrics.maxDepth = static_cast<int>(TreeStats::collect(g_cached->root()).maxDepth);
+            g_currentFile = filename;
+            g_isStreamMode = false;
+            g_isModified = false;
+
+            std::cout << "\n";
+            printSeparator();
+            std::cout << "[OK] Файл загружен из кэша!\n";
+            printSeparator();
+            std::cout << "Файл кэша: " << cache.cachePathFor(filename)
+                      << " (" << formatFileSizeShort(g_cached->sizeBytes()) << ")\n";
+            std::cout << "Отображение кэша: " << std::fixed << std::setprecision(3) << g_metrics.parseTimeMs << " мс\n";
+            std::cout << "Максимальная глубина: " << g_metrics.maxDepth << "\n";
+            printSeparator();
+            std::cout << "[i] Дерево документа строится при первой правке.\n";
+
+            pressEnterToContinue();
+            return;
+        }
+
         // КРИТИЧЕСКИЙ ПОРОГ: файлы > 500 МБ - только валидация без загрузки
         const size_t CRITICAL_SIZE = 500ULL * 1024 * 1024; // 500 МБ
 
@@ -612,6 +636,7 @@ void loadFile() {
                     // Сохраняем информацию о файле
                     g_currentFile = filename;
                     g_isStreamMode = true;
+                    g_cached.reset();
                     g_metrics.maxDepth = streamResult.maxDepth;
                     g_metrics.tokenCount = streamResult.tokenCount;
 
@@ -634,7 +659,7 @@ void loadFile() {
             }
             // choice == 2: продолжаем загрузку (опасно!)
             std::cout << "\n[!] Попытка загрузить " << formatFileSizeShort(g_metrics.fileSize) << " в память...\n";
-            std::cout << "    РЕЖИМ: Толерантная загрузка (пропускает ошибочные строки)\n";
+            std::cout << "    РЕЖИМ: Толерантная загрузка (пропускает ошибочные элементы)\n";
         }
 
         std::cout << "\nЗагрузка файла...\n\n";
@@ -643,17 +668,22 @@ void loadFile() {
         auto startTime = std::chrono::high_resolution_clock::now();
 
         // Используем толерантную загрузку для больших файлов
-        TolerantParseResult tolerantResult = parseTolerantFile(filename);
+        SourceFile source = SourceFile::capture(filename);
+        TolerantResult tolerantResult = parseTolerantFile(filename, source.id);
 
         auto endTime = std::chrono::high_resolution_clock::now();
         g_metrics.parseTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
 
         // Создаем JSON из валидных элементов
-        g_currentJson = JsonValue(std::move(tolerantResult.validElements));
+        size_t loadedCount = tolerantResult.elements.size();
+        g_currentJson = JsonValue(std::move(tolerantResult.elements));
+        g_undoHistory.clear();
+        g_cached.reset();
+        g_source = source;
 
         // Вычисляем глубину
         std::cout << "\nАнализ структуры...\n";
-        g_metrics.maxDepth = tolerantResult.maxDepth;
+        g_metrics.maxDepth = static_cast<int>(TreeStats::collect(g_currentJson, treeVisitor()).maxDepth);
 
         // Подсчитываем токены (приблизительно)
         g_metrics.tokenCount = g_metrics.fileSize / 10; // Примерная оценка
@@ -665,24 +695,35 @@ void loadFile() {
         printSeparator();
         std::cout << "[OK] Файл загружен!\n";
         printSeparator();
-        std::cout << "Успешно загружено элементов: " << tolerantResult.successCount << "\n";
-        std::cout << "Ошибок при парсинге: " << tolerantResult.errorCount << "\n";
-        std::cout << "Всего строк обработано: " << tolerantResult.totalLines << "\n";
+        std::cout << "Успешно загружено элементов: " << loadedCount << "\n";
+        std::cout << "Пропущено элементов: " << tolerantResult.skippedElements << "\n";
+        std::cout << "Ошибок при парсинге: " << tolerantResult.errors.size() << "\n";
+        std::cout << "Порций (параллельно): " << tolerantResult.chunkCount << "\n";
         std::cout << "Время загрузки: " << std::fixed << std::setprecision(3) << (g_metrics.parseTimeMs / 1000.0) << " сек\n";
         std::cout << "Максимальная глубина: " << g_metrics.maxDepth << "\n";
         printSeparator();
 
         // Показываем первые ошибки (максимум 10)
-        if (tolerantResult.errorCount > 0) {
+        if (!tolerantResult.errors.empty()) {
             std::cout << "\n[!] ОБНАРУЖЕНЫ ОШИБКИ:\n\n";
             size_t showErrors = std::min(size_t(10), tolerantResult.errors.size());
             for (size_t i = 0; i < showErrors; ++i) {
-                std::cout << "  " << tolerantResult.errors[i] << "\n";
+                const ValidationError& error = tolerantResult.errors[i];
+                std::cout << "  Строка " << error.line << ", столбец " << error.column
+                          << ": " << error.message << "\n";
+                if (!error.context.empty()) {
+                    std::cout << "    > " << error.context << "\n";
+                }
             }
             if (tolerantResult.errors.size() > 10) {
                 std::cout << "  ... и ещё " << (tolerantResult.errors.size() - 10) << " ошибок\n";
             }
-            std::cout << "\n[i] Ошибочные строки пропущены, валидные элементы загружены.\n";
+            std::cout << "\n[i] Ошибочные элементы пропущены, валидные элементы загружены.\n";
+        }
+
+        // Сохраняем разобранный документ для следующих загрузок
+        if (tolerantResult.errors.empty() && cache.store(filename, g_currentJson)) {
+            std::cout << "\n[i] Документ сохранён в кэш: " << cache.cachePathFor(filename) << "\n";
         }
 
     } catch (const LexerException& e) {
@@ -698,8 +739,26 @@ void loadFile() {
     pressEnterToContinue();
 }
 
+// Перебор полей объекта до первого false от fn: у JsonValue это
+// std::map, у документа из кэша - пары по индексу
+template<typename Fn>
+void forEachField(const JsonValue& value, Fn fn) {
+    for (const auto& [key, val] : value.asObject()) {
+        if (!fn(std::string_view(key), val)) break;
+    }
+}
+
+template<typename Fn>
+void forEachField(const CachedValue& value, Fn fn) {
+    for (size_t i = 0; i < value.size(); ++i) {
+        if (!fn(value.keyAt(i), value.valueAt(i))) break;
+    }
+}
+
 // Рекурсивный вывод дерева с ОГРАНИЧЕНИЯМИ (КРИТИЧНО для больших файлов!)
-void displayTree(const JsonValue& value, const std::string& prefix, bool isLast, int depth, int maxDepth, size_t maxItems) {
+// Value - JsonValue или CachedValue
+template<typename Value>
+void displayTree(const Value& value, const std::string& prefix, bool isLast, int depth, int maxDepth, size_t maxItems) {
     // ОГРАНИЧЕНИЕ ПО ГЛУБИНЕ - предотвращает бесконечный вывод
     if (depth >= maxDepth) {
         std::cout << prefix << "... (достигнут лимит глубины " << maxDepth << ")\n";
@@ -707,15 +766,13 @@ void displayTree(const JsonValue& value, const std::string& prefix, bool isLast,
     }
 
     if (value.isObject()) {
-        const auto& obj = value.asObject();
-
         // ОГРАНИЧЕНИЕ ПО КОЛИЧЕСТВУ КЛЮЧЕЙ
-        size_t limit = std::min(maxItems, obj.size());
-        bool truncated = obj.size() > maxItems;
+        size_t limit = std::min(maxItems, value.size());
+        bool truncated = value.size() > maxItems;
 
         size_t count = 0;
-        for (const auto& [key, val] : obj) {
-            if (count >= limit) break;
+        forEachField(value, [&](std::string_view key, const Value& val) {
+            if (count >= limit) return false;
 
             bool last = (count == limit - 1) && !truncated;
 
@@ -734,7 +791,7 @@ void displayTree(const JsonValue& value, const std::string& prefix, bool isLast,
                 }
             } else {
                 if (val.isString()) {
-                    std::string str = val.asString();
+                    std::string str(val.asString());
                     if (str.length() > 80) str = str.substr(0, 77) + "...";
                     std::cout << "\"" << str << "\"";
                 } else if (val.isNumber()) {
@@ -747,21 +804,20 @@ void displayTree(const JsonValue& value, const std::string& prefix, bool isLast,
                 std::cout << "\n";
             }
             count++;
-        }
+            return true;
+        });
 
         if (truncated) {
-            std::cout << prefix << "└── ... (ещё " << (obj.size() - limit) << " ключей)\n";
+            std::cout << prefix << "└── ... (ещё " << (value.size() - limit) << " ключей)\n";
         }
     } else if (value.isArray()) {
-        const auto& arr = value.asArray();
-
         // ОГРАНИЧЕНИЕ ПО КОЛИЧЕСТВУ ЭЛЕМЕНТОВ МАССИВА
-        size_t limit = std::min(maxItems, arr.size());
-        bool truncated = arr.size() > maxItems;
+        size_t limit = std::min(maxItems, value.size());
+        bool truncated = value.size() > maxItems;
 
         for (size_t i = 0; i < limit; ++i) {
             bool last = (i == limit - 1) && !truncated;
-            const JsonValue& val = arr[i];
+            decltype(auto) val = value[i];
 
             std::cout << prefix << (last ? "└── " : "├── ");
             std::cout << "[" << i << "]: ";
@@ -778,7 +834,7 @@ void displayTree(const JsonValue& value, const std::string& prefix, bool isLast,
                 }
             } else {
                 if (val.isString()) {
-                    std::string str = val.asString();
+                    std::string str(val.asString());
                     if (str.length() > 80) str = str.substr(0, 77) + "...";
                     std::cout << "\"" << str << "\"";
                 } else if (val.isNumber()) {
@@ -793,11 +849,69 @@ void displayTree(const JsonValue& value, const std::string& prefix, bool isLast,
         }
 
         if (truncated) {
-            std::cout << prefix << "└── ... (ещё " << (arr.size() - limit) << " элементов)\n";
+            std::cout << prefix << "└── ... (ещё " << (value.size() - limit) << " элементов)\n";
         }
     }
 }
 
+template<typename Value>
+void printStructure(const Value& root) {
+    // Для больших файлов предлагаем варианты
+    if (g_metrics.fileSize > 10 * 1024 * 1024) { // > 10 МБ
+        std::cout << "Файл большой (" << formatFileSizeShort(g_metrics.fileSize) << ").\n\n";
+        std::cout << "Варианты отображения:\n";
+        std::cout << "  [1] Первые 3 уровня вложенности (быстро)\n";
+        std::cout << "  [2] Первые 5 уровней вложенности (средне)\n";
+        std::cout << "  [3] Полная структура (может быть медленно!)\n";
+        std::cout << "  [4] Только корневой уровень\n";
+        std::cout << "\nВыбор: ";
+
+        int choice;
+        std::cin >> choice;
+
+        std::cout << "\nФормирование структуры...\n\n";
+
+        if (choice == 1) {
+            displayTree(root, "", true, 0, 3, 20);  // 3 уровня, 20 элементов
+            std::cout << "\n[Показаны первые 3 уровня, макс. 20 элементов на уровень]\n";
+        } else if (choice == 2) {
+            displayTree(root, "", true, 0, 5, 15);  // 5 уровней, 15 элементов
+            std::cout << "\n[Показаны первые 5 уровней, макс. 15 элементов на уровень]\n";
+        } else if (choice == 4) {
+            // Только корневой уровень
+            if (root.isObject()) {
+                std::cout << "Объект с ключами:\n";
+                forEachField(root, [](std::string_view key, const Value& val) {
+                    std::cout << "  • " << key << " : " << val.typeName() << "\n";
+                    return true;
+                });
+            } else if (root.isArray()) {
+                std::cout << "Массив [" << root.size() << " элементов]\n";
+                std::cout << "Типы элементов:\n";
+                size_t limit = std::min(size_t(10), root.size());
+                for (size_t i = 0; i < limit; ++i) {
+                    std::cout << "  [" << i << "] : " << root[i].typeName() << "\n";
+                }
+                if (root.size() > 10) {
+                    std::cout << "  ... и ещё " << (root.size() - 10) << " элементов\n";
+                }
+            } else {
+                std::cout << "Корневой тип: " << root.typeName() << "\n";
+            }
+        } else {
+            // "Полная" структура - всё равно ограничиваем!
+            std::cout << "[!] ВНИМАНИЕ: Для файлов > 10 МБ показываем ограниченную структуру\n";
+            std::cout << "    (макс. 10 уровней, 50 элементов на уровень)\n\n";
+
+            displayTree(root, "", true, 0, 10, 50);  // 10 уровней, 50 элементов
+            std::cout << "\n[Показано: макс. 10 уровней вложенности, 50 элементов на уровень]\n";
+        }
+    } else {
+        // Для маленьких файлов показываем дерево (ограниченное)
+        displayTree(root, "", true, 0, 20, 100);  // 20 уровней, 100 элементов
+    }
+}
+
 void showStructure() {
     printHeader();
     std::cout << "\n=== Структура JSON (дерево) ===\n\n";
@@ -834,6 +948,9 @@ void showStructure() {
             g_currentJson = Parser::parseFileWithProgress(g_currentFile, [&](size_t current, size_t total) {
                 progressBar.update(current);
             });
+            g_undoHistory.clear();
+            g_cached.reset();
+            g_source = SourceFile();
 
             progressBar.finish();
 
@@ -851,59 +968,13 @@ void showStructure() {
         }
     }
 
-    // Для больших файлов предлагаем варианты
-    if (g_metrics.fileSize > 10 * 1024 * 1024) { // > 10 МБ
-        std::cout << "Файл большой (" << formatFileSizeShort(g_metrics.fileSize) << ").\n\n";
-        std::cout << "Варианты отображения:\n";
-        std::cout << "  [1] Первые 3 уровня вложенности (быстро)\n";
-        std::cout << "  [2] Первые 5 уровней вложенности (средне)\n";
-        std::cout << "  [3] Полная структура (может быть медленно!)\n";
-        std::cout << "  [4] Только корневой уровень\n";
-        std::cout << "\nВыбор: ";
-
-        int choice;
-        std::cin >> choice;
-
-        std::cout << "\nФормирование структуры...\n\n";
-
-        if (choice == 1) {
-            displayTree(g_currentJson, "", true, 0, 3, 20);  // 3 уровня, 20 элементов
-            std::cout << "\n[Показаны первые 3 уровня, макс. 20 элементов на уровень]\n";
-        } else if (choice == 2) {
-            displayTree(g_currentJson, "", true, 0, 5, 15);  // 5 уровней, 15 элементов
-            std::cout << "\n[Показаны первые 5 уровней, макс. 15 элементов на уровень]\n";
-        } else if (choice == 4) {
-            // Только корневой уровень
-            if (g_currentJson.isObject()) {
-                const auto& obj = g_currentJson.asObject();
-                std::cout << "Объект с ключами:\n";
-                for (const auto& [key, val] : obj) {
-                    std::cout << "  • " << key << " : " << val.typeName() << "\n";
-                }
-            } else if (g_currentJson.isArray()) {
-                std::cout << "Массив [" << g_currentJson.size() << " элементов]\n";
-                std::cout << "Типы элементов:\n";
-                size_t limit = std::min(size_t(10), g_currentJson.size());
-                for (size_t i = 0; i < limit; ++i) {
-                    std::cout << "  [" << i << "] : " << g_currentJson[i].typeName() << "\n";
-                }
-                if (g_currentJson.size() > 10) {
-                    std::cout << "  ... и ещё " << (g_currentJson.size() - 10) << " элементов\n";
-                }
-            } else {
-                std::cout << "Корневой тип: " << g_currentJson.typeName() << "\n";
-            }
-        } else {
-            // "Полная" структура - всё равно ограничиваем!
-            std::cout << "[!] ВНИМАНИЕ: Для файлов > 10 МБ показываем ограниченную структуру\n";
-            std::cout << "    (макс. 10 уровней, 50 элементов на уровень)\n\n";
-
-            displayTree(g_currentJson, "", true, 0, 10, 50);  // 10 уровней, 50 элементов
-            std::cout << "\n[Показано: макс. 10 уровней вложенности, 50 элементов на уровень]\n";
-        }
+    // Документ из кэша показывается без построения дерева. JsonValue
+    // читается через const: неконстантные asObject() и operator[]
+    // отделили бы копию общего документа
+    if (g_cached) {
+        printStructure(g_cached->root());
     } else {
-        // Для маленьких файлов показываем дерево (ограниченное)
-        displayTree(g_currentJson, "", true, 0, 20, 100);  // 20 уровней, 100 элементов
+        printStructure(std::as_const(g_currentJson));
     }
 
     pressEnterToContinue();
@@ -940,13 +1011,21 @@ void searchByPath() {
     }
 
     // Измеряем время поиска
+    // В документе из кэша ищется без построения дерева; в JsonValue для
+    // вывода превращается только найденное поддерево
     auto startTime = std::chrono::high_resolution_clock::now();
-    auto result = g_currentJson.findByPath(path);
+    std::optional<CachedValue> cachedResult;
+    std::optional<std::reference_wrapper<const JsonValue>> result;
+    if (g_cached) {
+        cachedResult = g_cached->root().findByPath(path);
+    } else {
+        result = std::as_const(g_currentJson).findByPath(path);
+    }
     auto endTime = std::chrono::high_resolution_clock::now();
     g_metrics.searchTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
 
-    if (result.has_value()) {
-        const JsonValue& found = result->get();
+    if (cachedResult.has_value() || result.has_value()) {
+        const JsonValue found = cachedResult ? cachedResult->toJsonValue() : result->get();
         std::cout << "\n[OK] Найдено! Тип: " << found.typeName() << "\n";
         std::cout << "Время поиска: " << std::fixed << std::setprecision(3) << g_metrics.searchTimeMs << " мс\n";
         std::cout << "Значение:\n";
@@ -975,8 +1054,11 @@ void editValue() {
         return;
     }
 
+    materializeCached();
     std::string path = getInput("Введите путь к элементу: ");
 
+    // Снимок до findByPath: неконстантный поиск отделяет путь от копий
+    JsonValue snapshot = g_currentJson;
     auto result = g_currentJson.findByPath(path);
 
     if (!result.has_value()) {
@@ -1007,6 +1089,7 @@ void editValue() {
             input = getInput("Введите строковое значение: ");
             target = JsonValue(input);
             g_isModified = true;
+            pushUndoSnapshot(std::move(snapshot));
             std::cout << "\n[OK] Значение изменено.\n";
             break;
 
@@ -1016,6 +1099,7 @@ void editValue() {
             std::cin >> num;
             target = JsonValue(num);
             g_isModified = true;
+            pushUndoSnapshot(std::move(snapshot));
             std::cout << "\n[OK] Значение изменено.\n";
             break;
         }
@@ -1024,12 +1108,14 @@ void editValue() {
             input = getInput("Введите true или false: ");
             target = JsonValue(input == "true");
             g_isModified = true;
+            pushUndoSnapshot(std::move(snapshot));
             std::cout << "\n[OK] Значение изменено.\n";
             break;
 
         case 4:
             target = JsonValue(nullptr);
             g_isModified = true;
+            pushUndoSnapshot(std::move(snapshot));
             std::cout << "\n[OK] Значение изменено на null.\n";
             break;
 
@@ -1038,6 +1124,7 @@ void editValue() {
             try {
                 target = Parser::parseString(input);
                 g_isModified = true;
+                pushUndoSnapshot(std::move(snapshot));
                 std::cout << "\n[OK] Значение изменено.\n";
             } catch (const std::exception& e) {
                 std::cout << "\n[ОШИБКА] Некорректный JSON: " << e.what() << "\n";
@@ -1068,8 +1155,11 @@ void addElement() {
         return;
     }
 
+    materializeCached();
     std::string path = getInput("Введите путь к родительскому объекту/массиву (или пусто для корня): ");
 
+    // Снимок до findByPath: неконстантный поиск отделяет путь от копий
+    JsonValue snapshot = g_currentJson;
     JsonValue* target = &g_currentJson;
     if (!path.empty()) {
         auto result = g_currentJson.findByPath(path);
@@ -1088,6 +1178,7 @@ void addElement() {
         try {
             (*target)[key] = Parser::parseString(value);
             g_isModified = true;
+            pushUndoSnapshot(std::move(snapshot));
             std::cout << "\n[OK] Элемент добавлен.\n";
         } catch (const std::exception& e) {
             std::cout << "\n[ОШИБКА] Некорректный JSON: " << e.what() << "\n";
@@ -1098,6 +1189,7 @@ void addElement() {
         try {
             target->push_back(Parser::parseString(value));
             g_isModified = true;
+            pushUndoSnapshot(std::move(snapshot));
             std::cout << "\n[OK] Элемент добавлен в массив.\n";
         } catch (const std::exception& e) {
             std::cout << "\n[ОШИБКА] Некорректный JSON: " << e.what() << "\n";
@@ -1125,8 +1217,11 @@ void removeElement() {
         return;
     }
 
+    materializeCached();
     std::string path = getInput("Введите путь к родительскому объекту/массиву: ");
 
+    // Снимок до findByPath: неконстантный поиск отделяет путь от копий
+    JsonValue snapshot = g_currentJson;
     JsonValue* target = &g_currentJson;
     if (!path.empty()) {
         auto result = g_currentJson.findByPath(path);
@@ -1142,6 +1237,7 @@ void removeElement() {
         std::string key = getInput("Введите ключ для удаления: ");
         if (target->erase(key)) {
             g_isModified = true;
+            pushUndoSnapshot(std::move(snapshot));
             std::cout << "\n[OK] Элемент удалён.\n";
         } else {
             std::cout << "\n[!] Ключ не найден: " << key << "\n";
@@ -1154,6 +1250,7 @@ void removeElement() {
         try {
             target->erase(index);
             g_isModified = true;
+            pushUndoSnapshot(std::move(snapshot));
             std::cout << "\n[OK] Элемент удалён.\n";
         } catch (const JsonException& e) {
             std::cout << "\n[!] " << e.what() << "\n";
@@ -1165,6 +1262,40 @@ void removeElement() {
     pressEnterToContinue();
 }
 
+// Построить дерево документа, открытого из кэша: нужно правкам,
+// сохранению и метрикам сериализации
+void materializeCached() {
+    if (!g_cached) return;
+    g_currentJson = g_cached->root().toJsonValue();
+    g_cached.reset();
+}
+
+void pushUndoSnapshot(JsonValue snapshot) {
+    if (g_undoHistory.size() >= UNDO_HISTORY_LIMIT) {
+        g_undoHistory.pop_front();
+    }
+    g_undoHistory.push_back(std::move(snapshot));
+}
+
+void undoLastChange() {
+    printHeader();
+    std::cout << "\n=== Отмена изменения ===\n\n";
+
+    if (g_undoHistory.empty()) {
+        std::cout << "[!] Нет изменений для отмены.\n";
+        pressEnterToContinue();
+        return;
+    }
+
+    g_currentJson = std::move(g_undoHistory.back());
+    g_undoHistory.pop_back();
+    g_isModified = true;
+
+    std::cout << "[OK] Последнее изменение отменено.\n";
+    std::cout << "Осталось в истории: " << g_undoHistory.size() << "\n";
+    pressEnterToContinue();
+}
+
 void saveFile() {
     printHeader();
     std::cout << "\n=== Сохранение в файл ===\n\n";
@@ -1192,12 +1323,14 @@ void saveFile() {
     std::cout << "\nФорматирование:\n";
     std::cout << "  [1] Красивый вывод (с отступами)\n";
     std::cout << "  [2] Компактный (без пробелов)\n";
+    std::cout << "  [3] CBOR (двоичный, быстрая повторная загрузка)\n";
     std::cout << "Выбор: ";
 
     int formatChoice;
     std::cin >> formatChoice;
 
     bool pretty = (formatChoice != 2);
+    bool binary = (formatChoice == 3);
 
     std::cout << "\nСохранение файла...\n\n";
 
@@ -1214,7 +1347,18 @@ void saveFile() {
         }
     });
 
-    bool success = Serializer::toFile(g_currentJson, filename, pretty);
+    materializeCached();
+
+    // Текст пишется инкрементально: неизменённые элементы копируются
+    // из исходного файла, сериализуются только правки
+    Serializer::IncrementalStats incremental;
+    bool success = false;
+    if (binary) {
+        success = CborWriter::toFile(g_currentJson, filename);
+    } else {
+        Serializer serializer(pretty ? Serializer::Options::pretty() : Serializer::Options::compact());
+        success = serializer.saveIncremental(g_currentJson, g_source, filename, &incremental);
+    }
 
     progressThread.join();
     progressBar.update(100);
@@ -1226,6 +1370,11 @@ void saveFile() {
     if (success) {
         std::cout << "\n[OK] Файл сохранён: " << filename << "\n";
         std::cout << "Время сохранения: " << std::fixed << std::setprecision(3) << (saveTimeMs / 1000.0) << " сек\n";
+        if (!binary) {
+            std::cout << "Скопировано из исходного файла: " << formatFileSizeShort(incremental.copiedBytes)
+                      << " (" << incremental.copiedSpans << " элементов)\n";
+            std::cout << "Сериализовано заново: " << formatFileSizeShort(incremental.serializedBytes) << "\n";
+        }
         g_isModified = false;
         g_currentFile = filename;
     } else {
@@ -1275,30 +1424,10 @@ void validateJson() {
     pressEnterToContinue();
 }
 
-// Рекурсивный подсчёт статистики
-void countElements(const JsonValue& value, int& objects, int& arrays,
-                   int& strings, int& numbers, int& bools, int& nulls, int& totalKeys) {
-    if (value.isObject()) {
-        objects++;
-        const auto& obj = value.asObject();
-        totalKeys += obj.size();
-        for (const auto& [_, v] : obj) {
-            countElements(v, objects, arrays, strings, numbers, bools, nulls, totalKeys);
-        }
-    } else if (value.isArray()) {
-        arrays++;
-        for (const auto& v : value.asArray()) {
-            countElements(v, objects, arrays, strings, numbers, bools, nulls, totalKeys);
-        }
-    } else if (value.isString()) {
-        strings++;
-    } else if (value.isNumber()) {
-        numbers++;
-    } else if (value.isBool()) {
-        bools++;
-    } else if (value.isNull()) {
-        nulls++;
-    }
+// Параллельный обход документа для статистики (пул создаётся один раз)
+const TreeVisitor& treeVisitor() {
+    static TreeVisitor visitor;
+    return visitor;
 }
 
 void showStatistics() {
@@ -1318,23 +1447,30 @@ void showStatistics() {
         return;
     }
 
-    int objects = 0, arrays = 0, strings = 0;
-    int numbers = 0, bools = 0, nulls = 0, totalKeys = 0;
-
-    countElements(g_currentJson, objects, arrays, strings, numbers, bools, nulls, totalKeys);
+    auto startTime = std::chrono::high_resolution_clock::now();
+    TreeStats stats = g_cached ? TreeStats::collect(g_cached->root())
+                               : TreeStats::collect(g_currentJson, treeVisitor());
+    auto endTime = std::chrono::high_resolution_clock::now();
+    double statsTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    unsigned int threads = g_cached ? 1 : treeVisitor().threadCount();
 
     std::cout << "Файл: " << g_currentFile << "\n\n";
     printSeparator();
     std::cout << std::left;
-    std::cout << std::setw(25) << "Объектов:" << objects << "\n";
-    std::cout << std::setw(25) << "Массивов:" << arrays << "\n";
-    std::cout << std::setw(25) << "Строк:" << strings << "\n";
-    std::cout << std::setw(25) << "Чисел:" << numbers << "\n";
-    std::cout << std::setw(25) << "Булевых значений:" << bools << "\n";
-    std::cout << std::setw(25) << "Null значений:" << nulls << "\n";
+    std::cout << std::setw(25) << "Объектов:" << stats.objects << "\n";
+    std::cout << std::setw(25) << "Массивов:" << stats.arrays << "\n";
+    std::cout << std::setw(25) << "Строк:" << stats.strings << "\n";
+    std::cout << std::setw(25) << "Чисел:" << stats.numbers << "\n";
+    std::cout << std::setw(25) << "Булевых значений:" << stats.bools << "\n";
+    std::cout << std::setw(25) << "Null значений:" << stats.nulls << "\n";
     printSeparator();
-    std::cout << std::setw(25) << "Всего ключей:" << totalKeys << "\n";
-    std::cout << std::setw(25) << "Всего элементов:" << (objects + arrays + strings + numbers + bools + nulls) << "\n";
+    std::cout << std::setw(25) << "Всего ключей:" << stats.keys << "\n";
+    std::cout << std::setw(25) << "Всего элементов:" << stats.total() << "\n";
+    std::cout << std::setw(25) << "Текст строк и ключей:" << formatFileSizeShort(stats.stringBytes) << "\n";
+    std::cout << std::setw(25) << "Максимальная глубина:" << stats.maxDepth << "\n";
+    printSeparator();
+    std::cout << std::setw(25) << "Время анализа:" << std::fixed << std::setprecision(3) << statsTimeMs
+              << " мс (потоков: " << threads << ")\n";
     printSeparator();
 
     pressEnterToContinue();
@@ -1377,6 +1513,9 @@ void showPerformanceMetrics() {
         return;
     }
 
+    // Для сериализации нужно дерево
+    materializeCached();
+
     // Измеряем время сериализации
     auto startTime = std::chrono::high_resolution_clock::now();
     std::string serialized = Serializer::toString(g_currentJson, true);
@@ -1384,10 +1523,11 @@ void showPerformanceMetrics() {
     g_metrics.serializeTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
 
     // Подсчёт элементов для дополнительной статистики
-    int objects = 0, arrays = 0, strings = 0;
-    int numbers = 0, bools = 0, nulls = 0, totalKeys = 0;
-    countElements(g_currentJson, objects, arrays, strings, numbers, bools, nulls, totalKeys);
-    int totalElements = objects + arrays + strings + numbers + bools + nulls;
+    startTime = std::chrono::high_resolution_clock::now();
+    TreeStats stats = TreeStats::collect(g_currentJson, treeVisitor());
+    endTime = std::chrono::high_resolution_clock::now();
+    double statsTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    g_metrics.maxDepth = static_cast<int>(stats.maxDepth);
 
     std::cout << "Файл: " << g_currentFile << "\n\n";
 
@@ -1398,6 +1538,8 @@ void showPerformanceMetrics() {
     std::cout << std::setw(30) << "Время парсинга:" << g_metrics.parseTimeMs << " мс\n";
     std::cout << std::setw(30) << "Время сериализации:" << g_metrics.serializeTimeMs << " мс\n";
     std::cout << std::setw(30) << "Последний поиск:" << g_metrics.searchTimeMs << " мс\n";
+    std::cout << std::setw(30) << "Обход дерева:" << statsTimeMs << " мс ("
+              << treeVisitor().threadCount() << " потоков)\n";
 
     printSeparator();
     std::cout << "                    МЕТРИКИ ДАННЫХ                           \n";
@@ -1405,7 +1547,7 @@ void showPerformanceMetrics() {
     std::cout << std::setw(30) << "Размер файла:" << formatFileSize(g_metrics.fileSize) << "\n";
     std::cout << std::setw(30) << "Размер после сериализации:" << formatFileSize(serialized.size()) << "\n";
     std::cout << std::setw(30) << "Количество токенов:" << g_metrics.tokenCount << "\n";
-    std::cout << std::setw(30) << "Всего элементов:" << totalElements << "\n";
+    std::cout << std::setw(30) << "Всего элементов:" << stats.total() << "\n";
     std::cout << std::setw(30) << "Максимальная глубина:" << g_metrics.maxDepth << "\n";
 
     printSeparator();
@@ -1612,6 +1754,9 @@ void validateWithErrors() {
         if (answer == "да" || answer == "yes" || answer == "y") {
             try {
                 g_currentJson = Parser::parseFile(input);
+                g_undoHistory.clear();
+                g_cached.reset();
+                g_source = SourceFile();
                 g_currentFile = input;
                 g_isModified = false;
                 std::cout << "[OK] Файл загружен!\n";
@@ -1793,6 +1938,9 @@ void parallelValidation() {
     std::cout << std::setw(30) << "Пропускная способность:" << std::fixed << std::setprecision(2)
               << result.throughputMBps << " МБ/с\n";
 
+    printSeparator();
+    std::cout << result.stats.toString();
+
     // Показываем первые 10 ошибок
     if (!result.errors.empty()) {
         printSeparator();
@@ -1911,6 +2059,15 @@ void generateLargeFile() {
         errorProb = 0;
     }
 
+    std::cout << "Seed (0 - случайный) [0]: ";
+    unsigned long long seed;
+    std::cin >> seed;
+    if (std::cin.fail()) {
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        seed = 0;
+    }
+
     std::string filename = getInputAfterCin("\nИмя файла (сохраняется в data/): ");
     if (filename.empty()) {
         filename = "large_" + std::to_string(targetSizeMB) + "mb.json";
@@ -1928,6 +2085,7 @@ void generateLargeFile() {
     std::cout << "Потоков: " << threadCount << "\n\n";
 
     ParallelGenerator generator(threadCount);
+    generator.setSeed(seed);
 
     auto startTime = std::chrono::high_resolution_clock::now();
 
@@ -1971,6 +2129,8 @@ void generateLargeFile() {
                   << std::fixed << std::setprecision(2)
                   << ((actualSize / (1024.0 * 1024.0)) / (genTimeMs / 1000.0)) << " МБ/с\n";
 
+        std::cout << std::setw(30) << "Seed:" << generator.getLastSeed() << "\n";
+
         if (errorProb > 0) {
             std::cout << std::setw(30) << "Ошибки:" << "добавлены (" << errorProb << "% вероятность)\n";
         }
@@ -2074,10 +2234,11 @@ void parallelParsing() {
         ProgressBar progressBar(fileSize, "Парсинг");
         auto start = std::chrono::high_resolution_clock::now();
 
+        ParseStats stats;
         JsonValue result = Parser::parseFileParallel(filename, threadCount,
             [&](size_t current, size_t total) {
                 progressBar.update(current);
-            });
+            }, &stats);
 
         progressBar.finish();
         auto end = std::chrono::high_resolution_clock::now();
@@ -2103,11 +2264,16 @@ void parallelParsing() {
             std::cout << std::setw(30) << "Тип JSON:" << "Объект\n";
         }
 
+        printSeparator();
+        std::cout << stats.toString();
         printSeparator();
 
         std::string loadChoice = getInput("\nЗагрузить этот файл в редактор? (да/нет): ");
         if (loadChoice == "да" || loadChoice == "yes" || loadChoice == "y") {
             g_currentJson = std::move(result);
+            g_undoHistory.clear();
+            g_cached.reset();
+            g_source = SourceFile();
             g_currentFile = filename;
             g_isModified = false;
             std::cout << "[OK] Файл загружен в редактор.\n";
@@ -2120,7 +2286,178 @@ void parallelParsing() {
     pressEnterToContinue();
 }
 
-int main() {
+// ==================== Пакетный режим (без меню) ====================
+
+void printBatchUsage(const char* program) {
+    std::cout << "Использование:\n"
+              << "  " << program << "                       интерактивное меню\n"
+              << "  " << program << " [опции] <файл|каталог>...  пакетная обработка\n\n"
+              << "Опции пакетного режима:\n"
+              << "  --batch validate|convert   Проверить или преобразовать (по умолчанию validate)\n"
+              << "  --format compact|pretty|cbor  Формат результата convert (по умолчанию compact)\n"
+              << "  --out <каталог>            Каталог результатов convert (по умолчанию рядом с исходником)\n"
+              << "  --threads <N>              Рабочих потоков (0 - по числу ядер)\n"
+              << "  --read-ahead <МБ>          Предел прочитанных, но не обработанных данных (256)\n"
+              << "  --chunk-threshold <МБ>     С этого размера файл разбирается порциями (8)\n"
+              << "  --recursive                Искать *.json в подкаталогах\n"
+              << "  --quiet                    Печатать только ошибки и итог\n"
+              << "  --help                     Эта справка\n\n"
+              << "Код возврата: 0 - все файлы успешно, 1 - есть ошибки, 2 - неверные аргументы.\n";
+}
+
+// Неотрицательное целое из аргумента; false, если это не число
+bool parseCount(const std::string& text, size_t& value) {
+    if (text.empty() || !std::all_of(text.begin(), text.end(), [](unsigned char c) { return std::isdigit(c); })) {
+        return false;
+    }
+    try {
+        value = static_cast<size_t>(std::stoull(text));
+    } catch (const std::exception&) {
+        return false;
+    }
+    return true;
+}
+
+int runBatch(int argc, char* argv[]) {
+    BatchOptions options;
+    std::vector<std::string> paths;
+    bool recursive = false;
+    bool quiet = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        size_t number = 0;
+
+        if (arg == "--help" || arg == "-h") {
+            printBatchUsage(argv[0]);
+            return 0;
+        } else if (arg == "--batch" && hasValue) {
+            std::string operation = argv[++i];
+            if (operation == "validate") {
+                options.operation = BatchOperation::Validate;
+            } else if (operation == "convert") {
+                options.operation = BatchOperation::Convert;
+            } else {
+                std::cerr << "Неизвестная операция: " << operation << "\n";
+                printBatchUsage(argv[0]);
+                return 2;
+            }
+        } else if (arg == "--format" && hasValue) {
+            std::string format = argv[++i];
+            if (format == "compact") {
+                options.format = BatchFormat::Compact;
+            } else if (format == "pretty") {
+                options.format = BatchFormat::Pretty;
+            } else if (format == "cbor") {
+                options.format = BatchFormat::Cbor;
+            } else {
+                std::cerr << "Неизвестный формат: " << format << "\n";
+                printBatchUsage(argv[0]);
+                return 2;
+            }
+        } else if (arg == "--out" && hasValue) {
+            options.outputDir = argv[++i];
+        } else if (arg == "--threads" && hasValue && parseCount(argv[i + 1], number)) {
+            options.threads = static_cast<unsigned int>(number);
+            ++i;
+        } else if (arg == "--read-ahead" && hasValue && parseCount(argv[i + 1], number) && number > 0) {
+            options.readAheadBytes = number * 1024 * 1024;
+            ++i;
+        } else if (arg == "--chunk-threshold" && hasValue && parseCount(argv[i + 1], number) && number > 0) {
+            options.chunkThreshold = number * 1024 * 1024;
+            ++i;
+        } else if (arg == "--recursive") {
+            recursive = true;
+        } else if (arg == "--quiet") {
+            quiet = true;
+        } else if (!arg.empty() && arg[0] != '-') {
+            paths.push_back(arg);
+        } else {
+            std::cerr << "Неверный аргумент: " << arg << "\n";
+            printBatchUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (paths.empty()) {
+        std::cerr << "Не указаны файлы или каталоги\n";
+        printBatchUsage(argv[0]);
+        return 2;
+    }
+
+    try {
+        std::vector<std::string> files;
+        for (const std::string& path : paths) {
+            std::vector<std::string> found = BatchProcessor::collectFiles(path, recursive);
+            files.insert(files.end(), found.begin(), found.end());
+        }
+
+        BatchProcessor processor(options);
+        processor.setFileCallback([quiet](const BatchFileResult& file, size_t done, size_t total) {
+            if (file.success) {
+                if (quiet) return;
+                std::cout << "[" << done << "/" << total << "] [OK] " << file.path
+                          << " (" << formatFileSizeShort(file.bytes)
+                          << (file.chunked ? ", порциями" : "") << ")";
+                if (!file.outputPath.empty()) {
+                    std::cout << " -> " << file.outputPath;
+                }
+                std::cout << "\n";
+            } else {
+                std::cout << "[" << done << "/" << total << "] [ОШИБКА] " << file.path << ": "
+                          << file.firstError;
+                if (file.errorCount > 1) {
+                    std::cout << " (всего ошибок: " << file.errorCount << ")";
+                }
+                std::cout << "\n";
+            }
+        });
+
+        BatchResult result = processor.run(files);
+        std::cout << "\n" << result.toString();
+        return result.failed == 0 ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cerr << "[ОШИБКА] " << e.what() << "\n";
+        return 1;
+    }
+}
+
+#ifdef ENABLE_PROFILING
+// Запись трассировки: JSONPARSER_TRACE=trace.json ./jsonparser
+struct TraceSession {
+    std::string path;
+
+    TraceSession() {
+        const char* env = std::getenv("JSONPARSER_TRACE");
+        if (env && *env) {
+            path = env;
+            trace::start();
+            JSON_TRACE_THREAD_NAME("main");
+        }
+    }
+
+    ~TraceSession() {
+        if (path.empty()) return;
+        trace::stop();
+        if (trace::writeChromeTrace(path)) {
+            std::cout << "Трассировка сохранена: " << path
+                      << " (" << trace::eventCount() << " событий)\n";
+        }
+    }
+};
+#endif
+
+int main(int argc, char* argv[]) {
+#ifdef ENABLE_PROFILING
+    TraceSession traceSession;
+#endif
+
+    // С аргументами - пакетная обработка без меню
+    if (argc > 1) {
+        return runBatch(argc, argv);
+    }
+
     while (true) {
         printHeader();
         printMenu();
@@ -2142,6 +2479,7 @@ int main() {
             case 12: showSystemInfo(); break;
             case 13: generateLargeFile(); break;
             case 14: parallelParsing(); break;
+            case 15: undoLastChange(); break;
             case 0:
                 if (g_isModified) {
                     printHeader();
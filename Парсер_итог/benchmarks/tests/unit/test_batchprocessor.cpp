@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+#include "BatchProcessor.hpp"
+#include "Parser.hpp"
+#include "Serializer.hpp"
+#include "Cbor.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+using namespace json;
+namespace fs = std::filesystem;
+
+namespace {
+
+const char* BATCH_DIR = "batch_processor_test";
+
+std::string writeFile(const std::string& name, const std::string& content) {
+    fs::path path = fs::path(BATCH_DIR) / name;
+    fs::create_directories(path.parent_path());
+    std::ofstream file(path, std::ios::binary);
+    file << content;
+    return path.string();
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Массив объектов по одному на строку - такой TolerantParser режет на порции
+std::string makeArray(size_t count) {
+    std::string json = "[\n";
+    for (size_t i = 0; i < count; ++i) {
+        json += "  {\"id\": " + std::to_string(i) + ", \"name\": \"item" + std::to_string(i) + "\"}";
+        json += i + 1 < count ? ",\n" : "\n";
+    }
+    return json + "]\n";
+}
+
+class BatchProcessorTest : public ::testing::Test {
+protected:
+    void SetUp() override { fs::remove_all(BATCH_DIR); }
+    void TearDown() override { fs::remove_all(BATCH_DIR); }
+};
+
+} // namespace
+
+TEST_F(BatchProcessorTest, ValidateReportsEachFileInInputOrder) {
+    std::vector<std::string> files = {
+        writeFile("a.json", R"({"ok": true})"),
+        writeFile("b.json", "[1, 2,\n 3 4]"),
+        writeFile("c.json", "[]"),
+        (fs::path(BATCH_DIR) / "missing.json").string(),
+    };
+
+    BatchOptions options;
+    options.threads = 2;
+    size_t callbacks = 0;
+    BatchProcessor processor(options);
+    processor.setFileCallback([&callbacks](const BatchFileResult&, size_t done, size_t total) {
+        EXPECT_EQ(done, ++callbacks);
+        EXPECT_EQ(total, 4u);
+    });
+    BatchResult result = processor.run(files);
+
+    ASSERT_EQ(result.files.size(), 4u);
+    EXPECT_EQ(callbacks, 4u);
+    for (size_t i = 0; i < files.size(); ++i) {
+        EXPECT_EQ(result.files[i].path, files[i]);
+    }
+    EXPECT_TRUE(result.files[0].success);
+    EXPECT_FALSE(result.files[1].success);
+    EXPECT_NE(result.files[1].firstError.find("строка 2"), std::string::npos);
+    EXPECT_TRUE(result.files[2].success);
+    EXPECT_FALSE(result.files[3].success);
+    EXPECT_EQ(result.succeeded, 2u);
+    EXPECT_EQ(result.failed, 2u);
+    EXPECT_EQ(result.totalBytes, readFile(files[0]).size() + readFile(files[1]).size() + 2);
+}
+
+TEST_F(BatchProcessorTest, LargeFilesAreParsedInChunks) {
+    std::string array = makeArray(2000);
+    std::string broken = array;
+    broken.replace(broken.find("\"item1000\""), 10, "\"item1000");
+    std::vector<std::string> files = {
+        writeFile("array.json", array),
+        writeFile("broken.json", broken),
+        writeFile("sequence.json", "{\"a\": 1}\n{\"b\": 2}\n"),
+        writeFile("single.json", "{\"a\": [1, 2, 3]}\n"),
+    };
+
+    BatchOptions options;
+    options.operation = BatchOperation::Convert;
+    options.outputDir = (fs::path(BATCH_DIR) / "out").string();
+    options.threads = 3;
+    options.chunkThreshold = 16;
+    BatchResult result = BatchProcessor(options).run(files);
+
+    for (const BatchFileResult& file : result.files) {
+        EXPECT_TRUE(file.chunked) << file.path;
+    }
+    ASSERT_TRUE(result.files[0].success) << result.files[0].firstError;
+    EXPECT_EQ(readFile(result.files[0].outputPath),
+              Serializer::toString(Parser::parseString(array), false) + "\n");
+    EXPECT_FALSE(result.files[1].success);
+    EXPECT_GE(result.files[1].errorCount, 1u);
+    EXPECT_FALSE(result.files[2].success);
+    EXPECT_TRUE(result.files[3].success);
+    EXPECT_FALSE(fs::exists(result.files[1].outputPath));
+
+    // Проверка большого файла даёт те же ответы, не собирая дерево
+    options.operation = BatchOperation::Validate;
+    BatchResult validated = BatchProcessor(options).run(files);
+    for (size_t i = 0; i < files.size(); ++i) {
+        EXPECT_TRUE(validated.files[i].chunked) << files[i];
+        EXPECT_EQ(validated.files[i].success, result.files[i].success) << files[i];
+        EXPECT_EQ(validated.files[i].errorCount, result.files[i].errorCount) << files[i];
+    }
+}
+
+TEST_F(BatchProcessorTest, ConvertToCborRoundTrips) {
+    const std::string json = R"({"name": "Анна", "tags": ["x", "y"], "score": 4.5, "none": null})";
+    std::vector<std::string> files = {writeFile("doc.json", json)};
+
+    BatchOptions options;
+    options.operation = BatchOperation::Convert;
+    options.format = BatchFormat::Cbor;
+    BatchResult result = BatchProcessor(options).run(files);
+
+    ASSERT_TRUE(result.files[0].success) << result.files[0].firstError;
+    EXPECT_EQ(fs::path(result.files[0].outputPath).filename(), "doc.cbor");
+    EXPECT_EQ(Serializer::toString(CborReader::parseFile(result.files[0].outputPath), false),
+              Serializer::toString(Parser::parseString(json), false));
+}
+
+TEST_F(BatchProcessorTest, ConvertRefusesToOverwriteInputOrEarlierOutput) {
+    std::vector<std::string> files = {
+        writeFile("same.json", "[1]"),
+        writeFile("one/dup.json", "[1]"),
+        writeFile("two/dup.json", "[2]"),
+    };
+
+    // Без outputDir результат .json лёг бы поверх исходника
+    BatchOptions options;
+    options.operation = BatchOperation::Convert;
+    BatchResult inPlace = BatchProcessor(options).run({files[0]});
+    EXPECT_FALSE(inPlace.files[0].success);
+    EXPECT_EQ(readFile(files[0]), "[1]");
+
+    options.outputDir = (fs::path(BATCH_DIR) / "out").string();
+    BatchResult result = BatchProcessor(options).run({files[1], files[2]});
+    EXPECT_TRUE(result.files[0].success);
+    EXPECT_FALSE(result.files[1].success);
+    EXPECT_EQ(readFile(result.files[0].outputPath), "[1]\n");
+}
+
+TEST_F(BatchProcessorTest, ReadAheadStaysWithinBudget) {
+    std::vector<std::string> files;
+    size_t largest = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        std::string content = makeArray(50 + i * 10);
+        largest = std::max(largest, content.size());
+        files.push_back(writeFile("file" + std::to_string(i) + ".json", content));
+    }
+
+    // Бюджет меньше любого файла: в памяти не больше одного файла
+    BatchOptions options;
+    options.threads = 4;
+    options.readAheadBytes = 1;
+    BatchResult result = BatchProcessor(options).run(files);
+
+    EXPECT_EQ(result.succeeded, files.size());
+    EXPECT_GT(result.peakBufferedBytes, 0u);
+    EXPECT_LE(result.peakBufferedBytes, largest);
+}
+
+TEST_F(BatchProcessorTest, CollectFilesFindsJsonFiles) {
+    writeFile("b.json", "1");
+    writeFile("a.json", "2");
+    writeFile("notes.txt", "3");
+    writeFile("nested/c.json", "4");
+
+    std::vector<std::string> flat = BatchProcessor::collectFiles(BATCH_DIR);
+    ASSERT_EQ(flat.size(), 2u);
+    EXPECT_EQ(fs::path(flat[0]).filename(), "a.json");
+    EXPECT_EQ(fs::path(flat[1]).filename(), "b.json");
+
+    EXPECT_EQ(BatchProcessor::collectFiles(BATCH_DIR, true).size(), 3u);
+    EXPECT_EQ(BatchProcessor::collectFiles(flat[0]), std::vector<std::string>{flat[0]});
+    EXPECT_THROW(BatchProcessor::collectFiles("batch_processor_missing_dir"), JsonException);
+}
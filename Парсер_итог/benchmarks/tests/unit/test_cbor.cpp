@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include "Cbor.hpp"
+#include "Parser.hpp"
+#include "Serializer.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+
+using namespace json;
+
+// Байты из примеров RFC 8949, приложение A
+TEST(CborTest, EncodesScalarsCompactly) {
+    EXPECT_EQ(CborWriter::toBytes(JsonValue(0)), std::string("\x00", 1));
+    EXPECT_EQ(CborWriter::toBytes(JsonValue(23)), "\x17");
+    EXPECT_EQ(CborWriter::toBytes(JsonValue(24)), "\x18\x18");
+    EXPECT_EQ(CborWriter::toBytes(JsonValue(1000)), "\x19\x03\xe8");
+    EXPECT_EQ(CborWriter::toBytes(JsonValue(-1000)), "\x39\x03\xe7");
+    EXPECT_EQ(CborWriter::toBytes(JsonValue(1.5)), std::string("\xfa\x3f\xc0\x00\x00", 5));
+    EXPECT_EQ(CborWriter::toBytes(JsonValue(1.1)), "\xfb\x3f\xf1\x99\x99\x99\x99\x99\x9a");
+    EXPECT_EQ(CborWriter::toBytes(JsonValue("IETF")), "\x64IETF");
+    EXPECT_EQ(CborWriter::toBytes(JsonValue(nullptr)), "\xf6");
+    EXPECT_EQ(CborWriter::toBytes(JsonValue(true)), "\xf5");
+}
+
+TEST(CborTest, RoundTripMatchesText) {
+    JsonValue doc = Parser::parseString(R"({
+        "id": 12345678901, "neg": -42, "pi": 3.14159, "big": 1e300,
+        "name": "Привет, мир", "tags": ["a", "", null, true, false],
+        "nested": {"empty": {}, "list": [[], [1, [2, [3]]]]}
+    })");
+
+    std::string bytes = CborWriter::toBytes(doc);
+    JsonValue back = CborReader::parseBytes(bytes);
+
+    EXPECT_EQ(Serializer::toString(back, false), Serializer::toString(doc, false));
+    EXPECT_LT(bytes.size(), Serializer::toString(doc, false).size());
+}
+
+TEST(CborTest, ReadsIndefiniteLengthAndHalfFloats) {
+    // {_ "a": [_ 1, 1.5(half)], "b": (_ "x", "y")}
+    const char raw[] = "\xbf\x61" "a" "\x9f\x01\xf9\x3e\x00\xff\x61" "b" "\x7f\x61" "x" "\x61" "y" "\xff\xff";
+    std::string bytes(raw, sizeof(raw) - 1);
+    JsonValue value = CborReader::parseBytes(bytes);
+
+    EXPECT_DOUBLE_EQ(value.at("a")[1].asNumber(), 1.5);
+    EXPECT_EQ(value.at("b").asString(), "xy");
+}
+
+TEST(CborTest, RejectsMalformedInput) {
+    EXPECT_THROW(CborReader::parseBytes(""), JsonException);
+    EXPECT_THROW(CborReader::parseBytes("\x65" "abc"), JsonException);          // Короткая строка
+    EXPECT_THROW(CborReader::parseBytes("\x9b\xff\xff\xff\xff\xff\xff\xff\xff"), JsonException);
+    EXPECT_THROW(CborReader::parseBytes("\xa1\x01\x02"), JsonException);       // Ключ-число
+    EXPECT_THROW(CborReader::parseBytes("\xf6\xf6"), JsonException);           // Лишние данные
+    EXPECT_THROW(CborReader::parseBytes(std::string(5000, '\x81')), JsonException);
+}
+
+TEST(CborTest, FileRoundTripIsDetected) {
+    const std::string path = "cbor_test.cbor";
+    JsonValue doc = Parser::parseString(R"([{"id": 1, "v": 0.5}, {"id": 2, "v": -0.25}])");
+
+    ASSERT_TRUE(CborWriter::toFile(doc, path));
+    EXPECT_TRUE(CborReader::isCborFile(path));
+    JsonValue back = CborReader::parseFile(path);
+    std::remove(path.c_str());
+
+    EXPECT_EQ(Serializer::toString(back, false), Serializer::toString(doc, false));
+}
+
+namespace {
+
+// Поток, запоминающий самую большую порцию записи
+class ChunkRecorder : public std::stringbuf {
+public:
+    std::streamsize largest = 0;
+
+protected:
+    std::streamsize xsputn(const char* data, std::streamsize count) override {
+        largest = std::max(largest, count);
+        return std::stringbuf::xsputn(data, count);
+    }
+};
+
+} // namespace
+
+TEST(CborTest, LargeArraysOfScalarsStream) {
+    JsonArray numbers;
+    JsonObject fields;
+    for (int i = 0; i < 10000; ++i) {
+        numbers.push_back(JsonValue(i * 0.5));
+        fields.emplace("k" + std::to_string(i), JsonValue(static_cast<double>(i)));
+    }
+    JsonArray root;
+    root.push_back(JsonValue(std::move(numbers)));
+    root.push_back(JsonValue(std::move(fields)));
+    JsonValue doc(std::move(root));
+
+    ChunkRecorder buffer;
+    std::ostream os(&buffer);
+    {
+        CborWriter writer(os, 256);
+        writer.value(doc);
+    }
+    // Буфер сбрасывается по ходу контейнера, а не одним куском в конце
+    EXPECT_LE(buffer.largest, 256 + 32);
+    EXPECT_EQ(buffer.str(), CborWriter::toBytes(doc));
+}
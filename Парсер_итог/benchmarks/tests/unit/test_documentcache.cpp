@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include "DocumentCache.hpp"
+#include "Parser.hpp"
+#include "Serializer.hpp"
+#include "TreeVisitor.hpp"
+#include <filesystem>
+#include <fstream>
+
+using namespace json;
+namespace fs = std::filesystem;
+
+namespace {
+
+const char* CACHE_DIR = "document_cache_test";
+
+std::string writeSource(const std::string& name, const std::string& content) {
+    std::ofstream file(name, std::ios::binary);
+    file << content;
+    return name;
+}
+
+} // namespace
+
+TEST(DocumentCacheTest, StoreAndReopenWithoutParsing) {
+    const std::string json = R"({"users": [{"id": 1, "name": "Анна", "admin": true},
+                                           {"id": 2, "name": "Борис", "admin": false}],
+                                 "total": 2, "ratio": 0.75, "note": null})";
+    std::string source = writeSource("document_cache_source.json", json);
+    DocumentCache cache(CACHE_DIR);
+    JsonValue parsed = Parser::parseString(json);
+
+    ASSERT_TRUE(cache.store(source, parsed));
+    auto doc = cache.open(source, true);
+    ASSERT_NE(doc, nullptr);
+
+    CachedValue root = doc->root();
+    ASSERT_TRUE(root.isObject());
+    EXPECT_EQ(root.size(), 4u);
+    EXPECT_EQ(root.at("users")[1].at("name").asString(), "Борис");
+    EXPECT_TRUE(root.at("users")[0].at("admin").asBool());
+    EXPECT_DOUBLE_EQ(root.at("ratio").asNumber(), 0.75);
+    EXPECT_TRUE(root.at("note").isNull());
+    EXPECT_FALSE(root.find("missing").has_value());
+    EXPECT_THROW(root.at("total").asString(), JsonException);
+
+    EXPECT_EQ(Serializer::toString(root.toJsonValue(), false), Serializer::toString(parsed, false));
+
+    doc.reset();
+    fs::remove(source);
+    fs::remove_all(CACHE_DIR);
+}
+
+// Просмотр, поиск и статистика работают по кэшу без построения JsonValue
+TEST(DocumentCacheTest, ReadOnlyViewsOverCache) {
+    const std::string json = R"({"data": {"users": [{"id": 7, "tags": ["a", "bc"]}, {"id": 8, "tags": []}]},
+                                 "flag": false, "none": null, "title": "Отчёт"})";
+    std::string source = writeSource("document_cache_views.json", json);
+    DocumentCache cache(CACHE_DIR);
+    JsonValue parsed = Parser::parseString(json);
+    ASSERT_TRUE(cache.store(source, parsed));
+    auto doc = cache.open(source);
+    ASSERT_NE(doc, nullptr);
+    CachedValue root = doc->root();
+
+    EXPECT_DOUBLE_EQ(root.findByPath("data.users[1].id")->asNumber(), 8.0);
+    EXPECT_EQ(root.findByPath("data.users[0].tags[1]")->asString(), "bc");
+    EXPECT_TRUE(root.findByPath("")->isObject());
+    EXPECT_FALSE(root.findByPath("data.users[2]").has_value());
+    EXPECT_FALSE(root.findByPath("data.users.id").has_value());
+    EXPECT_FALSE(root.findByPath("title.x").has_value());
+
+    TreeStats fromCache = TreeStats::collect(root);
+    TreeStats fromTree = TreeStats::collect(parsed, TreeVisitor(1));
+    EXPECT_EQ(fromCache.objects, fromTree.objects);
+    EXPECT_EQ(fromCache.arrays, fromTree.arrays);
+    EXPECT_EQ(fromCache.strings, fromTree.strings);
+    EXPECT_EQ(fromCache.numbers, fromTree.numbers);
+    EXPECT_EQ(fromCache.bools, fromTree.bools);
+    EXPECT_EQ(fromCache.nulls, fromTree.nulls);
+    EXPECT_EQ(fromCache.keys, fromTree.keys);
+    EXPECT_EQ(fromCache.stringBytes, fromTree.stringBytes);
+    EXPECT_EQ(fromCache.maxDepth, fromTree.maxDepth);
+
+    doc.reset();
+    fs::remove(source);
+    fs::remove_all(CACHE_DIR);
+}
+
+TEST(DocumentCacheTest, ChangedSourceInvalidatesCache) {
+    std::string source = writeSource("document_cache_changed.json", "[1, 2, 3]");
+    DocumentCache cache(CACHE_DIR);
+
+    ASSERT_TRUE(cache.store(source, Parser::parseFile(source)));
+    ASSERT_NE(cache.open(source), nullptr);
+
+    writeSource(source, "[1, 2, 3, 4, 5]");
+    EXPECT_EQ(cache.open(source), nullptr);
+    EXPECT_FALSE(fs::exists(cache.cachePathFor(source)));
+
+    fs::remove(source);
+    fs::remove_all(CACHE_DIR);
+}
+
+TEST(DocumentCacheTest, RejectsCorruptedCacheFile) {
+    std::string source = writeSource("document_cache_corrupt.json", R"({"a": "b"})");
+    DocumentCache cache(CACHE_DIR);
+    ASSERT_TRUE(cache.store(source, Parser::parseFile(source)));
+
+    // Обрезанный файл кэша не должен открываться
+    std::string cacheFile = cache.cachePathFor(source);
+    fs::resize_file(cacheFile, fs::file_size(cacheFile) - 8);
+    EXPECT_THROW(CachedDocument::open(cacheFile), JsonException);
+    EXPECT_EQ(cache.open(source), nullptr);
+
+    fs::remove(source);
+    fs::remove_all(CACHE_DIR);
+}
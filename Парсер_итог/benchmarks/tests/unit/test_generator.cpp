@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "Generator.hpp"
+#include "Validator.hpp"
+#include "ParallelProcessor.hpp"
+#include "Parser.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+using namespace json;
+
+// Сгенерированный без ошибок JSON должен быть валидным в обоих режимах
+TEST(GeneratorTest, GeneratesValidJson) {
+    for (bool compact : {false, true}) {
+        for (unsigned int seed = 1; seed <= 50; ++seed) {
+            Generator generator(seed);
+            GeneratorOptions opts;
+            opts.compactOutput = compact;
+            generator.setOptions(opts);
+
+            std::string json = generator.generate();
+            EXPECT_TRUE(Validator::isValid(json)) << "seed " << seed << ": " << json;
+        }
+    }
+}
+
+TEST(GeneratorTest, SameSeedSameOutput) {
+    Generator a(42);
+    Generator b(42);
+    EXPECT_EQ(a.generate(), b.generate());
+}
+
+// Один seed - один и тот же файл на любой стандартной библиотеке:
+// диапазоны считаются из сырого выхода mt19937 без std::*_distribution
+TEST(GeneratorTest, SeedIsPortable) {
+    Generator generator(42);
+    GeneratorOptions opts;
+    opts.compactOutput = true;
+    generator.setOptions(opts);
+
+    const std::string golden = R"([null,[true,4458,{"description":null},"Смартфон",564,null,true,null],)"
+                               R"([[[[false,2912,true,466,4.29359e-1,"Принтер",184.8291],)";
+    EXPECT_EQ(generator.generate().substr(0, golden.size()), golden);
+}
+
+// generateInto дописывает элемент в конец буфера, не трогая существующие данные
+TEST(GeneratorTest, GenerateIntoAppends) {
+    Generator reference(7);
+    std::string expected = reference.generate();
+
+    Generator generator(7);
+    std::string out = "prefix";
+    generator.generateInto(out);
+
+    EXPECT_EQ(out, "prefix" + expected);
+}
+
+TEST(GeneratorTest, InjectedErrorsAreReported) {
+    for (unsigned int seed = 1; seed <= 50; ++seed) {
+        Generator generator(seed);
+        generator.generateWithErrors(3);
+        EXPECT_EQ(generator.getGeneratedErrors().size(), 3u);
+    }
+}
+
+// Конвейер генерации: чанки из разных потоков пишутся по порядку в валидный массив
+TEST(ParallelGeneratorTest, LargeFileIsValidArray) {
+    const std::string path = "parallel_generator_test.json";
+
+    ParallelGenerator generator(3);
+    generator.setChunkSize(16 * 1024);
+    generator.setMaxChunksInFlight(2);
+
+    size_t lastProgress = 0;
+    ASSERT_TRUE(generator.generateLargeFile(path, 200 * 1024, 3, 0,
+        [&](size_t current, size_t) {
+            EXPECT_GE(current, lastProgress);
+            lastProgress = current;
+        }));
+
+    JsonValue doc = Parser::parseFile(path);
+    std::remove(path.c_str());
+
+    ASSERT_TRUE(doc.isArray());
+    EXPECT_GT(doc.size(), 0u);
+    EXPECT_GE(lastProgress, 200u * 1024);
+}
+
+// Содержимое файла зависит только от seed, а не от числа потоков
+TEST(ParallelGeneratorTest, SameSeedSameFileForAnyThreadCount) {
+    auto generate = [](unsigned int threads, uint64_t seed) {
+        const std::string path = "parallel_generator_seed_test.json";
+        ParallelGenerator generator(threads);
+        generator.setChunkSize(8 * 1024);
+        generator.setSeed(seed);
+        EXPECT_TRUE(generator.generateLargeFile(path, 100 * 1024, 3, 0));
+        EXPECT_EQ(generator.getLastSeed(), seed);
+
+        std::ifstream file(path, std::ios::binary);
+        std::string content((std::istreambuf_iterator<char>(file)),
+                             std::istreambuf_iterator<char>());
+        file.close();
+        std::remove(path.c_str());
+        return content;
+    };
+
+    std::string single = generate(1, 12345);
+    EXPECT_EQ(single, generate(4, 12345));
+    EXPECT_NE(single, generate(1, 54321));
+}
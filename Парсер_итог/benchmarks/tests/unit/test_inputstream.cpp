@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include "InputStream.hpp"
+#include "Parser.hpp"
+#include "Serializer.hpp"
+#include "TolerantParser.hpp"
+#include "TypedJson.hpp"
+#include <cstdio>
+#include <fstream>
+
+#ifdef JSON_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef JSON_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+using namespace json;
+
+namespace {
+
+void writeFile(const std::string& path, const std::string& content) {
+    std::ofstream file(path, std::ios::binary);
+    file << content;
+}
+
+// Массив объектов по одному на строку
+std::string makeArray(size_t count) {
+    std::string json = "[\n";
+    for (size_t i = 0; i < count; ++i) {
+        json += "  {\"id\": " + std::to_string(i) + ", \"name\": \"элемент " + std::to_string(i) + "\"}";
+        json += i + 1 < count ? ",\n" : "\n";
+    }
+    return json + "]\n";
+}
+
+#ifdef JSON_HAVE_ZLIB
+// Один член gzip
+std::string gzip(const std::string& data) {
+    z_stream zs{};
+    // 16 + MAX_WBITS - заголовок gzip
+    EXPECT_EQ(deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY), Z_OK);
+    std::string out(deflateBound(&zs, static_cast<uLong>(data.size())), '\0');
+    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    zs.avail_in = static_cast<uInt>(data.size());
+    zs.next_out = reinterpret_cast<Bytef*>(&out[0]);
+    zs.avail_out = static_cast<uInt>(out.size());
+    EXPECT_EQ(deflate(&zs, Z_FINISH), Z_STREAM_END);
+    out.resize(zs.total_out);
+    deflateEnd(&zs);
+    return out;
+}
+#endif
+
+#ifdef JSON_HAVE_ZSTD
+// Кадры zstd по frameSize байт исходных данных, как у zstd -T
+std::string zstdFrames(const std::string& data, size_t frameSize) {
+    std::string out;
+    for (size_t pos = 0; pos < data.size(); pos += frameSize) {
+        size_t size = std::min(frameSize, data.size() - pos);
+        std::string frame(ZSTD_compressBound(size), '\0');
+        size_t written = ZSTD_compress(&frame[0], frame.size(), data.data() + pos, size, 3);
+        EXPECT_FALSE(ZSTD_isError(written));
+        out.append(frame.data(), written);
+    }
+    return out;
+}
+#endif
+
+} // namespace
+
+TEST(InputStreamTest, DetectsCompressionBySignature) {
+    EXPECT_EQ(detectCompression("\x1f\x8b\x08"), Compression::Gzip);
+    EXPECT_EQ(detectCompression(std::string("\x28\xb5\x2f\xfd\x00", 5)), Compression::Zstd);
+    EXPECT_EQ(detectCompression("\x28\xb5\x2f"), Compression::None);
+    EXPECT_EQ(detectCompression("{\"a\": 1}"), Compression::None);
+    EXPECT_EQ(detectCompression(""), Compression::None);
+    EXPECT_TRUE(isCompressedExtension(".gz"));
+    EXPECT_FALSE(isCompressedExtension(".json"));
+}
+
+TEST(InputStreamTest, PlainFilePassesThrough) {
+    const std::string path = "input_stream_plain.json";
+    const std::string content = makeArray(100);
+    writeFile(path, content);
+
+    auto input = InputStream::open(path);
+    EXPECT_EQ(input->compression(), Compression::None);
+    EXPECT_EQ(input->fileSize(), content.size());
+    EXPECT_EQ(input->readAll(), content);
+    EXPECT_EQ(input->position(), content.size());
+    std::remove(path.c_str());
+
+    EXPECT_THROW(InputStream::open("input_stream_missing.json"), JsonException);
+}
+
+TEST(InputStreamTest, GzipMembersAreConcatenated) {
+#ifdef JSON_HAVE_ZLIB
+    const std::string path = "input_stream_test.json.gz";
+    const std::string content = makeArray(20000);
+    size_t half = content.size() / 2;
+    const std::string packed = gzip(content.substr(0, half)) + gzip(content.substr(half));
+    writeFile(path, packed);
+
+    auto input = InputStream::open(path);
+    EXPECT_EQ(input->compression(), Compression::Gzip);
+    EXPECT_EQ(input->readAll(), content);
+    EXPECT_EQ(input->position(), packed.size());
+
+    // Обрыв посреди члена - ошибка, а не тихо укороченный документ
+    writeFile(path, packed.substr(0, packed.size() - 100));
+    EXPECT_THROW(InputStream::open(path)->readAll(), JsonException);
+    std::remove(path.c_str());
+#else
+    GTEST_SKIP() << "Сборка без zlib";
+#endif
+}
+
+TEST(InputStreamTest, ZstdFramesDecompressInOrder) {
+#ifdef JSON_HAVE_ZSTD
+    const std::string path = "input_stream_test.json.zst";
+    const std::string content = makeArray(20000);
+    const std::string packed = zstdFrames(content, 64 * 1024);
+    writeFile(path, packed);
+
+    // Параллельно и последовательно - одинаково; read() мелкими кусками
+    // пересекает границы кадров
+    EXPECT_EQ(InputStream::open(path, 1)->readAll(), content);
+    auto input = InputStream::open(path, 4);
+    EXPECT_EQ(input->compression(), Compression::Zstd);
+    std::string result;
+    char buffer[777];
+    while (size_t count = input->read(buffer, sizeof(buffer))) {
+        result.append(buffer, count);
+    }
+    EXPECT_EQ(result, content);
+    EXPECT_EQ(input->position(), packed.size());
+
+    writeFile(path, packed.substr(0, packed.size() - 100));
+    EXPECT_THROW(InputStream::open(path, 4)->readAll(), JsonException);
+    std::remove(path.c_str());
+#else
+    GTEST_SKIP() << "Сборка без libzstd";
+#endif
+}
+
+TEST(InputStreamTest, ParsersReadCompressedFiles) {
+    const std::string content = makeArray(3000);
+    std::vector<std::pair<std::string, std::string>> files;
+#ifdef JSON_HAVE_ZLIB
+    files.emplace_back("input_stream_parse.json.gz", gzip(content));
+#endif
+#ifdef JSON_HAVE_ZSTD
+    files.emplace_back("input_stream_parse.json.zst", zstdFrames(content, 16 * 1024));
+#endif
+    if (files.empty()) {
+        GTEST_SKIP() << "Сборка без zlib и libzstd";
+    }
+
+    const std::string expected = Serializer::toString(Parser::parseString(content), false);
+    for (const auto& [path, packed] : files) {
+        writeFile(path, packed);
+        EXPECT_EQ(readFileContent(path), content) << path;
+        EXPECT_EQ(Serializer::toString(Parser::parseFile(path), false), expected) << path;
+
+        // Чтение сообщает прогресс по сжатому файлу (разбор - по токенам)
+        size_t readProgress = 0;
+        JsonValue streamed = Parser::parseFileWithProgress(path, [&](size_t current, size_t total) {
+            EXPECT_LE(current, total);
+            if (total == packed.size()) readProgress = current;
+        });
+        EXPECT_EQ(Serializer::toString(streamed, false), expected) << path;
+        EXPECT_EQ(readProgress, packed.size()) << path;
+
+        TolerantParser tolerant(2);
+        tolerant.setChunkSize(4096);
+        tolerant.setSourceSpans(7);
+        TolerantResult result = tolerant.parseFile(path);
+        EXPECT_TRUE(result.errors.empty()) << path;
+        ASSERT_EQ(result.elements.size(), 3000u) << path;
+        // Участки указывали бы в распакованный текст
+        SourceSpan span;
+        EXPECT_FALSE(result.elements.front().sourceSpan(span)) << path;
+        std::remove(path.c_str());
+    }
+}
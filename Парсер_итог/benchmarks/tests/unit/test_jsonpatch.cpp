@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include "JsonPatch.hpp"
+#include "Parser.hpp"
+#include "Serializer.hpp"
+
+using namespace json;
+
+namespace {
+
+std::string compact(const JsonValue& value) {
+    return Serializer::toString(value, false);
+}
+
+} // namespace
+
+TEST(JsonPatchTest, DiffAndApplyRoundTrip) {
+    JsonValue from = Parser::parseString(R"({"a": 1, "b": [1, 2, 3, 4], "c": {"d": "x", "e/f": true}, "g": null})");
+    JsonValue to = Parser::parseString(R"({"a": 1, "b": [1, 9, 3, 4, 5], "c": {"d": "y", "e/f": true}, "h": [0]})");
+
+    JsonValue patch = JsonPatch::diff(from, to);
+    EXPECT_EQ(compact(patch),
+              R"([{"op":"replace","path":"/b/1","value":9},{"op":"add","path":"/b/4","value":5},)"
+              R"({"op":"replace","path":"/c/d","value":"y"},{"op":"remove","path":"/g"},)"
+              R"({"op":"add","path":"/h","value":[0]}])");
+
+    JsonValue result = from;
+    JsonPatch::apply(result, patch);
+    EXPECT_TRUE(JsonPatch::equal(result, to));
+    EXPECT_EQ(compact(result), compact(to));
+}
+
+TEST(JsonPatchTest, ArrayDiffTouchesOnlyChangedRegion) {
+    JsonArray items;
+    for (int i = 0; i < 1000; ++i) {
+        items.push_back(JsonValue(JsonArray{JsonValue(i)}));
+    }
+    JsonValue from(std::move(items));
+
+    // Снимок с одной вставкой и одним удалением в середине
+    JsonValue to = from;
+    to.asArray().insert(to.asArray().begin() + 500, JsonValue("new"));
+    to.erase(size_t(900));
+
+    JsonValue patch = JsonPatch::diff(from, to);
+    JsonValue result = from;
+    JsonPatch::apply(result, patch);
+    EXPECT_EQ(compact(result), compact(to));
+    EXPECT_LT(patch.size(), 500u);
+
+    EXPECT_EQ(JsonPatch::diff(from, from).size(), 0u);
+}
+
+TEST(JsonPatchTest, ApplyAllOperations) {
+    JsonValue doc = Parser::parseString(R"({"list": [1, 2], "obj": {"k": "v"}, "a~b": 0})");
+    JsonValue patch = Parser::parseString(R"([
+        {"op": "test", "path": "/a~0b", "value": 0},
+        {"op": "add", "path": "/list/-", "value": 3},
+        {"op": "add", "path": "/list/0", "value": 0},
+        {"op": "copy", "from": "/obj", "path": "/copy"},
+        {"op": "move", "from": "/obj/k", "path": "/moved"},
+        {"op": "replace", "path": "/a~0b", "value": [1]},
+        {"op": "remove", "path": "/list/1"}
+    ])");
+
+    JsonPatch::apply(doc, patch);
+    EXPECT_EQ(compact(doc), R"({"a~b":[1],"copy":{"k":"v"},"list":[0,2,3],"moved":"v","obj":{}})");
+}
+
+TEST(JsonPatchTest, FailedPatchLeavesDocumentUnchanged) {
+    JsonValue doc = Parser::parseString(R"({"a": [1, 2]})");
+    std::string before = compact(doc);
+
+    EXPECT_THROW(JsonPatch::apply(doc, Parser::parseString(
+        R"([{"op": "add", "path": "/b", "value": 1}, {"op": "test", "path": "/a/0", "value": 2}])")),
+        JsonException);
+    EXPECT_THROW(JsonPatch::apply(doc, Parser::parseString(R"([{"op": "remove", "path": "/a/2"}])")),
+                 JsonException);
+    EXPECT_THROW(JsonPatch::apply(doc, Parser::parseString(R"([{"op": "add", "path": "/a/01", "value": 1}])")),
+                 JsonException);
+    EXPECT_THROW(JsonPatch::apply(doc, Parser::parseString(R"([{"op": "move", "from": "/a", "path": "/a/0"}])")),
+                 JsonException);
+    EXPECT_THROW(JsonPatch::apply(doc, Parser::parseString(R"([{"op": "replace", "path": "a"}])")),
+                 JsonException);
+    EXPECT_EQ(compact(doc), before);
+}
+
+TEST(JsonPatchTest, PointerEscaping) {
+    EXPECT_EQ(JsonPatch::escapeToken("a/b~c"), "a~1b~0c");
+    std::vector<std::string> tokens = JsonPatch::parsePointer("/a~1b~0c//0");
+    ASSERT_EQ(tokens.size(), 3u);
+    EXPECT_EQ(tokens[0], "a/b~c");
+    EXPECT_EQ(tokens[1], "");
+    EXPECT_EQ(tokens[2], "0");
+    EXPECT_TRUE(JsonPatch::parsePointer("").empty());
+    EXPECT_THROW(JsonPatch::parsePointer("/a~2"), JsonException);
+}
+
+TEST(JsonPatchTest, HashCollisionIsNotEquality) {
+    // Подобранная коллизия: хэш без ключа не доказывает равенства
+    JsonValue left = Parser::parseString("[1, 3]");
+    JsonValue right = Parser::parseString("[2, -2.0354921750212268e-185]");
+    ASSERT_EQ(left.hash(), right.hash());
+    EXPECT_FALSE(JsonPatch::equal(left, right));
+
+    JsonValue doc = Parser::parseString(R"({"v": [1, 3], "w": 1})");
+    std::string before = compact(doc);
+    EXPECT_THROW(JsonPatch::apply(doc, Parser::parseString(
+        R"([{"op": "test", "path": "/v", "value": [2, -2.0354921750212268e-185]}, {"op": "remove", "path": "/w"}])")),
+        JsonException);
+    EXPECT_EQ(compact(doc), before);
+
+    // diff не пропускает изменённое поддерево под ключом
+    JsonValue to = Parser::parseString(R"({"v": [2, -2.0354921750212268e-185], "w": 1})");
+    JsonValue patch = JsonPatch::diff(doc, to);
+    JsonPatch::apply(doc, patch);
+    EXPECT_EQ(compact(doc), compact(to));
+}
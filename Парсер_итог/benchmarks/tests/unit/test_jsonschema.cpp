@@ -0,0 +1,360 @@
+#include <gtest/gtest.h>
+#include "JsonSchema.hpp"
+#include "SchemaValidator.hpp"
+#include "Parser.hpp"
+#include <cstdio>
+#include <fstream>
+#include <tuple>
+
+using namespace json;
+
+namespace {
+
+SchemaValidator validatorFor(const std::string& schema, unsigned int threads = 1) {
+    return SchemaValidator(JsonSchema::compile(Parser::parseString(schema)), threads);
+}
+
+// Сообщения ошибок с путями: "путь: сообщение"
+std::vector<std::string> errorsOf(const std::string& schema, const std::string& json) {
+    SchemaResult result = validatorFor(schema).validate(json);
+    std::vector<std::string> errors;
+    for (const SchemaError& error : result.errors) {
+        errors.push_back(error.path + ": " + error.message);
+    }
+    EXPECT_EQ(result.isValid, errors.empty());
+    return errors;
+}
+
+bool valid(const std::string& schema, const std::string& json) {
+    return validatorFor(schema).validate(json).isValid;
+}
+
+// Массив записей; каждая пятая нарушает схему, одна - дважды
+std::string makeRecords(size_t count) {
+    std::string json = "[\n";
+    for (size_t i = 0; i < count; ++i) {
+        json += "  {\"id\": " + std::to_string(i % 5 == 0 ? -1 : static_cast<int>(i)) + ", \"name\": \"запись " +
+                std::to_string(i) + "\", \"tags\": [" + (i == 7 ? "1" : "\"a\"") + "]}";
+        json += i + 1 < count ? ",\n" : "\n";
+    }
+    return json + "]\n";
+}
+
+const char* RECORD_SCHEMA = R"({
+    "type": "array",
+    "minItems": 1,
+    "contains": {"properties": {"id": {"const": 3}}},
+    "items": {"$ref": "#/definitions/record"},
+    "definitions": {
+        "record": {
+            "type": "object",
+            "required": ["id", "name"],
+            "additionalProperties": false,
+            "properties": {
+                "id": {"type": "integer", "minimum": 0},
+                "name": {"type": "string", "minLength": 1},
+                "tags": {"type": "array", "items": {"type": "string"}}
+            }
+        }
+    }
+})";
+
+void expectSameErrors(const SchemaResult& actual, const SchemaResult& expected) {
+    EXPECT_EQ(actual.isValid, expected.isValid);
+    EXPECT_EQ(actual.syntaxError, expected.syntaxError);
+    EXPECT_EQ(actual.valueCount, expected.valueCount);
+    ASSERT_EQ(actual.errors.size(), expected.errors.size());
+    for (size_t i = 0; i < actual.errors.size(); ++i) {
+        EXPECT_EQ(actual.errors[i].line, expected.errors[i].line) << i;
+        EXPECT_EQ(actual.errors[i].column, expected.errors[i].column) << i;
+        EXPECT_EQ(actual.errors[i].path, expected.errors[i].path) << i;
+        EXPECT_EQ(actual.errors[i].message, expected.errors[i].message) << i;
+    }
+}
+
+} // namespace
+
+TEST(JsonSchemaTest, RejectsInvalidSchemas) {
+    for (const char* schema : {
+             R"({"type": "text"})",
+             R"({"minLength": -1})",
+             R"({"maxItems": 1.5})",
+             R"({"multipleOf": 0})",
+             R"({"pattern": "("})",
+             R"({"required": [1]})",
+             R"({"allOf": []})",
+             R"({"properties": {"a": 5}})",
+             R"({"$ref": "other.json#/a"})",
+             R"({"$ref": "#/definitions/missing"})",
+             R"({"definitions": {"a": {"$ref": "#/definitions/b"}, "b": {"$ref": "#/definitions/a"}},
+                 "$ref": "#/definitions/a"})",
+             R"({"allOf": [{"$ref": "#"}]})",
+         }) {
+        EXPECT_THROW(JsonSchema::compile(Parser::parseString(schema)), JsonException) << schema;
+    }
+    // Рекурсия через вложенное значение допустима
+    EXPECT_NO_THROW(JsonSchema::compile(Parser::parseString(R"({"items": {"$ref": "#"}})")));
+}
+
+TEST(JsonSchemaTest, CompilesRefsAndEmptySchemas) {
+    JsonSchema schema = JsonSchema::compile(Parser::parseString(R"({
+        "definitions": {"any": {}, "alias": {"$ref": "#/definitions/any"}, "n": {"type": "number"}},
+        "properties": {"a": {"$ref": "#/definitions/alias"}, "b": {"$ref": "#/definitions/n"}, "c": false},
+        "required": ["d"]
+    })"));
+    const JsonSchema::Node& root = schema.node(schema.root());
+    ASSERT_EQ(root.properties.size(), 4u);
+    EXPECT_EQ(JsonSchema::findProperty(root, "a")->node, JsonSchema::TRUE_NODE);
+    EXPECT_EQ(schema.node(JsonSchema::findProperty(root, "b")->node).types,
+              JsonSchema::INTEGER_TYPE | JsonSchema::FRACTION_TYPE);
+    EXPECT_EQ(JsonSchema::findProperty(root, "c")->node, JsonSchema::FALSE_NODE);
+    EXPECT_FALSE(JsonSchema::findProperty(root, "d")->declared);
+    EXPECT_EQ(JsonSchema::findProperty(root, "e"), nullptr);
+
+    EXPECT_EQ(JsonSchema::compile(Parser::parseString(R"({"title": "x", "allOf": [{}, true]})")).root(),
+              JsonSchema::TRUE_NODE);
+}
+
+TEST(JsonSchemaTest, ScalarKeywords) {
+    EXPECT_TRUE(valid(R"({"type": "integer"})", "3.0"));
+    EXPECT_FALSE(valid(R"({"type": "integer"})", "3.5"));
+    EXPECT_TRUE(valid(R"({"type": ["string", "null"]})", "null"));
+    EXPECT_TRUE(valid(R"({"exclusiveMinimum": 0, "maximum": 10})", "10"));
+    EXPECT_FALSE(valid(R"({"exclusiveMinimum": 0, "maximum": 10})", "0"));
+    EXPECT_TRUE(valid(R"({"multipleOf": 0.1})", "0.3"));
+    EXPECT_FALSE(valid(R"({"multipleOf": 2})", "7"));
+    // Длина - в символах, а не в байтах
+    EXPECT_TRUE(valid(R"({"maxLength": 3})", "\"ёжи\""));
+    EXPECT_FALSE(valid(R"({"minLength": 4})", "\"ёжи\""));
+    EXPECT_TRUE(valid(R"({"pattern": "^[a-z]+\\d$"})", "\"abc1\""));
+    EXPECT_FALSE(valid(R"({"pattern": "^[a-z]+\\d$"})", "\"abc\""));
+    EXPECT_TRUE(valid(R"({"enum": [1, "a", null]})", "1.0"));
+    EXPECT_FALSE(valid(R"({"const": "a"})", "\"b\""));
+    EXPECT_FALSE(valid("false", "1"));
+    EXPECT_TRUE(valid("true", "{\"a\": [1]}"));
+
+    // Все нарушения значения, а не только первое
+    std::vector<std::string> errors = errorsOf(R"({"type": "string", "minimum": 5, "enum": ["a"]})", "3");
+    ASSERT_EQ(errors.size(), 3u);
+    EXPECT_EQ(errors[0], ": Неверный тип: ожидается string, получено integer");
+    EXPECT_EQ(errors[1], ": Число меньше 5 (minimum)");
+    EXPECT_EQ(errors[2], ": Значение не входит в enum");
+}
+
+TEST(JsonSchemaTest, PatternsMatchInLinearTime) {
+    for (const auto& [pattern, text, expected] : std::vector<std::tuple<std::string, std::string, bool>>{
+             {"^a|b$", "xb", true},
+             {"^(?:ab|cd){2,3}$", "abcdab", true},
+             {"^(?:ab|cd){2,3}$", "ab", false},
+             {"colou?r", "my color", true},
+             {"^[^0-9\\s]+$", "abc", true},
+             {"^[^0-9\\s]+$", "ab c", false},
+             {"^[\\w-]+@\\w+\\.[a-z]{2,}$", "user-1@host.org", true},
+             {"\\bcat\\b", "concat", false},
+             {"\\bcat\\b", "a cat!", true},
+             {"^.$", "ё", true},                  // Точка - символ, а не байт
+             {"^\\u0451+$", "ёё", true},
+             {"^[а-я]+$", "ёжик", false},         // ё вне диапазона а-я
+             {"^(a*)*$", "aaaa", true},
+             {"^$", "", true},
+             {"a{,2}", "a{,2}", true},            // Не квантификатор - литерал
+             {"^(?<year>\\d{4})-\\d\\d$", "2024-01", true},
+             {"^(a)\\1$", "aa", true},            // Обратная ссылка - через std::regex
+         }) {
+        Regex regex(pattern);
+        EXPECT_EQ(regex.search(text), expected) << pattern << " ~ " << text;
+    }
+    EXPECT_FALSE(Regex("^[a-z]+$").usesFallback());
+    EXPECT_TRUE(Regex("^(?=.*\\d)").usesFallback());
+    EXPECT_THROW(Regex("a)"), JsonException);
+    EXPECT_THROW(Regex("[b-a]"), JsonException);
+
+    // 200 000 символов: std::regex переполнял стек
+    std::string text(200000, 'a');
+    EXPECT_TRUE(valid(R"({"type": "string", "pattern": "^[a-z]+$"})", "\"" + text + "\""));
+    EXPECT_FALSE(valid(R"({"type": "string", "pattern": "^[a-z]+$"})", "\"" + text + "1\""));
+    EXPECT_TRUE(valid(R"({"patternProperties": {"^a+$": {"type": "integer"}}})", "{\"" + text + "\": 1}"));
+    EXPECT_FALSE(valid(R"({"patternProperties": {"^a+$": {"type": "integer"}}})", "{\"" + text + "\": \"1\"}"));
+
+    // Выражения только для std::regex проверяются до предела длины
+    std::vector<std::string> errors = errorsOf(R"j({"pattern": "^(?=.*\\d)"})j", "\"" + text + "\"");
+    ASSERT_EQ(errors.size(), 1u);
+    EXPECT_EQ(errors[0], ": Строка длиннее 4096 байт не проверяется шаблоном \"^(?=.*\\d)\" (pattern)");
+    EXPECT_TRUE(valid(R"j({"pattern": "^(?=.*\\d)"})j", "\"a1\""));
+}
+
+TEST(JsonSchemaTest, ContainerKeywordsReportPathsAndPositions) {
+    SchemaResult result = validatorFor(RECORD_SCHEMA).validate(makeRecords(8));
+    std::vector<std::string> errors;
+    for (const SchemaError& error : result.errors) {
+        errors.push_back(error.path + ": " + error.message);
+    }
+    ASSERT_EQ(errors.size(), 3u);
+    EXPECT_EQ(errors[0], "/0/id: Число меньше 0 (minimum)");
+    EXPECT_EQ(errors[1], "/5/id: Число меньше 0 (minimum)");
+    EXPECT_EQ(errors[2], "/7/tags/0: Неверный тип: ожидается string, получено integer");
+    EXPECT_EQ(result.errors[0].line, 2u);
+    EXPECT_EQ(result.errors[0].column, 10u);
+    EXPECT_EQ(result.valueCount, 1 + 8 * 5u);
+
+    EXPECT_EQ(errorsOf(R"({"required": ["a", "b"], "maxProperties": 1, "additionalProperties": false,
+                           "properties": {"a": {}}})",
+                       "{\"a\": 1, \"c~/\": 2}"),
+              (std::vector<std::string>{"/c~0~1: Ключ 'c~/' не допускается (additionalProperties: false)",
+                                        ": В объекте больше 1 ключей (maxProperties)",
+                                        ": Отсутствует обязательный ключ 'b'"}));
+    EXPECT_EQ(errorsOf(R"({"items": [{"type": "string"}], "additionalItems": false, "contains": {"type": "null"}})",
+                       "[\"a\", 2]"),
+              (std::vector<std::string>{"/1: Лишний элемент массива: допускается не больше 1 (additionalItems: false)",
+                                        ": Ни один элемент массива не подходит под contains"}));
+
+    EXPECT_TRUE(valid(R"({"patternProperties": {"^x-": {"type": "integer"}}, "additionalProperties": {"type": "string"}})",
+                      R"({"x-a": 1, "b": "c"})"));
+    EXPECT_FALSE(valid(R"({"patternProperties": {"^x-": {"type": "integer"}}})", R"({"x-a": "1"})"));
+    EXPECT_FALSE(valid(R"({"propertyNames": {"maxLength": 2}})", R"({"abc": 1})"));
+    EXPECT_FALSE(valid(R"({"dependencies": {"a": ["b"]}})", R"({"a": 1})"));
+    EXPECT_TRUE(valid(R"({"dependencies": {"a": ["b"]}})", R"({"c": 1})"));
+    EXPECT_FALSE(valid(R"({"dependencies": {"a": {"required": ["c"]}}})", R"({"a": 1})"));
+    EXPECT_TRUE(valid(R"({"dependencies": {"a": {"required": ["c"]}}})", R"({"b": 1})"));
+}
+
+TEST(JsonSchemaTest, CombinatorsOnScalarsAndContainers) {
+    const char* anyOf = R"({"anyOf": [{"type": "string"}, {"type": "array", "items": {"type": "integer"}}]})";
+    EXPECT_TRUE(valid(anyOf, "\"a\""));
+    EXPECT_TRUE(valid(anyOf, "[1, 2]"));
+    EXPECT_EQ(errorsOf(anyOf, "[1, \"x\"]"),
+              (std::vector<std::string>{": Значение не подходит ни под одну схему anyOf"}));
+
+    const char* oneOf = R"({"oneOf": [{"type": "object", "required": ["a"]}, {"type": "object", "required": ["b"]}]})";
+    EXPECT_TRUE(valid(oneOf, R"({"a": 1})"));
+    EXPECT_FALSE(valid(oneOf, R"({"a": 1, "b": 2})"));
+    EXPECT_FALSE(valid(oneOf, R"({})"));
+
+    EXPECT_FALSE(valid(R"({"not": {"type": "array", "minItems": 1}})", "[0]"));
+    EXPECT_TRUE(valid(R"({"not": {"type": "array", "minItems": 1}})", "[]"));
+
+    const char* conditional = R"({"if": {"properties": {"kind": {"const": "n"}}},
+                                  "then": {"properties": {"value": {"type": "number"}}},
+                                  "else": {"properties": {"value": {"type": "string"}}}})";
+    EXPECT_TRUE(valid(conditional, R"({"kind": "n", "value": 1})"));
+    EXPECT_TRUE(valid(conditional, R"({"kind": "s", "value": "1"})"));
+    EXPECT_FALSE(valid(conditional, R"({"kind": "n", "value": "1"})"));
+    EXPECT_FALSE(valid(conditional, R"({"kind": "s", "value": 1})"));
+
+    // Нарушения внутри allOf - с путями вложенных значений
+    EXPECT_EQ(errorsOf(R"({"allOf": [{"items": {"type": "integer"}}, {"maxItems": 1}]})", "[1, true]"),
+              (std::vector<std::string>{"/1: Неверный тип: ожидается integer, получено boolean",
+                                        ": В массиве больше 1 элементов (maxItems)"}));
+}
+
+TEST(JsonSchemaTest, RecursiveRefsAndWholeValueKeywords) {
+    const char* tree = R"({"type": "object", "required": ["value"],
+                          "properties": {"value": {"type": "integer"},
+                                         "children": {"type": "array", "items": {"$ref": "#"}}}})";
+    EXPECT_TRUE(valid(tree, R"({"value": 1, "children": [{"value": 2, "children": [{"value": 3}]}]})"));
+    EXPECT_EQ(errorsOf(tree, R"({"value": 1, "children": [{"value": 2, "children": [{"value": "3"}]}]})"),
+              (std::vector<std::string>{"/children/0/children/0/value: Неверный тип: ожидается integer, получено string"}));
+
+    EXPECT_TRUE(valid(R"({"uniqueItems": true})", R"([1, "1", [1], {"a": 1}, {"a": 2}])"));
+    EXPECT_FALSE(valid(R"({"uniqueItems": true})", R"([{"a": [1, 2]}, {"a": [1, 2.0]}])"));
+    EXPECT_TRUE(valid(R"({"items": {"uniqueItems": true}})", R"([[1, 2], [1, 3]])"));
+    EXPECT_TRUE(valid(R"({"const": {"a": [1, {"b": null}]}})", R"({"a": [1, {"b": null}]})"));
+    EXPECT_FALSE(valid(R"({"const": {"a": [1, {"b": null}]}})", R"({"a": [1, {"b": false}]})"));
+    EXPECT_FALSE(valid(R"({"enum": [[1], 2]})", R"({"a": 1})"));
+}
+
+TEST(JsonSchemaTest, SyntaxErrorsStopValidation) {
+    SchemaValidator validator = validatorFor(R"({"type": "array"})");
+    for (const auto& [json, message] : std::vector<std::pair<std::string, std::string>>{
+             {"", "Пустой JSON"},
+             {"[1, 2,]", "Запятая перед закрывающей скобкой ']' не допускается"},
+             {"{\"a\" 1}", "Ожидалось ':' после ключа"},
+             {"[1] 2", "Неожиданные данные после JSON"},
+             {"[1, 2", "Незакрытый массив (пропущена ']')"},
+         }) {
+        SchemaResult result = validator.validate(json);
+        EXPECT_FALSE(result.isValid) << json;
+        EXPECT_TRUE(result.syntaxError) << json;
+        ASSERT_FALSE(result.errors.empty()) << json;
+        EXPECT_EQ(result.errors.back().message, message) << json;
+    }
+
+    SchemaResult lexical = validator.validate("[1, @]");
+    EXPECT_TRUE(lexical.syntaxError);
+    EXPECT_EQ(lexical.errors.back().column, 5u);
+
+    validator.setMaxDepth(3);
+    EXPECT_TRUE(validator.validate("[[[1]]]").isValid);
+    EXPECT_TRUE(validator.validate("[[[[1]]]]").syntaxError);
+}
+
+TEST(JsonSchemaTest, ParallelChunksMatchSequential) {
+    const std::string content = makeRecords(3000);
+    SchemaValidator sequential = validatorFor(RECORD_SCHEMA, 1);
+    SchemaResult expected = sequential.validate(content);
+    EXPECT_EQ(expected.chunkCount, 1u);
+    EXPECT_EQ(expected.errors.size(), 601u);
+
+    SchemaValidator parallel = validatorFor(RECORD_SCHEMA, 4);
+    parallel.setChunkSize(4096);
+    ParseStats stats;
+    SchemaResult actual = parallel.validate(content, &stats);
+    EXPECT_GT(actual.chunkCount, 10u);
+    EXPECT_EQ(stats.chunkSizes.size(), actual.chunkCount);
+    expectSameErrors(actual, expected);
+
+    // Нарушения, которые видны только по всему массиву
+    const char* whole = R"({"maxItems": 2000, "contains": {"const": -5}, "items": {"type": "object"}})";
+    expectSameErrors(validatorFor(whole, 4).validate(content), validatorFor(whole, 1).validate(content));
+
+    // Синтаксическая ошибка в середине: ошибка та же, что без порций
+    std::string broken = content;
+    broken.insert(broken.find("\"запись 1500\""), "{");
+    SchemaResult brokenResult = parallel.validate(broken);
+    EXPECT_TRUE(brokenResult.syntaxError);
+    expectSameErrors(brokenResult, sequential.validate(broken));
+
+    // Корень с anyOf проверяется последовательно
+    SchemaValidator combined = validatorFor(R"({"anyOf": [{"type": "array"}, {"type": "object"}]})", 4);
+    combined.setChunkSize(4096);
+    EXPECT_EQ(combined.validate(content).chunkCount, 1u);
+
+    parallel.setStopOnFirstError(true);
+    SchemaResult first = parallel.validate(content);
+    ASSERT_EQ(first.errors.size(), 1u);
+    EXPECT_EQ(first.errors[0].path, expected.errors[0].path);
+}
+
+TEST(JsonSchemaTest, ValidatesFilesAndValues) {
+    const std::string path = "schema_validator_test.json";
+    const std::string content = makeRecords(20000);
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << content;
+    }
+
+    SchemaValidator validator = validatorFor(RECORD_SCHEMA, 1);
+    SchemaResult expected = validator.validate(content);
+    // Файл больше блока чтения: проверка идёт по частям
+    ASSERT_GT(content.size(), 1024u * 1024);
+    ParseStats stats;
+    expectSameErrors(validator.validateFile(path, &stats), expected);
+    EXPECT_EQ(stats.bytes, content.size());
+
+    SchemaValidator parallel = validatorFor(RECORD_SCHEMA, 3);
+    parallel.setChunkSize(16 * 1024);
+    SchemaResult fromFile = parallel.validateFile(path);
+    EXPECT_GT(fromFile.chunkCount, 1u);
+    expectSameErrors(fromFile, expected);
+    std::remove(path.c_str());
+    EXPECT_THROW(validator.validateFile(path), JsonException);
+
+    // Уже построенное значение: те же нарушения без координат
+    SchemaResult fromValue = validator.validateValue(Parser::parseString(content));
+    ASSERT_EQ(fromValue.errors.size(), expected.errors.size());
+    for (size_t i = 0; i < expected.errors.size(); ++i) {
+        EXPECT_EQ(fromValue.errors[i].path, expected.errors[i].path);
+        EXPECT_EQ(fromValue.errors[i].message, expected.errors[i].message);
+        EXPECT_EQ(fromValue.errors[i].line, 0u);
+    }
+}
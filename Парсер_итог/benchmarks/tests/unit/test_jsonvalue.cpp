@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "JsonValue.hpp"
+#include <thread>
 
 using namespace json;
 
@@ -287,6 +288,119 @@ TEST(JsonValueTest, MoveConstructor) {
     EXPECT_EQ(moved.asString(), "Hello");
 }
 
+TEST(JsonValueTest, CompactNode) {
+    EXPECT_EQ(sizeof(JsonValue), 16u);
+
+    // Глубокая копия: изменение копии не затрагивает оригинал
+    JsonObject obj;
+    obj["list"] = JsonValue(JsonArray{JsonValue(1), JsonValue("two"), JsonValue(true)});
+    JsonValue original(std::move(obj));
+    JsonValue copy = original;
+    copy["list"].asArray().push_back(JsonValue(nullptr));
+    EXPECT_EQ(original.at("list").size(), 3u);
+    EXPECT_EQ(copy.at("list").size(), 4u);
+    EXPECT_EQ(copy.at("list")[1].asString(), "two");
+    EXPECT_EQ(copy.type(), JsonValue::Type::Object);
+}
+
+TEST(JsonValueTest, AssignFromOwnChild) {
+    // Источник - часть заменяемого дерева
+    JsonValue value(JsonArray{JsonValue(JsonArray{JsonValue("inner")})});
+    value = value[0];
+    ASSERT_TRUE(value.isArray());
+    EXPECT_EQ(value[0].asString(), "inner");
+
+    value = std::move(value[0]);
+    EXPECT_EQ(value.asString(), "inner");
+
+    JsonValue moved = std::move(value);
+    EXPECT_TRUE(value.isNull());
+    EXPECT_EQ(moved.asString(), "inner");
+}
+
+TEST(JsonValueTest, CopyOnWriteSnapshot) {
+    JsonObject root;
+    root["edited"] = JsonValue(JsonObject{{"x", JsonValue(1)}});
+    root["untouched"] = JsonValue(JsonArray(1000, JsonValue("payload")));
+    JsonValue doc(std::move(root));
+
+    // Снимок разделяет всё дерево
+    JsonValue snapshot = doc;
+    EXPECT_TRUE(doc.isShared());
+
+    // Правка отделяет только пройденный путь
+    doc["edited"]["x"] = JsonValue(2);
+    EXPECT_EQ(snapshot.at("edited").at("x").asNumber(), 1.0);
+    EXPECT_EQ(doc.at("edited").at("x").asNumber(), 2.0);
+    EXPECT_FALSE(doc.at("edited").isShared());
+    EXPECT_TRUE(doc.at("untouched").isShared());
+    EXPECT_EQ(&doc.at("untouched").asArray(), &snapshot.at("untouched").asArray());
+
+    // Поиск по пути для изменения тоже отделяет путь
+    auto found = snapshot.findByPath("untouched[3]");
+    ASSERT_TRUE(found.has_value());
+    found->get() = JsonValue(nullptr);
+    EXPECT_TRUE(doc.at("untouched")[3].isString());
+    EXPECT_TRUE(snapshot.at("untouched")[3].isNull());
+}
+
+TEST(JsonValueTest, SharedCopiesAcrossThreads) {
+    JsonValue doc(JsonArray(100, JsonValue(JsonObject{{"name", JsonValue("item")}})));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&doc, t]() {
+            for (int i = 0; i < 1000; ++i) {
+                size_t index = static_cast<size_t>(i % 100);
+                JsonValue local = doc;
+                local[index]["owner"] = JsonValue(t);
+
+                const JsonValue& shared = doc;
+                const JsonValue& edited = local;
+                EXPECT_EQ(edited[index].size(), 2u);
+                EXPECT_EQ(shared[index].size(), 1u);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_FALSE(doc.isShared());
+    EXPECT_FALSE(doc[0].contains("owner"));
+}
+
+TEST(JsonValueTest, StructuralHashTracksMutation) {
+    JsonObject user;
+    user["name"] = "Анна";
+    user["tags"] = JsonArray{JsonValue("a"), JsonValue(1)};
+    JsonValue doc(JsonArray{JsonValue(user), JsonValue(-0.0), JsonValue(nullptr)});
+
+    JsonValue same(JsonArray{JsonValue(user), JsonValue(0.0), JsonValue(nullptr)});
+    EXPECT_EQ(doc.hash(), same.hash());
+    EXPECT_NE(JsonValue("1").hash(), JsonValue(1).hash());
+    EXPECT_NE(JsonValue(JsonArray()).hash(), JsonValue(JsonObject()).hash());
+
+    // Правка сбрасывает кэш на пути, снимок сохраняет свой хэш
+    JsonValue snapshot = doc;
+    uint64_t before = doc.hash();
+    doc[0]["tags"].push_back(2);
+    EXPECT_NE(doc.hash(), before);
+    EXPECT_EQ(snapshot.hash(), before);
+
+    doc[0]["tags"].erase(size_t(2));
+    EXPECT_EQ(doc.hash(), before);
+
+    JsonArray wide;
+    for (int i = 0; i < 1000; ++i) {
+        wide.push_back(JsonValue(JsonArray{JsonValue(i), JsonValue(user)}));
+    }
+    JsonValue parallel(wide);
+    JsonValue serial(std::move(wide));
+    parallel.computeHashes(4);
+    EXPECT_EQ(parallel.hash(), serial.hash());
+}
+
 TEST(JsonValueTest, LargeArray) {
     JsonArray arr;
     for (int i = 0; i < 1000; ++i) {
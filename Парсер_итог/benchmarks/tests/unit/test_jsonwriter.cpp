@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "JsonWriter.hpp"
+#include "Parser.hpp"
+#include "Serializer.hpp"
+#include <sstream>
+#include <limits>
+
+using namespace json;
+
+// Тесты компактного вывода
+TEST(JsonWriterTest, CompactObject) {
+    std::string out;
+    JsonWriter writer(out, JsonWriter::Options::compact());
+    writer.beginObject()
+          .key("id").value(1)
+          .key("name").value("Alice")
+          .key("active").value(true)
+          .key("score").value(3.5)
+          .key("tags").beginArray().value("a").null().endArray()
+          .endObject();
+
+    EXPECT_TRUE(writer.isComplete());
+    EXPECT_EQ(out, R"({"id":1,"name":"Alice","active":true,"score":3.5,"tags":["a",null]})");
+}
+
+TEST(JsonWriterTest, EmptyContainers) {
+    std::string out;
+    JsonWriter writer(out);
+    writer.beginArray().beginObject().endObject().beginArray().endArray().endArray();
+    EXPECT_EQ(out, "[\n  {},\n  []\n]");
+}
+
+TEST(JsonWriterTest, PrettyMatchesSerializer) {
+    JsonValue doc = Parser::parseString(
+        R"({"a": [1, 2.25, "x"], "b": {"c": null, "d": false}, "e": []})");
+
+    std::string out;
+    JsonWriter writer(out, JsonWriter::Options::pretty(2));
+    writer.value(doc);
+
+    EXPECT_EQ(out, Serializer::toString(doc, true));
+}
+
+TEST(JsonWriterTest, EscapesStrings) {
+    std::string out;
+    JsonWriter writer(out, JsonWriter::Options::compact());
+    writer.value(std::string("q\"b\\n\n\x01"));
+    EXPECT_EQ(out, R"("q\"b\\n\n\u0001")");
+
+    auto parsed = Parser::parseString(out);
+    EXPECT_EQ(parsed.asString(), std::string("q\"b\\n\n\x01"));
+}
+
+TEST(JsonWriterTest, StreamOutputWithSmallBuffer) {
+    std::ostringstream os;
+    JsonWriter::Options opts = JsonWriter::Options::compact();
+    opts.bufferSize = 16;
+
+    {
+        JsonWriter writer(os, opts);
+        writer.beginArray();
+        for (int i = 0; i < 1000; ++i) {
+            writer.value(i);
+        }
+        writer.endArray();
+        EXPECT_GT(writer.bytesWritten(), 1000u);
+    }
+
+    auto parsed = Parser::parseString(os.str());
+    ASSERT_TRUE(parsed.isArray());
+    EXPECT_EQ(parsed.size(), 1000u);
+    EXPECT_DOUBLE_EQ(parsed[999].asNumber(), 999.0);
+}
+
+// Тесты проверки вложенности
+TEST(JsonWriterTest, NestingErrorsThrow) {
+    std::string out;
+    JsonWriter writer(out);
+
+    EXPECT_THROW(writer.endArray(), JsonException);
+    EXPECT_THROW(writer.key("k"), JsonException);
+
+    writer.beginObject();
+    EXPECT_THROW(writer.value(1), JsonException);   // значение без ключа
+    EXPECT_THROW(writer.endArray(), JsonException); // неверный тип скобки
+    writer.key("k");
+    EXPECT_THROW(writer.key("k2"), JsonException);  // два ключа подряд
+    EXPECT_THROW(writer.endObject(), JsonException);
+    writer.value(1).endObject();
+
+    EXPECT_TRUE(writer.isComplete());
+    EXPECT_THROW(writer.value(2), JsonException);   // второй корень
+}
+
+TEST(JsonWriterTest, RejectsNonFiniteNumbers) {
+    std::string out;
+    JsonWriter writer(out);
+    EXPECT_THROW(writer.value(std::numeric_limits<double>::infinity()), JsonException);
+}
@@ -72,6 +72,36 @@ TEST(LexerTest, StringWithCyrillicUnicode) {
     EXPECT_EQ(tokens[0].type, TokenType::String);
 }
 
+TEST(LexerTest, LongStringWithEscapesBetweenRuns) {
+    // Участки длиннее 16 байт проходят векторный поиск, escape - на границах
+    std::string text(40, 'a');
+    Lexer lexer("\"" + text + "\\n" + text + "\\u0416" + text + "\\\"\" 1");
+    auto tokens = lexer.tokenize();
+
+    ASSERT_EQ(tokens.size(), 3);
+    EXPECT_EQ(tokens[0].value, text + "\n" + text + "\xD0\x96" + text + "\"");
+    EXPECT_EQ(tokens[1].column, 134u);
+}
+
+TEST(LexerTest, StringErrorPositions) {
+    std::string text(20, 'x');
+    try {
+        Lexer(R"({"k": ")" + text + "\x01\"}").tokenize();
+        FAIL() << "Ожидалось исключение";
+    } catch (const LexerException& e) {
+        EXPECT_EQ(e.column, 28u);
+    }
+
+    try {
+        Lexer(R"("ab\u00G1")").tokenize();
+        FAIL() << "Ожидалось исключение";
+    } catch (const LexerException& e) {
+        EXPECT_EQ(e.column, 8u);
+    }
+
+    EXPECT_THROW(Lexer(R"("\u00)").tokenize(), LexerException);
+}
+
 // Тесты для чисел
 TEST(LexerTest, PositiveInteger) {
     Lexer lexer("42");
@@ -239,3 +269,113 @@ TEST(LexerTest, VerySmallNumber) {
     auto tokens = lexer.tokenize();
     EXPECT_EQ(tokens[0].type, TokenType::Number);
 }
+
+// Тесты для пошагового входа
+namespace {
+
+// Токены входа, поданного частями по step байт
+std::vector<Token> tokenizeInParts(const std::string& input, size_t step) {
+    Lexer lexer;
+    std::vector<Token> tokens;
+    for (size_t pos = 0; pos < input.size(); pos += step) {
+        lexer.append(input.data() + pos, std::min(step, input.size() - pos));
+        lexer.tokenizeAvailable(tokens);
+    }
+    lexer.finish();
+    EXPECT_TRUE(lexer.tokenizeAvailable(tokens));
+    return tokens;
+}
+
+} // namespace
+
+TEST(LexerTest, IncrementalMatchesWholeInput) {
+    const std::string input = "{\"name\": \"Анна \\u0041\\ud83d\\ude00\", \"n\": -12.5e+3,\n"
+                              " \"list\": [true, false, null, 0, 12345678901234567890],\n"
+                              " \"long\": \"" + std::string(100, 'x') + "\\n\"}";
+    std::vector<Token> expected = Lexer(input).tokenize();
+
+    for (size_t step : {1u, 2u, 3u, 7u, 64u, 1000u}) {
+        std::vector<Token> tokens = tokenizeInParts(input, step);
+        ASSERT_EQ(tokens.size(), expected.size()) << "step " << step;
+        for (size_t i = 0; i < tokens.size(); ++i) {
+            EXPECT_EQ(tokens[i].type, expected[i].type);
+            EXPECT_EQ(tokens[i].value, expected[i].value);
+            EXPECT_EQ(tokens[i].line, expected[i].line);
+            EXPECT_EQ(tokens[i].column, expected[i].column);
+            EXPECT_EQ(tokens[i].offset, expected[i].offset);
+        }
+    }
+}
+
+TEST(LexerTest, IncrementalReportsErrorsLikeWholeInput) {
+    // Незакрытая строка видна только в конце входа
+    EXPECT_THROW(tokenizeInParts("[\"abc", 2), LexerException);
+
+    // Ошибка в середине и некорректный UTF-8 на границе частей
+    for (const std::string& input : {std::string("[1, tru, 2]"), std::string("[\"a\xC3\", 1]")}) {
+        size_t line = 0;
+        size_t column = 0;
+        try {
+            Lexer(input).tokenize();
+        } catch (const LexerException& e) {
+            line = e.line;
+            column = e.column;
+        }
+        ASSERT_GT(line, 0u) << input;
+        for (size_t step : {1u, 4u}) {
+            try {
+                tokenizeInParts(input, step);
+                ADD_FAILURE() << "Нет ошибки: " << input;
+            } catch (const LexerException& e) {
+                EXPECT_EQ(e.line, line);
+                EXPECT_EQ(e.column, column);
+            }
+        }
+    }
+}
+
+TEST(LexerTest, DiscardAndStartPositionKeepCoordinates) {
+    const std::string input = "[\n  {\"a\": 1},\n  \"строка\",\n  [true, null]\n]";
+    std::vector<Token> expected = Lexer(input).tokenize();
+
+    // Разобранное начало отбрасывается после каждой части
+    Lexer lexer;
+    std::vector<Token> tokens;
+    for (size_t pos = 0; pos < input.size(); pos += 3) {
+        lexer.append(input.data() + pos, std::min<size_t>(3, input.size() - pos));
+        lexer.tokenizeAvailable(tokens);
+        lexer.discardConsumed();
+    }
+    lexer.finish();
+    EXPECT_TRUE(lexer.tokenizeAvailable(tokens));
+    ASSERT_EQ(tokens.size(), expected.size());
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        EXPECT_EQ(tokens[i].value, expected[i].value);
+        EXPECT_EQ(tokens[i].line, expected[i].line);
+        EXPECT_EQ(tokens[i].column, expected[i].column);
+        EXPECT_EQ(tokens[i].offset, expected[i].offset);
+    }
+
+    // Фрагмент с третьей строки: координаты те же, что во всём входе
+    size_t start = input.find("\"строка\"");
+    Lexer fragment(input.substr(start));
+    fragment.setStartPosition(3, 3, start);
+    Token token = fragment.nextToken();
+    EXPECT_EQ(token.value, "строка");
+    EXPECT_EQ(token.line, 3u);
+    EXPECT_EQ(token.column, 3u);
+    EXPECT_EQ(token.offset, start);
+    std::vector<Token> rest = fragment.tokenize();
+    EXPECT_EQ(rest.back().offset, input.size());
+
+    // Ошибка UTF-8 во фрагменте - тоже в координатах всего входа
+    Lexer broken(std::string("1,\n  \"a\xC3\""));
+    broken.setStartPosition(5, 7, 100);
+    try {
+        broken.tokenize();
+        ADD_FAILURE() << "Нет ошибки";
+    } catch (const LexerException& e) {
+        EXPECT_EQ(e.line, 6u);
+        EXPECT_EQ(e.column, 5u);
+    }
+}
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include "Parser.hpp"
+#include "Serializer.hpp"
+#include <cstdio>
+#include <fstream>
 
 using namespace json;
 
@@ -324,3 +327,109 @@ TEST(ParserTest, ParseVerySmallNumber) {
     auto value = Parser::parseString("2.2250738585072014e-308");
     EXPECT_TRUE(value.isNumber());
 }
+
+// Тесты отложенного преобразования чисел
+TEST(ParserTest, LazyNumbersKeepOriginalText) {
+    const std::string input = R"({"big":12345678901234567890123,"exp":1E+2,"f":0.10000000000000000001,"n":-0})";
+    JsonValue value = Parser::parseString(input, NumberMode::Lazy);
+
+    const JsonValue& exp = value.at("exp");
+    EXPECT_TRUE(exp.isNumber());
+    EXPECT_TRUE(exp.isRawNumber());
+    EXPECT_EQ(exp.numberText(), "1E+2");
+    EXPECT_DOUBLE_EQ(exp.asNumber(), 100.0);
+    EXPECT_EQ(exp.asInt64(), 100);
+
+    // Запись без изменений: точный круговой обход
+    EXPECT_EQ(Serializer::toString(value, false), input);
+}
+
+TEST(ParserTest, LazyNumbersAsInt64IsExact) {
+    JsonValue value = Parser::parseString("[9007199254740993, -9223372036854775808, 1.5, 1e30]",
+                                          NumberMode::Lazy);
+
+    EXPECT_EQ(value[0].asInt64(), 9007199254740993LL);
+    EXPECT_EQ(value[1].asInt64(), INT64_MIN);
+    EXPECT_THROW(value[2].asInt64(), JsonException);
+    EXPECT_THROW(value[3].asInt64(), JsonException);
+
+    // В режиме Eager 2^53 + 1 уже округлено до double
+    JsonValue eager = Parser::parseString("[9007199254740993]");
+    EXPECT_FALSE(eager[0].isRawNumber());
+    EXPECT_EQ(eager[0].asInt64(), 9007199254740992LL);
+}
+
+TEST(ParserTest, MaxDepthLimitsNesting) {
+    auto nested = [](size_t depth) {
+        return std::string(depth, '[') + "{\"k\":1}" + std::string(depth, ']');
+    };
+
+    // Объект внутри 999 массивов - ровно 1000 уровней
+    JsonValue value = Parser::parseString(nested(Parser::DEFAULT_MAX_DEPTH - 1));
+    EXPECT_TRUE(value.isArray());
+
+    // Заведомо враждебный вход: ошибка вместо переполнения стека
+    std::string hostile(1000000, '[');
+    try {
+        Parser::parseString(hostile);
+        FAIL() << "Ожидалось исключение";
+    } catch (const ParserException& e) {
+        EXPECT_EQ(e.column, Parser::DEFAULT_MAX_DEPTH + 1);
+    }
+
+    Lexer lexer(nested(10));
+    Parser parser(lexer.tokenize());
+    parser.setMaxDepth(10);
+    EXPECT_THROW(parser.parse(), ParserException);
+}
+
+TEST(ParserTest, IterativeParseKeepsStructure) {
+    JsonValue value = Parser::parseString(R"({"a": [1, {"b": [], "c": {}}, [[2]]], "d": "x"})");
+
+    ASSERT_TRUE(value.isObject());
+    EXPECT_EQ(value.at("a").asArray().size(), 3u);
+    EXPECT_TRUE(value.at("a")[1].at("b").isArray());
+    EXPECT_TRUE(value.at("a")[1].at("c").isObject());
+    EXPECT_EQ(value.at("a")[2][0][0].asNumber(), 2.0);
+    EXPECT_EQ(value.at("d").asString(), "x");
+
+    EXPECT_THROW(Parser::parseString("[1, [2,]]"), ParserException);
+    EXPECT_THROW(Parser::parseString(R"({"a": 1 "b": 2})"), ParserException);
+    EXPECT_THROW(Parser::parseString("[[1]"), ParserException);
+}
+
+TEST(ParserTest, ParseFileWithProgressReadsAcrossBlocks) {
+    // Больше трёх блоков чтения по 1 МБ; строки пересекают границы блоков
+    std::string item = R"({"text": "строка \"с\" escape", "v": [1.5, true, null], "pad": ")" +
+                       std::string(4000, '.') + "\"}";
+    std::string json = "[";
+    size_t count = 0;
+    for (; json.size() < 3500000; ++count) {
+        if (count > 0) json += ",\n";
+        json += item;
+    }
+    json += "]";
+    const char* path = "parser_progress_test.json";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << json;
+    }
+
+    size_t lastRead = 0;
+    JsonValue value = Parser::parseFileWithProgress(path, [&](size_t current, size_t total) {
+        if (total == json.size()) lastRead = std::max(lastRead, current);
+    });
+    EXPECT_EQ(lastRead, json.size());
+    ASSERT_TRUE(value.isArray());
+    ASSERT_EQ(value.asArray().size(), count);
+    EXPECT_EQ(Serializer::toString(value[count - 1], false),
+              Serializer::toString(Parser::parseString(item), false));
+
+    // Ошибка в последнем блоке
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << json.substr(0, json.size() - 1);
+    }
+    EXPECT_THROW(Parser::parseFileWithProgress(path), ParserException);
+    std::remove(path);
+}
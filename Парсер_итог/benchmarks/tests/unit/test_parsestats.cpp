@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include "Parser.hpp"
+#include "Validator.hpp"
+#include "ParallelProcessor.hpp"
+#include <cstdio>
+#include <fstream>
+
+using namespace json;
+
+namespace {
+
+std::string makeArray(int count) {
+    std::string json = "[";
+    for (int i = 0; i < count; ++i) {
+        if (i > 0) json += ",";
+        json += R"({"id":)" + std::to_string(i) + R"(,"name":"item"})";
+    }
+    json += "]";
+    return json;
+}
+
+} // namespace
+
+TEST(ParseStatsTest, ParseStringCountsTokensAndValues) {
+    ParseStats stats;
+    JsonValue value = Parser::parseString(R"({"a": [1, 2, 3], "b": null})", &stats);
+
+    EXPECT_TRUE(value.isObject());
+    EXPECT_EQ(stats.tokens, 16u);      // Включая EndOfFile
+    EXPECT_EQ(stats.elements, 6u);     // Объект, массив, три числа, null
+    EXPECT_EQ(stats.tokenize.calls, 1u);
+    EXPECT_EQ(stats.parse.calls, 1u);
+    EXPECT_EQ(stats.total.calls, 1u);
+    EXPECT_GT(stats.bytes, 0u);
+}
+
+TEST(ParseStatsTest, ParallelParseReportsWorkersAndChunks) {
+    const std::string path = "parse_stats_test.json";
+    std::string json = makeArray(5000);
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << json;
+    }
+
+    ParseStats stats;
+    JsonValue value = Parser::parseFileParallel(path, 4, nullptr, &stats);
+    std::remove(path.c_str());
+
+    ASSERT_TRUE(value.isArray());
+    EXPECT_EQ(value.size(), 5000u);
+    EXPECT_EQ(stats.bytes, json.size());
+    EXPECT_EQ(stats.elements, 5000u);
+    EXPECT_EQ(stats.read.calls, 1u);
+    EXPECT_EQ(stats.boundaryScan.calls, 1u);
+    EXPECT_GT(stats.chunkSizes.size(), 1u);
+    EXPECT_EQ(stats.workers.size(), stats.chunkSizes.size());
+    EXPECT_EQ(stats.tokenize.calls, stats.chunkSizes.size());
+    EXPECT_GT(stats.tokens, 0u);
+
+    size_t workerBytes = 0;
+    for (const auto& w : stats.workers) {
+        workerBytes += w.bytes;
+        EXPECT_GE(w.busyMs, 0.0);
+        EXPECT_GE(w.idleMs, 0.0);
+    }
+    EXPECT_LE(workerBytes, json.size());
+    EXPECT_GT(workerBytes, json.size() / 2);
+}
+
+TEST(ParseStatsTest, ValidatorAndParallelProcessorFillStats) {
+    std::string json = makeArray(2000);
+
+    ParseStats stats;
+    Validator validator;
+    EXPECT_TRUE(validator.validate(json, &stats).isValid);
+    EXPECT_EQ(stats.bytes, json.size());
+    EXPECT_GT(stats.tokens, 0u);
+    EXPECT_EQ(stats.parse.calls, 1u);
+
+    ParallelProcessor processor(4);
+    ParallelResult result = processor.validateContent(json);
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.stats.bytes, json.size());
+    EXPECT_EQ(result.stats.chunkSizes.size(), result.totalChunks);
+    EXPECT_EQ(result.stats.boundaryScan.calls, 1u);
+    EXPECT_GT(result.stats.tokens, 0u);
+}
+
+TEST(ParseStatsTest, GeneratorReportsStages) {
+    const std::string path = "parse_stats_gen_test.json";
+
+    ParallelGenerator generator(2);
+    generator.setChunkSize(16 * 1024);
+    generator.setSeed(1);
+
+    ParseStats stats;
+    ASSERT_TRUE(generator.generateLargeFile(path, 100 * 1024, 3, 0, nullptr, &stats));
+    std::remove(path.c_str());
+
+    EXPECT_EQ(stats.bytes, generator.getGeneratedBytes());
+    EXPECT_EQ(stats.workers.size(), 2u);
+    EXPECT_EQ(stats.chunkSizes.size(), stats.generate.calls);
+    EXPECT_EQ(stats.write.calls, stats.chunkSizes.size());
+    EXPECT_FALSE(stats.toString().empty());
+}
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include "Serializer.hpp"
+#include "Parser.hpp"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace json;
+namespace fs = std::filesystem;
+
+namespace {
+
+void writeText(const std::string& name, const std::string& content) {
+    std::ofstream file(name, std::ios::binary);
+    file << content;
+}
+
+std::string readText(const std::string& name) {
+    std::ifstream file(name, std::ios::binary);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+// Разбор с участками контейнеров в исходном файле
+JsonValue parseWithSpans(const SourceFile& source) {
+    Lexer lexer(readText(source.path));
+    Parser parser(lexer.tokenize());
+    parser.setSourceSpans(source.id);
+    return parser.parse();
+}
+
+} // namespace
+
+TEST(SerializerTest, ParserRecordsContainerSpans) {
+    const std::string text = R"( {"a": [1,  2], "b": { }} )";
+    Lexer lexer(text);
+    Parser parser(lexer.tokenize());
+    parser.setSourceSpans(7, 100);
+    JsonValue root = parser.parse();
+
+    SourceSpan span;
+    ASSERT_TRUE(root.sourceSpan(span));
+    EXPECT_EQ(span.source, 7u);
+    EXPECT_EQ(span.offset, 101u);
+    EXPECT_EQ(span.length, text.size() - 2);
+
+    ASSERT_TRUE(root.at("a").sourceSpan(span));
+    EXPECT_EQ(text.substr(span.offset - 100, span.length), "[1,  2]");
+    ASSERT_TRUE(root.at("b").sourceSpan(span));
+    EXPECT_EQ(text.substr(span.offset - 100, span.length), "{ }");
+
+    // Доступ для изменения снимает участок с пути, но не с соседей
+    JsonValue snapshot = root;
+    root["a"].push_back(3);
+    EXPECT_FALSE(root.sourceSpan(span));
+    EXPECT_FALSE(root.at("a").sourceSpan(span));
+    EXPECT_TRUE(root.at("b").sourceSpan(span));
+    EXPECT_TRUE(snapshot.sourceSpan(span));
+    EXPECT_TRUE(snapshot.at("a").sourceSpan(span));
+}
+
+TEST(SerializerTest, IncrementalSaveCopiesUntouchedContainers) {
+    const std::string name = "serializer_incremental.json";
+    writeText(name, "{\n  \"a\": [\n    1,\n    2,\n    3\n  ],\n  \"b\": {\n    \"x\": true\n  },\n  \"c\": []\n}\n");
+    SourceFile source = SourceFile::capture(name);
+    JsonValue root = parseWithSpans(source);
+
+    root["b"]["x"] = false;
+
+    Serializer serializer;
+    Serializer::IncrementalStats stats;
+    ASSERT_TRUE(serializer.saveIncremental(root, source, name, &stats));
+    EXPECT_EQ(readText(name), serializer.serialize(root) + "\n");
+    EXPECT_EQ(source.layout, SourceFile::Layout::Pretty);
+    EXPECT_EQ(stats.copiedSpans, 2u);
+    EXPECT_EQ(stats.copiedBytes, 27u);
+    EXPECT_EQ(stats.copiedBytes + stats.serializedBytes, fs::file_size(name));
+    EXPECT_FALSE(fs::exists(name + ".tmp"));
+
+    // Участки перенесены в новый файл: следующая правка тоже инкрементальна
+    root["a"][0] = 10;
+    ASSERT_TRUE(serializer.saveIncremental(root, source, name, &stats));
+    EXPECT_EQ(stats.copiedSpans, 2u);
+    EXPECT_EQ(Serializer::toString(Parser::parseFile(name), false),
+              R"({"a":[10,2,3],"b":{"x":false},"c":[]})");
+
+    // Без правок файл копируется целиком
+    ASSERT_TRUE(serializer.saveIncremental(root, source, name, &stats));
+    EXPECT_EQ(stats.copiedSpans, 1u);
+    EXPECT_EQ(stats.serializedBytes, 1u);
+
+    fs::remove(name);
+}
+
+TEST(SerializerTest, IncrementalSaveFollowsOutputOptions) {
+    const std::string name = "serializer_options.json";
+    const std::string text = "[\n    {\n        \"a\": 1,\n        \"b\": [\n            1,\n            2\n        ]\n    },\n"
+                             "    {\n        \"c\": \"é\"\n    }\n]\n";
+    Serializer::IncrementalStats stats;
+    auto save = [&](const Serializer::Options& options) {
+        writeText(name, text);
+        SourceFile source = SourceFile::capture(name);
+        JsonValue root = parseWithSpans(source);
+        root[1]["d"] = true;
+        EXPECT_TRUE(Serializer(options).saveIncremental(root, source, name, &stats));
+        EXPECT_EQ(readText(name), Serializer(options).serialize(root) + "\n");
+        return source;
+    };
+
+    // Другой режим, отступ или экранирование: результат как у saveToFile
+    Serializer::Options escaped = Serializer::Options::compact();
+    escaped.escapeUnicode = true;
+    for (const Serializer::Options& options : {Serializer::Options::compact(), Serializer::Options::pretty(2),
+                                               escaped}) {
+        save(options);
+        EXPECT_EQ(stats.copiedBytes, 0u);
+    }
+    EXPECT_EQ(readText(name).find("é"), std::string::npos);
+
+    // Тот же отступ: неизменённый первый элемент копируется
+    SourceFile source = save(Serializer::Options::pretty(4));
+    EXPECT_EQ(source.layout, SourceFile::Layout::Pretty);
+    EXPECT_EQ(source.indentSize, 4);
+    EXPECT_EQ(stats.copiedSpans, 1u);
+
+    // Файл не в формате Serializer сохраняется целиком
+    writeText(name, "[[1,  2], {\"k\": \"v\"}]");
+    SourceFile other = SourceFile::capture(name);
+    JsonValue loose = parseWithSpans(other);
+    ASSERT_TRUE(Serializer(Serializer::Options::compact()).saveIncremental(loose, other, name, &stats));
+    EXPECT_EQ(stats.copiedBytes, 0u);
+    EXPECT_EQ(readText(name), "[[1,2],{\"k\":\"v\"}]\n");
+
+    fs::remove(name);
+}
+
+TEST(SerializerTest, IncrementalSaveSerializesWhenSourceChanged) {
+    const std::string name = "serializer_changed.json";
+    const std::string copy = "serializer_changed_copy.json";
+    writeText(name, "[[1, 2], {\"k\": \"v\"}]");
+    SourceFile source = SourceFile::capture(name);
+    JsonValue root = parseWithSpans(source);
+
+    writeText(name, "[\"другое содержимое\"]");
+
+    Serializer::IncrementalStats stats;
+    ASSERT_TRUE(Serializer(Serializer::Options::compact()).saveIncremental(root, source, copy, &stats));
+    EXPECT_EQ(stats.copiedBytes, 0u);
+    EXPECT_EQ(readText(copy), "[[1,2],{\"k\":\"v\"}]\n");
+    EXPECT_EQ(source.path, copy);
+
+    fs::remove(name);
+    fs::remove(copy);
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include "TolerantParser.hpp"
+#include "Generator.hpp"
+#include "Serializer.hpp"
+
+using namespace json;
+
+namespace {
+
+TolerantResult parseWith(const std::string& content, unsigned int threads = 1,
+                         size_t chunkSize = TolerantParser::DEFAULT_CHUNK_SIZE) {
+    TolerantParser parser(threads);
+    parser.setChunkSize(chunkSize);
+    return parser.parse(content);
+}
+
+// Документ из элементов генератора, часть из них с ошибками
+std::string generatedDocument(int errorProbability, size_t count) {
+    Generator generator(11);
+    GeneratorOptions opts;
+    opts.maxDepth = 3;
+    opts.errorProbability = errorProbability;
+    opts.compactOutput = true;
+    generator.setOptions(opts);
+
+    std::string content = "[\n";
+    for (size_t i = 0; i < count; ++i) {
+        if (i > 0) content += ",\n";
+        generator.generateInto(content);
+    }
+    content += "\n]";
+    return content;
+}
+
+} // namespace
+
+TEST(TolerantParserTest, CleanArrayMatchesParser) {
+    std::string content = R"([
+  {"id": 1, "tags": ["a", "b"], "ok": true},
+  {"id": 2, "nested": {"x": null, "y": -1.5e3}},
+  "text é😀",
+  []
+])";
+    TolerantResult result = parseWith(content);
+
+    EXPECT_TRUE(result.errors.empty());
+    EXPECT_EQ(result.skippedElements, 0u);
+    EXPECT_EQ(Serializer::toString(JsonValue(result.elements), false),
+              Serializer::toString(Parser::parseString(content), false));
+}
+
+TEST(TolerantParserTest, SkipsBrokenElementsWithPositions) {
+    std::string content =
+        "[\n"
+        "{\"a\": 1},\n"
+        "{\"b\": tru},\n"
+        "{\"c\" 3, \"d\": {\"e\": [1, 2]}},\n"
+        "{\"f\": \"unterminated},\n"
+        "{\"g\": 7}\n"
+        "]";
+    TolerantResult result = parseWith(content);
+
+    ASSERT_EQ(result.elements.size(), 2u);
+    EXPECT_DOUBLE_EQ(result.elements[0].at("a").asNumber(), 1.0);
+    EXPECT_DOUBLE_EQ(result.elements[1].at("g").asNumber(), 7.0);
+    EXPECT_EQ(result.skippedElements, 3u);
+
+    ASSERT_EQ(result.errors.size(), 3u);
+    EXPECT_EQ(result.errors[0].line, 3u);
+    EXPECT_EQ(result.errors[0].column, 7u);
+    EXPECT_NE(result.errors[0].message.find("tru"), std::string::npos);
+    EXPECT_EQ(result.errors[1].line, 4u);
+    EXPECT_EQ(result.errors[2].line, 5u);
+    EXPECT_EQ(result.errors[2].context, "{\"f\": \"unterminated},");
+}
+
+TEST(TolerantParserTest, MissingBracketCostsOneElement) {
+    // Отформатированный файл: у второго элемента нет закрывающей '}'
+    std::string content =
+        "[\n"
+        "  {\n"
+        "    \"id\": 1\n"
+        "  },\n"
+        "  {\n"
+        "    \"id\": 2,\n"
+        "    \"items\": [\n"
+        "      {\"x\": 1},\n"
+        "      {\"x\": 2}\n"
+        "    ]\n"
+        "  ,\n"
+        "  {\n"
+        "    \"id\": 3\n"
+        "  }\n"
+        "]\n";
+    TolerantResult result = parseWith(content);
+
+    ASSERT_EQ(result.elements.size(), 2u);
+    EXPECT_DOUBLE_EQ(result.elements[0].at("id").asNumber(), 1.0);
+    EXPECT_DOUBLE_EQ(result.elements[1].at("id").asNumber(), 3.0);
+    EXPECT_EQ(result.errors.size(), 1u);
+}
+
+TEST(TolerantParserTest, MissingCommaKeepsBothElements) {
+    TolerantResult result = parseWith("[{\"a\": 1}\n{\"b\": 2}]");
+
+    EXPECT_EQ(result.elements.size(), 2u);
+    ASSERT_EQ(result.errors.size(), 1u);
+    EXPECT_EQ(result.errors[0].line, 2u);
+}
+
+TEST(TolerantParserTest, ValueSequenceWithoutArray) {
+    TolerantResult result = parseWith("{\"a\": 1}\n{\"b\": }\n[1, 2]\n\"s\"\n");
+
+    ASSERT_EQ(result.elements.size(), 3u);
+    EXPECT_TRUE(result.elements[1].isArray());
+    EXPECT_EQ(result.elements[2].asString(), "s");
+    EXPECT_EQ(result.errors.size(), 1u);
+}
+
+TEST(TolerantParserTest, ChunkedParallelMatchesSingleChunk) {
+    std::string content = generatedDocument(30, 1000);
+
+    TolerantResult single = parseWith(content, 1, content.size());
+    TolerantResult parallel = parseWith(content, 4, 2048);
+
+    EXPECT_EQ(single.chunkCount, 1u);
+    EXPECT_GT(parallel.chunkCount, 10u);
+    EXPECT_GT(single.skippedElements, 0u);
+    EXPECT_EQ(parallel.skippedElements, single.skippedElements);
+    EXPECT_EQ(parallel.errors.size(), single.errors.size());
+    EXPECT_EQ(Serializer::toString(JsonValue(parallel.elements), false),
+              Serializer::toString(JsonValue(single.elements), false));
+    EXPECT_EQ(parallel.elementCount, single.elements.size());
+
+    // Только проверка: те же ошибки и число элементов, но без дерева
+    TolerantParser counter(4);
+    counter.setChunkSize(2048);
+    counter.setKeepElements(false);
+    TolerantResult counted = counter.parse(content);
+    EXPECT_TRUE(counted.elements.empty());
+    EXPECT_EQ(counted.elementCount, single.elements.size());
+    EXPECT_EQ(counted.skippedElements, single.skippedElements);
+    ASSERT_EQ(counted.errors.size(), single.errors.size());
+    for (size_t i = 0; i < counted.errors.size(); ++i) {
+        EXPECT_EQ(counted.errors[i].line, single.errors[i].line) << i;
+        EXPECT_EQ(counted.errors[i].column, single.errors[i].column) << i;
+    }
+
+    // Без ошибок загружается всё
+    TolerantResult clean = parseWith(generatedDocument(0, 1000), 4, 2048);
+    EXPECT_TRUE(clean.errors.empty());
+    EXPECT_EQ(clean.elements.size(), 1000u);
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "Trace.hpp"
+#include "Parser.hpp"
+#include <cstdio>
+#include <thread>
+
+using namespace json;
+
+TEST(TraceTest, ScopeRecordsOnlyWhileEnabled) {
+    trace::start();
+    {
+        trace::Scope scope("enabled");
+    }
+    trace::stop();
+    EXPECT_EQ(trace::eventCount(), 1u);
+
+    {
+        trace::Scope scope("disabled");
+    }
+    EXPECT_EQ(trace::eventCount(), 1u);
+}
+
+TEST(TraceTest, ChromeTraceIsValidJson) {
+    const std::string path = "trace_test.json";
+
+    trace::start();
+    std::thread worker([]() {
+        trace::setThreadName("worker");
+        trace::Scope scope("work");
+    });
+    worker.join();
+    {
+        trace::Scope scope("main");
+    }
+    trace::stop();
+
+    ASSERT_TRUE(trace::writeChromeTrace(path));
+    JsonValue doc = Parser::parseFile(path);
+    std::remove(path.c_str());
+
+    const JsonValue& events = doc.at("traceEvents");
+    ASSERT_TRUE(events.isArray());
+
+    size_t complete = 0;
+    bool named = false;
+    for (size_t i = 0; i < events.size(); ++i) {
+        const JsonValue& e = events[i];
+        if (e.at("ph").asString() == "X") {
+            ++complete;
+            EXPECT_GE(e.at("dur").asNumber(), 0.0);
+        } else if (e.at("ph").asString() == "M") {
+            named = named || e.at("args").at("name").asString() == "worker";
+        }
+    }
+    EXPECT_EQ(complete, 2u);
+    EXPECT_TRUE(named);
+}
+
+TEST(TraceTest, ExitedThreadsDoNotKeepBuffers) {
+    trace::start();
+    trace::stop();
+    size_t before = trace::threadBufferCount();
+
+    // Выключенная запись: потоки не заводят буферов
+    for (int i = 0; i < 8; ++i) {
+        std::thread([]() {
+            JSON_TRACE_THREAD_NAME("idle worker");
+            trace::setThreadName("idle worker");
+            trace::Scope scope("ignored");
+        }).join();
+    }
+    EXPECT_EQ(trace::threadBufferCount(), before);
+
+    // Буфер потока с событиями живёт до следующего start()
+    trace::start();
+    std::thread([]() {
+        trace::setThreadName("busy worker");
+        trace::Scope scope("work");
+    }).join();
+    std::thread([]() { trace::setThreadName("named only"); }).join();
+    trace::stop();
+    EXPECT_EQ(trace::threadBufferCount(), before + 1);
+    EXPECT_EQ(trace::eventCount(), 1u);
+
+    trace::start();
+    trace::stop();
+    EXPECT_EQ(trace::threadBufferCount(), before);
+}
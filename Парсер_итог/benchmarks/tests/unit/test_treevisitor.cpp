@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "TreeVisitor.hpp"
+#include "Parser.hpp"
+#include "Serializer.hpp"
+
+using namespace json;
+
+namespace {
+
+// Документ с большими массивами и объектами на разных уровнях
+JsonValue makeDocument() {
+    JsonArray records;
+    for (int i = 0; i < 3000; ++i) {
+        JsonObject record;
+        record["id"] = i;
+        record["name"] = "item" + std::to_string(i);
+        record["flags"] = JsonArray{JsonValue(i % 2 == 0), JsonValue(nullptr)};
+        records.push_back(JsonValue(std::move(record)));
+    }
+    JsonObject index;
+    for (int i = 0; i < 500; ++i) {
+        index["k" + std::to_string(i)] = i * 0.5;
+    }
+    JsonObject root;
+    root["records"] = std::move(records);
+    root["index"] = std::move(index);
+    return JsonValue(std::move(root));
+}
+
+// Строки в порядке обхода: проверка порядка слияния порций
+struct Concat {
+    std::string text;
+    void merge(const Concat& other) { text += other.text; }
+};
+
+} // namespace
+
+TEST(TreeVisitorTest, ParallelStatsMatchSerial) {
+    JsonValue doc = makeDocument();
+    TreeStats serial = TreeStats::collect(doc, TreeVisitor(1));
+    TreeStats parallel = TreeStats::collect(doc, TreeVisitor(4, 64));
+
+    EXPECT_EQ(serial.objects, 3002u);
+    EXPECT_EQ(serial.arrays, 3001u);
+    EXPECT_EQ(serial.strings, 3000u);
+    EXPECT_EQ(serial.numbers, 3500u);
+    EXPECT_EQ(serial.bools, 3000u);
+    EXPECT_EQ(serial.nulls, 3000u);
+    EXPECT_EQ(serial.keys, 2 + 500 + 3000u * 3);
+    EXPECT_EQ(serial.maxDepth, 4u);
+
+    EXPECT_EQ(parallel.objects, serial.objects);
+    EXPECT_EQ(parallel.arrays, serial.arrays);
+    EXPECT_EQ(parallel.total(), serial.total());
+    EXPECT_EQ(parallel.keys, serial.keys);
+    EXPECT_EQ(parallel.stringBytes, serial.stringBytes);
+    EXPECT_EQ(parallel.maxDepth, serial.maxDepth);
+}
+
+TEST(TreeVisitorTest, ReduceKeepsChildOrder) {
+    JsonValue doc = makeDocument();
+    auto collect = [](Concat& acc, const JsonValue& value, size_t) {
+        if (value.isString()) acc.text += value.asString() + ",";
+    };
+
+    std::string serial = TreeVisitor(1).reduce<Concat>(doc, collect).text;
+    std::string parallel = TreeVisitor(4, 16).reduce<Concat>(doc, collect).text;
+    EXPECT_EQ(parallel, serial);
+    EXPECT_EQ(serial.substr(0, 12), "item0,item1,");
+}
+
+TEST(TreeVisitorTest, TransformBuildsNewTree) {
+    JsonValue doc = makeDocument();
+    auto scale = [](JsonValue value, size_t) {
+        return value.isNumber() ? JsonValue(value.asNumber() * 2) : value;
+    };
+
+    JsonValue serial = TreeVisitor(1).transform(doc, scale);
+    JsonValue parallel = TreeVisitor(4, 64).transform(doc, scale);
+
+    EXPECT_EQ(Serializer::toString(parallel, false), Serializer::toString(serial, false));
+    EXPECT_DOUBLE_EQ(parallel.at("records")[2999].at("id").asNumber(), 5998.0);
+    EXPECT_DOUBLE_EQ(parallel.at("index").at("k499").asNumber(), 499.0);
+    EXPECT_DOUBLE_EQ(doc.at("records")[2999].at("id").asNumber(), 2999.0);
+}
+
+TEST(TreeVisitorTest, ExceptionFromTaskPropagates) {
+    JsonValue doc = makeDocument();
+    TreeVisitor visitor(4, 32);
+    auto failing = [](TreeStats&, const JsonValue& value, size_t) {
+        if (value.isString() && value.asString() == "item2500") {
+            throw JsonException("stop");
+        }
+    };
+    EXPECT_THROW(visitor.reduce<TreeStats>(doc, failing), JsonException);
+
+    // Пул остаётся рабочим
+    EXPECT_EQ(TreeStats::collect(doc, visitor).strings, 3000u);
+}
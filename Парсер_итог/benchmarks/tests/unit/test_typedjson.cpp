@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include "TypedJson.hpp"
+#include "Parser.hpp"
+
+using namespace json;
+
+namespace records {
+
+struct Address {
+    std::string city;
+    std::optional<std::string> zip;
+};
+JSON_FIELDS(Address, city, zip)
+
+struct User {
+    int id = 0;
+    std::string name;
+    std::string email;
+    double score = 0.0;
+    bool active = false;
+    std::vector<std::string> tags;
+    std::optional<Address> address;
+};
+JSON_FIELDS(User, id, name, email, score, active, tags, address)
+
+} // namespace records
+
+using records::User;
+
+TEST(TypedJsonTest, ReadsStructWithNestedFields) {
+    User user = json::read<User>(R"({
+        "email": "anna@example.com", "id": 7, "unknown": {"x": [1, 2, {"y": null}]},
+        "name": "Анна ❤", "score": 4.5, "active": true,
+        "tags": ["a", "b"], "address": {"city": "Москва", "zip": null}
+    })");
+
+    EXPECT_EQ(user.id, 7);
+    EXPECT_EQ(user.name, "Анна \xE2\x9D\xA4");
+    EXPECT_EQ(user.email, "anna@example.com");
+    EXPECT_DOUBLE_EQ(user.score, 4.5);
+    EXPECT_TRUE(user.active);
+    EXPECT_EQ(user.tags, (std::vector<std::string>{"a", "b"}));
+    ASSERT_TRUE(user.address.has_value());
+    EXPECT_EQ(user.address->city, "Москва");
+    EXPECT_FALSE(user.address->zip.has_value());
+}
+
+TEST(TypedJsonTest, ReadsVectorAndWritesBack) {
+    const std::string input =
+        R"([{"id":1,"name":"A","email":"a@x","score":1,"active":false,"tags":[]},)"
+        R"({"id":2,"name":"B","email":"b@x","score":2.5,"active":true,"tags":["t"],"address":null}])";
+
+    auto users = json::read<std::vector<User>>(input);
+    ASSERT_EQ(users.size(), 2u);
+    EXPECT_EQ(users[1].tags.front(), "t");
+
+    std::string written = json::write(users);
+    EXPECT_EQ(written,
+        R"([{"id":1,"name":"A","email":"a@x","score":1,"active":false,"tags":[],"address":null},)"
+        R"({"id":2,"name":"B","email":"b@x","score":2.5,"active":true,"tags":["t"],"address":null}])");
+
+    auto again = json::read<std::vector<User>>(written);
+    EXPECT_EQ(again[1].name, "B");
+}
+
+TEST(TypedJsonTest, ReportsTypeAndSchemaErrors) {
+    EXPECT_THROW(json::read<User>(R"({"id": 1})"), ParserException);                    // Нет полей
+    EXPECT_THROW(json::read<int>("1.5"), ParserException);
+    EXPECT_THROW(json::read<int8_t>("300"), ParserException);
+    EXPECT_THROW(json::read<std::string>("\"abc"), ParserException);
+    EXPECT_THROW(json::read<std::vector<int>>("[1, 2,]"), ParserException);
+    EXPECT_THROW(json::read<bool>("true false"), ParserException);
+    EXPECT_EQ(json::read<int>("1e3"), 1000);
+    EXPECT_THROW(json::read<User>(R"({"id": 1e400, "name": "x", "email": "", "score": 0, "active": true,
+                                      "tags": []})"),
+                 ParserException);
+    EXPECT_THROW(json::read<long long>("-1e400"), ParserException);
+}
+
+TEST(TypedJsonTest, MapsAndDomFallback) {
+    auto counts = json::read<std::map<std::string, long long>>(R"({"a": 1, "b": -9007199254740993})");
+    EXPECT_EQ(counts["b"], -9007199254740993LL);
+
+    auto raw = json::read<std::map<std::string, JsonValue>>(R"({"x": {"y": [true]}})");
+    EXPECT_TRUE(raw["x"].at("y")[0].asBool());
+}
+
+TEST(TypedJsonTest, SkipsDeeplyNestedUnknownFields) {
+    const size_t depth = 1000000;
+    std::string json = R"({"city": "x", "junk": )" + std::string(depth, '[') + std::string(depth, ']') + "}";
+    EXPECT_EQ(json::read<records::Address>(json).city, "x");
+
+    // Незакрытый или лишний контейнер - ошибка, а не переполнение стека
+    EXPECT_THROW(json::read<records::Address>(R"({"city": "x", "junk": [[{"a": [1}]]})"), ParserException);
+    EXPECT_THROW(json::read<records::Address>(R"({"city": "x", "junk": )" + std::string(depth, '[') + "}"),
+                 ParserException);
+
+    // В JsonValue глубина ограничена, как у Parser
+    EXPECT_THROW((json::read<std::map<std::string, JsonValue>>(R"({"x": )" + std::string(depth, '[') +
+                                                                  std::string(depth, ']') + "}")),
+                 ParserException);
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include "Utf8.hpp"
+#include "Lexer.hpp"
+#include "Validator.hpp"
+#include <random>
+
+using namespace json;
+
+TEST(Utf8Test, AcceptsWellFormedText) {
+    EXPECT_TRUE(utf8::isValid(""));
+    EXPECT_TRUE(utf8::isValid("plain ascii"));
+    EXPECT_TRUE(utf8::isValid("Привет, 你好, \xF0\x9F\x98\x80, \xF4\x8F\xBF\xBF"));
+}
+
+TEST(Utf8Test, RejectsMalformedSequences) {
+    const std::string prefix(70, 'a');      // Ошибка во втором 64-байтном блоке
+    const char* cases[] = {
+        "\x80",             // Продолжение без начала
+        "\xC0\xAF",         // Избыточная форма '/'
+        "\xC3",             // Обрезанная последовательность
+        "\xE0\x80\xAF",     // Избыточная 3-байтовая
+        "\xED\xA0\x80",     // Суррогат U+D800
+        "\xF4\x90\x80\x80", // Больше U+10FFFF
+        "\xF8\x88\x80\x80\x80",
+        "\xE2\x82",         // Незавершённая в конце входа
+    };
+    for (const char* bad : cases) {
+        std::string text = prefix + bad;
+        EXPECT_EQ(utf8::findInvalid(text), prefix.size()) << "байты: " << text.substr(prefix.size());
+        EXPECT_EQ(utf8::findInvalidScalar(text.data(), text.size()), prefix.size());
+    }
+}
+
+TEST(Utf8Test, VectorAndScalarAgreeOnRandomInput) {
+    const char* pieces[] = {"a", "\"", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80",
+                            "\x80", "\xC3", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\xEF\xBF\xBF"};
+    std::mt19937 rng(12345);
+
+    for (int round = 0; round < 2000; ++round) {
+        std::string text;
+        size_t length = rng() % 200;
+        bool corrupt = round % 2 == 1;
+        while (text.size() < length) {
+            size_t piece = rng() % (corrupt ? 10 : 5);
+            text += pieces[piece == 5 && !corrupt ? 0 : piece];
+        }
+        size_t scalar = utf8::findInvalidScalar(text.data(), text.size());
+        EXPECT_EQ(utf8::findInvalid(text), scalar);
+    }
+}
+
+TEST(Utf8Test, LexerAndValidatorReportPosition) {
+    std::string json = "{\n  \"name\": \"ok \xC3\x28\"\n}";
+
+    Lexer lexer(json);
+    try {
+        lexer.tokenize();
+        FAIL() << "Ожидалось исключение";
+    } catch (const LexerException& e) {
+        EXPECT_EQ(e.line, 2u);
+        EXPECT_EQ(e.column, 15u);
+    }
+
+    Validator validator;
+    ValidationResult result = validator.validate(json);
+    EXPECT_FALSE(result.isValid);
+    ASSERT_FALSE(result.errors.empty());
+    EXPECT_NE(result.errors[0].message.find("UTF-8"), std::string::npos);
+}
@@ -287,6 +287,18 @@ TEST(ValidatorTest, DeepNesting) {
     EXPECT_TRUE(result.isValid);
 }
 
+TEST(ValidatorTest, NestingBeyondMaxDepth) {
+    // Вложенность глубже лимита - ошибка, а не переполнение стека
+    std::string json = "[" + std::string(100000, '[') + std::string(100000, ']') + ", 1]";
+
+    Validator validator;
+    validator.setMaxDepth(50);
+    auto result = validator.validate(json);
+    EXPECT_FALSE(result.isValid);
+    ASSERT_EQ(result.errors.size(), 1u);
+    EXPECT_NE(result.errors[0].message.find("глубина"), std::string::npos);
+}
+
 TEST(ValidatorTest, LongString) {
     std::string longStr(10000, 'x');
     std::string json = "\"" + longStr + "\"";